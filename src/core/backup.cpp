@@ -0,0 +1,197 @@
+/*  Copyright (C) 2014-2016 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "core/backup.h"
+
+#include <errno.h>   // for errno, ENOENT
+#include <stdio.h>   // for rename
+#include <string.h>  // for strerror
+
+#include <fstream>  // for ifstream, ofstream
+
+#include <common/time.h>  // for current_mstime
+
+#define BACKUP_COPY_BUFFER_SIZE (1024 * 1024)
+
+namespace fastonosql {
+namespace core {
+namespace {
+
+// "db/" is renamed as "db", siblings of it can't be inside of it
+std::string withoutTrailingSeparators(const std::string& path) {
+  std::string result = path;
+  while (result.size() > 1 && (result.back() == '/' || result.back() == '\\')) {
+    result.pop_back();
+  }
+  return result;
+}
+
+}  // namespace
+
+BackupStats::BackupStats() : files(0), keys(0), bytes(0), total_bytes(0), elapsed_msec(0) {}
+
+double BackupStats::BytesPerSecond() const {
+  if (elapsed_msec <= 0) {
+    return 0;
+  }
+
+  return static_cast<double>(bytes) * 1000 / elapsed_msec;
+}
+
+int BackupStats::Percent() const {
+  if (!total_bytes) {
+    return 0;
+  }
+
+  if (bytes >= total_bytes) {
+    return 100;
+  }
+
+  return static_cast<int>(bytes * 100 / total_bytes);
+}
+
+BackupProgress::BackupProgress(backup_progress_callback_t progress_cb, BackupStats* stats)
+    : progress_cb_(progress_cb),
+      stats_(stats),
+      start_ts_(common::time::current_mstime()),
+      reported_ts_(start_ts_) {}
+
+BackupStats* BackupProgress::Stats() const {
+  return stats_;
+}
+
+void BackupProgress::Add(uint64_t bytes, uint64_t keys) {
+  stats_->bytes += bytes;
+  stats_->keys += keys;
+  Report(false);
+}
+
+void BackupProgress::Update() {
+  Report(false);
+}
+
+void BackupProgress::Finish() {
+  Report(true);
+}
+
+void BackupProgress::Report(bool force) {
+  common::time64_t now = common::time::current_mstime();
+  stats_->elapsed_msec = now - start_ts_;
+  if (!force && now - reported_ts_ < BACKUP_PROGRESS_INTERVAL_MSEC) {
+    return;
+  }
+
+  reported_ts_ = now;
+  if (progress_cb_) {
+    progress_cb_(*stats_);
+  }
+}
+
+common::Error CopyFileWithProgress(const std::string& from,
+                                   const std::string& to,
+                                   BackupProgress* progress) {
+  std::ifstream in(from.c_str(), std::ios::in | std::ios::binary);
+  if (!in.is_open()) {
+    std::string buff = common::MemSPrintf("Can't open file for reading: %s", from);
+    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+  }
+
+  std::ofstream out(to.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!out.is_open()) {
+    std::string buff = common::MemSPrintf("Can't open file for writing: %s", to);
+    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+  }
+
+  std::vector<char> buffer(BACKUP_COPY_BUFFER_SIZE);
+  while (in) {
+    in.read(buffer.data(), buffer.size());
+    std::streamsize count = in.gcount();
+    if (count <= 0) {
+      break;
+    }
+
+    if (!out.write(buffer.data(), count)) {
+      std::string buff = common::MemSPrintf("Can't write file: %s", to);
+      return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+    }
+    progress->Add(count, 0);
+  }
+
+  if (in.bad()) {
+    std::string buff = common::MemSPrintf("Can't read file: %s", from);
+    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+  }
+
+  out.close();
+  if (out.fail()) {
+    std::string buff = common::MemSPrintf("Can't write file: %s", to);
+    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+  }
+
+  progress->Stats()->files++;
+  return common::Error();
+}
+
+bool IsDBServiceFile(const std::string& name) {
+  return name == "LOCK" || name.compare(0, 3, "LOG") == 0;
+}
+
+void RemoveRestoredFile(const std::string& path) {
+  if (common::file_system::is_file_exist(path)) {
+    common::Error err = common::file_system::remove_file(path);
+    UNUSED(err);
+  }
+}
+
+std::string RestoreTempPath(const std::string& target) {
+  return withoutTrailingSeparators(target) + BACKUP_RESTORE_SUFFIX;
+}
+
+common::Error SwapRestored(const std::string& restored,
+                           const std::string& target_path,
+                           remove_path_func_t remove_path) {
+  // left by interrupted swap
+  const std::string target = withoutTrailingSeparators(target_path);
+  const std::string old = target + BACKUP_OLD_SUFFIX;
+  remove_path(old);
+
+  bool had_target = true;
+  if (rename(target.c_str(), old.c_str()) != 0) {
+    if (errno != ENOENT) {
+      std::string buff = common::MemSPrintf("Can't move %s aside: %s", target, strerror(errno));
+      return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+    }
+    had_target = false;
+  }
+
+  if (rename(restored.c_str(), target.c_str()) != 0) {
+    std::string buff = common::MemSPrintf("Can't replace %s: %s", target, strerror(errno));
+    if (had_target) {
+      rename(old.c_str(), target.c_str());
+    }
+    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+  }
+
+  if (had_target) {
+    remove_path(old);
+  }
+  return common::Error();
+}
+
+}  // namespace core
+}  // namespace fastonosql
@@ -0,0 +1,144 @@
+/*  Copyright (C) 2014-2016 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <stdint.h>  // for uint64_t
+
+#include <functional>  // for function
+#include <string>      // for string
+#include <vector>      // for vector
+
+#include <common/error.h>        // for Error
+#include <common/file_system.h>  // for create_directory
+#include <common/macros.h>       // for WARN_UNUSED_RESULT
+#include <common/sprintf.h>      // for MemSPrintf
+#include <common/types.h>        // for time64_t
+
+#define BACKUP_PROGRESS_INTERVAL_MSEC 250
+#define BACKUP_RESTORE_SUFFIX ".restore"
+#define BACKUP_OLD_SUFFIX ".old"
+
+namespace fastonosql {
+namespace core {
+
+struct BackupStats {
+  BackupStats();
+
+  double BytesPerSecond() const;
+  int Percent() const;  // of total_bytes, 0 if total isn't known
+
+  uint64_t files;
+  uint64_t keys;         // engines which copy by iterator
+  uint64_t bytes;        // written to backup (or restored database)
+  uint64_t total_bytes;  // expected, may be estimate
+  common::time64_t elapsed_msec;
+};
+
+typedef std::function<void(const BackupStats&)> backup_progress_callback_t;
+
+// measures time of backup or restore and reports stats
+// not more often than every BACKUP_PROGRESS_INTERVAL_MSEC
+class BackupProgress {
+ public:
+  BackupProgress(backup_progress_callback_t progress_cb, BackupStats* stats);
+
+  BackupStats* Stats() const;
+  void Add(uint64_t bytes, uint64_t keys);
+  void Update();  // elapsed time of engine which copies without callbacks
+  void Finish();
+
+ private:
+  void Report(bool force);
+
+  const backup_progress_callback_t progress_cb_;
+  BackupStats* const stats_;
+  const common::time64_t start_ts_;
+  common::time64_t reported_ts_;
+};
+
+// copy by pieces, for engines which can't stream their own files,
+// existing target is overwritten
+common::Error CopyFileWithProgress(const std::string& from,
+                                   const std::string& to,
+                                   BackupProgress* progress) WARN_UNUSED_RESULT;
+
+// lock and info logs belong to running instance
+bool IsDBServiceFile(const std::string& name);
+
+typedef std::function<void(const std::string&)> remove_path_func_t;
+
+// remove_path_func_t of engines stored in one file, missing file is ignored
+void RemoveRestoredFile(const std::string& path);
+
+// backup is restored next to database first, so failed copy leaves it untouched
+std::string RestoreTempPath(const std::string& target);
+
+// replaces target file or directory by restored one by renames,
+// previous target is moved aside and removed only after swap succeeded
+common::Error SwapRestored(const std::string& restored,
+                           const std::string& target,
+                           remove_path_func_t remove_path) WARN_UNUSED_RESULT;
+
+// files of LevelDB/RocksDB database directory listed by Env of engine,
+// directory shouldn't be opened by any instance while copying
+template <typename Env>
+common::Error CopyDBFiles(Env* env,
+                          const std::string& from,
+                          const std::string& to,
+                          BackupProgress* progress) {
+  std::vector<std::string> files;
+  auto st = env->GetChildren(from, &files);
+  if (!st.ok()) {
+    std::string buff = common::MemSPrintf("Copy files error: %s", st.ToString());
+    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+  }
+
+  common::Error err = common::file_system::create_directory(to, true);
+  if (err && err->IsError()) {
+    return err;
+  }
+
+  std::vector<std::string> db_files;
+  for (size_t i = 0; i < files.size(); ++i) {
+    if (files[i] == "." || files[i] == ".." || IsDBServiceFile(files[i])) {
+      continue;
+    }
+
+    uint64_t size = 0;
+    st = env->GetFileSize(from + "/" + files[i], &size);
+    if (!st.ok()) {
+      std::string buff = common::MemSPrintf("Copy files error: %s", st.ToString());
+      return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+    }
+    progress->Stats()->total_bytes += size;
+    db_files.push_back(files[i]);
+  }
+
+  for (size_t i = 0; i < db_files.size(); ++i) {
+    err = CopyFileWithProgress(from + "/" + db_files[i], to + "/" + db_files[i], progress);
+    if (err && err->IsError()) {
+      return err;
+    }
+  }
+
+  return common::Error();
+}
+
+}  // namespace core
+}  // namespace fastonosql
@@ -0,0 +1,196 @@
+/*  Copyright (C) 2014-2016 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "core/bulk_operation.h"
+
+#include <algorithm>  // for min
+#include <chrono>     // for milliseconds
+#include <thread>     // for sleep_for
+
+#include <common/time.h>  // for current_mstime
+
+#define BULK_DEFAULT_PATTERN "*"
+#define BULK_DEFAULT_BATCH_SIZE 500
+
+namespace fastonosql {
+namespace core {
+
+BulkOptions::BulkOptions()
+    : type(BULK_DELETE),
+      pattern(BULK_DEFAULT_PATTERN),
+      ttl(NO_TTL),
+      old_prefix(),
+      new_prefix(),
+      batch_size(BULK_DEFAULT_BATCH_SIZE),
+      ops_per_sec(0),
+      dry_run(false) {}
+
+BulkStats::BulkStats() : scanned(0), matched(0), processed(0), skipped(0), elapsed_msec(0) {}
+
+double BulkStats::OpsPerSecond() const {
+  if (elapsed_msec <= 0) {
+    return 0;
+  }
+
+  return static_cast<double>(processed) * 1000 / elapsed_msec;
+}
+
+bool RewriteKeyPrefix(const std::string& key,
+                      const std::string& old_prefix,
+                      const std::string& new_prefix,
+                      std::string* new_key) {
+  if (!new_key || key.compare(0, old_prefix.size(), old_prefix) != 0) {
+    return false;
+  }
+
+  // SCAN can return already renamed key if new prefix extends old one
+  if (new_prefix.size() > old_prefix.size() &&
+      new_prefix.compare(0, old_prefix.size(), old_prefix) == 0 &&
+      key.compare(0, new_prefix.size(), new_prefix) == 0) {
+    return false;
+  }
+
+  *new_key = new_prefix + key.substr(old_prefix.size());
+  return true;
+}
+
+IBulkTarget::~IBulkTarget() {}
+
+bool IBulkTarget::HasStableCursors() const {
+  return false;
+}
+
+BulkOperation::BulkOperation(IBulkTarget* target, const BulkOptions& options)
+    : target_(target), options_(options) {}
+
+common::Error BulkOperation::Run(interrupt_callback_t is_interrupted,
+                                 progress_callback_t progress_cb,
+                                 BulkStats* stats) {
+  if (!target_ || !stats || options_.batch_size == 0) {
+    DNOTREACHED();
+    return common::make_error_value("Invalid input argument(s)", common::ErrorValue::E_ERROR);
+  }
+
+  if (options_.type == BULK_RENAME && options_.old_prefix == options_.new_prefix) {
+    return common::make_error_value("New prefix should differ from old one",
+                                    common::ErrorValue::E_ERROR);
+  }
+
+  *stats = BulkStats();
+  const common::time64_t start_ts = common::time::current_mstime();
+  const size_t batch_size = options_.ops_per_sec
+                                ? std::min(options_.batch_size, options_.ops_per_sec)
+                                : options_.batch_size;
+  // deleted or renamed keys shift offsets of unstable cursors,
+  // so pass is repeated from start while previous one changed something
+  const bool repeat_passes = !options_.dry_run && !target_->HasStableCursors() &&
+                             (options_.type == BULK_DELETE || options_.type == BULK_RENAME);
+  uint64_t pass_processed = 0;
+  uint64_t cursor = 0;
+  do {
+    if (cursor == 0) {
+      pass_processed = stats->processed;
+    }
+
+    if (is_interrupted && is_interrupted()) {
+      stats->elapsed_msec = common::time::current_mstime() - start_ts;
+      return common::make_error_value("Interrupted.", common::ErrorValue::E_INTERRUPTED);
+    }
+
+    std::vector<std::string> keys;
+    common::Error err = target_->Scan(cursor, options_.pattern, batch_size, &keys, &cursor);
+    if (err && err->IsError()) {
+      stats->elapsed_msec = common::time::current_mstime() - start_ts;
+      return err;
+    }
+
+    stats->scanned += keys.size();
+    err = ApplyBatch(keys, stats);
+    if (err && err->IsError()) {
+      stats->elapsed_msec = common::time::current_mstime() - start_ts;
+      return err;
+    }
+
+    stats->elapsed_msec = common::time::current_mstime() - start_ts;
+    if (progress_cb) {
+      progress_cb(*stats);
+    }
+
+    Throttle(start_ts, *stats);
+  } while (cursor != 0 || (repeat_passes && stats->processed != pass_processed));
+
+  stats->elapsed_msec = common::time::current_mstime() - start_ts;
+  return common::Error();
+}
+
+common::Error BulkOperation::ApplyBatch(const std::vector<std::string>& keys, BulkStats* stats) {
+  NKeys matched;
+  std::vector<std::string> new_keys;
+  for (size_t i = 0; i < keys.size(); ++i) {
+    if (options_.type == BULK_RENAME) {
+      std::string new_key;
+      if (!RewriteKeyPrefix(keys[i], options_.old_prefix, options_.new_prefix, &new_key)) {
+        continue;
+      }
+      new_keys.push_back(new_key);
+    }
+    matched.push_back(NKey(keys[i]));
+  }
+
+  stats->matched += matched.size();
+  if (options_.dry_run || matched.empty()) {
+    return common::Error();
+  }
+
+  NKeys processed;
+  common::Error err;
+  if (options_.type == BULK_DELETE) {
+    err = target_->Delete(matched, &processed);
+  } else if (options_.type == BULK_EXPIRE) {
+    err = target_->SetTTL(matched, options_.ttl, &processed);
+  } else if (options_.type == BULK_PERSIST) {
+    err = target_->SetTTL(matched, NO_TTL, &processed);
+  } else if (options_.type == BULK_RENAME) {
+    err = target_->Rename(matched, new_keys, &processed);
+  } else {
+    NOTREACHED();
+  }
+
+  if (err && err->IsError()) {
+    return err;
+  }
+
+  stats->processed += processed.size();
+  stats->skipped += matched.size() - processed.size();
+  return common::Error();
+}
+
+void BulkOperation::Throttle(common::time64_t start_ts, const BulkStats& stats) const {
+  if (options_.ops_per_sec == 0 || options_.dry_run) {
+    return;
+  }
+
+  const common::time64_t expected_msec = stats.matched * 1000 / options_.ops_per_sec;
+  const common::time64_t elapsed_msec = common::time::current_mstime() - start_ts;
+  if (elapsed_msec < expected_msec) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(expected_msec - elapsed_msec));
+  }
+}
+
+}  // namespace core
+}  // namespace fastonosql
@@ -0,0 +1,159 @@
+/*  Copyright (C) 2014-2016 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <stddef.h>  // for size_t
+#include <stdint.h>  // for uint64_t
+
+#include <functional>  // for function
+#include <string>      // for string
+#include <vector>      // for vector
+
+#include <common/error.h>   // for Error
+#include <common/macros.h>  // for WARN_UNUSED_RESULT
+#include <common/types.h>   // for time64_t
+
+#include "core/db_key.h"  // for NKeys, ttl_t
+
+namespace fastonosql {
+namespace core {
+
+enum BulkOperationType { BULK_DELETE = 0, BULK_EXPIRE, BULK_PERSIST, BULK_RENAME };
+
+struct BulkOptions {
+  BulkOptions();
+
+  BulkOperationType type;
+  std::string pattern;
+  ttl_t ttl;               // BULK_EXPIRE
+  std::string old_prefix;  // BULK_RENAME, old_prefix of matched keys replaced by new_prefix
+  std::string new_prefix;
+  size_t batch_size;   // keys per SCAN page and per pipeline
+  size_t ops_per_sec;  // 0 is unlimited
+  bool dry_run;        // only count matched keys
+};
+
+struct BulkStats {
+  BulkStats();
+
+  double OpsPerSecond() const;
+
+  uint64_t scanned;
+  uint64_t matched;
+  uint64_t processed;
+  uint64_t skipped;  // removed while processing or without ttl
+  common::time64_t elapsed_msec;
+};
+
+// false if key hasn't old_prefix
+bool RewriteKeyPrefix(const std::string& key,
+                      const std::string& old_prefix,
+                      const std::string& new_prefix,
+                      std::string* new_key);
+
+class IBulkTarget {
+ public:
+  virtual ~IBulkTarget();
+
+  virtual common::Error Scan(uint64_t cursor_in,
+                             const std::string& pattern,
+                             uint64_t count_keys,
+                             std::vector<std::string>* keys_out,
+                             uint64_t* cursor_out) WARN_UNUSED_RESULT = 0;
+  virtual common::Error DBkcount(size_t* size) WARN_UNUSED_RESULT = 0;
+  virtual common::Error Delete(const NKeys& keys, NKeys* deleted_keys) WARN_UNUSED_RESULT = 0;
+  virtual common::Error SetTTL(const NKeys& keys,
+                               ttl_t ttl,
+                               NKeys* changed_keys) WARN_UNUSED_RESULT = 0;
+  virtual common::Error Rename(const NKeys& keys,
+                               const std::vector<std::string>& new_keys,
+                               NKeys* renamed_keys) WARN_UNUSED_RESULT = 0;
+
+  // true if cursors aren't shifted by keys deleted or renamed in previous batches,
+  // otherwise pages after changed keys can be skipped and scan pass is repeated
+  virtual bool HasStableCursors() const;
+};
+
+// adapter of any CDBConnection, batches go through its batch nvi,
+// stable_cursors for engines scanned from pinned snapshot or resumed by key
+template <typename DBConnection>
+class CDBBulkTarget : public IBulkTarget {
+ public:
+  explicit CDBBulkTarget(DBConnection* db, bool stable_cursors = false)
+      : db_(db), stable_cursors_(stable_cursors) {
+    db_->PinSnapshot();
+  }
+  virtual ~CDBBulkTarget() { db_->UnpinSnapshot(); }
+
+  virtual common::Error Scan(uint64_t cursor_in,
+                             const std::string& pattern,
+                             uint64_t count_keys,
+                             std::vector<std::string>* keys_out,
+                             uint64_t* cursor_out) override {
+    return db_->Scan(cursor_in, pattern, count_keys, keys_out, cursor_out);
+  }
+
+  virtual common::Error DBkcount(size_t* size) override { return db_->DBkcount(size); }
+
+  virtual common::Error Delete(const NKeys& keys, NKeys* deleted_keys) override {
+    return db_->Delete(keys, deleted_keys);
+  }
+
+  virtual common::Error SetTTL(const NKeys& keys, ttl_t ttl, NKeys* changed_keys) override {
+    return db_->SetTTLBatch(keys, ttl, changed_keys);
+  }
+
+  virtual common::Error Rename(const NKeys& keys,
+                               const std::vector<std::string>& new_keys,
+                               NKeys* renamed_keys) override {
+    return db_->RenameBatch(keys, new_keys, renamed_keys);
+  }
+
+  virtual bool HasStableCursors() const override { return stable_cursors_; }
+
+ private:
+  DBConnection* const db_;
+  const bool stable_cursors_;
+};
+
+// SCAN driven, every page is applied as one batch,
+// batches are delayed to keep ops_per_sec on live servers,
+// delete and rename passes are repeated until nothing left on unstable cursors
+class BulkOperation {
+ public:
+  typedef std::function<void(const BulkStats&)> progress_callback_t;
+  typedef std::function<bool()> interrupt_callback_t;
+
+  BulkOperation(IBulkTarget* target, const BulkOptions& options);
+
+  common::Error Run(interrupt_callback_t is_interrupted,
+                    progress_callback_t progress_cb,
+                    BulkStats* stats) WARN_UNUSED_RESULT;
+
+ private:
+  common::Error ApplyBatch(const std::vector<std::string>& keys,
+                           BulkStats* stats) WARN_UNUSED_RESULT;
+  void Throttle(common::time64_t start_ts, const BulkStats& stats) const;
+
+  IBulkTarget* const target_;
+  const BulkOptions options_;
+};
+
+}  // namespace core
+}  // namespace fastonosql
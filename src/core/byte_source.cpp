@@ -0,0 +1,114 @@
+/*  Copyright (C) 2014-2016 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "core/byte_source.h"
+
+#include <string.h>  // for memcpy
+
+#include <algorithm>  // for min
+
+namespace fastonosql {
+namespace core {
+
+IByteSource::~IByteSource() {}
+
+std::string IByteSource::LastError() const {
+  return std::string();
+}
+
+ByteSources::ByteSources() : sources_() {}
+
+void ByteSources::Add(byte_source_t source) {
+  for (auto it = sources_.begin(); it != sources_.end();) {
+    if (it->expired()) {
+      it = sources_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  sources_.push_back(source);
+}
+
+void ByteSources::CloseAll() {
+  for (auto it = sources_.begin(); it != sources_.end(); ++it) {
+    byte_source_t source = it->lock();
+    if (source) {
+      source->Close();
+    }
+  }
+  sources_.clear();
+}
+
+StringByteSource::StringByteSource(const std::string& data) : data_(data) {}
+
+uint64_t StringByteSource::Size() const {
+  return data_.size();
+}
+
+size_t StringByteSource::Read(uint64_t offset, char* out, size_t size) {
+  if (offset >= data_.size()) {
+    return 0;
+  }
+
+  size_t count = std::min<uint64_t>(size, data_.size() - offset);
+  memcpy(out, data_.data() + offset, count);
+  return count;
+}
+
+void StringByteSource::Close() {}
+
+ChunkedByteSource::ChunkedByteSource() : chunks_(), size_(0) {}
+
+void ChunkedByteSource::Append(const char* data, size_t size) {
+  while (size) {
+    if (chunks_.empty() || chunks_.back().size() == BYTE_SOURCE_CHUNK_SIZE) {
+      chunks_.push_back(std::string());
+      chunks_.back().reserve(BYTE_SOURCE_CHUNK_SIZE);
+    }
+
+    std::string& chunk = chunks_.back();
+    size_t count = std::min<size_t>(size, BYTE_SOURCE_CHUNK_SIZE - chunk.size());
+    chunk.append(data, count);
+    data += count;
+    size -= count;
+    size_ += count;
+  }
+}
+
+uint64_t ChunkedByteSource::Size() const {
+  return size_;
+}
+
+size_t ChunkedByteSource::Read(uint64_t offset, char* out, size_t size) {
+  size_t copied = 0;
+  while (copied < size && offset < size_) {
+    const std::string& chunk = chunks_[offset / BYTE_SOURCE_CHUNK_SIZE];
+    size_t chunk_offset = offset % BYTE_SOURCE_CHUNK_SIZE;
+    size_t count = std::min<size_t>(size - copied, chunk.size() - chunk_offset);
+    memcpy(out + copied, chunk.data() + chunk_offset, count);
+    copied += count;
+    offset += count;
+  }
+
+  return copied;
+}
+
+void ChunkedByteSource::Close() {}
+
+}  // namespace core
+}  // namespace fastonosql
@@ -0,0 +1,96 @@
+/*  Copyright (C) 2014-2016 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <stddef.h>  // for size_t
+#include <stdint.h>  // for uint64_t
+
+#include <memory>  // for shared_ptr, weak_ptr
+#include <string>  // for string
+#include <vector>  // for vector
+
+#define BYTE_SOURCE_CHUNK_SIZE (64 * 1024)
+
+namespace fastonosql {
+namespace core {
+
+// bytes of value read page by page, so viewers don't hold whole value in memory,
+// Read can be called from other thread than the one which created source
+class IByteSource {
+ public:
+  virtual ~IByteSource();
+
+  virtual uint64_t Size() const = 0;
+  // copies at most size bytes from offset, returns count of copied bytes,
+  // 0 after end of value or when source was closed
+  virtual size_t Read(uint64_t offset, char* out, size_t size) = 0;
+  // database is going to be closed, Read shouldn't touch it anymore
+  virtual void Close() = 0;
+  // why last Read copied nothing before end of value, empty if it didn't fail
+  virtual std::string LastError() const;
+};
+
+typedef std::shared_ptr<IByteSource> byte_source_t;
+
+// sources opened by connection, they are closed before its database
+class ByteSources {
+ public:
+  ByteSources();
+
+  void Add(byte_source_t source);
+  void CloseAll();
+
+ private:
+  std::vector<std::weak_ptr<IByteSource> > sources_;
+};
+
+// for values already in memory, immutable so it needs no locks
+class StringByteSource : public IByteSource {
+ public:
+  explicit StringByteSource(const std::string& data);
+
+  virtual uint64_t Size() const override;
+  virtual size_t Read(uint64_t offset, char* out, size_t size) override;
+  virtual void Close() override;
+
+ private:
+  const std::string data_;
+};
+
+// for values which engine can only hand out as stream of pieces,
+// pieces are appended to fixed size chunks, so value is never
+// copied into one contiguous buffer and reallocated while it grows,
+// source is filled before it is shared, reading needs no locks
+class ChunkedByteSource : public IByteSource {
+ public:
+  ChunkedByteSource();
+
+  void Append(const char* data, size_t size);
+
+  virtual uint64_t Size() const override;
+  virtual size_t Read(uint64_t offset, char* out, size_t size) override;
+  virtual void Close() override;
+
+ private:
+  std::vector<std::string> chunks_;
+  uint64_t size_;
+};
+
+}  // namespace core
+}  // namespace fastonosql
@@ -35,6 +35,10 @@ bool IsSupportTTLKeys(connectionTypes type) {
   return type == REDIS || type == MEMCACHED || type == SSDB;
 }
 
+bool IsSupportContainerValues(connectionTypes type) {
+  return type == REDIS;
+}
+
 bool IsLocalType(connectionTypes type) {
   return type == ROCKSDB || type == LEVELDB || type == LMDB || type == UPSCALEDB || type == UNQLITE;
 }
@@ -61,6 +61,7 @@ enum ConnectionMode { InteractiveMode };
 
 bool IsRemoteType(connectionTypes type);
 bool IsSupportTTLKeys(connectionTypes type);
+bool IsSupportContainerValues(connectionTypes type);
 bool IsLocalType(connectionTypes type);
 bool IsCanSSHConnection(connectionTypes type);
 const char* CommandLineHelpText(connectionTypes type);
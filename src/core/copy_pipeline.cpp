@@ -0,0 +1,333 @@
+/*  Copyright (C) 2014-2016 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "core/copy_pipeline.h"
+
+#include <condition_variable>  // for condition_variable
+#include <deque>               // for deque
+#include <thread>              // for thread
+
+#include <common/sprintf.h>  // for MemSPrintf
+#include <common/time.h>     // for current_mstime
+
+#include "core/global.h"  // for ConvertToString
+
+#define COPY_DEFAULT_PATTERN "*"
+#define COPY_DEFAULT_BATCH_SIZE 500
+#define COPY_DEFAULT_QUEUE_SIZE 4
+#define COPY_CONVERTED_VALUES_DELIMITER " "
+
+namespace fastonosql {
+namespace core {
+
+class CopyPipeline::BatchQueue {
+ public:
+  explicit BatchQueue(size_t capacity)
+      : capacity_(capacity), mutex_(), cond_(), batches_(), finished_(false), canceled_(false) {}
+
+  // blocks while queue is full, false if canceled
+  bool Push(NDbKValues* batch) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (batches_.size() >= capacity_ && !canceled_) {
+      cond_.wait(lock);
+    }
+
+    if (canceled_) {
+      return false;
+    }
+
+    batches_.push_back(NDbKValues());
+    batches_.back().swap(*batch);
+    cond_.notify_all();
+    return true;
+  }
+
+  // false if canceled or finished and drained
+  bool Pop(NDbKValues* batch) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (batches_.empty() && !finished_ && !canceled_) {
+      cond_.wait(lock);
+    }
+
+    if (canceled_ || batches_.empty()) {
+      return false;
+    }
+
+    batch->swap(batches_.front());
+    batches_.pop_front();
+    cond_.notify_all();
+    return true;
+  }
+
+  void Finish() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    finished_ = true;
+    cond_.notify_all();
+  }
+
+  void Cancel() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    canceled_ = true;
+    batches_.clear();
+    cond_.notify_all();
+  }
+
+ private:
+  const size_t capacity_;
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  std::deque<NDbKValues> batches_;
+  bool finished_;
+  bool canceled_;
+};
+
+CopyOptions::CopyOptions()
+    : pattern(COPY_DEFAULT_PATTERN),
+      batch_size(COPY_DEFAULT_BATCH_SIZE),
+      queue_size(COPY_DEFAULT_QUEUE_SIZE),
+      with_ttl(false) {}
+
+CopyStats::CopyStats()
+    : scanned(0),
+      copied(0),
+      skipped(0),
+      converted(0),
+      dropped_ttls(0),
+      errors(0),
+      elapsed_msec(0),
+      error_keys() {}
+
+double CopyStats::KeysPerSecond() const {
+  if (elapsed_msec <= 0) {
+    return 0;
+  }
+
+  return static_cast<double>(copied) * 1000 / elapsed_msec;
+}
+
+ICopySource::~ICopySource() {}
+
+common::Error ICopySource::GetTTL(const NKey& key, ttl_t* ttl) {
+  UNUSED(key);
+  if (!ttl) {
+    DNOTREACHED();
+    return common::make_error_value("Invalid input argument(s)", common::ErrorValue::E_ERROR);
+  }
+
+  *ttl = NO_TTL;
+  return common::Error();
+}
+
+ICopyTarget::~ICopyTarget() {}
+
+bool ICopyTarget::IsSupportedTTL() const {
+  return false;
+}
+
+CopyPipeline::CopyPipeline(ICopySource* source, ICopyTarget* target, const CopyOptions& options)
+    : source_(source), target_(target), options_(options), mutex_(), stats_(), fatal_error_() {}
+
+common::Error CopyPipeline::Run(interrupt_callback_t is_interrupted,
+                                progress_callback_t progress_cb,
+                                CopyStats* stats) {
+  if (!source_ || !target_ || !stats || options_.batch_size == 0 || options_.queue_size == 0) {
+    DNOTREACHED();
+    return common::make_error_value("Invalid input argument(s)", common::ErrorValue::E_ERROR);
+  }
+
+  stats_ = CopyStats();
+  fatal_error_ = common::Error();
+  const common::time64_t start_ts = common::time::current_mstime();
+
+  BatchQueue read_queue(options_.queue_size);
+  BatchQueue write_queue(options_.queue_size);
+  std::thread reader(&CopyPipeline::ReadRoutine, this, is_interrupted, &read_queue);
+  std::thread transformer(&CopyPipeline::TransformRoutine, this, &read_queue, &write_queue);
+
+  bool interrupted = false;
+  NDbKValues batch;
+  while (write_queue.Pop(&batch)) {
+    if (is_interrupted && is_interrupted()) {
+      interrupted = true;
+      break;
+    }
+
+    NDbKValues added_keys;
+    common::Error err = target_->SetBatch(batch, &added_keys);
+    if (err && err->IsError()) {
+      SetFatalError(err);
+      break;
+    }
+
+    CopyStats snapshot;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      stats_.copied += added_keys.size();
+      stats_.elapsed_msec = common::time::current_mstime() - start_ts;
+      snapshot = stats_;
+    }
+
+    if (progress_cb) {
+      progress_cb(snapshot);
+    }
+  }
+
+  // unblocks reader and transformer if writer stopped first
+  read_queue.Cancel();
+  write_queue.Cancel();
+  reader.join();
+  transformer.join();
+
+  stats_.elapsed_msec = common::time::current_mstime() - start_ts;
+  *stats = stats_;
+  if (fatal_error_ && fatal_error_->IsError()) {
+    return fatal_error_;
+  }
+
+  if (interrupted || (is_interrupted && is_interrupted())) {
+    return common::make_error_value("Interrupted.", common::ErrorValue::E_INTERRUPTED);
+  }
+
+  return common::Error();
+}
+
+void CopyPipeline::ReadRoutine(interrupt_callback_t is_interrupted, BatchQueue* out) {
+  uint64_t cursor = 0;
+  do {
+    if (is_interrupted && is_interrupted()) {
+      break;
+    }
+
+    std::vector<std::string> keys;
+    common::Error err =
+        source_->Scan(cursor, options_.pattern, options_.batch_size, &keys, &cursor);
+    if (err && err->IsError()) {
+      SetFatalError(err);
+      out->Cancel();
+      return;
+    }
+
+    NDbKValues batch;
+    batch.reserve(keys.size());
+    uint64_t skipped = 0;
+    for (size_t i = 0; i < keys.size(); ++i) {
+      NDbKValue loaded_key;
+      err = source_->Get(NKey(keys[i]), &loaded_key);
+      if (IsKeyNotFoundError(err, keys[i])) {
+        skipped++;
+        continue;
+      }
+
+      if (err && err->IsError()) {
+        AddKeyError(keys[i], err);
+        continue;
+      }
+
+      if (options_.with_ttl) {
+        ttl_t ttl = NO_TTL;
+        err = source_->GetTTL(loaded_key.Key(), &ttl);
+        if (err && err->IsError() && !IsKeyNotFoundError(err, keys[i])) {
+          AddKeyError(keys[i], err);
+          continue;
+        }
+
+        // expired or removed after its value was read
+        if ((err && err->IsError()) || ttl == EXPIRED_TTL) {
+          skipped++;
+          continue;
+        }
+        loaded_key.SetKey(NKey(keys[i], ttl));
+      }
+
+      batch.push_back(loaded_key);
+    }
+
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      stats_.scanned += keys.size();
+      stats_.skipped += skipped;
+    }
+
+    if (!batch.empty() && !out->Push(&batch)) {
+      return;
+    }
+  } while (cursor != 0);
+
+  out->Finish();
+}
+
+void CopyPipeline::TransformRoutine(BatchQueue* in, BatchQueue* out) {
+  NDbKValues batch;
+  while (in->Pop(&batch)) {
+    NDbKValues transformed;
+    transformed.reserve(batch.size());
+    uint64_t skipped = 0;
+    uint64_t converted = 0;
+    uint64_t dropped_ttls = 0;
+    const bool with_ttl = target_->IsSupportedTTL();
+    for (size_t i = 0; i < batch.size(); ++i) {
+      NValue value = batch[i].Value();
+      if (!value || value->GetType() == common::Value::TYPE_NULL) {
+        skipped++;
+        continue;
+      }
+
+      if (!target_->IsSupportedType(value->GetType())) {
+        std::string str = common::ConvertToString(value.get(), COPY_CONVERTED_VALUES_DELIMITER);
+        batch[i].SetValue(NValue(common::Value::CreateStringValue(str)));
+        converted++;
+      }
+      if (!with_ttl && batch[i].Key().TTL() > 0) {
+        batch[i].SetKey(NKey(batch[i].KeyString(), NO_TTL));
+        dropped_ttls++;
+      }
+      transformed.push_back(batch[i]);
+    }
+
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      stats_.skipped += skipped;
+      stats_.converted += converted;
+      stats_.dropped_ttls += dropped_ttls;
+    }
+
+    if (!transformed.empty() && !out->Push(&transformed)) {
+      return;
+    }
+  }
+
+  out->Finish();
+}
+
+void CopyPipeline::AddKeyError(const std::string& key, common::Error err) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  stats_.errors++;
+  if (stats_.error_keys.size() < COPY_MAX_REPORTED_ERRORS) {
+    stats_.error_keys.push_back(common::MemSPrintf("%s: %s", key, err->Description()));
+  }
+}
+
+void CopyPipeline::SetFatalError(common::Error err) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (!fatal_error_) {
+    fatal_error_ = err;
+  }
+}
+
+}  // namespace core
+}  // namespace fastonosql
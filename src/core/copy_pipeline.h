@@ -0,0 +1,207 @@
+/*  Copyright (C) 2014-2016 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <stddef.h>  // for size_t
+#include <stdint.h>  // for uint64_t
+
+#include <functional>  // for function
+#include <mutex>       // for mutex
+#include <string>      // for string
+#include <vector>      // for vector
+
+#include <common/error.h>   // for Error
+#include <common/macros.h>  // for WARN_UNUSED_RESULT
+#include <common/types.h>   // for time64_t
+#include <common/value.h>   // for Value::Type
+
+#include "core/connection_types.h"  // for IsSupportTTLKeys, IsSupportContainerValues
+#include "core/db_key.h"            // for NDbKValues, NKey
+
+#include "core/internal/cdb_connection_client.h"  // for CDBConnectionClient
+
+#define COPY_MAX_REPORTED_ERRORS 100
+
+namespace fastonosql {
+namespace core {
+
+struct CopyOptions {
+  CopyOptions();
+
+  std::string pattern;
+  size_t batch_size;  // keys per SCAN page and per target write batch
+  size_t queue_size;  // batches buffered between two stages
+  bool with_ttl;      // ttl of every key is read by one more request
+};
+
+struct CopyStats {
+  CopyStats();
+
+  double KeysPerSecond() const;
+
+  uint64_t scanned;
+  uint64_t copied;
+  uint64_t skipped;       // removed while copying
+  uint64_t converted;     // values stored as string because target hasn't their type
+  uint64_t dropped_ttls;  // keys stored without ttl because target can't expire them
+  uint64_t errors;
+  common::time64_t elapsed_msec;
+  std::vector<std::string> error_keys;  // first COPY_MAX_REPORTED_ERRORS errors
+};
+
+class ICopySource {
+ public:
+  virtual ~ICopySource();
+
+  virtual common::Error Scan(uint64_t cursor_in,
+                             const std::string& pattern,
+                             uint64_t count_keys,
+                             std::vector<std::string>* keys_out,
+                             uint64_t* cursor_out) WARN_UNUSED_RESULT = 0;
+  virtual common::Error Get(const NKey& key, NDbKValue* loaded_key) WARN_UNUSED_RESULT = 0;
+  virtual common::Error DBkcount(size_t* size) WARN_UNUSED_RESULT = 0;
+  // sources without expiration return NO_TTL
+  virtual common::Error GetTTL(const NKey& key, ttl_t* ttl) WARN_UNUSED_RESULT;
+};
+
+class ICopyTarget {
+ public:
+  virtual ~ICopyTarget();
+
+  virtual bool IsSupportedType(common::Value::Type type) const = 0;
+  // ttl of keys is written with their values by SetBatch, targets without it get NO_TTL
+  virtual bool IsSupportedTTL() const;
+  virtual common::Error SetBatch(const NDbKValues& keys,
+                                 NDbKValues* added_keys) WARN_UNUSED_RESULT = 0;
+};
+
+// adapters of any CDBConnection
+// source is detached from its client while copying,
+// loaded keys shouldn't be reported one by one,
+// all keys are read from snapshot pinned while copying
+template <typename DBConnection>
+class CDBCopySource : public ICopySource {
+ public:
+  explicit CDBCopySource(DBConnection* db) : db_(db), client_(db->Client()) {
+    db_->SetClient(nullptr);
+    db_->PinSnapshot();
+  }
+  virtual ~CDBCopySource() {
+    db_->UnpinSnapshot();
+    db_->SetClient(client_);
+  }
+
+  virtual common::Error Scan(uint64_t cursor_in,
+                             const std::string& pattern,
+                             uint64_t count_keys,
+                             std::vector<std::string>* keys_out,
+                             uint64_t* cursor_out) override {
+    return db_->Scan(cursor_in, pattern, count_keys, keys_out, cursor_out);
+  }
+
+  virtual common::Error Get(const NKey& key, NDbKValue* loaded_key) override {
+    return db_->GetFromSnapshot(key, loaded_key);
+  }
+
+  virtual common::Error DBkcount(size_t* size) override { return db_->DBkcount(size); }
+
+  virtual common::Error GetTTL(const NKey& key, ttl_t* ttl) override {
+    if (!IsSupportTTLKeys(DBConnection::connection_t)) {
+      return ICopySource::GetTTL(key, ttl);
+    }
+    return db_->GetTTL(key, ttl);
+  }
+
+ private:
+  DBConnection* const db_;
+  CDBConnectionClient* const client_;
+};
+
+template <typename DBConnection>
+class CDBCopyTarget : public ICopyTarget {
+ public:
+  CDBCopyTarget(DBConnection* db, bool owns_db) : db_(db), owns_db_(owns_db) {
+    db_->BeginBulkLoad();
+  }
+  virtual ~CDBCopyTarget() {
+    db_->EndBulkLoad();
+    if (owns_db_) {
+      common::Error err = db_->Disconnect();
+      UNUSED(err);
+      delete db_;
+    }
+  }
+
+  // every engine stores strings, some of them containers too
+  virtual bool IsSupportedType(common::Value::Type type) const override {
+    if (type == common::Value::TYPE_STRING) {
+      return true;
+    }
+
+    return IsSupportContainerValues(DBConnection::connection_t) &&
+           (type == common::Value::TYPE_ARRAY || type == common::Value::TYPE_SET ||
+            type == common::Value::TYPE_ZSET || type == common::Value::TYPE_HASH);
+  }
+
+  virtual bool IsSupportedTTL() const override {
+    return IsSupportTTLKeys(DBConnection::connection_t);
+  }
+
+  virtual common::Error SetBatch(const NDbKValues& keys, NDbKValues* added_keys) override {
+    return db_->SetBatch(keys, added_keys);
+  }
+
+ private:
+  DBConnection* const db_;
+  const bool owns_db_;
+};
+
+// reader (SCAN + GET), transform and writer stages work in own threads
+// and are connected by bounded queues, so memory usage is limited by
+// 2 * queue_size * batch_size values for any pair of engines
+class CopyPipeline {
+ public:
+  typedef std::function<void(const CopyStats&)> progress_callback_t;
+  typedef std::function<bool()> interrupt_callback_t;
+
+  CopyPipeline(ICopySource* source, ICopyTarget* target, const CopyOptions& options);
+
+  common::Error Run(interrupt_callback_t is_interrupted,
+                    progress_callback_t progress_cb,
+                    CopyStats* stats) WARN_UNUSED_RESULT;
+
+ private:
+  class BatchQueue;
+
+  void ReadRoutine(interrupt_callback_t is_interrupted, BatchQueue* out);
+  void TransformRoutine(BatchQueue* in, BatchQueue* out);
+  void AddKeyError(const std::string& key, common::Error err);
+  void SetFatalError(common::Error err);
+
+  ICopySource* const source_;
+  ICopyTarget* const target_;
+  const CopyOptions options_;
+
+  std::mutex mutex_;
+  CopyStats stats_;
+  common::Error fatal_error_;
+};
+
+}  // namespace core
+}  // namespace fastonosql
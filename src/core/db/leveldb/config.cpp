@@ -56,6 +56,8 @@ Config parseOptions(int argc, char** argv) {
       cfg.dbname = argv[++i];
     } else if (!strcmp(argv[i], "-c")) {
       cfg.create_if_missing = true;
+    } else if (!strcmp(argv[i], "-scan-snapshots")) {
+      cfg.scan_snapshots = true;
     } else {
       if (argv[i][0] == '-') {
         std::string buff = common::MemSPrintf(
@@ -76,7 +78,9 @@ Config parseOptions(int argc, char** argv) {
 }  // namespace
 
 Config::Config()
-    : LocalConfig(common::file_system::prepare_path("~/test.leveldb")), create_if_missing(false) {}
+    : LocalConfig(common::file_system::prepare_path("~/test.leveldb")),
+      create_if_missing(false),
+      scan_snapshots(false) {}
 
 }  // namespace leveldb
 }  // namespace core
@@ -90,6 +94,9 @@ std::string ConvertToString(const fastonosql::core::leveldb::Config& conf) {
   if (conf.create_if_missing) {
     argv.push_back("-c");
   }
+  if (conf.scan_snapshots) {
+    argv.push_back("-scan-snapshots");
+  }
 
   return fastonosql::core::ConvertToStringConfigArgs(argv);
 }
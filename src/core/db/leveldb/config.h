@@ -30,6 +30,7 @@ struct Config : public LocalConfig {
   Config();
 
   bool create_if_missing;
+  bool scan_snapshots;  // pages of one SCAN are read from same snapshot
 };
 
 }  // namespace leveldb
@@ -18,9 +18,14 @@
 
 #include "core/db/leveldb/db_connection.h"
 
+#include <algorithm>  // for sort
+#include <vector>     // for vector
+
 #include <leveldb/c.h>  // for leveldb_major_version, etc
 #include <leveldb/db.h>
-#include <leveldb/options.h>  // for ReadOptions, WriteOptions
+#include <leveldb/env.h>          // for Env
+#include <leveldb/options.h>      // for ReadOptions, WriteOptions
+#include <leveldb/write_batch.h>  // for WriteBatch
 
 #include <common/sprintf.h>
 #include <common/convert2string.h>  // for ConvertFromString
@@ -30,13 +35,17 @@
 #include "core/db/leveldb/database_info.h"
 #include "core/db/leveldb/internal/commands_api.h"
 
-#include "core/global.h"  // for FastoObject, etc
+#include "core/global.h"            // for FastoObject, etc
+#include "core/partitioned_scan.h"  // for CountKeysPartitioned, CDBPartitionedSource
 
 #define LEVELDB_HEADER_STATS                             \
   "                               Compactions\n"         \
   "Level  Files Size(MB) Time(sec) Read(MB) Write(MB)\n" \
   "--------------------------------------------------\n"
 
+#define LEVELDB_BACKUP_BATCH_SIZE (4 * 1024 * 1024)
+#define LEVELDB_KEYSPACE_END "\xff\xff\xff\xff"
+
 namespace fastonosql {
 namespace core {
 namespace internal {
@@ -128,8 +137,90 @@ common::Error TestConnection(const Config& config) {
   return common::Error();
 }
 
+common::Error RestoreBackup(const Config& config,
+                            const std::string& path,
+                            backup_progress_callback_t progress_cb,
+                            BackupStats* stats) {
+  if (!stats) {
+    DNOTREACHED();
+    return common::make_error_value("Invalid input argument(s)", common::ErrorValue::E_ERROR);
+  }
+
+  ::leveldb::Env* env = ::leveldb::Env::Default();
+  if (!env->FileExists(path + "/CURRENT")) {
+    return common::make_error_value(common::MemSPrintf("Invalid backup path(%s)", path),
+                                    common::ErrorValue::E_ERROR);
+  }
+
+  auto remove_db = [](const std::string& db_path) {
+    auto st = ::leveldb::DestroyDB(db_path, ::leveldb::Options());
+    UNUSED(st);
+  };
+
+  BackupProgress progress(progress_cb, stats);
+  const std::string restored = RestoreTempPath(config.dbname);
+  remove_db(restored);
+  common::Error err = CopyDBFiles(env, path, restored, &progress);
+  if (err && err->IsError()) {
+    remove_db(restored);
+    return err;
+  }
+
+  err = SwapRestored(restored, config.dbname, remove_db);
+  if (err && err->IsError()) {
+    remove_db(restored);
+    return err;
+  }
+
+  progress.Finish();
+  return common::Error();
+}
+
 DBConnection::DBConnection(CDBConnectionClient* client)
-    : base_class(client, new CommandTranslator(base_class::Commands())) {}
+    : base_class(client, new CommandTranslator(base_class::Commands())),
+      pinned_snapshot_(nullptr),
+      pinned_count_(0),
+      paging_snapshots_() {}
+
+DBConnection::~DBConnection() {
+  ReleaseSnapshots();
+}
+
+void DBConnection::OnDisconnect() {
+  ReleaseSnapshots();
+}
+
+::leveldb::ReadOptions DBConnection::PointReadOptions() const {
+  // interactive reads see current state even while long operation pins snapshot
+  return ::leveldb::ReadOptions();
+}
+
+::leveldb::ReadOptions DBConnection::SnapshotReadOptions() const {
+  ::leveldb::ReadOptions ro;
+  ro.snapshot = pinned_snapshot_;
+  return ro;
+}
+
+::leveldb::ReadOptions DBConnection::IteratorReadOptions() const {
+  ::leveldb::ReadOptions ro;
+  // full scans shouldn't evict hot blocks from block cache
+  ro.fill_cache = false;
+  ro.snapshot = pinned_snapshot_;
+  return ro;
+}
+
+void DBConnection::ReleaseSnapshots() {
+  if (!IsConnected()) {
+    return;
+  }
+
+  paging_snapshots_.Clear(connection_.handle_);
+  if (pinned_snapshot_) {
+    connection_.handle_->ReleaseSnapshot(pinned_snapshot_);
+    pinned_snapshot_ = nullptr;
+  }
+  pinned_count_ = 0;
+}
 
 common::Error DBConnection::Info(const char* args, ServerInfo::Stats* statsout) {
   UNUSED(args);
@@ -202,6 +293,113 @@ common::Error DBConnection::Info(const char* args, ServerInfo::Stats* statsout)
   return common::Error();
 }
 
+common::Error DBConnection::Backup(const std::string& path,
+                                   backup_progress_callback_t progress_cb,
+                                   BackupStats* stats) {
+  if (!stats) {
+    DNOTREACHED();
+    return common::make_error_value("Invalid input argument(s)", common::ErrorValue::E_ERROR);
+  }
+
+  if (!IsConnected()) {
+    return common::make_error_value("Not connected", common::Value::E_ERROR);
+  }
+
+  ::leveldb::Options options;
+  options.create_if_missing = true;
+  options.error_if_exists = true;
+  ::leveldb::DB* backup = nullptr;
+  auto st = ::leveldb::DB::Open(options, path, &backup);
+  if (!st.ok()) {
+    std::string buff = common::MemSPrintf("BACKUP function error: %s", st.ToString());
+    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+  }
+
+  // size on disk of compressed blocks, so percents are rough
+  const std::string all_end(LEVELDB_KEYSPACE_END);
+  ::leveldb::Range all(::leveldb::Slice(), all_end);
+  uint64_t total = 0;
+  connection_.handle_->GetApproximateSizes(&all, 1, &total);
+  stats->total_bytes = total;
+
+  BackupProgress progress(progress_cb, stats);
+  const ::leveldb::Snapshot* snapshot = connection_.handle_->GetSnapshot();
+  ::leveldb::ReadOptions ro = IteratorReadOptions();
+  ro.snapshot = snapshot;
+  ::leveldb::Iterator* it = connection_.handle_->NewIterator(ro);
+  ::leveldb::WriteBatch batch;
+  size_t batch_bytes = 0;
+  for (it->SeekToFirst(); st.ok() && it->Valid(); it->Next()) {
+    if (IsInterrupted()) {
+      st = ::leveldb::Status::IOError("Interrupted");
+      break;
+    }
+
+    batch.Put(it->key(), it->value());
+    size_t bytes = it->key().size() + it->value().size();
+    batch_bytes += bytes;
+    progress.Add(bytes, 1);
+    if (batch_bytes >= LEVELDB_BACKUP_BATCH_SIZE) {
+      st = backup->Write(::leveldb::WriteOptions(), &batch);
+      batch.Clear();
+      batch_bytes = 0;
+    }
+  }
+
+  if (st.ok()) {
+    st = it->status();
+  }
+  if (st.ok() && batch_bytes) {
+    st = backup->Write(::leveldb::WriteOptions(), &batch);
+  }
+  delete it;
+  connection_.handle_->ReleaseSnapshot(snapshot);
+  delete backup;
+
+  if (!st.ok()) {
+    std::string buff = common::MemSPrintf("BACKUP function error: %s", st.ToString());
+    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+  }
+
+  progress.Finish();
+  return common::Error();
+}
+
+common::Error DBConnection::EstimateSizes(const namespace_ranges_t& ranges,
+                                          namespace_sizes_t* sizes) {
+  if (!sizes) {
+    DNOTREACHED();
+    return common::make_error_value("Invalid input argument(s)", common::ErrorValue::E_ERROR);
+  }
+
+  if (!IsConnected()) {
+    return common::make_error_value("Not connected", common::Value::E_ERROR);
+  }
+
+  const std::string keyspace_end(LEVELDB_KEYSPACE_END);
+  std::vector< ::leveldb::Range> lranges;
+  for (size_t i = 0; i < ranges.size(); ++i) {
+    const std::string& limit = ranges[i].limit.empty() ? keyspace_end : ranges[i].limit;
+    lranges.push_back(::leveldb::Range(ranges[i].start, limit));
+  }
+
+  std::vector<uint64_t> lsizes(ranges.size(), 0);
+  if (!lranges.empty()) {
+    connection_.handle_->GetApproximateSizes(lranges.data(), static_cast<int>(lranges.size()),
+                                             lsizes.data());
+  }
+
+  namespace_sizes_t result;
+  for (size_t i = 0; i < ranges.size(); ++i) {
+    NamespaceSize size(ranges[i].ns);
+    size.disk_bytes = lsizes[i];
+    result.push_back(size);
+  }
+
+  *sizes = result;
+  return common::Error();
+}
+
 common::Error DBConnection::DelInner(const std::string& key) {
   if (!IsConnected()) {
     return common::make_error_value("Not connected", common::Value::E_ERROR);
@@ -257,7 +455,15 @@ common::Error DBConnection::ScanImpl(uint64_t cursor_in,
                                      uint64_t count_keys,
                                      std::vector<std::string>* keys_out,
                                      uint64_t* cursor_out) {
-  ::leveldb::ReadOptions ro;
+  ::leveldb::ReadOptions ro = IteratorReadOptions();
+  // offsets of cursors are stable while all pages are read from one snapshot,
+  // forgotten scan continues on current keyspace
+  const ::leveldb::Snapshot* paging_snapshot = nullptr;
+  if (!pinned_snapshot_ && connection_.config_.scan_snapshots) {
+    paging_snapshot = paging_snapshots_.Take(connection_.handle_, cursor_in, pattern);
+    ro.snapshot = paging_snapshot;
+  }
+
   ::leveldb::Iterator* it = connection_.handle_->NewIterator(ro);
   uint64_t offset_pos = cursor_in;
   uint64_t lcursor_out = 0;
@@ -282,10 +488,12 @@ common::Error DBConnection::ScanImpl(uint64_t cursor_in,
   delete it;
 
   if (!st.ok()) {
+    paging_snapshots_.Put(connection_.handle_, 0, pattern, paging_snapshot);
     std::string buff = common::MemSPrintf("SCAN function error: %s", st.ToString());
     return common::make_error_value(buff, common::ErrorValue::E_ERROR);
   }
 
+  paging_snapshots_.Put(connection_.handle_, lcursor_out, pattern, paging_snapshot);
   *keys_out = lkeys_out;
   *cursor_out = lcursor_out;
   return common::Error();
@@ -295,7 +503,7 @@ common::Error DBConnection::KeysImpl(const std::string& key_start,
                                      const std::string& key_end,
                                      uint64_t limit,
                                      std::vector<std::string>* ret) {
-  ::leveldb::ReadOptions ro;
+  ::leveldb::ReadOptions ro = IteratorReadOptions();
   ::leveldb::Iterator* it =
       connection_.handle_->NewIterator(ro);  // keys(key_start, key_end, limit, ret);
   for (it->Seek(key_start); it->Valid(); it->Next()) {
@@ -320,18 +528,14 @@ common::Error DBConnection::KeysImpl(const std::string& key_start,
 }
 
 common::Error DBConnection::DBkcountImpl(size_t* size) {
-  ::leveldb::ReadOptions ro;
-  ::leveldb::Iterator* it = connection_.handle_->NewIterator(ro);
+  // leveldb hasn't key counter, ranges of keyspace are counted in parallel
+  CDBPartitionedSource<DBConnection> source(this, false);
   size_t sz = 0;
-  for (it->SeekToFirst(); it->Valid(); it->Next()) {
-    sz++;
-  }
-
-  auto st = it->status();
-  delete it;
-
-  if (!st.ok()) {
-    std::string buff = common::MemSPrintf("Couldn't determine DBKCOUNT error: %s", st.ToString());
+  common::Error err = CountKeysPartitioned(&source, PartitionedScanOptions(),
+                                           [this]() { return IsInterrupted(); }, &sz);
+  if (err && err->IsError()) {
+    std::string buff =
+        common::MemSPrintf("Couldn't determine DBKCOUNT error: %s", err->Description());
     return common::make_error_value(buff, common::ErrorValue::E_ERROR);
   }
 
@@ -340,7 +544,7 @@ common::Error DBConnection::DBkcountImpl(size_t* size) {
 }
 
 common::Error DBConnection::FlushDBImpl() {
-  ::leveldb::ReadOptions ro;
+  ::leveldb::ReadOptions ro = IteratorReadOptions();
   ::leveldb::WriteOptions wo;
   ::leveldb::Iterator* it = connection_.handle_->NewIterator(ro);
   for (it->SeekToFirst(); it->Valid(); it->Next()) {
@@ -376,17 +580,57 @@ common::Error DBConnection::SelectImpl(const std::string& name, IDataBaseInfo**
 }
 
 common::Error DBConnection::DeleteImpl(const NKeys& keys, NKeys* deleted_keys) {
+  // only existing keys are reported, all of them removed by one write batch,
+  // existence is checked on live data by keys of one sorted iterator, values aren't copied
+  std::vector<size_t> order(keys.size());
+  for (size_t i = 0; i < order.size(); ++i) {
+    order[i] = i;
+  }
+  std::sort(order.begin(), order.end(),
+            [&keys](size_t lhs, size_t rhs) { return keys[lhs].Key() < keys[rhs].Key(); });
+
+  std::vector<bool> found(keys.size(), false);
+  ::leveldb::ReadOptions ro;
+  ro.fill_cache = false;
+  ::leveldb::Iterator* it = connection_.handle_->NewIterator(ro);
+  for (size_t i = 0; i < order.size(); ++i) {
+    const std::string key = keys[order[i]].Key();
+    if (!it->Valid() || it->key().compare(key) < 0) {
+      it->Seek(key);
+    }
+
+    found[order[i]] = it->Valid() && it->key() == key;
+  }
+
+  auto ist = it->status();
+  delete it;
+
+  if (!ist.ok()) {
+    std::string buff = common::MemSPrintf("delete function error: %s", ist.ToString());
+    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+  }
+
+  ::leveldb::WriteBatch batch;
+  NKeys existing_keys;
   for (size_t i = 0; i < keys.size(); ++i) {
-    NKey key = keys[i];
-    std::string key_str = key.Key();
-    common::Error err = DelInner(key_str);
-    if (err && err->IsError()) {
-      continue;
+    if (found[i]) {
+      batch.Delete(keys[i].Key());
+      existing_keys.push_back(keys[i]);
     }
+  }
 
-    deleted_keys->push_back(key);
+  if (existing_keys.empty()) {
+    return common::Error();
   }
 
+  ::leveldb::WriteOptions wo;
+  auto st = connection_.handle_->Write(wo, &batch);
+  if (!st.ok()) {
+    std::string buff = common::MemSPrintf("write batch error: %s", st.ToString());
+    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+  }
+
+  deleted_keys->insert(deleted_keys->end(), existing_keys.begin(), existing_keys.end());
   return common::Error();
 }
 
@@ -402,12 +646,44 @@ common::Error DBConnection::SetImpl(const NDbKValue& key, NDbKValue* added_key)
   return common::Error();
 }
 
+common::Error DBConnection::SetBatchImpl(const NDbKValues& keys, NDbKValues* added_keys) {
+  ::leveldb::WriteBatch batch;
+  for (size_t i = 0; i < keys.size(); ++i) {
+    batch.Put(keys[i].KeyString(), keys[i].ValueString());
+  }
+
+  ::leveldb::WriteOptions wo;
+  auto st = connection_.handle_->Write(wo, &batch);
+  if (!st.ok()) {
+    std::string buff = common::MemSPrintf("write batch error: %s", st.ToString());
+    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+  }
+
+  added_keys->insert(added_keys->end(), keys.begin(), keys.end());
+  return common::Error();
+}
+
 common::Error DBConnection::GetImpl(const NKey& key, NDbKValue* loaded_key) {
+  return GetWithOptions(PointReadOptions(), key, loaded_key);
+}
+
+common::Error DBConnection::GetFromSnapshotImpl(const NKey& key, NDbKValue* loaded_key) {
+  return GetWithOptions(SnapshotReadOptions(), key, loaded_key);
+}
+
+common::Error DBConnection::GetWithOptions(const ::leveldb::ReadOptions& ro,
+                                           const NKey& key,
+                                           NDbKValue* loaded_key) {
   std::string key_str = key.Key();
   std::string value_str;
-  common::Error err = GetInner(key_str, &value_str);
-  if (err && err->IsError()) {
-    return err;
+  auto st = connection_.handle_->Get(ro, key_str, &value_str);
+  if (st.IsNotFound()) {
+    return MakeKeyNotFoundError(key_str);
+  }
+
+  if (!st.ok()) {
+    std::string buff = common::MemSPrintf("get function error: %s", st.ToString());
+    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
   }
 
   NValue val(common::Value::CreateStringValue(value_str));
@@ -415,6 +691,50 @@ common::Error DBConnection::GetImpl(const NKey& key, NDbKValue* loaded_key) {
   return common::Error();
 }
 
+common::Error DBConnection::GetBatchImpl(const NKeys& keys, NDbKValues* loaded_keys) {
+  // leveldb hasn't multi get, so keys are looked up in sorted order
+  // by one iterator, neighbour keys are found in already loaded blocks
+  std::vector<size_t> order(keys.size());
+  for (size_t i = 0; i < order.size(); ++i) {
+    order[i] = i;
+  }
+  std::sort(order.begin(), order.end(),
+            [&keys](size_t lhs, size_t rhs) { return keys[lhs].Key() < keys[rhs].Key(); });
+
+  std::vector<bool> found(keys.size(), false);
+  std::vector<std::string> values(keys.size());
+  ::leveldb::ReadOptions ro = PointReadOptions();
+  ::leveldb::Iterator* it = connection_.handle_->NewIterator(ro);
+  for (size_t i = 0; i < order.size(); ++i) {
+    const std::string key = keys[order[i]].Key();
+    if (!it->Valid() || it->key().compare(key) < 0) {
+      it->Seek(key);
+    }
+
+    if (it->Valid() && it->key() == key) {
+      found[order[i]] = true;
+      values[order[i]] = it->value().ToString();
+    }
+  }
+
+  auto st = it->status();
+  delete it;
+
+  if (!st.ok()) {
+    std::string buff = common::MemSPrintf("get function error: %s", st.ToString());
+    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+  }
+
+  for (size_t i = 0; i < keys.size(); ++i) {
+    if (found[i]) {
+      NValue val(common::Value::CreateStringValue(values[i]));
+      loaded_keys->push_back(NDbKValue(keys[i], val));
+    }
+  }
+
+  return common::Error();
+}
+
 common::Error DBConnection::RenameImpl(const NKey& key, const std::string& new_key) {
   std::string key_str = key.Key();
   std::string value_str;
@@ -461,6 +781,89 @@ common::Error DBConnection::QuitImpl() {
   return common::Error();
 }
 
+void DBConnection::PinSnapshotImpl() {
+  if (pinned_count_++ == 0) {
+    pinned_snapshot_ = connection_.handle_->GetSnapshot();
+  }
+}
+
+void DBConnection::UnpinSnapshotImpl() {
+  if (pinned_count_ == 0) {
+    return;
+  }
+
+  if (--pinned_count_ == 0) {
+    connection_.handle_->ReleaseSnapshot(pinned_snapshot_);
+    pinned_snapshot_ = nullptr;
+  }
+}
+
+common::Error DBConnection::PartitionImpl(size_t count, key_ranges_t* ranges) {
+  // sizes of all pieces are estimated by one GetApproximateSizes call
+  const std::string keyspace_end(LEVELDB_KEYSPACE_END);
+  auto sizes_func = [this, &keyspace_end](const key_ranges_t& pieces,
+                                          std::vector<uint64_t>* sizes) {
+    std::vector< ::leveldb::Range> lranges;
+    for (size_t i = 0; i < pieces.size(); ++i) {
+      const std::string& limit = pieces[i].limit.empty() ? keyspace_end : pieces[i].limit;
+      lranges.push_back(::leveldb::Range(pieces[i].start, limit));
+    }
+
+    std::vector<uint64_t> lsizes(pieces.size(), 0);
+    connection_.handle_->GetApproximateSizes(lranges.data(), static_cast<int>(lranges.size()),
+                                             lsizes.data());
+    *sizes = lsizes;
+    return true;
+  };
+
+  *ranges = internal::SplitBySizes(sizes_func, count);
+  return common::Error();
+}
+
+common::Error DBConnection::ScanRangeImpl(const KeyRange& range,
+                                          const std::string& pattern,
+                                          size_t batch_size,
+                                          bool with_values,
+                                          range_batch_callback_t batch_cb) {
+  ::leveldb::ReadOptions ro = IteratorReadOptions();
+  ::leveldb::Iterator* it = connection_.handle_->NewIterator(ro);
+  NDbKValues batch;
+  bool stopped = false;
+  for (it->Seek(range.start); it->Valid() && !stopped; it->Next()) {
+    std::string key = it->key().ToString();
+    if (!range.limit.empty() && key >= range.limit) {
+      break;
+    }
+
+    if (!common::MatchPattern(key, pattern)) {
+      continue;
+    }
+
+    NValue val;
+    if (with_values) {
+      val = NValue(common::Value::CreateStringValue(it->value().ToString()));
+    }
+    batch.push_back(NDbKValue(NKey(key), val));
+    if (batch.size() >= batch_size) {
+      stopped = !batch_cb(batch);
+      batch.clear();
+    }
+  }
+
+  auto st = it->status();
+  delete it;
+
+  if (!st.ok()) {
+    std::string buff = common::MemSPrintf("SCAN function error: %s", st.ToString());
+    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+  }
+
+  if (!stopped && !batch.empty()) {
+    batch_cb(batch);
+  }
+  return common::Error();
+}
+
 }  // namespace leveldb
 }  // namespace core
 }  // namespace fastonosql
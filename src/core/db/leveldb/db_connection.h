@@ -18,16 +18,20 @@
 
 #pragma once
 
+#include <stddef.h>  // for size_t
 #include <stdint.h>  // for uint64_t
 #include <string>    // for string
 
 #include <common/error.h>   // for Error
 #include <common/macros.h>  // for WARN_UNUSED_RESULT
 
+#include "core/backup.h"                   // for BackupStats, backup_progress_callback_t
 #include "core/command_info.h"             // for UNDEFINED_EXAMPLE_STR, UNDEFIN...
 #include "core/connection_types.h"         // for connectionTypes::LEVELDB
 #include "core/db_key.h"                   // for NDbKValue, NKey, NKeys
+#include "core/namespace_size.h"           // for namespace_ranges_t, namespace_sizes_t
 #include "core/internal/cdb_connection.h"  // for CDBConnection
+#include "core/internal/paging_snapshots.h"  // for PagingSnapshots
 
 #include "core/db/leveldb/config.h"
 #include "core/db/leveldb/server_info.h"
@@ -54,6 +58,8 @@ class IDataBaseInfo;
 }
 namespace leveldb {
 class DB;
+class Snapshot;
+struct ReadOptions;
 }  // lines 30-30
 
 namespace fastonosql {
@@ -64,16 +70,43 @@ typedef ::leveldb::DB NativeConnection;
 
 common::Error CreateConnection(const Config& config, NativeConnection** context);
 common::Error TestConnection(const Config& config);
+// replaces files of closed database by files of backup
+common::Error RestoreBackup(const Config& config,
+                            const std::string& path,
+                            backup_progress_callback_t progress_cb,
+                            BackupStats* stats) WARN_UNUSED_RESULT;
 
 class DBConnection : public core::internal::CDBConnection<NativeConnection, Config, LEVELDB> {
  public:
   typedef core::internal::CDBConnection<NativeConnection, Config, LEVELDB> base_class;
   explicit DBConnection(CDBConnectionClient* client);
+  virtual ~DBConnection();
 
   common::Error Info(const char* args, ServerInfo::Stats* statsout) WARN_UNUSED_RESULT;
 
+  // leveldb can't link its files, so snapshot is copied by iterator
+  // into new database at path, writes aren't blocked while copying
+  common::Error Backup(const std::string& path,
+                       backup_progress_callback_t progress_cb,
+                       BackupStats* stats) WARN_UNUSED_RESULT;
+
+  // sizes of compressed files of ranges by one GetApproximateSizes call,
+  // values aren't read, so it takes milliseconds for any database
+  common::Error EstimateSizes(const namespace_ranges_t& ranges,
+                              namespace_sizes_t* sizes) WARN_UNUSED_RESULT;
+
  private:
+  typedef core::internal::PagingSnapshots<NativeConnection, ::leveldb::Snapshot> paging_snapshots_t;
+
+  ::leveldb::ReadOptions PointReadOptions() const;
+  ::leveldb::ReadOptions SnapshotReadOptions() const;
+  ::leveldb::ReadOptions IteratorReadOptions() const;
+  void ReleaseSnapshots();
+
   common::Error DelInner(const std::string& key) WARN_UNUSED_RESULT;
+  common::Error GetWithOptions(const ::leveldb::ReadOptions& ro,
+                               const NKey& key,
+                               NDbKValue* loaded_key) WARN_UNUSED_RESULT;
   common::Error SetInner(const std::string& key, const std::string& value) WARN_UNUSED_RESULT;
   common::Error GetInner(const std::string& key, std::string* ret_val) WARN_UNUSED_RESULT;
 
@@ -91,11 +124,28 @@ class DBConnection : public core::internal::CDBConnection<NativeConnection, Conf
   virtual common::Error SelectImpl(const std::string& name, IDataBaseInfo** info) override;
   virtual common::Error DeleteImpl(const NKeys& keys, NKeys* deleted_keys) override;
   virtual common::Error SetImpl(const NDbKValue& key, NDbKValue* added_key) override;
+  virtual common::Error SetBatchImpl(const NDbKValues& keys, NDbKValues* added_keys) override;
   virtual common::Error GetImpl(const NKey& key, NDbKValue* loaded_key) override;
+  virtual common::Error GetBatchImpl(const NKeys& keys, NDbKValues* loaded_keys) override;
   virtual common::Error RenameImpl(const NKey& key, const std::string& new_key) override;
   virtual common::Error SetTTLImpl(const NKey& key, ttl_t ttl) override;
   virtual common::Error GetTTLImpl(const NKey& key, ttl_t* ttl) override;
   virtual common::Error QuitImpl() override;
+  // snapshots should be released before db is closed
+  virtual void OnDisconnect() override;
+  virtual void PinSnapshotImpl() override;
+  virtual void UnpinSnapshotImpl() override;
+  virtual common::Error GetFromSnapshotImpl(const NKey& key, NDbKValue* loaded_key) override;
+  virtual common::Error PartitionImpl(size_t count, key_ranges_t* ranges) override;
+  virtual common::Error ScanRangeImpl(const KeyRange& range,
+                                      const std::string& pattern,
+                                      size_t batch_size,
+                                      bool with_values,
+                                      range_batch_callback_t batch_cb) override;
+
+  const ::leveldb::Snapshot* pinned_snapshot_;
+  size_t pinned_count_;
+  paging_snapshots_t paging_snapshots_;
 };
 
 }  // namespace leveldb
@@ -43,6 +43,11 @@ namespace lmdb {
 
 namespace {
 
+static_assert(LMDB_ENV_WRITEMAP == MDB_WRITEMAP, "LMDB_ENV_WRITEMAP should be MDB_WRITEMAP");
+static_assert(LMDB_ENV_NOSYNC == MDB_NOSYNC, "LMDB_ENV_NOSYNC should be MDB_NOSYNC");
+static_assert(LMDB_ENV_MAPASYNC == MDB_MAPASYNC, "LMDB_ENV_MAPASYNC should be MDB_MAPASYNC");
+static_assert(LMDB_ENV_NORDAHEAD == MDB_NORDAHEAD, "LMDB_ENV_NORDAHEAD should be MDB_NORDAHEAD");
+
 Config parseOptions(int argc, char** argv) {
   Config cfg;
   for (int i = 0; i < argc; i++) {
@@ -59,6 +64,21 @@ Config parseOptions(int argc, char** argv) {
       if (common::ConvertFromString(argv[++i], &env_flags)) {
         cfg.env_flags = env_flags;
       }
+    } else if (!strcmp(argv[i], "-map-size") && !lastarg) {
+      size_t map_size;
+      if (common::ConvertFromString(argv[++i], &map_size)) {
+        cfg.map_size = map_size;
+      }
+    } else if (!strcmp(argv[i], "-max-readers") && !lastarg) {
+      unsigned int max_readers;
+      if (common::ConvertFromString(argv[++i], &max_readers)) {
+        cfg.max_readers = max_readers;
+      }
+    } else if (!strcmp(argv[i], "-max-dbs") && !lastarg) {
+      unsigned int max_dbs;
+      if (common::ConvertFromString(argv[++i], &max_dbs)) {
+        cfg.max_dbs = max_dbs;
+      }
     } else {
       if (argv[i][0] == '-') {
         const std::string buff = common::MemSPrintf(
@@ -80,17 +100,28 @@ Config parseOptions(int argc, char** argv) {
 
 Config::Config()
     : LocalConfig(common::file_system::prepare_path("~/test.lmdb")),
-      env_flags(LMDB_DEFAULT_ENV_FLAGS) {}
+      env_flags(LMDB_DEFAULT_ENV_FLAGS),
+      map_size(LMDB_DEFAULT_MAP_SIZE),
+      max_readers(LMDB_DEFAULT_MAX_READERS),
+      max_dbs(LMDB_DEFAULT_MAX_DBS) {}
 
 bool Config::ReadOnlyDB() const {
-  return env_flags & MDB_RDONLY;
+  return IsEnvFlag(MDB_RDONLY);
 }
 
 void Config::SetReadOnlyDB(bool ro) {
-  if (ro) {
-    env_flags |= MDB_RDONLY;
+  SetEnvFlag(MDB_RDONLY, ro);
+}
+
+bool Config::IsEnvFlag(int flag) const {
+  return (env_flags & flag) == flag;
+}
+
+void Config::SetEnvFlag(int flag, bool on) {
+  if (on) {
+    env_flags |= flag;
   } else {
-    env_flags &= ~MDB_RDONLY;
+    env_flags &= ~flag;
   }
 }
 
@@ -107,6 +138,18 @@ std::string ConvertToString(const fastonosql::core::lmdb::Config& conf) {
     argv.push_back("-e");
     argv.push_back(common::ConvertToString(conf.env_flags));
   }
+  if (conf.map_size != LMDB_DEFAULT_MAP_SIZE) {
+    argv.push_back("-map-size");
+    argv.push_back(common::ConvertToString(conf.map_size));
+  }
+  if (conf.max_readers != LMDB_DEFAULT_MAX_READERS) {
+    argv.push_back("-max-readers");
+    argv.push_back(common::ConvertToString(conf.max_readers));
+  }
+  if (conf.max_dbs != LMDB_DEFAULT_MAX_DBS) {
+    argv.push_back("-max-dbs");
+    argv.push_back(common::ConvertToString(conf.max_dbs));
+  }
 
   return fastonosql::core::ConvertToStringConfigArgs(argv);
 }
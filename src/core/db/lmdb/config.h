@@ -18,12 +18,23 @@
 
 #pragma once
 
+#include <stddef.h>  // for size_t
+
 #include <string>
 
 #include "core/config/config.h"
 
 #define LMDB_DEFAULT_ENV_FLAGS 0x20000  // mdb_env Environment Flags
                                         // MDB_RDONLY  0x20000
+#define LMDB_DEFAULT_MAP_SIZE (64 * 1024 * 1024)
+#define LMDB_DEFAULT_MAX_READERS 126
+#define LMDB_DEFAULT_MAX_DBS 16
+
+// values of MDB_WRITEMAP, MDB_NOSYNC, MDB_MAPASYNC, MDB_NORDAHEAD
+#define LMDB_ENV_WRITEMAP 0x80000
+#define LMDB_ENV_NOSYNC 0x10000
+#define LMDB_ENV_MAPASYNC 0x100000
+#define LMDB_ENV_NORDAHEAD 0x800000
 
 namespace fastonosql {
 namespace core {
@@ -35,7 +46,13 @@ struct Config : public LocalConfig {
   bool ReadOnlyDB() const;
   void SetReadOnlyDB(bool ro);
 
+  bool IsEnvFlag(int flag) const;
+  void SetEnvFlag(int flag, bool on);
+
   int env_flags;
+  size_t map_size;           // initial bytes, map grows twice when it is full
+  unsigned int max_readers;  // concurrent read transactions of all processes
+  unsigned int max_dbs;      // named databases which can be selected
 };
 
 }  // namespace lmdb
@@ -21,8 +21,18 @@
 #include <errno.h>   // for EACCES
 #include <lmdb.h>    // for mdb_txn_abort, MDB_val
 #include <stdlib.h>  // for NULL, free, calloc
+#include <string.h>  // for memcpy
 #include <time.h>    // for time_t
-#include <string>    // for string
+
+#include <algorithm>   // for max, min, stable_sort
+#include <atomic>      // for atomic
+#include <chrono>      // for milliseconds
+#include <functional>  // for function
+#include <mutex>       // for mutex, unique_lock
+#include <string>      // for string
+#include <thread>      // for thread, sleep_for
+#include <utility>     // for pair, make_pair
+#include <vector>      // for vector
 
 #include <common/value.h>  // for StringValue (ptr only)
 #include <common/utils.h>  // for c_strornull
@@ -34,9 +44,15 @@
 #include "core/db/lmdb/database_info.h"
 #include "core/db/lmdb/internal/commands_api.h"
 
-#include "core/global.h"  // for FastoObject, etc
+#include "core/global.h"               // for FastoObject, etc
+#include "core/internal/range_scan.h"  // for KeyRangePosition
 
 #define LMDB_OK 0
+#define LMDB_DATA_FILE_NAME "data.mdb"
+#define LMDB_LOCK_FILE_NAME "lock.mdb"
+#define LMDB_BACKUP_POLL_MSEC 100
+#define LMDB_PAGE_HEADER_SIZE 16
+#define LMDB_NODE_HEADER_SIZE 8
 
 namespace fastonosql {
 namespace core {
@@ -44,6 +60,10 @@ namespace lmdb {
 struct lmdb {
   MDB_env* env;
   MDB_dbi dbir;
+  MDB_dbi main_dbir;
+  char* db_name;            // selected named database, NULL for main
+  MDB_txn* read_txn;        // reset after every read, renewed by next one
+  MDB_cursor* read_cursor;  // renewed together with read_txn
 };
 
 namespace {
@@ -52,38 +72,88 @@ unsigned int lmdb_db_flag_from_env_flags(int env_flags) {
   return (env_flags & MDB_RDONLY) ? MDB_RDONLY : 0;
 }
 
-int lmdb_open(lmdb** context,
-              const char* db_path,
-              const char* db_name,
-              int env_flags,
-              unsigned int db_env_flags) {
-  lmdb* lcontext = reinterpret_cast<lmdb*>(calloc(1, sizeof(lmdb)));
-  int rc = mdb_env_create(&lcontext->env);
+void lmdb_read_close(lmdb* context) {
+  if (context->read_cursor) {
+    mdb_cursor_close(context->read_cursor);
+    context->read_cursor = NULL;
+  }
+  if (context->read_txn) {
+    mdb_txn_abort(context->read_txn);
+    context->read_txn = NULL;
+  }
+}
+
+// named database is created if env is writable,
+// handle is valid for all transactions only after commit
+int lmdb_select(lmdb* context, const char* db_name, unsigned int db_env_flags) {
+  MDB_txn* txn = NULL;
+  int rc = mdb_txn_begin(context->env, NULL, db_env_flags, &txn);
   if (rc != LMDB_OK) {
-    free(lcontext);
     return rc;
   }
 
-  rc = mdb_env_open(lcontext->env, db_path, env_flags, 0664);
+  MDB_dbi dbir = 0;
+  unsigned int dbi_flags = (db_name && !(db_env_flags & MDB_RDONLY)) ? MDB_CREATE : 0;
+  rc = mdb_dbi_open(txn, db_name, dbi_flags, &dbir);
   if (rc != LMDB_OK) {
-    free(lcontext);
+    mdb_txn_abort(txn);
     return rc;
   }
 
-  MDB_txn* txn = NULL;
-  rc = mdb_txn_begin(lcontext->env, NULL, db_env_flags, &txn);
+  rc = mdb_txn_commit(txn);
+  if (rc != LMDB_OK) {
+    return rc;
+  }
+
+  // pooled cursor is bound to previous database
+  if (context->read_cursor) {
+    mdb_cursor_close(context->read_cursor);
+    context->read_cursor = NULL;
+  }
+  free(context->db_name);
+  context->db_name = db_name ? strdup(db_name) : NULL;
+  context->dbir = dbir;
+  return rc;
+}
+
+int lmdb_open(lmdb** context,
+              const char* db_path,
+              int env_flags,
+              unsigned int db_env_flags,
+              size_t map_size,
+              unsigned int max_readers,
+              unsigned int max_dbs) {
+  lmdb* lcontext = reinterpret_cast<lmdb*>(calloc(1, sizeof(lmdb)));
+  int rc = mdb_env_create(&lcontext->env);
   if (rc != LMDB_OK) {
     free(lcontext);
     return rc;
   }
 
-  rc = mdb_dbi_open(txn, db_name, 0, &lcontext->dbir);
-  mdb_txn_abort(txn);
+  if (map_size) {
+    rc = mdb_env_set_mapsize(lcontext->env, map_size);
+  }
+  if (rc == LMDB_OK && max_readers) {
+    rc = mdb_env_set_maxreaders(lcontext->env, max_readers);
+  }
+  if (rc == LMDB_OK && max_dbs) {
+    rc = mdb_env_set_maxdbs(lcontext->env, max_dbs);
+  }
+  if (rc == LMDB_OK) {
+    // read transaction is kept by connection, not by thread which began it
+    rc = mdb_env_open(lcontext->env, db_path, env_flags | MDB_NOTLS, 0664);
+  }
+  if (rc == LMDB_OK) {
+    rc = lmdb_select(lcontext, NULL, db_env_flags);
+  }
+
   if (rc != LMDB_OK) {
+    mdb_env_close(lcontext->env);
     free(lcontext);
     return rc;
   }
 
+  lcontext->main_dbir = lcontext->dbir;
   *context = lcontext;
   return rc;
 }
@@ -98,12 +168,134 @@ void lmdb_close(lmdb** context) {
     return;
   }
 
-  mdb_dbi_close(lcontext->env, lcontext->dbir);
+  lmdb_read_close(lcontext);
   mdb_env_close(lcontext->env);
+  free(lcontext->db_name);
   free(lcontext);
   *context = NULL;
 }
 
+// reader table slot and txn are allocated once per connection,
+// every read only renews them, lmdb_read_end should follow success
+int lmdb_read_begin(lmdb* context, MDB_txn** txn) {
+  if (context->read_txn) {
+    int rc = mdb_txn_renew(context->read_txn);
+    if (rc == LMDB_OK) {
+      *txn = context->read_txn;
+      return rc;
+    }
+
+    lmdb_read_close(context);
+  }
+
+  int rc = mdb_txn_begin(context->env, NULL, MDB_RDONLY, &context->read_txn);
+  if (rc != LMDB_OK) {
+    context->read_txn = NULL;
+    return rc;
+  }
+
+  *txn = context->read_txn;
+  return rc;
+}
+
+int lmdb_read_cursor(lmdb* context, MDB_cursor** cursor) {
+  if (context->read_cursor) {
+    int rc = mdb_cursor_renew(context->read_txn, context->read_cursor);
+    if (rc == LMDB_OK) {
+      *cursor = context->read_cursor;
+      return rc;
+    }
+
+    mdb_cursor_close(context->read_cursor);
+    context->read_cursor = NULL;
+  }
+
+  int rc = mdb_cursor_open(context->read_txn, context->dbir, &context->read_cursor);
+  if (rc != LMDB_OK) {
+    context->read_cursor = NULL;
+    return rc;
+  }
+
+  *cursor = context->read_cursor;
+  return rc;
+}
+
+void lmdb_read_end(lmdb* context) {
+  mdb_txn_reset(context->read_txn);
+}
+
+// leaf node with its index slot and overflow pages of big value
+uint64_t lmdb_entry_disk_size(size_t page_size, const MDB_val& key, const MDB_val& data) {
+  const size_t node_max = (page_size - LMDB_PAGE_HEADER_SIZE) / 2 - sizeof(uint16_t);
+  const size_t node = LMDB_NODE_HEADER_SIZE + key.mv_size + sizeof(uint16_t);
+  if (node + data.mv_size <= node_max) {
+    return node + data.mv_size;
+  }
+
+  size_t pages = (LMDB_PAGE_HEADER_SIZE + data.mv_size + page_size - 1) / page_size;
+  return node + sizeof(size_t) + static_cast<uint64_t>(pages) * page_size;
+}
+
+// map can be resized only without active transactions in process,
+// grow - double map size, otherwise adopt size set by other process
+int lmdb_resize_map(lmdb* context, bool grow) {
+  lmdb_read_close(context);
+  size_t map_size = 0;
+  if (grow) {
+    MDB_envinfo info;
+    int rc = mdb_env_info(context->env, &info);
+    if (rc != LMDB_OK) {
+      return rc;
+    }
+
+    map_size = info.me_mapsize * 2;
+    if (map_size < info.me_mapsize) {
+      return MDB_MAP_FULL;
+    }
+  }
+
+  return mdb_env_set_mapsize(context->env, map_size);
+}
+
+// bytes are copied straight from map, txn pins pages of value
+class MappedValueSource : public IByteSource {
+ public:
+  MappedValueSource(MDB_txn* txn, const MDB_val& value)
+      : mutex_(),
+        txn_(txn),
+        data_(reinterpret_cast<const char*>(value.mv_data)),
+        size_(value.mv_size) {}
+  virtual ~MappedValueSource() { Close(); }
+
+  virtual uint64_t Size() const override { return size_; }
+
+  virtual size_t Read(uint64_t offset, char* out, size_t size) override {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!txn_ || offset >= size_) {
+      return 0;
+    }
+
+    size_t count = std::min<uint64_t>(size, size_ - offset);
+    memcpy(out, data_ + offset, count);
+    return count;
+  }
+
+  virtual void Close() override {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (txn_) {
+      mdb_txn_abort(txn_);
+      txn_ = NULL;
+      data_ = NULL;
+    }
+  }
+
+ private:
+  std::mutex mutex_;
+  MDB_txn* txn_;
+  const char* data_;
+  const uint64_t size_;
+};
+
 }  // namespace
 }
 namespace internal {
@@ -175,7 +367,8 @@ common::Error CreateConnection(const Config& config, NativeConnection** context)
 
   const char* db_path = common::utils::c_strornull(folder);
   int env_flags = config.env_flags;
-  int st = lmdb_open(&lcontext, db_path, NULL, env_flags, lmdb_db_flag_from_env_flags(env_flags));
+  int st = lmdb_open(&lcontext, db_path, env_flags, lmdb_db_flag_from_env_flags(env_flags),
+                     config.map_size, config.max_readers, config.max_dbs);
   if (st != LMDB_OK) {
     std::string buff = common::MemSPrintf("Fail open database: %s", mdb_strerror(st));
     return common::make_error_value(buff, common::ErrorValue::E_ERROR);
@@ -196,11 +389,75 @@ common::Error TestConnection(const Config& config) {
   return common::Error();
 }
 
+common::Error RestoreBackup(const Config& config,
+                            const std::string& path,
+                            backup_progress_callback_t progress_cb,
+                            BackupStats* stats) {
+  if (!stats) {
+    DNOTREACHED();
+    return common::make_error_value("Invalid input argument(s)", common::ErrorValue::E_ERROR);
+  }
+
+  std::string backup_data = common::file_system::make_path(path, LMDB_DATA_FILE_NAME);
+  off_t size = 0;
+  common::Error err = common::file_system::get_file_size_by_path(backup_data, &size);
+  if (err && err->IsError()) {
+    return common::make_error_value(common::MemSPrintf("Invalid backup path(%s)", path),
+                                    common::ErrorValue::E_ERROR);
+  }
+
+  stats->total_bytes = size;
+  BackupProgress progress(progress_cb, stats);
+  std::string data = common::file_system::make_path(config.dbname, LMDB_DATA_FILE_NAME);
+  const std::string restored = RestoreTempPath(data);
+  err = CopyFileWithProgress(backup_data, restored, &progress);
+  if (err && err->IsError()) {
+    RemoveRestoredFile(restored);
+    return err;
+  }
+
+  err = SwapRestored(restored, data, RemoveRestoredFile);
+  if (err && err->IsError()) {
+    RemoveRestoredFile(restored);
+    return err;
+  }
+
+  // reader table belongs to replaced data, failed restore keeps it for old data
+  std::string lock = common::file_system::make_path(config.dbname, LMDB_LOCK_FILE_NAME);
+  if (common::file_system::is_file_exist(lock)) {
+    err = common::file_system::remove_file(lock);
+    if (err && err->IsError()) {
+      return err;
+    }
+  }
+
+  progress.Finish();
+  return common::Error();
+}
+
 DBConnection::DBConnection(CDBConnectionClient* client)
-    : base_class(client, new CommandTranslator(base_class::Commands())) {}
+    : base_class(client, new CommandTranslator(base_class::Commands())),
+      value_sources_(),
+      bulk_count_(0),
+      bulk_env_flags_(0) {}
+
+DBConnection::~DBConnection() {
+  value_sources_.CloseAll();
+}
+
+void DBConnection::OnDisconnect() {
+  value_sources_.CloseAll();
+  if (bulk_count_ != 0 && connection_.handle_) {
+    mdb_env_sync(connection_.handle_->env, 1);
+  }
+  bulk_count_ = 0;
+}
 
 std::string DBConnection::CurrentDBName() const {
   if (connection_.handle_) {
+    if (connection_.handle_->db_name) {
+      return connection_.handle_->db_name;
+    }
     return common::ConvertToString(connection_.handle_->dbir);
   }
 
@@ -223,35 +480,265 @@ common::Error DBConnection::Info(const char* args, ServerInfo::Stats* statsout)
   Config conf = config();
   linfo.db_path = conf.dbname;
 
+  lmdb* context = connection_.handle_;
+  MDB_envinfo env_info;
+  int rc = mdb_env_info(context->env, &env_info);
+  if (rc != LMDB_OK) {
+    std::string buff = common::MemSPrintf("info function error: %s", mdb_strerror(rc));
+    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+  }
+
+  MDB_txn* txn = NULL;
+  MDB_stat db_stat;
+  rc = lmdb_read_begin(context, &txn);
+  if (rc == LMDB_OK) {
+    rc = mdb_stat(txn, context->dbir, &db_stat);
+    lmdb_read_end(context);
+  }
+  if (rc != LMDB_OK) {
+    std::string buff = common::MemSPrintf("info function error: %s", mdb_strerror(rc));
+    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+  }
+
+  linfo.map_size = env_info.me_mapsize;
+  linfo.map_used = static_cast<uint64_t>(env_info.me_last_pgno + 1) * db_stat.ms_psize;
+  linfo.last_txnid = env_info.me_last_txnid;
+  linfo.max_readers = env_info.me_maxreaders;
+  linfo.num_readers = env_info.me_numreaders;
+  linfo.page_size = db_stat.ms_psize;
+  linfo.tree_depth = db_stat.ms_depth;
+  linfo.branch_pages = db_stat.ms_branch_pages;
+  linfo.leaf_pages = db_stat.ms_leaf_pages;
+  linfo.overflow_pages = db_stat.ms_overflow_pages;
+  linfo.entries = db_stat.ms_entries;
   *statsout = linfo;
   return common::Error();
 }
 
-common::Error DBConnection::SetInner(const std::string& key, const std::string& value) {
+common::Error DBConnection::Backup(const std::string& path,
+                                   backup_progress_callback_t progress_cb,
+                                   BackupStats* stats) {
+  if (!stats) {
+    DNOTREACHED();
+    return common::make_error_value("Invalid input argument(s)", common::ErrorValue::E_ERROR);
+  }
+
   if (!IsConnected()) {
     return common::make_error_value("Not connected", common::Value::E_ERROR);
   }
 
+  common::Error err = common::file_system::create_directory(path, true);
+  if (err && err->IsError()) {
+    return err;
+  }
+
+  // used pages of environment, compacted copy is smaller
+  MDB_env* env = connection_.handle_->env;
+  MDB_envinfo env_info;
+  MDB_stat env_stat;
+  if (mdb_env_info(env, &env_info) == LMDB_OK && mdb_env_stat(env, &env_stat) == LMDB_OK) {
+    stats->total_bytes = static_cast<uint64_t>(env_info.me_last_pgno + 1) * env_stat.ms_psize;
+  }
+
+  // lmdb copies without callbacks, progress is size of written file
+  BackupProgress progress(progress_cb, stats);
+  const std::string data = common::file_system::make_path(path, LMDB_DATA_FILE_NAME);
+  std::atomic<bool> finished(false);
+  int rc = LMDB_OK;
+  std::thread copy_thread([env, path, &rc, &finished]() {
+    rc = mdb_env_copy2(env, path.c_str(), MDB_CP_COMPACT);
+    finished = true;
+  });
+  while (!finished) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(LMDB_BACKUP_POLL_MSEC));
+    off_t size = 0;
+    common::Error size_err = common::file_system::get_file_size_by_path(data, &size);
+    if (!size_err) {
+      stats->bytes = size;
+    }
+    progress.Update();
+  }
+  copy_thread.join();
+
+  if (rc != LMDB_OK) {
+    std::string buff = common::MemSPrintf("BACKUP function error: %s", mdb_strerror(rc));
+    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+  }
+
+  off_t size = 0;
+  err = common::file_system::get_file_size_by_path(data, &size);
+  if (!err) {
+    stats->bytes = size;
+  }
+  stats->files = 1;
+  progress.Finish();
+  return common::Error();
+}
+
+common::Error DBConnection::SampleSizes(const namespace_ranges_t& ranges,
+                                        size_t sample_keys,
+                                        namespace_sizes_t* sizes) {
+  if (!sizes) {
+    DNOTREACHED();
+    return common::make_error_value("Invalid input argument(s)", common::ErrorValue::E_ERROR);
+  }
+
+  if (!IsConnected()) {
+    return common::make_error_value("Not connected", common::Value::E_ERROR);
+  }
+
+  MDB_stat db_stat;
+  MDB_cursor* cursor = NULL;
+  MDB_txn* txn = NULL;
+  int rc = lmdb_read_begin(connection_.handle_, &txn);
+  if (rc == LMDB_OK) {
+    rc = mdb_stat(txn, connection_.handle_->dbir, &db_stat);
+    if (rc == LMDB_OK) {
+      rc = lmdb_read_cursor(connection_.handle_, &cursor);
+    }
+    if (rc != LMDB_OK) {
+      lmdb_read_end(connection_.handle_);
+    }
+  }
+
+  if (rc != LMDB_OK) {
+    std::string buff = common::MemSPrintf("SAMPLE SIZES function error: %s", mdb_strerror(rc));
+    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+  }
+
+  // every range is walked up to sample_keys keys, walk stopped earlier is
+  // scaled by position of last walked key in range, up to entries of database
+  namespace_sizes_t result;
+  for (size_t i = 0; i < ranges.size(); ++i) {
+    const NamespaceRange& range = ranges[i];
+    NamespaceSize size(range.ns);
+    size_t visited = 0;
+    std::string last_key;
+    MDB_val key;
+    MDB_val data;
+    key.mv_size = range.start.size();
+    key.mv_data = const_cast<char*>(range.start.data());
+    rc = mdb_cursor_get(cursor, &key, &data, range.start.empty() ? MDB_FIRST : MDB_SET_RANGE);
+    size.exact = true;
+    while (rc == LMDB_OK) {
+      std::string skey(reinterpret_cast<const char*>(key.mv_data), key.mv_size);
+      if (!range.limit.empty() && skey >= range.limit) {
+        break;
+      }
+
+      if (visited >= sample_keys || IsInterrupted()) {
+        size.exact = false;
+        break;
+      }
+
+      size.keys++;
+      size.disk_bytes += lmdb_entry_disk_size(db_stat.ms_psize, key, data);
+      visited++;
+      last_key.swap(skey);
+      rc = mdb_cursor_get(cursor, &key, &data, MDB_NEXT);
+    }
+
+    if (!size.exact && visited) {
+      uint64_t keys = db_stat.ms_entries;
+      if (!range.start.empty() || !range.limit.empty()) {
+        double position = internal::KeyRangePosition(range.start, range.limit, last_key);
+        if (position > 0) {
+          keys = std::min<uint64_t>(keys, static_cast<uint64_t>(visited / position));
+        }
+      }
+      keys = std::max<uint64_t>(keys, visited);
+      double scale = static_cast<double>(keys) / visited;
+      size.disk_bytes = static_cast<uint64_t>(size.disk_bytes * scale);
+      size.keys = keys;
+    }
+    result.push_back(size);
+  }
+
+  lmdb_read_end(connection_.handle_);
+  *sizes = result;
+  return common::Error();
+}
+
+common::Error DBConnection::OpenValueSource(const NKey& key, byte_source_t* source) {
+  if (!source) {
+    DNOTREACHED();
+    return common::make_error_value("Invalid input argument(s)", common::ErrorValue::E_ERROR);
+  }
+
+  if (!IsConnected()) {
+    return common::make_error_value("Not connected", common::Value::E_ERROR);
+  }
+
+  std::string key_str = key.Key();
   MDB_val mkey;
-  mkey.mv_size = key.size();
-  mkey.mv_data = const_cast<char*>(key.c_str());
+  mkey.mv_size = key_str.size();
+  mkey.mv_data = const_cast<char*>(key_str.c_str());
   MDB_val mval;
-  mval.mv_size = value.size();
-  mval.mv_data = const_cast<char*>(value.c_str());
 
   MDB_txn* txn = NULL;
-  int env_flags = connection_.config_.env_flags;
-  int rc =
-      mdb_txn_begin(connection_.handle_->env, NULL, lmdb_db_flag_from_env_flags(env_flags), &txn);
+  int rc = mdb_txn_begin(connection_.handle_->env, NULL, MDB_RDONLY, &txn);
   if (rc == LMDB_OK) {
-    rc = mdb_put(txn, connection_.handle_->dbir, &mkey, &mval, 0);
-    if (rc == LMDB_OK) {
-      rc = mdb_txn_commit(txn);
-    } else {
+    rc = mdb_get(txn, connection_.handle_->dbir, &mkey, &mval);
+    if (rc != LMDB_OK) {
       mdb_txn_abort(txn);
     }
   }
 
+  if (rc != LMDB_OK) {
+    std::string buff = common::MemSPrintf("get function error: %s", mdb_strerror(rc));
+    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+  }
+
+  byte_source_t lsource(new MappedValueSource(txn, mval));
+  value_sources_.Add(lsource);
+  *source = lsource;
+  return common::Error();
+}
+
+int DBConnection::WriteInTxn(std::function<int(MDB_txn*)> write_func) {
+  lmdb* context = connection_.handle_;
+  unsigned int flags = lmdb_db_flag_from_env_flags(connection_.config_.env_flags);
+  while (true) {
+    MDB_txn* txn = NULL;
+    int rc = mdb_txn_begin(context->env, NULL, flags, &txn);
+    if (rc == LMDB_OK) {
+      rc = write_func(txn);
+      if (rc == LMDB_OK) {
+        rc = mdb_txn_commit(txn);
+      } else {
+        mdb_txn_abort(txn);
+      }
+    }
+
+    if (rc != MDB_MAP_FULL && rc != MDB_MAP_RESIZED) {
+      return rc;
+    }
+
+    // opened values keep read transactions, map can't be resized under them
+    value_sources_.CloseAll();
+    int resize_rc = lmdb_resize_map(context, rc == MDB_MAP_FULL);
+    if (resize_rc != LMDB_OK) {
+      return rc;
+    }
+  }
+}
+
+common::Error DBConnection::SetInner(const std::string& key, const std::string& value) {
+  if (!IsConnected()) {
+    return common::make_error_value("Not connected", common::Value::E_ERROR);
+  }
+
+  MDB_val mkey;
+  mkey.mv_size = key.size();
+  mkey.mv_data = const_cast<char*>(key.c_str());
+  MDB_val mval;
+  mval.mv_size = value.size();
+  mval.mv_data = const_cast<char*>(value.c_str());
+
+  MDB_dbi dbir = connection_.handle_->dbir;
+  int rc = WriteInTxn([dbir, &mkey, &mval](MDB_txn* txn) {
+    return mdb_put(txn, dbir, &mkey, &mval, 0);
+  });
   if (rc != LMDB_OK) {
     std::string buff = common::MemSPrintf("set function error: %s", mdb_strerror(rc));
     return common::make_error_value(buff, common::ErrorValue::E_ERROR);
@@ -271,18 +758,27 @@ common::Error DBConnection::GetInner(const std::string& key, std::string* ret_va
   MDB_val mval;
 
   MDB_txn* txn = NULL;
-  int rc = mdb_txn_begin(connection_.handle_->env, NULL, MDB_RDONLY, &txn);
-  if (rc == LMDB_OK) {
-    rc = mdb_get(txn, connection_.handle_->dbir, &mkey, &mval);
+  int rc = lmdb_read_begin(connection_.handle_, &txn);
+  if (rc != LMDB_OK) {
+    std::string buff = common::MemSPrintf("get function error: %s", mdb_strerror(rc));
+    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+  }
+
+  rc = mdb_get(txn, connection_.handle_->dbir, &mkey, &mval);
+  if (rc == MDB_NOTFOUND) {
+    lmdb_read_end(connection_.handle_);
+    return MakeKeyNotFoundError(key);
   }
-  mdb_txn_abort(txn);
 
   if (rc != LMDB_OK) {
+    lmdb_read_end(connection_.handle_);
     std::string buff = common::MemSPrintf("get function error: %s", mdb_strerror(rc));
     return common::make_error_value(buff, common::ErrorValue::E_ERROR);
   }
 
+  // value points into map, it is valid until txn reset
   ret_val->assign(reinterpret_cast<const char*>(mval.mv_data), mval.mv_size);
+  lmdb_read_end(connection_.handle_);
   return common::Error();
 }
 
@@ -295,19 +791,8 @@ common::Error DBConnection::DelInner(const std::string& key) {
   mkey.mv_size = key.size();
   mkey.mv_data = const_cast<char*>(key.c_str());
 
-  MDB_txn* txn = NULL;
-  int env_flags = connection_.config_.env_flags;
-  int rc =
-      mdb_txn_begin(connection_.handle_->env, NULL, lmdb_db_flag_from_env_flags(env_flags), &txn);
-  if (rc == LMDB_OK) {
-    rc = mdb_del(txn, connection_.handle_->dbir, &mkey, NULL);
-    if (rc == LMDB_OK) {
-      rc = mdb_txn_commit(txn);
-    } else {
-      mdb_txn_abort(txn);
-    }
-  }
-
+  MDB_dbi dbir = connection_.handle_->dbir;
+  int rc = WriteInTxn([dbir, &mkey](MDB_txn* txn) { return mdb_del(txn, dbir, &mkey, NULL); });
   if (rc != LMDB_OK) {
     std::string buff = common::MemSPrintf("delete function error: %s", mdb_strerror(rc));
     return common::make_error_value(buff, common::ErrorValue::E_ERROR);
@@ -323,13 +808,15 @@ common::Error DBConnection::ScanImpl(uint64_t cursor_in,
                                      uint64_t* cursor_out) {
   MDB_cursor* cursor = NULL;
   MDB_txn* txn = NULL;
-  int rc = mdb_txn_begin(connection_.handle_->env, NULL, MDB_RDONLY, &txn);
+  int rc = lmdb_read_begin(connection_.handle_, &txn);
   if (rc == LMDB_OK) {
-    rc = mdb_cursor_open(txn, connection_.handle_->dbir, &cursor);
+    rc = lmdb_read_cursor(connection_.handle_, &cursor);
+    if (rc != LMDB_OK) {
+      lmdb_read_end(connection_.handle_);
+    }
   }
 
   if (rc != LMDB_OK) {
-    mdb_txn_abort(txn);
     std::string buff = common::MemSPrintf("Keys function error: %s", mdb_strerror(rc));
     return common::make_error_value(buff, common::ErrorValue::E_ERROR);
   }
@@ -357,8 +844,7 @@ common::Error DBConnection::ScanImpl(uint64_t cursor_in,
 
   *keys_out = lkeys_out;
   *cursor_out = lcursor_out;
-  mdb_cursor_close(cursor);
-  mdb_txn_abort(txn);
+  lmdb_read_end(connection_.handle_);
   return common::Error();
 }
 
@@ -368,13 +854,15 @@ common::Error DBConnection::KeysImpl(const std::string& key_start,
                                      std::vector<std::string>* ret) {
   MDB_cursor* cursor = NULL;
   MDB_txn* txn = NULL;
-  int rc = mdb_txn_begin(connection_.handle_->env, NULL, MDB_RDONLY, &txn);
+  int rc = lmdb_read_begin(connection_.handle_, &txn);
   if (rc == LMDB_OK) {
-    rc = mdb_cursor_open(txn, connection_.handle_->dbir, &cursor);
+    rc = lmdb_read_cursor(connection_.handle_, &cursor);
+    if (rc != LMDB_OK) {
+      lmdb_read_end(connection_.handle_);
+    }
   }
 
   if (rc != LMDB_OK) {
-    mdb_txn_abort(txn);
     std::string buff = common::MemSPrintf("Keys function error: %s", mdb_strerror(rc));
     return common::make_error_value(buff, common::ErrorValue::E_ERROR);
   }
@@ -388,85 +876,57 @@ common::Error DBConnection::KeysImpl(const std::string& key_start,
     }
   }
 
-  mdb_cursor_close(cursor);
-  mdb_txn_abort(txn);
+  lmdb_read_end(connection_.handle_);
   return common::Error();
 }
 
 common::Error DBConnection::DBkcountImpl(size_t* size) {
-  MDB_cursor* cursor = NULL;
+  // b-tree keeps number of its entries, so keys aren't walked
   MDB_txn* txn = NULL;
-  int rc = mdb_txn_begin(connection_.handle_->env, NULL, MDB_RDONLY, &txn);
+  int rc = lmdb_read_begin(connection_.handle_, &txn);
+  MDB_stat stat;
   if (rc == LMDB_OK) {
-    rc = mdb_cursor_open(txn, connection_.handle_->dbir, &cursor);
+    rc = mdb_stat(txn, connection_.handle_->dbir, &stat);
+    lmdb_read_end(connection_.handle_);
   }
 
   if (rc != LMDB_OK) {
-    mdb_txn_abort(txn);
     std::string buff = common::MemSPrintf("DBKCOUNT function error: %s", mdb_strerror(rc));
     return common::make_error_value(buff, common::ErrorValue::E_ERROR);
   }
 
-  MDB_val key;
-  MDB_val data;
-  size_t sz = 0;
-  while (mdb_cursor_get(cursor, &key, &data, MDB_NEXT) == LMDB_OK) {
-    sz++;
-  }
-  mdb_cursor_close(cursor);
-  mdb_txn_abort(txn);
-
-  *size = sz;
+  *size = stat.ms_entries;
   return common::Error();
 }
 
 common::Error DBConnection::FlushDBImpl() {
-  MDB_cursor* cursor = NULL;
-  MDB_txn* txn = NULL;
-  int env_flags = connection_.config_.env_flags;
-  int rc =
-      mdb_txn_begin(connection_.handle_->env, NULL, lmdb_db_flag_from_env_flags(env_flags), &txn);
-  if (rc == LMDB_OK) {
-    rc = mdb_cursor_open(txn, connection_.handle_->dbir, &cursor);
-  }
-
+  // all keys are dropped in one write transaction
+  MDB_dbi dbir = connection_.handle_->dbir;
+  int rc = WriteInTxn([dbir](MDB_txn* txn) { return mdb_drop(txn, dbir, 0); });
   if (rc != LMDB_OK) {
-    mdb_txn_abort(txn);
     std::string buff = common::MemSPrintf("flushdb function error: %s", mdb_strerror(rc));
     return common::make_error_value(buff, common::ErrorValue::E_ERROR);
   }
 
-  MDB_val key;
-  MDB_val data;
-  size_t sz = 0;
-  while (mdb_cursor_get(cursor, &key, &data, MDB_NEXT) == LMDB_OK) {
-    sz++;
-    rc = mdb_del(txn, connection_.handle_->dbir, &key, NULL);
-    if (rc != LMDB_OK) {
-      mdb_cursor_close(cursor);
-      mdb_txn_abort(txn);
-      std::string buff = common::MemSPrintf("del function error: %s", mdb_strerror(rc));
-      return common::make_error_value(buff, common::ErrorValue::E_ERROR);
-    }
-  }
-
-  mdb_cursor_close(cursor);
-  if (sz != 0) {
-    rc = mdb_txn_commit(txn);
-    if (rc != LMDB_OK) {
-      std::string buff = common::MemSPrintf("commit function error: %s", mdb_strerror(rc));
-      return common::make_error_value(buff, common::ErrorValue::E_ERROR);
-    }
-    return common::Error();
-  }
-
-  mdb_txn_abort(txn);
   return common::Error();
 }
 
 common::Error DBConnection::SelectImpl(const std::string& name, IDataBaseInfo** info) {
+  lmdb* context = connection_.handle_;
   if (name != CurrentDBName()) {
-    return ICommandTranslator::InvalidInputArguments("SELECT");
+    if (name.empty()) {
+      return ICommandTranslator::InvalidInputArguments("SELECT");
+    }
+
+    // main database is named by its handle
+    bool is_main = name == common::ConvertToString(context->main_dbir);
+    int env_flags = connection_.config_.env_flags;
+    int rc = lmdb_select(context, is_main ? NULL : name.c_str(),
+                         lmdb_db_flag_from_env_flags(env_flags));
+    if (rc != LMDB_OK) {
+      std::string buff = common::MemSPrintf("select function error: %s", mdb_strerror(rc));
+      return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+    }
   }
 
   size_t kcount = 0;
@@ -501,18 +961,108 @@ common::Error DBConnection::GetImpl(const NKey& key, NDbKValue* loaded_key) {
   return common::Error();
 }
 
-common::Error DBConnection::DeleteImpl(const NKeys& keys, NKeys* deleted_keys) {
+common::Error DBConnection::GetBatchImpl(const NKeys& keys, NDbKValues* loaded_keys) {
+  // one read transaction for all keys instead of transaction per key
+  MDB_txn* txn = NULL;
+  int rc = lmdb_read_begin(connection_.handle_, &txn);
+  if (rc != LMDB_OK) {
+    std::string buff = common::MemSPrintf("get function error: %s", mdb_strerror(rc));
+    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+  }
+
   for (size_t i = 0; i < keys.size(); ++i) {
-    NKey key = keys[i];
-    std::string key_str = key.Key();
-    common::Error err = DelInner(key_str);
-    if (err && err->IsError()) {
+    std::string key_str = keys[i].Key();
+    MDB_val mkey;
+    mkey.mv_size = key_str.size();
+    mkey.mv_data = const_cast<char*>(key_str.c_str());
+    MDB_val mval;
+    rc = mdb_get(txn, connection_.handle_->dbir, &mkey, &mval);
+    if (rc == MDB_NOTFOUND) {
       continue;
     }
 
-    deleted_keys->push_back(key);
+    if (rc != LMDB_OK) {
+      lmdb_read_end(connection_.handle_);
+      std::string buff = common::MemSPrintf("get function error: %s", mdb_strerror(rc));
+      return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+    }
+
+    std::string value_str(reinterpret_cast<const char*>(mval.mv_data), mval.mv_size);
+    NValue val(common::Value::CreateStringValue(value_str));
+    loaded_keys->push_back(NDbKValue(keys[i], val));
   }
 
+  lmdb_read_end(connection_.handle_);
+  return common::Error();
+}
+
+common::Error DBConnection::SetBatchImpl(const NDbKValues& keys, NDbKValues* added_keys) {
+  // one write transaction for all keys, keys are put in order of btree
+  std::vector<std::pair<std::string, std::string> > pairs;
+  pairs.reserve(keys.size());
+  for (size_t i = 0; i < keys.size(); ++i) {
+    pairs.push_back(std::make_pair(keys[i].KeyString(), keys[i].ValueString()));
+  }
+  // last value of duplicated key wins
+  std::stable_sort(pairs.begin(), pairs.end(),
+                   [](const std::pair<std::string, std::string>& lhs,
+                      const std::pair<std::string, std::string>& rhs) {
+                     return lhs.first < rhs.first;
+                   });
+
+  MDB_dbi dbir = connection_.handle_->dbir;
+  int rc = WriteInTxn([dbir, &pairs](MDB_txn* txn) {
+    for (size_t i = 0; i < pairs.size(); ++i) {
+      MDB_val mkey;
+      mkey.mv_size = pairs[i].first.size();
+      mkey.mv_data = const_cast<char*>(pairs[i].first.c_str());
+      MDB_val mval;
+      mval.mv_size = pairs[i].second.size();
+      mval.mv_data = const_cast<char*>(pairs[i].second.c_str());
+      int rc = mdb_put(txn, dbir, &mkey, &mval, 0);
+      if (rc != LMDB_OK) {
+        return rc;
+      }
+    }
+    return LMDB_OK;
+  });
+  if (rc != LMDB_OK) {
+    std::string buff = common::MemSPrintf("set function error: %s", mdb_strerror(rc));
+    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+  }
+
+  added_keys->insert(added_keys->end(), keys.begin(), keys.end());
+  return common::Error();
+}
+
+common::Error DBConnection::DeleteImpl(const NKeys& keys, NKeys* deleted_keys) {
+  // one write transaction for all keys instead of transaction per key
+  MDB_dbi dbir = connection_.handle_->dbir;
+  NKeys existing_keys;
+  int rc = WriteInTxn([dbir, &keys, &existing_keys](MDB_txn* txn) {
+    existing_keys.clear();
+    for (size_t i = 0; i < keys.size(); ++i) {
+      std::string key_str = keys[i].Key();
+      MDB_val mkey;
+      mkey.mv_size = key_str.size();
+      mkey.mv_data = const_cast<char*>(key_str.c_str());
+      int rc = mdb_del(txn, dbir, &mkey, NULL);
+      if (rc == MDB_NOTFOUND) {
+        continue;
+      } else if (rc != LMDB_OK) {
+        return rc;
+      }
+
+      existing_keys.push_back(keys[i]);
+    }
+    return LMDB_OK;
+  });
+  if (rc != LMDB_OK) {
+    std::string buff = common::MemSPrintf("delete function error: %s", mdb_strerror(rc));
+    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+  }
+
+  deleted_keys->insert(deleted_keys->end(), existing_keys.begin(), existing_keys.end());
   return common::Error();
 }
 
@@ -553,6 +1103,146 @@ common::Error DBConnection::GetTTLImpl(const NKey& key, ttl_t* ttl) {
                                   common::ErrorValue::E_ERROR);
 }
 
+void DBConnection::BeginBulkLoadImpl() {
+  if (bulk_count_++ != 0 || connection_.config_.ReadOnlyDB()) {
+    return;
+  }
+
+  // commits of bulk load aren't synced, with writable map pages are flushed asynchronously
+  lmdb* context = connection_.handle_;
+  unsigned int env_flags = 0;
+  if (mdb_env_get_flags(context->env, &env_flags) != LMDB_OK) {
+    return;
+  }
+
+  unsigned int bulk_flags = MDB_NOSYNC;
+  if (env_flags & MDB_WRITEMAP) {
+    bulk_flags |= MDB_MAPASYNC;
+  }
+  bulk_env_flags_ = bulk_flags & ~env_flags;
+  if (bulk_env_flags_ && mdb_env_set_flags(context->env, bulk_env_flags_, 1) != LMDB_OK) {
+    bulk_env_flags_ = 0;
+  }
+}
+
+void DBConnection::EndBulkLoadImpl() {
+  if (bulk_count_ == 0 || --bulk_count_ != 0 || connection_.config_.ReadOnlyDB()) {
+    return;
+  }
+
+  lmdb* context = connection_.handle_;
+  if (bulk_env_flags_) {
+    mdb_env_sync(context->env, 1);
+    mdb_env_set_flags(context->env, bulk_env_flags_, 0);
+    bulk_env_flags_ = 0;
+  }
+}
+
+common::Error DBConnection::PartitionImpl(size_t count, key_ranges_t* ranges) {
+  // branch pages aren't exposed by api, so split keys are found by seeks
+  MDB_cursor* cursor = NULL;
+  MDB_txn* txn = NULL;
+  int rc = lmdb_read_begin(connection_.handle_, &txn);
+  if (rc == LMDB_OK) {
+    rc = lmdb_read_cursor(connection_.handle_, &cursor);
+    if (rc != LMDB_OK) {
+      lmdb_read_end(connection_.handle_);
+    }
+  }
+
+  if (rc != LMDB_OK) {
+    std::string buff = common::MemSPrintf("PARTITION function error: %s", mdb_strerror(rc));
+    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+  }
+
+  auto seek_func = [cursor](const std::string& start, std::string* found) {
+    MDB_val key;
+    MDB_val data;
+    key.mv_size = start.size();
+    key.mv_data = const_cast<char*>(start.data());
+    if (mdb_cursor_get(cursor, &key, &data, start.empty() ? MDB_FIRST : MDB_SET_RANGE) !=
+        LMDB_OK) {
+      return false;
+    }
+
+    *found = std::string(reinterpret_cast<const char*>(key.mv_data), key.mv_size);
+    return true;
+  };
+
+  // every range being scanned holds reader slot, half of table is left for
+  // read txn of connection and readers of other processes
+  unsigned int max_readers = LMDB_DEFAULT_MAX_READERS;
+  mdb_env_get_maxreaders(connection_.handle_->env, &max_readers);
+  count = std::min<size_t>(count, std::max(max_readers / 2, 1u));
+  *ranges = internal::SplitByPrefixProbes(seek_func, count);
+  lmdb_read_end(connection_.handle_);
+  return common::Error();
+}
+
+// every call begins own read txn which takes slot in readers table till end of range,
+// so ranges count is capped by PartitionImpl, every range sees last commit at its start
+common::Error DBConnection::ScanRangeImpl(const KeyRange& range,
+                                          const std::string& pattern,
+                                          size_t batch_size,
+                                          bool with_values,
+                                          range_batch_callback_t batch_cb) {
+  lmdb* context = connection_.handle_;
+  MDB_txn* txn = NULL;
+  MDB_cursor* cursor = NULL;
+  int rc = mdb_txn_begin(context->env, NULL, MDB_RDONLY, &txn);
+  if (rc == LMDB_OK) {
+    rc = mdb_cursor_open(txn, context->dbir, &cursor);
+    if (rc != LMDB_OK) {
+      mdb_txn_abort(txn);
+    }
+  }
+
+  if (rc != LMDB_OK) {
+    std::string buff = common::MemSPrintf("SCAN function error: %s", mdb_strerror(rc));
+    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+  }
+
+  MDB_val key;
+  MDB_val data;
+  key.mv_size = range.start.size();
+  key.mv_data = const_cast<char*>(range.start.data());
+  rc = mdb_cursor_get(cursor, &key, &data, range.start.empty() ? MDB_FIRST : MDB_SET_RANGE);
+  NDbKValues batch;
+  bool stopped = false;
+  while (rc == LMDB_OK && !stopped) {
+    std::string skey(reinterpret_cast<const char*>(key.mv_data), key.mv_size);
+    if (!range.limit.empty() && skey >= range.limit) {
+      break;
+    }
+
+    if (common::MatchPattern(skey, pattern)) {
+      NValue val;
+      if (with_values) {
+        std::string sval(reinterpret_cast<const char*>(data.mv_data), data.mv_size);
+        val = NValue(common::Value::CreateStringValue(sval));
+      }
+      batch.push_back(NDbKValue(NKey(skey), val));
+      if (batch.size() >= batch_size) {
+        stopped = !batch_cb(batch);
+        batch.clear();
+      }
+    }
+    rc = mdb_cursor_get(cursor, &key, &data, MDB_NEXT);
+  }
+
+  mdb_cursor_close(cursor);
+  mdb_txn_abort(txn);
+  if (rc != LMDB_OK && rc != MDB_NOTFOUND) {
+    std::string buff = common::MemSPrintf("SCAN function error: %s", mdb_strerror(rc));
+    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+  }
+
+  if (!stopped && !batch.empty()) {
+    batch_cb(batch);
+  }
+  return common::Error();
+}
+
 common::Error DBConnection::QuitImpl() {
   common::Error err = Disconnect();
   if (err && err->IsError()) {
@@ -19,11 +19,16 @@
 #pragma once
 
 #include <stdint.h>  // for uint64_t
-#include <string>    // for string
+
+#include <functional>  // for function
+#include <string>      // for string
 
 #include <common/error.h>   // for Error
 #include <common/macros.h>  // for WARN_UNUSED_RESULT
 
+#include "core/backup.h"                   // for BackupStats, backup_progress_callback_t
+#include "core/namespace_size.h"           // for namespace_ranges_t, namespace_sizes_t
+#include "core/byte_source.h"              // for byte_source_t, ByteSources
 #include "core/command_info.h"             // for UNDEFINED_EXAMPLE_STR, UNDEFINED_...
 #include "core/connection_types.h"         // for connectionTypes::LMDB
 #include "core/db_key.h"                   // for NDbKValue, NKey, NKeys
@@ -32,6 +37,8 @@
 #include "core/db/lmdb/server_info.h"  // for ServerInfo
 #include "core/db/lmdb/config.h"
 
+struct MDB_txn;
+
 namespace fastonosql {
 class FastoObject;
 }
@@ -66,19 +73,40 @@ typedef lmdb NativeConnection;
 
 common::Error CreateConnection(const Config& config, NativeConnection** context);
 common::Error TestConnection(const Config& config);
+// replaces data file of closed environment by data file of backup
+common::Error RestoreBackup(const Config& config,
+                            const std::string& path,
+                            backup_progress_callback_t progress_cb,
+                            BackupStats* stats) WARN_UNUSED_RESULT;
 
 class DBConnection : public core::internal::CDBConnection<NativeConnection, Config, LMDB> {
  public:
   typedef core::internal::CDBConnection<NativeConnection, Config, LMDB> base_class;
   explicit DBConnection(CDBConnectionClient* client);
+  virtual ~DBConnection();
 
   std::string CurrentDBName() const;
   common::Error Info(const char* args, ServerInfo::Stats* statsout) WARN_UNUSED_RESULT;
+  // value stays in map while source is opened, source keeps own read transaction
+  common::Error OpenValueSource(const NKey& key, byte_source_t* source) WARN_UNUSED_RESULT;
+  // compacting copy of environment into folder path, free pages are omitted,
+  // copy runs in own read transaction, so writers aren't blocked
+  common::Error Backup(const std::string& path,
+                       backup_progress_callback_t progress_cb,
+                       BackupStats* stats) WARN_UNUSED_RESULT;
+  // lmdb has no range estimates, so keys of ranges are walked in one read
+  // transaction and pages of their nodes are counted, values aren't copied,
+  // walk stops after sample_keys and sizes of unfinished ranges are lower bounds
+  common::Error SampleSizes(const namespace_ranges_t& ranges,
+                            size_t sample_keys,
+                            namespace_sizes_t* sizes) WARN_UNUSED_RESULT;
 
  private:
   common::Error SetInner(const std::string& key, const std::string& value) WARN_UNUSED_RESULT;
   common::Error GetInner(const std::string& key, std::string* ret_val) WARN_UNUSED_RESULT;
   common::Error DelInner(const std::string& key) WARN_UNUSED_RESULT;
+  // commits write_func, repeats it in larger map when map is full, returns lmdb code
+  int WriteInTxn(std::function<int(MDB_txn*)> write_func);
 
   virtual common::Error ScanImpl(uint64_t cursor_in,
                                  const std::string& pattern,
@@ -93,12 +121,29 @@ class DBConnection : public core::internal::CDBConnection<NativeConnection, Conf
   virtual common::Error FlushDBImpl() override;
   virtual common::Error SelectImpl(const std::string& name, IDataBaseInfo** info) override;
   virtual common::Error SetImpl(const NDbKValue& key, NDbKValue* added_key) override;
+  virtual common::Error SetBatchImpl(const NDbKValues& keys, NDbKValues* added_keys) override;
   virtual common::Error GetImpl(const NKey& key, NDbKValue* loaded_key) override;
+  virtual common::Error GetBatchImpl(const NKeys& keys, NDbKValues* loaded_keys) override;
   virtual common::Error DeleteImpl(const NKeys& keys, NKeys* deleted_keys) override;
   virtual common::Error RenameImpl(const NKey& key, const std::string& new_key) override;
   virtual common::Error SetTTLImpl(const NKey& key, ttl_t ttl) override;
   virtual common::Error GetTTLImpl(const NKey& key, ttl_t* ttl) override;
   virtual common::Error QuitImpl() override;
+  // value sources should be closed before env is closed,
+  // unsynced commits of bulk load are flushed
+  virtual void OnDisconnect() override;
+  virtual void BeginBulkLoadImpl() override;
+  virtual void EndBulkLoadImpl() override;
+  virtual common::Error PartitionImpl(size_t count, key_ranges_t* ranges) override;
+  virtual common::Error ScanRangeImpl(const KeyRange& range,
+                                      const std::string& pattern,
+                                      size_t batch_size,
+                                      bool with_values,
+                                      range_batch_callback_t batch_cb) override;
+
+  ByteSources value_sources_;
+  size_t bulk_count_;
+  unsigned int bulk_env_flags_;  // flags set only while bulk load
 };
 
 }  // namespace lmdb
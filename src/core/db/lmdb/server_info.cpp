@@ -24,8 +24,9 @@
 #include <utility>   // for make_pair
 #include <vector>    // for vector
 
-#include <common/macros.h>  // for NOTREACHED, DCHECK_EQ
-#include <common/value.h>   // for Value, Value::Type, etc
+#include <common/convert2string.h>  // for ConvertFromString
+#include <common/macros.h>          // for NOTREACHED, DCHECK_EQ
+#include <common/value.h>           // for Value, Value::Type, etc
 
 #include "core/connection_types.h"  // for connectionTypes::LMDB
 #include "core/db_traits.h"
@@ -37,7 +38,18 @@ namespace core {
 namespace {
 
 const std::vector<Field> lmdbCommonFields = {
-    Field(LMDB_FILE_NAME_LABEL, common::Value::TYPE_STRING)};
+    Field(LMDB_FILE_NAME_LABEL, common::Value::TYPE_STRING),
+    Field(LMDB_MAP_SIZE_LABEL, common::Value::TYPE_ULONG_LONG_INTEGER),
+    Field(LMDB_MAP_USED_LABEL, common::Value::TYPE_ULONG_LONG_INTEGER),
+    Field(LMDB_LAST_TXNID_LABEL, common::Value::TYPE_ULONG_LONG_INTEGER),
+    Field(LMDB_MAX_READERS_LABEL, common::Value::TYPE_UINTEGER),
+    Field(LMDB_NUM_READERS_LABEL, common::Value::TYPE_UINTEGER),
+    Field(LMDB_PAGE_SIZE_LABEL, common::Value::TYPE_UINTEGER),
+    Field(LMDB_TREE_DEPTH_LABEL, common::Value::TYPE_UINTEGER),
+    Field(LMDB_BRANCH_PAGES_LABEL, common::Value::TYPE_ULONG_LONG_INTEGER),
+    Field(LMDB_LEAF_PAGES_LABEL, common::Value::TYPE_ULONG_LONG_INTEGER),
+    Field(LMDB_OVERFLOW_PAGES_LABEL, common::Value::TYPE_ULONG_LONG_INTEGER),
+    Field(LMDB_ENTRIES_LABEL, common::Value::TYPE_ULONG_LONG_INTEGER)};
 
 }  // namespace
 
@@ -53,9 +65,21 @@ std::vector<info_field_t> DBTraits<LMDB>::InfoFields() {
 }
 namespace lmdb {
 
-ServerInfo::Stats::Stats() : db_path() {}
-
-ServerInfo::Stats::Stats(const std::string& common_text) {
+ServerInfo::Stats::Stats()
+    : db_path(),
+      map_size(0),
+      map_used(0),
+      last_txnid(0),
+      max_readers(0),
+      num_readers(0),
+      page_size(0),
+      tree_depth(0),
+      branch_pages(0),
+      leaf_pages(0),
+      overflow_pages(0),
+      entries(0) {}
+
+ServerInfo::Stats::Stats(const std::string& common_text) : Stats() {
   size_t pos = 0;
   size_t start = 0;
 
@@ -66,6 +90,61 @@ ServerInfo::Stats::Stats(const std::string& common_text) {
     std::string value = line.substr(delem + 1);
     if (field == LMDB_FILE_NAME_LABEL) {
       db_path = value;
+    } else if (field == LMDB_MAP_SIZE_LABEL) {
+      uint64_t lmap_size;
+      if (common::ConvertFromString(value, &lmap_size)) {
+        map_size = lmap_size;
+      }
+    } else if (field == LMDB_MAP_USED_LABEL) {
+      uint64_t lmap_used;
+      if (common::ConvertFromString(value, &lmap_used)) {
+        map_used = lmap_used;
+      }
+    } else if (field == LMDB_LAST_TXNID_LABEL) {
+      uint64_t llast_txnid;
+      if (common::ConvertFromString(value, &llast_txnid)) {
+        last_txnid = llast_txnid;
+      }
+    } else if (field == LMDB_MAX_READERS_LABEL) {
+      uint32_t lmax_readers;
+      if (common::ConvertFromString(value, &lmax_readers)) {
+        max_readers = lmax_readers;
+      }
+    } else if (field == LMDB_NUM_READERS_LABEL) {
+      uint32_t lnum_readers;
+      if (common::ConvertFromString(value, &lnum_readers)) {
+        num_readers = lnum_readers;
+      }
+    } else if (field == LMDB_PAGE_SIZE_LABEL) {
+      uint32_t lpage_size;
+      if (common::ConvertFromString(value, &lpage_size)) {
+        page_size = lpage_size;
+      }
+    } else if (field == LMDB_TREE_DEPTH_LABEL) {
+      uint32_t ltree_depth;
+      if (common::ConvertFromString(value, &ltree_depth)) {
+        tree_depth = ltree_depth;
+      }
+    } else if (field == LMDB_BRANCH_PAGES_LABEL) {
+      uint64_t lbranch_pages;
+      if (common::ConvertFromString(value, &lbranch_pages)) {
+        branch_pages = lbranch_pages;
+      }
+    } else if (field == LMDB_LEAF_PAGES_LABEL) {
+      uint64_t lleaf_pages;
+      if (common::ConvertFromString(value, &lleaf_pages)) {
+        leaf_pages = lleaf_pages;
+      }
+    } else if (field == LMDB_OVERFLOW_PAGES_LABEL) {
+      uint64_t loverflow_pages;
+      if (common::ConvertFromString(value, &loverflow_pages)) {
+        overflow_pages = loverflow_pages;
+      }
+    } else if (field == LMDB_ENTRIES_LABEL) {
+      uint64_t lentries;
+      if (common::ConvertFromString(value, &lentries)) {
+        entries = lentries;
+      }
     }
     start = pos + 2;
   }
@@ -75,6 +154,28 @@ common::Value* ServerInfo::Stats::ValueByIndex(unsigned char index) const {
   switch (index) {
     case 0:
       return new common::StringValue(db_path);
+    case 1:
+      return common::Value::CreateULongLongIntegerValue(map_size);
+    case 2:
+      return common::Value::CreateULongLongIntegerValue(map_used);
+    case 3:
+      return common::Value::CreateULongLongIntegerValue(last_txnid);
+    case 4:
+      return new common::FundamentalValue(max_readers);
+    case 5:
+      return new common::FundamentalValue(num_readers);
+    case 6:
+      return new common::FundamentalValue(page_size);
+    case 7:
+      return new common::FundamentalValue(tree_depth);
+    case 8:
+      return common::Value::CreateULongLongIntegerValue(branch_pages);
+    case 9:
+      return common::Value::CreateULongLongIntegerValue(leaf_pages);
+    case 10:
+      return common::Value::CreateULongLongIntegerValue(overflow_pages);
+    case 11:
+      return common::Value::CreateULongLongIntegerValue(entries);
     default:
       break;
   }
@@ -100,7 +201,17 @@ common::Value* ServerInfo::ValueByIndexes(unsigned char property, unsigned char
 }
 
 std::ostream& operator<<(std::ostream& out, const ServerInfo::Stats& value) {
-  return out << LMDB_FILE_NAME_LABEL ":" << value.db_path << MARKER;
+  return out << LMDB_FILE_NAME_LABEL ":" << value.db_path << MARKER << LMDB_MAP_SIZE_LABEL ":"
+             << value.map_size << MARKER << LMDB_MAP_USED_LABEL ":" << value.map_used << MARKER
+             << LMDB_LAST_TXNID_LABEL ":" << value.last_txnid << MARKER
+             << LMDB_MAX_READERS_LABEL ":" << value.max_readers << MARKER
+             << LMDB_NUM_READERS_LABEL ":" << value.num_readers << MARKER
+             << LMDB_PAGE_SIZE_LABEL ":" << value.page_size << MARKER
+             << LMDB_TREE_DEPTH_LABEL ":" << value.tree_depth << MARKER
+             << LMDB_BRANCH_PAGES_LABEL ":" << value.branch_pages << MARKER
+             << LMDB_LEAF_PAGES_LABEL ":" << value.leaf_pages << MARKER
+             << LMDB_OVERFLOW_PAGES_LABEL ":" << value.overflow_pages << MARKER
+             << LMDB_ENTRIES_LABEL ":" << value.entries << MARKER;
 }
 
 std::ostream& operator<<(std::ostream& out, const ServerInfo& value) {
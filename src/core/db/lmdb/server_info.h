@@ -18,7 +18,7 @@
 
 #pragma once
 
-#include <stdint.h>  // for uint32_t
+#include <stdint.h>  // for uint32_t, uint64_t
 
 #include <iosfwd>  // for ostream
 #include <string>  // for string, basic_string
@@ -31,6 +31,17 @@
 #define LMDB_STATS_LABEL "# Stats"
 
 #define LMDB_FILE_NAME_LABEL "db_path"
+#define LMDB_MAP_SIZE_LABEL "map_size"
+#define LMDB_MAP_USED_LABEL "map_used"
+#define LMDB_LAST_TXNID_LABEL "last_txnid"
+#define LMDB_MAX_READERS_LABEL "max_readers"
+#define LMDB_NUM_READERS_LABEL "num_readers"
+#define LMDB_PAGE_SIZE_LABEL "page_size"
+#define LMDB_TREE_DEPTH_LABEL "tree_depth"
+#define LMDB_BRANCH_PAGES_LABEL "branch_pages"
+#define LMDB_LEAF_PAGES_LABEL "leaf_pages"
+#define LMDB_OVERFLOW_PAGES_LABEL "overflow_pages"
+#define LMDB_ENTRIES_LABEL "entries"
 
 namespace fastonosql {
 namespace core {
@@ -46,6 +57,19 @@ class ServerInfo : public IServerInfo {
     common::Value* ValueByIndex(unsigned char index) const override;
 
     std::string db_path;
+    // mdb_env_info
+    uint64_t map_size;  // bytes
+    uint64_t map_used;  // bytes
+    uint64_t last_txnid;
+    uint32_t max_readers;
+    uint32_t num_readers;
+    // mdb_stat of selected database
+    uint32_t page_size;
+    uint32_t tree_depth;
+    uint64_t branch_pages;
+    uint64_t leaf_pages;
+    uint64_t overflow_pages;
+    uint64_t entries;
   } stats_;
 
   ServerInfo();
@@ -60,6 +60,10 @@ Config parseOptions(int argc, char** argv) {
       cfg.user = argv[++i];
     } else if (!strcmp(argv[i], "-a") && !lastarg) {
       cfg.password = argv[++i];
+    } else if (!strcmp(argv[i], "-servers") && !lastarg) {
+      cfg.servers = argv[++i];
+    } else if (!strcmp(argv[i], "-ketama")) {
+      cfg.ketama = true;
     } else if (!strcmp(argv[i], "-d") && !lastarg) {
       cfg.delimiter = argv[++i];
     } else if (!strcmp(argv[i], "-ns") && !lastarg) {
@@ -87,7 +91,9 @@ Config parseOptions(int argc, char** argv) {
 Config::Config()
     : RemoteConfig(common::net::HostAndPort::CreateLocalHost(DEFAULT_MEMCACHED_SERVER_PORT)),
       user(),
-      password() {}
+      password(),
+      servers(),
+      ketama(false) {}
 
 }  // namespace memcached
 }  // namespace core
@@ -108,6 +114,15 @@ std::string ConvertToString(const fastonosql::core::memcached::Config& conf) {
     argv.push_back(conf.password);
   }
 
+  if (!conf.servers.empty()) {
+    argv.push_back("-servers");
+    argv.push_back(conf.servers);
+  }
+
+  if (conf.ketama) {
+    argv.push_back("-ketama");
+  }
+
   return fastonosql::core::ConvertToStringConfigArgs(argv);
 }
 
@@ -31,6 +31,8 @@ struct Config : public RemoteConfig {
 
   std::string user;
   std::string password;
+  std::string servers;  // other nodes of pool, libmemcached list "host:port[:weight],..."
+  bool ketama;          // MEMCACHED_BEHAVIOR_KETAMA_WEIGHTED distribution of pool
 };
 
 }  // namespace memcached
@@ -18,10 +18,15 @@
 
 #include "core/db/memcached/db_connection.h"
 
-#include <string.h>  // for strcasecmp
+#include <inttypes.h>  // for PRIu64
+#include <string.h>    // for strcasecmp
 
-#include <memory>  // for __shared_ptr
-#include <string>  // for string, operator<, etc
+#include <algorithm>  // for min
+#include <map>        // for map
+#include <memory>     // for __shared_ptr
+#include <string>     // for string, operator<, etc
+#include <thread>     // for thread
+#include <vector>     // for vector
 
 #include <libmemcached/memcached.h>
 #include <libmemcached/util.h>
@@ -30,6 +35,8 @@
 #include <common/convert2string.h>  // for ConvertFromString
 #include <common/net/types.h>       // for HostAndPort
 #include <common/sprintf.h>         // for MemSPrintf
+#include <common/string_util.h>     // for FullEqualsASCII
+#include <common/time.h>            // for current_mstime
 #include <common/utils.h>           // for c_strornull
 #include <common/value.h>           // for Value::ErrorsType::E_ERROR, etc
 
@@ -42,117 +49,95 @@
 
 namespace {
 
-struct KeysHolder {
-  KeysHolder(const std::string& key_start,
-             const std::string& key_end,
-             uint64_t limit,
-             std::vector<std::string>* r)
-      : key_start(key_start), key_end(key_end), limit(limit), r(r) {}
+struct IndexHolder {
+  IndexHolder() : keys() {}
 
-  const std::string key_start;
-  const std::string key_end;
-  const uint64_t limit;
-  std::vector<std::string>* r;
+  fastonosql::core::memcached::KeyIndex::keys_t keys;
 
   memcached_return_t addKey(const char* key, size_t key_length, time_t exp) {
-    UNUSED(exp);
-    if (r->size() < limit) {
-      std::string received_key(key, key_length);
-      if (key_start < received_key && key_end > received_key) {
-        r->push_back(received_key);
-        return MEMCACHED_SUCCESS;
-      }
-
-      return MEMCACHED_SUCCESS;
-    }
-
-    return MEMCACHED_END;
+    keys[std::string(key, key_length)] = exp;
+    return MEMCACHED_SUCCESS;
   }
 };
 
-memcached_return_t memcached_dump_keys_callback(const memcached_st* ptr,
-                                                const char* key,
-                                                size_t key_length,
-                                                time_t exp,
-                                                void* context) {
+memcached_return_t memcached_dump_index_callback(const memcached_st* ptr,
+                                                 const char* key,
+                                                 size_t key_length,
+                                                 time_t exp,
+                                                 void* context) {
   UNUSED(ptr);
 
-  KeysHolder* holder = static_cast<KeysHolder*>(context);
+  IndexHolder* holder = static_cast<IndexHolder*>(context);
   return holder->addKey(key, key_length, exp);
 }
 
-struct ScanHolder {
-  ScanHolder(uint64_t cursor_in, const std::string& pattern, uint64_t limit)
-      : cursor_in(cursor_in),
-        pattern(pattern),
-        limit(limit),
-        r(),
-        cursor_out(0),
-        offset_pos(cursor_in) {}
-
-  const uint64_t cursor_in;
-  const std::string pattern;
-  const uint64_t limit;
-  std::vector<std::string> r;
-  uint64_t cursor_out;
-  uint64_t offset_pos;
-
-  memcached_return_t addKey(const char* key, size_t key_length, time_t exp) {
-    UNUSED(exp);
-    if (r.size() < limit) {
-      std::string received_key(key, key_length);
-      if (common::MatchPattern(received_key, pattern)) {
-        if (offset_pos == 0) {
-          r.push_back(received_key);
-        } else {
-          offset_pos--;
-        }
-      }
-      return MEMCACHED_SUCCESS;
-    } else {
-      cursor_out = cursor_in + limit;
-    }
-
-    return MEMCACHED_END;
+// lru crawler streams all keys, stats cachedump of older servers
+// is limited per slab class
+memcached_return_t memcached_dump_index(memcached_st* memc,
+                                        fastonosql::core::memcached::KeyIndex::keys_t* keys) {
+  IndexHolder hld;
+  memcached_dump_fn func[1] = {0};
+  func[0] = memcached_dump_index_callback;
+  memcached_return_t result = memcached_metadump(memc, func, &hld, SIZEOFMASS(func));
+  if (result == MEMCACHED_NOT_SUPPORTED) {
+    hld.keys.clear();
+    result = memcached_dump(memc, func, &hld, SIZEOFMASS(func));
   }
-};
-
-memcached_return_t memcached_dump_scan_callback(const memcached_st* ptr,
-                                                const char* key,
-                                                size_t key_length,
-                                                time_t exp,
-                                                void* context) {
-  UNUSED(ptr);
 
-  ScanHolder* holder = static_cast<ScanHolder*>(context);
-  return holder->addKey(key, key_length, exp);
+  if (result == MEMCACHED_SUCCESS) {
+    keys->swap(hld.keys);
+  }
+  return result;
 }
 
-struct TTLHolder {
-  TTLHolder(const std::string& key, time_t* exp) : looked_key(key), exp_out(exp) {}
-  memcached_return_t CheckKey(const char* key, size_t key_length, time_t exp) {
-    std::string received_key(key, key_length);
-    if (received_key == looked_key) {
-      *exp_out = exp;
-      return MEMCACHED_END;
-    }
+// writes are sent without waiting for replies and buffered on client
+// till Sync, so bulk writes cost one round trip instead of one per key
+class NoReplyWrites {
+ public:
+  explicit NoReplyWrites(memcached_st* memc)
+      : memc_(memc),
+        noreply_(memcached_behavior_get(memc, MEMCACHED_BEHAVIOR_NOREPLY)),
+        buffered_(memcached_behavior_get(memc, MEMCACHED_BEHAVIOR_BUFFER_REQUESTS)) {
+    memcached_behavior_set(memc_, MEMCACHED_BEHAVIOR_NOREPLY, 1);
+    memcached_behavior_set(memc_, MEMCACHED_BEHAVIOR_BUFFER_REQUESTS, 1);
+  }
+  ~NoReplyWrites() {
+    memcached_behavior_set(memc_, MEMCACHED_BEHAVIOR_BUFFER_REQUESTS, buffered_);
+    memcached_behavior_set(memc_, MEMCACHED_BEHAVIOR_NOREPLY, noreply_);
+  }
 
-    return MEMCACHED_SUCCESS;
+  static bool IsSent(memcached_return_t rc) {
+    return rc == MEMCACHED_SUCCESS || rc == MEMCACHED_BUFFERED;
   }
 
-  const std::string looked_key;
-  time_t* exp_out;
+  // version of every server is answered after all previous requests were processed,
+  // errors are the only replies of noreply writes
+  memcached_return_t Sync(uint64_t* failures) { return memcached_sync(memc_, failures); }
+
+ private:
+  memcached_st* const memc_;
+  const uint64_t noreply_;
+  const uint64_t buffered_;
 };
 
-memcached_return_t memcached_dump_ttl_callback(const memcached_st* ptr,
-                                               const char* key,
-                                               size_t key_length,
-                                               time_t exp,
-                                               void* context) {
-  UNUSED(ptr);
+// replies of synced writes, rejected ones are reported at line of sync
+void addRejectedWrites(uint64_t line,
+                       uint64_t synced,
+                       uint64_t failures,
+                       fastonosql::core::ImportStats* stats) {
+  stats->replies += synced - std::min(synced, failures);
+  for (uint64_t i = 0; i < failures; ++i) {
+    stats->AddError(line, "Write rejected by server");
+  }
+}
+
+// relative expiration of memcached is up to 30 days, greater values are unix time
+time_t memcached_absolute_expiration(time_t expiration) {
+  if (expiration <= 0 || expiration > 60 * 60 * 24 * 30) {
+    return expiration;
+  }
 
-  TTLHolder* holder = static_cast<TTLHolder*>(context);
-  return holder->CheckKey(key, key_length, exp);
+  return time(NULL) + expiration;
 }
 
 }  // namespace
@@ -254,6 +239,36 @@ common::Error CreateConnection(const Config& config, NativeConnection** context)
         common::ErrorValue::E_ERROR);
   }
 
+  if (!config.servers.empty()) {
+    memcached_server_st* servers = memcached_servers_parse(config.servers.c_str());
+    if (!servers) {
+      memcached_free(memc);
+      return common::make_error_value(
+          common::MemSPrintf("Couldn't parse server list: %s", config.servers),
+          common::ErrorValue::E_ERROR);
+    }
+
+    rc = memcached_server_push(memc, servers);
+    memcached_server_list_free(servers);
+    if (rc != MEMCACHED_SUCCESS) {
+      memcached_free(memc);
+      return common::make_error_value(
+          common::MemSPrintf("Couldn't add servers: %s", memcached_strerror(memc, rc)),
+          common::ErrorValue::E_ERROR);
+    }
+  }
+
+  if (config.ketama) {
+    // keys are routed the same way as by ketama clients of pool
+    rc = memcached_behavior_set(memc, MEMCACHED_BEHAVIOR_KETAMA_WEIGHTED, 1);
+    if (rc != MEMCACHED_SUCCESS) {
+      memcached_free(memc);
+      return common::make_error_value(
+          common::MemSPrintf("Couldn't set ketama distribution: %s", memcached_strerror(memc, rc)),
+          common::ErrorValue::E_ERROR);
+    }
+  }
+
   memcached_return_t error = memcached_version(memc);
   if (error != MEMCACHED_SUCCESS) {
     memcached_free(memc);
@@ -292,8 +307,197 @@ common::Error TestConnection(const Config& config) {
   return common::Error();
 }
 
+namespace {
+
+std::vector<common::net::HostAndPort> PoolNodes(memcached_st* memc) {
+  std::vector<common::net::HostAndPort> nodes;
+  const uint32_t count = memcached_server_count(memc);
+  for (uint32_t i = 0; i < count; ++i) {
+    const memcached_instance_st* instance = memcached_server_instance_by_position(memc, i);
+    nodes.push_back(
+        common::net::HostAndPort(memcached_server_name(instance), memcached_server_port(instance)));
+  }
+  return nodes;
+}
+
+// nodes of pool are dumped concurrently, each by own connection
+memcached_return_t DumpPoolIndex(const Config& config,
+                                 memcached_st* memc,
+                                 KeyIndex::keys_t* keys) {
+  const std::vector<common::net::HostAndPort> nodes = PoolNodes(memc);
+  if (nodes.size() <= 1) {
+    return memcached_dump_index(memc, keys);
+  }
+
+  std::vector<KeyIndex::keys_t> nodes_keys(nodes.size());
+  std::vector<memcached_return_t> results(nodes.size(), MEMCACHED_SUCCESS);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    threads.push_back(std::thread([&config, &nodes, &nodes_keys, &results, i]() {
+      Config node_config = config;
+      node_config.host = nodes[i];
+      node_config.servers.clear();
+      NativeConnection* node = nullptr;
+      common::Error err = CreateConnection(node_config, &node);
+      if (err && err->IsError()) {
+        results[i] = MEMCACHED_CONNECTION_FAILURE;
+        return;
+      }
+
+      results[i] = memcached_dump_index(node, &nodes_keys[i]);
+      memcached_free(node);
+    }));
+  }
+  for (size_t i = 0; i < threads.size(); ++i) {
+    threads[i].join();
+  }
+
+  KeyIndex::keys_t lkeys;
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    if (results[i] != MEMCACHED_SUCCESS) {
+      return results[i];
+    }
+
+    lkeys.insert(nodes_keys[i].begin(), nodes_keys[i].end());
+  }
+
+  keys->swap(lkeys);
+  return MEMCACHED_SUCCESS;
+}
+
+ServerInfo::Stats MakeStats(const memcached_stat_st& st) {
+  ServerInfo::Stats stats;
+  stats.pid = st.pid;
+  stats.uptime = st.uptime;
+  stats.time = st.time;
+  stats.version = st.version;
+  stats.pointer_size = st.pointer_size;
+  stats.rusage_user = st.rusage_user_seconds;
+  stats.rusage_system = st.rusage_system_seconds;
+  stats.curr_items = st.curr_items;
+  stats.total_items = st.total_items;
+  stats.bytes = st.bytes;
+  stats.curr_connections = st.curr_connections;
+  stats.total_connections = st.total_connections;
+  stats.connection_structures = st.connection_structures;
+  stats.cmd_get = st.cmd_get;
+  stats.cmd_set = st.cmd_set;
+  stats.get_hits = st.get_hits;
+  stats.get_misses = st.get_misses;
+  stats.evictions = st.evictions;
+  stats.bytes_read = st.bytes_read;
+  stats.bytes_written = st.bytes_written;
+  stats.limit_maxbytes = st.limit_maxbytes;
+  stats.threads = st.threads;
+  return stats;
+}
+
+void AddStats(const ServerInfo::Stats& node, ServerInfo::Stats* total) {
+  total->rusage_user += node.rusage_user;
+  total->rusage_system += node.rusage_system;
+  total->curr_items += node.curr_items;
+  total->total_items += node.total_items;
+  total->bytes += node.bytes;
+  total->curr_connections += node.curr_connections;
+  total->total_connections += node.total_connections;
+  total->connection_structures += node.connection_structures;
+  total->cmd_get += node.cmd_get;
+  total->cmd_set += node.cmd_set;
+  total->get_hits += node.get_hits;
+  total->get_misses += node.get_misses;
+  total->evictions += node.evictions;
+  total->bytes_read += node.bytes_read;
+  total->bytes_written += node.bytes_written;
+  total->limit_maxbytes += node.limit_maxbytes;
+  total->threads += node.threads;
+}
+
+std::string MakeNodeSummary(const std::string& node, const ServerInfo::Stats& stats) {
+  const uint64_t gets = static_cast<uint64_t>(stats.get_hits) + stats.get_misses;
+  const double hit_ratio = gets ? stats.get_hits * 100.0 / gets : 0.0;
+  return common::MemSPrintf("%s hit ratio %.2f%%, evictions %u, bytes %u of %u", node, hit_ratio,
+                            stats.evictions, stats.bytes, stats.limit_maxbytes);
+}
+
+}  // namespace
+
 DBConnection::DBConnection(CDBConnectionClient* client)
-    : base_class(client, new CommandTranslator(base_class::Commands())), current_info_() {}
+    : base_class(client, new CommandTranslator(base_class::Commands())),
+      current_info_(),
+      key_index_(),
+      refresh_thread_(),
+      refreshing_(false),
+      meta_unsupported_(false) {}
+
+DBConnection::~DBConnection() {
+  JoinRefreshThread();
+}
+
+void DBConnection::OnDisconnect() {
+  JoinRefreshThread();
+  key_index_.Clear();
+  meta_unsupported_ = false;
+}
+
+common::Error DBConnection::RefreshKeyIndex(bool async) {
+  if (!IsConnected()) {
+    return common::make_error_value("Not connected", common::Value::E_ERROR);
+  }
+
+  JoinRefreshThread();
+  if (!async) {
+    KeyIndex::keys_t keys;
+    memcached_return_t result = DumpPoolIndex(connection_.config_, connection_.handle_, &keys);
+    if (result != MEMCACHED_SUCCESS) {
+      std::string buff = common::MemSPrintf("Dump keys error: %s",
+                                            memcached_strerror(connection_.handle_, result));
+      return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+    }
+
+    key_index_.Reset(&keys, common::time::current_mstime());
+    return common::Error();
+  }
+
+  // handle isn't thread safe, clone has same servers and auth
+  memcached_st* clone = memcached_clone(NULL, connection_.handle_);
+  if (!clone) {
+    return common::make_error_value("Clone connection error", common::ErrorValue::E_ERROR);
+  }
+
+  refreshing_ = true;
+  key_index_.BeginRefresh();
+  const Config config = connection_.config_;
+  refresh_thread_ = std::thread([this, config, clone]() {
+    KeyIndex::keys_t keys;
+    if (DumpPoolIndex(config, clone, &keys) == MEMCACHED_SUCCESS) {
+      key_index_.Reset(&keys, common::time::current_mstime());
+    } else {
+      key_index_.CancelRefresh();
+    }
+    memcached_free(clone);
+    refreshing_ = false;
+  });
+  return common::Error();
+}
+
+common::Error DBConnection::EnsureKeyIndex(bool new_scan) {
+  if (!key_index_.IsBuilt()) {
+    return RefreshKeyIndex(false);
+  }
+
+  // new scans are served from current index while fresh one is dumped
+  if (new_scan && !refreshing_ && key_index_.IsStale(common::time::current_mstime())) {
+    return RefreshKeyIndex(true);
+  }
+
+  return common::Error();
+}
+
+void DBConnection::JoinRefreshThread() {
+  if (refresh_thread_.joinable()) {
+    refresh_thread_.join();
+  }
+}
 
 common::Error DBConnection::Info(const char* args, ServerInfo::Stats* statsout) {
   if (!statsout) {
@@ -305,41 +509,95 @@ common::Error DBConnection::Info(const char* args, ServerInfo::Stats* statsout)
     return common::make_error_value("Not connected", common::Value::E_ERROR);
   }
 
-  memcached_return_t error;
-  memcached_stat_st* st = memcached_stat(connection_.handle_, const_cast<char*>(args), &error);
-  if (error != MEMCACHED_SUCCESS) {
-    std::string buff = common::MemSPrintf("Stats function error: %s",
-                                          memcached_strerror(connection_.handle_, error));
-    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+  const std::vector<common::net::HostAndPort> nodes = PoolNodes(connection_.handle_);
+  std::vector<memcached_stat_st> stats(nodes.size());
+  std::vector<memcached_return_t> results(nodes.size(), MEMCACHED_SUCCESS);
+  if (nodes.size() > 1 && connection_.config_.user.empty()) {
+    // every node of pool is asked concurrently by own connection
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < nodes.size(); ++i) {
+      threads.push_back(std::thread([&nodes, &stats, &results, args, i]() {
+        results[i] = memcached_stat_servername(&stats[i], const_cast<char*>(args),
+                                               nodes[i].host.c_str(), nodes[i].port);
+      }));
+    }
+    for (size_t i = 0; i < threads.size(); ++i) {
+      threads[i].join();
+    }
+  } else {
+    // stats servername can't authenticate, so SASL pools are asked one by one
+    memcached_return_t error;
+    memcached_stat_st* st = memcached_stat(connection_.handle_, const_cast<char*>(args), &error);
+    if (error != MEMCACHED_SUCCESS) {
+      std::string buff = common::MemSPrintf("Stats function error: %s",
+                                            memcached_strerror(connection_.handle_, error));
+      return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+    }
+
+    for (size_t i = 0; i < stats.size(); ++i) {
+      stats[i] = st[i];
+    }
+    memcached_stat_free(NULL, st);
   }
 
+  // counters are summed over nodes, common fields are taken from first answered node
   ServerInfo::Stats lstatsout;
-  lstatsout.pid = st->pid;
-  lstatsout.uptime = st->uptime;
-  lstatsout.time = st->time;
-  lstatsout.version = st->version;
-  lstatsout.pointer_size = st->pointer_size;
-  lstatsout.rusage_user = st->rusage_user_seconds;
-  lstatsout.rusage_system = st->rusage_system_seconds;
-  lstatsout.curr_items = st->curr_items;
-  lstatsout.total_items = st->total_items;
-  lstatsout.bytes = st->bytes;
-  lstatsout.curr_connections = st->curr_connections;
-  lstatsout.total_connections = st->total_connections;
-  lstatsout.connection_structures = st->connection_structures;
-  lstatsout.cmd_get = st->cmd_get;
-  lstatsout.cmd_set = st->cmd_set;
-  lstatsout.get_hits = st->get_hits;
-  lstatsout.get_misses = st->get_misses;
-  lstatsout.evictions = st->evictions;
-  lstatsout.bytes_read = st->bytes_read;
-  lstatsout.bytes_written = st->bytes_written;
-  lstatsout.limit_maxbytes = st->limit_maxbytes;
-  lstatsout.threads = st->threads;
+  bool answered = false;
+  std::string nodes_str;
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    if (i != 0) {
+      nodes_str += MEMCACHED_NODES_SEPARATOR;
+    }
+
+    const std::string node_str = common::ConvertToString(nodes[i]);
+    if (results[i] != MEMCACHED_SUCCESS) {
+      nodes_str += common::MemSPrintf("%s error: %s", node_str, memcached_strerror(NULL, results[i]));
+      continue;
+    }
+
+    ServerInfo::Stats node_stats = MakeStats(stats[i]);
+    nodes_str += MakeNodeSummary(node_str, node_stats);
+    if (!answered) {
+      lstatsout = node_stats;
+      answered = true;
+    } else {
+      AddStats(node_stats, &lstatsout);
+    }
+  }
+
+  if (!answered) {
+    std::string buff = common::MemSPrintf("Stats function error: %s", nodes_str);
+    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+  }
 
+  if (nodes.size() > 1) {
+    lstatsout.nodes = nodes_str;
+  }
   *statsout = lstatsout;
   current_info_ = lstatsout;
-  memcached_stat_free(NULL, st);
+  return common::Error();
+}
+
+common::Error DBConnection::KeyNode(const std::string& key, common::net::HostAndPort* node) {
+  if (!node) {
+    DNOTREACHED();
+    return common::make_error_value("Invalid input argument(s)", common::ErrorValue::E_ERROR);
+  }
+
+  if (!IsConnected()) {
+    return common::make_error_value("Not connected", common::Value::E_ERROR);
+  }
+
+  memcached_return_t error;
+  const memcached_instance_st* instance =
+      memcached_server_by_key(connection_.handle_, key.c_str(), key.length(), &error);
+  if (!instance) {
+    std::string buff = common::MemSPrintf("Node function error: %s",
+                                          memcached_strerror(connection_.handle_, error));
+    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+  }
+
+  *node = common::net::HostAndPort(memcached_server_name(instance), memcached_server_port(instance));
   return common::Error();
 }
 
@@ -360,6 +618,8 @@ common::Error DBConnection::AddIfNotExist(const NKey& key,
     return common::make_error_value(buff, common::ErrorValue::E_ERROR);
   }
 
+  key_index_.Add(key_str, memcached_absolute_expiration(expiration));
+
   if (client_) {
     client_->OnKeyAdded(NDbKValue(key, NValue(common::Value::CreateStringValue(value))));
   }
@@ -545,6 +805,10 @@ common::Error DBConnection::GetInner(const std::string& key, std::string* ret_va
 
   char* value =
       memcached_get(connection_.handle_, key.c_str(), key.length(), &value_length, &flags, &error);
+  if (error == MEMCACHED_NOTFOUND) {
+    return MakeKeyNotFoundError(key);
+  }
+
   if (error != MEMCACHED_SUCCESS) {
     std::string buff = common::MemSPrintf("Get function error: %s",
                                           memcached_strerror(connection_.handle_, error));
@@ -586,24 +850,51 @@ common::Error DBConnection::ExpireInner(const std::string& key, ttl_t expiration
 }
 
 common::Error DBConnection::TTL(const std::string& key, ttl_t* expiration) {
+  if (!expiration) {
+    DNOTREACHED();
+    return common::make_error_value("Invalid input argument(s)", common::ErrorValue::E_ERROR);
+  }
+
   if (!IsConnected()) {
     return common::make_error_value("Not connected", common::Value::E_ERROR);
   }
 
-  time_t exp;
-  TTLHolder hld(key, &exp);
-  memcached_dump_fn func[1] = {0};
-  func[0] = memcached_dump_ttl_callback;
-  memcached_return_t result = memcached_dump(connection_.handle_, func, &hld, SIZEOFMASS(func));
-  if (result != MEMCACHED_SUCCESS) {
-    std::string buff = common::MemSPrintf("TTL function error: %s",
-                                          memcached_strerror(connection_.handle_, result));
-    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+  if (!meta_unsupported_) {
+    int64_t lttl = 0;
+    memcached_return_t result =
+        memcached_meta_ttl(connection_.handle_, key.c_str(), key.length(), &lttl);
+    if (result == MEMCACHED_SUCCESS) {
+      *expiration = lttl < 0 ? NO_TTL : lttl;
+      return common::Error();
+    } else if (result == MEMCACHED_NOTFOUND) {
+      *expiration = EXPIRED_TTL;
+      return common::Error();
+    } else if (result != MEMCACHED_NOT_SUPPORTED) {
+      std::string buff = common::MemSPrintf("TTL function error: %s",
+                                            memcached_strerror(connection_.handle_, result));
+      return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+    }
+
+    meta_unsupported_ = true;
+  }
+
+  // servers without meta commands, expiration from key index
+  common::Error err = EnsureKeyIndex(false);
+  if (err && err->IsError()) {
+    return err;
+  }
+
+  time_t exp = 0;
+  if (!key_index_.FindExpiration(key, &exp)) {
+    *expiration = EXPIRED_TTL;
+    return common::Error();
   }
 
   time_t cur_t = time(NULL);
   time_t server_t = current_info_.time;
-  if (cur_t > exp) {
+  if (exp == 0) {
+    *expiration = NO_TTL;
+  } else if (cur_t > exp) {
     if (server_t > exp) {
       *expiration = NO_TTL;
     } else {
@@ -635,18 +926,12 @@ common::Error DBConnection::ScanImpl(uint64_t cursor_in,
                                      uint64_t count_keys,
                                      std::vector<std::string>* keys_out,
                                      uint64_t* cursor_out) {
-  ScanHolder hld(cursor_in, pattern, count_keys);
-  memcached_dump_fn func[1] = {0};
-  func[0] = memcached_dump_scan_callback;
-  memcached_return_t result = memcached_dump(connection_.handle_, func, &hld, SIZEOFMASS(func));
-  if (result != MEMCACHED_SUCCESS) {
-    std::string buff = common::MemSPrintf("SCAN function error: %s",
-                                          memcached_strerror(connection_.handle_, result));
-    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+  common::Error err = EnsureKeyIndex(cursor_in == 0);
+  if (err && err->IsError()) {
+    return err;
   }
 
-  *keys_out = hld.r;
-  *cursor_out = hld.cursor_out;
+  key_index_.Scan(cursor_in, pattern, count_keys, keys_out, cursor_out);
   return common::Error();
 }
 
@@ -654,29 +939,24 @@ common::Error DBConnection::KeysImpl(const std::string& key_start,
                                      const std::string& key_end,
                                      uint64_t limit,
                                      std::vector<std::string>* ret) {
-  KeysHolder hld(key_start, key_end, limit, ret);
-  memcached_dump_fn func[1] = {0};
-  func[0] = memcached_dump_keys_callback;
-  memcached_return_t result = memcached_dump(connection_.handle_, func, &hld, SIZEOFMASS(func));
-  if (result != MEMCACHED_SUCCESS) {
-    std::string buff = common::MemSPrintf("KEYS function error: %s",
-                                          memcached_strerror(connection_.handle_, result));
-    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+  common::Error err = EnsureKeyIndex(true);
+  if (err && err->IsError()) {
+    return err;
   }
 
+  key_index_.Keys(key_start, key_end, limit, ret);
   return common::Error();
 }
 
 common::Error DBConnection::DBkcountImpl(size_t* size) {
-  std::vector<std::string> ret;
-  common::Error err = Keys("a", "z", UINT64_MAX, &ret);
+  common::Error err = EnsureKeyIndex(false);
   if (err && err->IsError()) {
     std::string buff =
         common::MemSPrintf("Couldn't determine DBKCOUNT error: %s", err->Description());
     return common::make_error_value(buff, common::ErrorValue::E_ERROR);
   }
 
-  *size = ret.size();
+  *size = key_index_.Size();
   return common::Error();
 }
 
@@ -688,6 +968,9 @@ common::Error DBConnection::FlushDBImpl() {
     return common::make_error_value(buff, common::ErrorValue::E_ERROR);
   }
 
+  JoinRefreshThread();
+  KeyIndex::keys_t keys;
+  key_index_.Reset(&keys, common::time::current_mstime());
   return common::Error();
 }
 
@@ -703,7 +986,141 @@ common::Error DBConnection::SelectImpl(const std::string& name, IDataBaseInfo**
   return common::Error();
 }
 
+common::Error DBConnection::BulkImport(ImportReader* reader,
+                                       ImportStats* stats,
+                                       import_progress_callback_t progress_cb) {
+  if (!reader || !stats) {
+    DNOTREACHED();
+    return common::make_error_value("Invalid input argument(s)", common::ErrorValue::E_ERROR);
+  }
+
+  if (!IsConnected()) {
+    return common::make_error_value("Not connected", common::Value::E_ERROR);
+  }
+
+  NoReplyWrites writes(connection_.handle_);
+  uint64_t unsynced = 0;
+  bool eof = false;
+  while (true) {
+    if (IsInterrupted()) {
+      return common::make_error_value("Interrupted.", common::ErrorValue::E_INTERRUPTED);
+    }
+
+    ImportRecord record;
+    common::Error err = reader->Next(&record, &eof);
+    if (err && err->IsError()) {
+      if (eof) {
+        return err;
+      }
+
+      stats->AddError(record.line, err->Description());
+      continue;
+    }
+
+    if (eof) {
+      break;
+    }
+
+    std::string key_str;
+    std::string value_str;
+    time_t expiration = 0;
+    if (record.IsCommand()) {
+      if (record.command.size() != 3 ||
+          !common::FullEqualsASCII(record.command[0], "SET", false)) {
+        stats->AddError(record.line, "Only SET key value commands can be imported");
+        continue;
+      }
+
+      key_str = record.command[1];
+      value_str = record.command[2];
+    } else {
+      key_str = record.key.Key();
+      value_str = record.value;
+      ttl_t ttl = record.key.TTL();
+      if (ttl > 0) {
+        expiration = ttl;
+      }
+    }
+
+    memcached_return_t rc =
+        memcached_set(connection_.handle_, key_str.c_str(), key_str.length(), value_str.c_str(),
+                      value_str.length(), expiration, 0);
+    if (!NoReplyWrites::IsSent(rc)) {
+      stats->AddError(record.line, memcached_strerror(connection_.handle_, rc));
+      continue;
+    }
+
+    key_index_.Add(key_str, memcached_absolute_expiration(expiration));
+    stats->sent++;
+    if (++unsynced < MEMCACHED_IMPORT_SYNC_COMMANDS) {
+      continue;
+    }
+
+    uint64_t failures = 0;
+    rc = writes.Sync(&failures);
+    if (rc != MEMCACHED_SUCCESS) {
+      std::string buff = common::MemSPrintf("Import function error: %s",
+                                            memcached_strerror(connection_.handle_, rc));
+      return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+    }
+    addRejectedWrites(reader->CurrentLine(), unsynced, failures, stats);
+    unsynced = 0;
+    if (progress_cb) {
+      progress_cb(*stats);
+    }
+  }
+
+  uint64_t failures = 0;
+  memcached_return_t rc = writes.Sync(&failures);
+  if (rc != MEMCACHED_SUCCESS) {
+    std::string buff = common::MemSPrintf("Import function error: %s",
+                                          memcached_strerror(connection_.handle_, rc));
+    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+  }
+  addRejectedWrites(reader->CurrentLine(), unsynced, failures, stats);
+  if (progress_cb) {
+    progress_cb(*stats);
+  }
+  return common::Error();
+}
+
 common::Error DBConnection::DeleteImpl(const NKeys& keys, NKeys* deleted_keys) {
+  if (keys.size() > 1) {
+    // missing keys aren't known without replies, so all keys are reported
+    NoReplyWrites writes(connection_.handle_);
+    for (size_t i = 0; i < keys.size(); ++i) {
+      std::string key_str = keys[i].Key();
+      memcached_return_t rc =
+          memcached_delete(connection_.handle_, key_str.c_str(), key_str.length(), 0);
+      if (!NoReplyWrites::IsSent(rc)) {
+        std::string buff = common::MemSPrintf("Delete function error: %s",
+                                              memcached_strerror(connection_.handle_, rc));
+        return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+      }
+    }
+
+    uint64_t failures = 0;
+    memcached_return_t rc = writes.Sync(&failures);
+    if (rc != MEMCACHED_SUCCESS) {
+      std::string buff = common::MemSPrintf("Delete function error: %s",
+                                            memcached_strerror(connection_.handle_, rc));
+      return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+    }
+
+    if (failures != 0) {
+      std::string buff = common::MemSPrintf("Delete function error: %" PRIu64 " of %" PRIu64
+                                            " keys weren't deleted",
+                                            failures, static_cast<uint64_t>(keys.size()));
+      return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+    }
+
+    for (size_t i = 0; i < keys.size(); ++i) {
+      key_index_.Remove(keys[i].Key());
+    }
+    deleted_keys->insert(deleted_keys->end(), keys.begin(), keys.end());
+    return common::Error();
+  }
+
   for (size_t i = 0; i < keys.size(); ++i) {
     NKey key = keys[i];
     std::string key_str = key.Key();
@@ -712,6 +1129,7 @@ common::Error DBConnection::DeleteImpl(const NKeys& keys, NKeys* deleted_keys) {
       continue;
     }
 
+    key_index_.Remove(key_str);
     deleted_keys->push_back(key);
   }
 
@@ -731,6 +1149,97 @@ common::Error DBConnection::GetImpl(const NKey& key, NDbKValue* loaded_key) {
   return common::Error();
 }
 
+common::Error DBConnection::GetBatchImpl(const NKeys& keys, NDbKValues* loaded_keys) {
+  // one multi key get per chunk, missing keys aren't answered
+  for (size_t pos = 0; pos < keys.size(); pos += MEMCACHED_MGET_MAX_KEYS) {
+    const size_t count = std::min<size_t>(MEMCACHED_MGET_MAX_KEYS, keys.size() - pos);
+    std::vector<std::string> keys_str;
+    std::vector<const char*> keys_ptr;
+    std::vector<size_t> keys_len;
+    for (size_t i = 0; i < count; ++i) {
+      keys_str.push_back(keys[pos + i].Key());
+    }
+    for (size_t i = 0; i < count; ++i) {
+      keys_ptr.push_back(keys_str[i].c_str());
+      keys_len.push_back(keys_str[i].length());
+    }
+
+    memcached_return_t rc =
+        memcached_mget(connection_.handle_, keys_ptr.data(), keys_len.data(), count);
+    if (rc != MEMCACHED_SUCCESS) {
+      std::string buff = common::MemSPrintf("Mget function error: %s",
+                                            memcached_strerror(connection_.handle_, rc));
+      return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+    }
+
+    std::map<std::string, std::string> values;
+    memcached_result_st* result = nullptr;
+    while ((result = memcached_fetch_result(connection_.handle_, result, &rc))) {
+      std::string key_str(memcached_result_key_value(result), memcached_result_key_length(result));
+      values[key_str] = std::string(memcached_result_value(result), memcached_result_length(result));
+    }
+    memcached_result_free(result);
+    if (rc != MEMCACHED_END && rc != MEMCACHED_SUCCESS && rc != MEMCACHED_NOTFOUND) {
+      std::string buff = common::MemSPrintf("Mget function error: %s",
+                                            memcached_strerror(connection_.handle_, rc));
+      return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+    }
+
+    // loaded keys keep order of requested keys
+    for (size_t i = 0; i < count; ++i) {
+      auto it = values.find(keys_str[i]);
+      if (it == values.end()) {
+        continue;
+      }
+
+      NValue val(common::Value::CreateStringValue(it->second));
+      loaded_keys->push_back(NDbKValue(keys[pos + i], val));
+    }
+  }
+
+  return common::Error();
+}
+
+common::Error DBConnection::SetBatchImpl(const NDbKValues& keys, NDbKValues* added_keys) {
+  NoReplyWrites writes(connection_.handle_);
+  std::vector<time_t> expirations;
+  for (size_t i = 0; i < keys.size(); ++i) {
+    std::string key_str = keys[i].KeyString();
+    std::string value_str = keys[i].ValueString();
+    ttl_t ttl = keys[i].Key().TTL();
+    time_t expiration = ttl > 0 ? ttl : 0;
+    expirations.push_back(expiration);
+    memcached_return_t rc = memcached_set(connection_.handle_, key_str.c_str(), key_str.length(),
+                                          value_str.c_str(), value_str.length(), expiration, 0);
+    if (!NoReplyWrites::IsSent(rc)) {
+      std::string buff = common::MemSPrintf("Set function error: %s",
+                                            memcached_strerror(connection_.handle_, rc));
+      return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+    }
+  }
+
+  uint64_t failures = 0;
+  memcached_return_t rc = writes.Sync(&failures);
+  if (rc != MEMCACHED_SUCCESS) {
+    std::string buff = common::MemSPrintf("Set function error: %s",
+                                          memcached_strerror(connection_.handle_, rc));
+    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+  }
+
+  if (failures != 0) {
+    std::string buff = common::MemSPrintf("Set function error: %" PRIu64 " of %" PRIu64
+                                          " keys weren't stored",
+                                          failures, static_cast<uint64_t>(keys.size()));
+    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+  }
+
+  for (size_t i = 0; i < keys.size(); ++i) {
+    key_index_.Add(keys[i].KeyString(), memcached_absolute_expiration(expirations[i]));
+  }
+  added_keys->insert(added_keys->end(), keys.begin(), keys.end());
+  return common::Error();
+}
+
 common::Error DBConnection::SetImpl(const NDbKValue& key, NDbKValue* added_key) {
   std::string key_str = key.KeyString();
   std::string value_str = key.ValueString();
@@ -739,6 +1248,7 @@ common::Error DBConnection::SetImpl(const NDbKValue& key, NDbKValue* added_key)
     return err;
   }
 
+  key_index_.Add(key_str, 0);
   *added_key = key;
   return common::Error();
 }
@@ -756,16 +1266,25 @@ common::Error DBConnection::RenameImpl(const NKey& key, const std::string& new_k
     return err;
   }
 
+  key_index_.Remove(key_str);
   err = SetInner(new_key, value_str, 0, 0);
   if (err && err->IsError()) {
     return err;
   }
 
+  key_index_.Add(new_key, 0);
   return common::Error();
 }
 
 common::Error DBConnection::SetTTLImpl(const NKey& key, ttl_t ttl) {
-  return ExpireInner(key.Key(), ttl);
+  std::string key_str = key.Key();
+  common::Error err = ExpireInner(key_str, ttl);
+  if (err && err->IsError()) {
+    return err;
+  }
+
+  key_index_.Add(key_str, memcached_absolute_expiration(ttl));
+  return common::Error();
 }
 
 common::Error DBConnection::GetTTLImpl(const NKey& key, ttl_t* ttl) {
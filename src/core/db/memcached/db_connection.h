@@ -20,17 +20,24 @@
 
 #include <stdint.h>  // for uint32_t, uint64_t
 #include <time.h>    // for time_t
-#include <string>    // for string
 
-#include <common/error.h>   // for Error
-#include <common/macros.h>  // for WARN_UNUSED_RESULT
+#include <atomic>      // for atomic
+#include <functional>  // for function
+#include <string>      // for string
+#include <thread>      // for thread
+
+#include <common/error.h>      // for Error
+#include <common/macros.h>     // for WARN_UNUSED_RESULT
+#include <common/net/types.h>  // for HostAndPort
 
 #include "core/command_info.h"             // for UNDEFINED_EXAMPLE_STR, UNDEF...
 #include "core/connection_types.h"         // for connectionTypes::MEMCACHED
 #include "core/db_key.h"                   // for NDbKValue, NKey, NKeys
+#include "core/import_reader.h"            // for ImportReader, ImportStats
 #include "core/internal/cdb_connection.h"  // for CDBConnection
 #include "core/db/memcached/server_info.h"
 #include "core/db/memcached/config.h"
+#include "core/db/memcached/key_index.h"
 
 namespace fastonosql {
 namespace core {
@@ -55,6 +62,9 @@ class IDataBaseInfo;
 
 struct memcached_st;  // lines 37-37
 
+#define MEMCACHED_MGET_MAX_KEYS 1000
+#define MEMCACHED_IMPORT_SYNC_COMMANDS 10000
+
 namespace fastonosql {
 namespace core {
 namespace memcached {
@@ -67,9 +77,17 @@ common::Error TestConnection(const Config& config);
 class DBConnection : public core::internal::CDBConnection<NativeConnection, Config, MEMCACHED> {
  public:
   typedef core::internal::CDBConnection<NativeConnection, Config, MEMCACHED> base_class;
+  typedef std::function<void(const ImportStats&)> import_progress_callback_t;
   explicit DBConnection(CDBConnectionClient* client);
+  virtual ~DBConnection();
 
+  // dump keys now or by clone of connection in background thread
+  common::Error RefreshKeyIndex(bool async) WARN_UNUSED_RESULT;
+
+  // stats of pool are summed over nodes, see ServerInfo::Stats::nodes
   common::Error Info(const char* args, ServerInfo::Stats* statsout) WARN_UNUSED_RESULT;
+  // node of pool which holds key by distribution of connection
+  common::Error KeyNode(const std::string& key, common::net::HostAndPort* node) WARN_UNUSED_RESULT;
 
   common::Error AddIfNotExist(const NKey& key,
                               const std::string& value,
@@ -91,6 +109,11 @@ class DBConnection : public core::internal::CDBConnection<NativeConnection, Conf
 
   common::Error TTL(const std::string& key, ttl_t* expiration) WARN_UNUSED_RESULT;
 
+  // sets without replies, server is synced every MEMCACHED_IMPORT_SYNC_COMMANDS records
+  common::Error BulkImport(ImportReader* reader,
+                           ImportStats* stats,
+                           import_progress_callback_t progress_cb) WARN_UNUSED_RESULT;
+
  private:
   common::Error DelInner(const std::string& key, time_t expiration) WARN_UNUSED_RESULT;
   common::Error GetInner(const std::string& key, std::string* ret_val) WARN_UNUSED_RESULT;
@@ -99,6 +122,8 @@ class DBConnection : public core::internal::CDBConnection<NativeConnection, Conf
                          time_t expiration,
                          uint32_t flags) WARN_UNUSED_RESULT;
   common::Error ExpireInner(const std::string& key, ttl_t expiration) WARN_UNUSED_RESULT;
+  common::Error EnsureKeyIndex(bool new_scan) WARN_UNUSED_RESULT;
+  void JoinRefreshThread();
 
   virtual common::Error ScanImpl(uint64_t cursor_in,
                                  const std::string& pattern,
@@ -114,13 +139,21 @@ class DBConnection : public core::internal::CDBConnection<NativeConnection, Conf
   virtual common::Error SelectImpl(const std::string& name, IDataBaseInfo** info) override;
   virtual common::Error DeleteImpl(const NKeys& keys, NKeys* deleted_keys) override;
   virtual common::Error GetImpl(const NKey& key, NDbKValue* loaded_key) override;
+  virtual common::Error GetBatchImpl(const NKeys& keys, NDbKValues* loaded_keys) override;
   virtual common::Error SetImpl(const NDbKValue& key, NDbKValue* added_key) override;
+  virtual common::Error SetBatchImpl(const NDbKValues& keys, NDbKValues* added_keys) override;
   virtual common::Error RenameImpl(const NKey& key, const std::string& new_key) override;
   virtual common::Error SetTTLImpl(const NKey& key, ttl_t ttl) override;
   virtual common::Error GetTTLImpl(const NKey& key, ttl_t* ttl) override;
   virtual common::Error QuitImpl() override;
+  // refresh thread of key index is finished before handle is freed
+  virtual void OnDisconnect() override;
 
   ServerInfo::Stats current_info_;
+  KeyIndex key_index_;
+  std::thread refresh_thread_;
+  std::atomic<bool> refreshing_;
+  bool meta_unsupported_;  // server answered ERROR to mg
 };
 
 }  // namespace memcached
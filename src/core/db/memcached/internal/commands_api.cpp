@@ -40,6 +40,25 @@ common::Error CommandsApi::Version(internal::CommandHandler* handler,
   return mem->VersionServer();
 }
 
+common::Error CommandsApi::Node(internal::CommandHandler* handler,
+                                int argc,
+                                const char** argv,
+                                FastoObject* out) {
+  UNUSED(argc);
+
+  DBConnection* mem = static_cast<DBConnection*>(handler);
+  common::net::HostAndPort node;
+  common::Error err = mem->KeyNode(argv[0], &node);
+  if (err && err->IsError()) {
+    return err;
+  }
+
+  common::StringValue* val = common::Value::CreateStringValue(common::ConvertToString(node));
+  FastoObject* child = new FastoObject(out, val, mem->Delimiter());
+  out->AddChildren(child);
+  return common::Error();
+}
+
 common::Error CommandsApi::Info(internal::CommandHandler* handler,
                                 int argc,
                                 const char** argv,
@@ -36,6 +36,10 @@ struct CommandsApi : public internal::ApiTraits<DBConnection> {
                                int argc,
                                const char** argv,
                                FastoObject* out);
+  static common::Error Node(internal::CommandHandler* handler,
+                            int argc,
+                            const char** argv,
+                            FastoObject* out);
 
   static common::Error Add(internal::CommandHandler* handler,
                            int argc,
@@ -90,6 +94,14 @@ static const internal::ConstantCommandsArray memcachedCommands = {
                   0,
                   0,
                   &CommandsApi::Version),
+    CommandHolder("NODE",
+                  "<key>",
+                  "Return the server of pool which holds key.",
+                  UNDEFINED_SINCE,
+                  UNDEFINED_EXAMPLE_STR,
+                  1,
+                  0,
+                  &CommandsApi::Node),
     CommandHolder("INCR",
                   "<key> <value>",
                   "Increment value associated with key in "
@@ -0,0 +1,175 @@
+/*  Copyright (C) 2014-2016 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "core/db/memcached/key_index.h"
+
+#include <common/string_util.h>  // for MatchPattern
+
+namespace fastonosql {
+namespace core {
+namespace memcached {
+
+KeyIndex::KeyIndex()
+    : mutex_(),
+      keys_(),
+      journaling_(false),
+      journal_(),
+      built_(false),
+      built_msec_(0),
+      scan_cursors_() {}
+
+bool KeyIndex::IsBuilt() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return built_;
+}
+
+bool KeyIndex::IsStale(common::time64_t now_msec) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return !built_ || now_msec - built_msec_ > MEMCACHED_KEY_INDEX_MAX_AGE_MSEC;
+}
+
+void KeyIndex::BeginRefresh() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  journaling_ = true;
+  journal_.clear();
+}
+
+void KeyIndex::CancelRefresh() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  journaling_ = false;
+  journal_.clear();
+}
+
+void KeyIndex::Reset(keys_t* keys, common::time64_t built_msec) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  keys_.swap(*keys);
+  // dump may have missed or still seen keys written while it was running
+  for (auto it = journal_.begin(); it != journal_.end(); ++it) {
+    if (it->second.first) {
+      keys_[it->first] = it->second.second;
+    } else {
+      keys_.erase(it->first);
+    }
+  }
+  journaling_ = false;
+  journal_.clear();
+  built_ = true;
+  built_msec_ = built_msec;
+}
+
+void KeyIndex::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  keys_.clear();
+  journaling_ = false;
+  journal_.clear();
+  built_ = false;
+  built_msec_ = 0;
+  scan_cursors_.Clear();
+}
+
+void KeyIndex::Add(const std::string& key, time_t expiration) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (built_) {
+    keys_[key] = expiration;
+  }
+  if (journaling_) {
+    journal_[key] = std::make_pair(true, expiration);
+  }
+}
+
+void KeyIndex::Remove(const std::string& key) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  keys_.erase(key);
+  if (journaling_) {
+    journal_[key] = std::make_pair(false, time_t(0));
+  }
+}
+
+bool KeyIndex::FindExpiration(const std::string& key, time_t* expiration) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = keys_.find(key);
+  if (it == keys_.end()) {
+    return false;
+  }
+
+  *expiration = it->second;
+  return true;
+}
+
+size_t KeyIndex::Size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return keys_.size();
+}
+
+void KeyIndex::Scan(uint64_t cursor_in,
+                    const std::string& pattern,
+                    uint64_t count_keys,
+                    std::vector<std::string>* keys_out,
+                    uint64_t* cursor_out) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  // only keys with literal prefix of pattern can match it
+  const std::string prefix = internal::GlobPrefix(pattern);
+  const std::string range_end = internal::PrefixEnd(prefix);
+  std::string last_key;
+  uint64_t offset_pos = 0;
+  keys_t::const_iterator it;
+  if (scan_cursors_.Take(cursor_in, pattern, &last_key)) {
+    it = keys_.upper_bound(last_key);
+  } else {
+    // new or forgotten scan, cursor is offset from start of range
+    offset_pos = cursor_in;
+    it = keys_.lower_bound(prefix);
+  }
+
+  std::vector<std::string> lkeys_out;
+  for (; it != keys_.end() && lkeys_out.size() < count_keys; ++it) {
+    if (!range_end.empty() && it->first >= range_end) {
+      break;
+    }
+
+    last_key = it->first;
+    if (common::MatchPattern(it->first, pattern)) {
+      if (offset_pos == 0) {
+        lkeys_out.push_back(it->first);
+      } else {
+        offset_pos--;
+      }
+    }
+  }
+
+  const bool finished = it == keys_.end() || (!range_end.empty() && it->first >= range_end);
+  const uint64_t lcursor_out = finished ? 0 : cursor_in + lkeys_out.size();
+  scan_cursors_.Put(lcursor_out, pattern, last_key);
+  *keys_out = lkeys_out;
+  *cursor_out = lcursor_out;
+}
+
+void KeyIndex::Keys(const std::string& key_start,
+                    const std::string& key_end,
+                    uint64_t limit,
+                    std::vector<std::string>* ret) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto it = keys_.upper_bound(key_start);
+       it != keys_.end() && it->first < key_end && ret->size() < limit; ++it) {
+    ret->push_back(it->first);
+  }
+}
+
+}  // namespace memcached
+}  // namespace core
+}  // namespace fastonosql
@@ -0,0 +1,90 @@
+/*  Copyright (C) 2014-2016 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <stddef.h>  // for size_t
+#include <stdint.h>  // for uint64_t
+#include <time.h>    // for time_t
+
+#include <map>      // for map
+#include <mutex>    // for mutex
+#include <string>   // for string
+#include <utility>  // for pair
+#include <vector>   // for vector
+
+#include <common/types.h>  // for time64_t
+
+#include "core/internal/range_scan.h"  // for RangeScanCursors
+
+#define MEMCACHED_KEY_INDEX_MAX_AGE_MSEC 30000
+
+namespace fastonosql {
+namespace core {
+namespace memcached {
+
+// keys of server with expiration times (0 if key hasn't it) taken by one dump,
+// pages of SCAN and ranges of KEYS are served from sorted index
+// and resumed by last seen key, so server is dumped once per refresh
+// instead of once per page; writes of connection are applied to index,
+// index is replaced by Reset from refresh thread, writes made since
+// BeginRefresh are journaled and replayed over the dumped keys
+class KeyIndex {
+ public:
+  typedef std::map<std::string, time_t> keys_t;
+
+  KeyIndex();
+
+  bool IsBuilt() const;
+  bool IsStale(common::time64_t now_msec) const;
+  void BeginRefresh();
+  void CancelRefresh();
+  void Reset(keys_t* keys, common::time64_t built_msec);
+  void Clear();
+
+  void Add(const std::string& key, time_t expiration);
+  void Remove(const std::string& key);
+  bool FindExpiration(const std::string& key, time_t* expiration) const;
+  size_t Size() const;
+
+  void Scan(uint64_t cursor_in,
+            const std::string& pattern,
+            uint64_t count_keys,
+            std::vector<std::string>* keys_out,
+            uint64_t* cursor_out);
+  void Keys(const std::string& key_start,
+            const std::string& key_end,
+            uint64_t limit,
+            std::vector<std::string>* ret) const;
+
+ private:
+  // last write of every key: added with expiration or removed
+  typedef std::map<std::string, std::pair<bool, time_t> > journal_t;
+
+  mutable std::mutex mutex_;
+  keys_t keys_;
+  bool journaling_;
+  journal_t journal_;
+  bool built_;
+  common::time64_t built_msec_;
+  internal::RangeScanCursors scan_cursors_;
+};
+
+}  // namespace memcached
+}  // namespace core
+}  // namespace fastonosql
@@ -59,7 +59,8 @@ const std::vector<Field> memcachedCommonFields = {
     Field(MEMCACHED_BYTES_READ_LABEL, common::Value::TYPE_UINTEGER),
     Field(MEMCACHED_BYTES_WRITTEN_LABEL, common::Value::TYPE_UINTEGER),
     Field(MEMCACHED_LIMIT_MAXBYTES_LABEL, common::Value::TYPE_UINTEGER),
-    Field(MEMCACHED_THREADS_LABEL, common::Value::TYPE_UINTEGER)};
+    Field(MEMCACHED_THREADS_LABEL, common::Value::TYPE_UINTEGER),
+    Field(MEMCACHED_NODES_LABEL, common::Value::TYPE_STRING)};
 }  // namespace
 
 template <>
@@ -193,6 +194,8 @@ ServerInfo::Stats::Stats(const std::string& common_text) {
       if (common::ConvertFromString(value, &lthreads)) {
         threads = lthreads;
       }
+    } else if (field == MEMCACHED_NODES_LABEL) {
+      nodes = value;
     }
     start = pos + 2;
   }
@@ -244,6 +247,8 @@ common::Value* ServerInfo::Stats::ValueByIndex(unsigned char index) const {
       return new common::FundamentalValue(limit_maxbytes);
     case 21:
       return new common::FundamentalValue(threads);
+    case 22:
+      return new common::StringValue(nodes);
     default:
       break;
   }
@@ -289,7 +294,8 @@ std::ostream& operator<<(std::ostream& out, const ServerInfo::Stats& value) {
              << MEMCACHED_BYTES_READ_LABEL ":" << value.bytes_read << MARKER
              << MEMCACHED_BYTES_WRITTEN_LABEL ":" << value.bytes_written << MARKER
              << MEMCACHED_LIMIT_MAXBYTES_LABEL ":" << value.limit_maxbytes << MARKER
-             << MEMCACHED_THREADS_LABEL ":" << value.threads << MARKER;
+             << MEMCACHED_THREADS_LABEL ":" << value.threads << MARKER
+             << MEMCACHED_NODES_LABEL ":" << value.nodes << MARKER;
 }
 
 std::ostream& operator<<(std::ostream& out, const ServerInfo& value) {
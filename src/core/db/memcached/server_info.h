@@ -52,6 +52,9 @@
 #define MEMCACHED_BYTES_WRITTEN_LABEL "bytes_written"
 #define MEMCACHED_LIMIT_MAXBYTES_LABEL "limit_maxbytes"
 #define MEMCACHED_THREADS_LABEL "threads"
+#define MEMCACHED_NODES_LABEL "nodes"
+
+#define MEMCACHED_NODES_SEPARATOR "; "
 
 namespace fastonosql {
 namespace core {
@@ -86,6 +89,7 @@ class ServerInfo : public IServerInfo {
     uint32_t bytes_written;
     uint32_t limit_maxbytes;
     uint32_t threads;
+    std::string nodes;  // per node stats of pool joined by MEMCACHED_NODES_SEPARATOR
   } stats_;
 
   ServerInfo();
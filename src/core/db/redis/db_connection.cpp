@@ -23,6 +23,7 @@
 #include <unistd.h>
 #ifdef OS_POSIX
 #include <sys/socket.h>  // for setsockopt, SOL_SOCKET, etc
+#include <sys/select.h>  // for select, FD_SET, etc
 #include <netinet/in.h>
 #include <netinet/tcp.h>
 #endif
@@ -34,6 +35,7 @@
 #include <stdlib.h>  // for free, malloc, realloc, etc
 #include <string.h>  // for strcasecmp, NULL, strcmp, etc
 
+#include <deque>   // for deque
 #include <memory>  // for __shared_ptr
 #include <string>
 #include <vector>
@@ -59,6 +61,7 @@ extern "C" {
 #include "core/icommand_translator.h"  // for translator_t, etc
 
 #include "core/command_holder.h"  // for CommandHolder
+#include "core/global.h"          // for ConvertToString
 
 #include "core/internal/connection.h"  // for Connection<>::config_t, etc
 #include "core/internal/cdb_connection_client.h"
@@ -68,6 +71,7 @@ extern "C" {
 #include "core/db/redis/sentinel_info.h"  // for DiscoverySentinelInfo, etc
 #include "core/db/redis/command_translator.h"
 #include "core/db/redis/internal/commands_api.h"
+#include "core/db/redis/migrator.h"  // for Migrator
 
 #define HIREDIS_VERSION    \
   STRINGIZE(HIREDIS_MAJOR) \
@@ -90,6 +94,8 @@ extern "C" {
 #define RTYPE_ZSET 4
 #define RTYPE_NONE 5
 
+#define PIPE_IMPORT_FLUSH_BYTES (64 * 1024)
+
 #define ANET_OK 0
 #define ANET_ERR -1
 #define ANET_ERR_LEN 256
@@ -325,6 +331,304 @@ common::Error authContext(const char* auth_str, redisContext* context) {
   return cliPrintContextError(context);
 }
 
+common::Error selectContext(int num, redisContext* context) {
+  redisReply* reply = static_cast<redisReply*>(redisCommand(context, "SELECT %d", num));
+  if (reply) {
+    if (reply->type == REDIS_REPLY_ERROR) {
+      std::string buff = common::MemSPrintf("Select error: %s", reply->str);
+      freeReplyObject(reply);
+      return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+    }
+
+    freeReplyObject(reply);
+    return common::Error();
+  }
+
+  return cliPrintContextError(context);
+}
+
+// ssh channel has own buffering, so only plain sockets can be polled
+bool isPollableConnection(const RConfig& config) {
+  return !config.hostsocket.empty() || config.ssh_info.current_method == SSHInfo::UNKNOWN ||
+         config.ssh_info.host.host.empty();
+}
+
+bool isSocketReadable(int fd) {
+#ifdef OS_POSIX
+  fd_set rfds;
+  FD_ZERO(&rfds);
+  FD_SET(fd, &rfds);
+  struct timeval tv = {0, 0};
+  return select(fd + 1, &rfds, NULL, NULL, &tv) > 0;
+#else
+  UNUSED(fd);
+  return false;
+#endif
+}
+
+common::Error appendImportRecord(const ImportRecord& record, redisContext* context) {
+  std::vector<const char*> argv;
+  std::vector<size_t> argvlen;
+  std::string key_str = record.key.Key();
+  std::string ttl_str;
+  if (record.IsCommand()) {
+    if (!isPipeLineCommand(record.command[0].c_str())) {
+      std::string buff =
+          common::MemSPrintf("Command %s can't be used in import", record.command[0]);
+      return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+    }
+
+    for (size_t i = 0; i < record.command.size(); ++i) {
+      argv.push_back(record.command[i].c_str());
+      argvlen.push_back(record.command[i].size());
+    }
+  } else {
+    argv.push_back("SET");
+    argvlen.push_back(3);
+    argv.push_back(key_str.c_str());
+    argvlen.push_back(key_str.size());
+    argv.push_back(record.value.c_str());
+    argvlen.push_back(record.value.size());
+    ttl_t ttl = record.key.TTL();
+    if (ttl > 0) {
+      ttl_str = common::ConvertToString(ttl);
+      argv.push_back("EX");
+      argvlen.push_back(2);
+      argv.push_back(ttl_str.c_str());
+      argvlen.push_back(ttl_str.size());
+    }
+  }
+
+  char* cmd = NULL;
+  int len = redisFormatCommandArgv(&cmd, static_cast<int>(argv.size()), &argv[0], &argvlen[0]);
+  if (len == -1) {
+    return common::make_error_value("Out of memory", common::ErrorValue::E_ERROR);
+  }
+
+  int res = redisAppendFormattedCommand(context, cmd, static_cast<size_t>(len));
+  free(cmd);
+  if (res != REDIS_OK) {
+    return cliPrintContextError(context);
+  }
+
+  return common::Error();
+}
+
+common::Error flushImportBuffer(redisContext* context) {
+  int done = 0;
+  while (!done) {
+    if (redisBufferWrite(context, &done) != REDIS_OK) {
+      return cliPrintContextError(context);
+    }
+  }
+
+  return common::Error();
+}
+
+/* Consumes replies which already arrived, blocks only while
+ * more than keep commands are still waiting for reply. */
+common::Error readImportReplies(redisContext* context,
+                                bool pollable,
+                                size_t keep,
+                                std::deque<uint64_t>* inflight,
+                                ImportStats* stats) {
+  while (!inflight->empty()) {
+    void* reply = NULL;
+    if (redisGetReplyFromReader(context, &reply) != REDIS_OK) {
+      return cliPrintContextError(context);
+    }
+
+    if (!reply) {
+      if (inflight->size() <= keep && (!pollable || !isSocketReadable(context->fd))) {
+        break;
+      }
+
+      if (redisBufferRead(context) != REDIS_OK) {
+        return cliPrintContextError(context);
+      }
+      continue;
+    }
+
+    redisReply* r = static_cast<redisReply*>(reply);
+    stats->replies++;
+    if (r->type == REDIS_REPLY_ERROR) {
+      stats->AddError(inflight->front(), std::string(r->str, r->len));
+    }
+    freeReplyObject(r);
+    inflight->pop_front();
+  }
+
+  return common::Error();
+}
+
+typedef std::vector<std::string> command_args_t;
+
+// sends all commands before reading first reply,
+// integer 1 and status replies are successful
+common::Error execPipeline(redisContext* context,
+                           const std::vector<command_args_t>& commands,
+                           std::vector<bool>* succeeded,
+                           std::string* first_error) {
+  for (size_t i = 0; i < commands.size(); ++i) {
+    const command_args_t& args = commands[i];
+    std::vector<const char*> argv;
+    std::vector<size_t> argvlen;
+    for (size_t j = 0; j < args.size(); ++j) {
+      argv.push_back(args[j].data());
+      argvlen.push_back(args[j].size());
+    }
+    redisAppendCommandArgv(context, argv.size(), argv.data(), argvlen.data());
+  }
+
+  for (size_t i = 0; i < commands.size(); ++i) {
+    void* rep = NULL;
+    if (redisGetReply(context, &rep) != REDIS_OK) {
+      return cliPrintContextError(context);
+    }
+
+    redisReply* reply = static_cast<redisReply*>(rep);
+    bool ok = (reply->type == REDIS_REPLY_INTEGER && reply->integer == 1) ||
+              reply->type == REDIS_REPLY_STATUS;
+    if (reply->type == REDIS_REPLY_ERROR && first_error->empty()) {
+      *first_error = std::string(reply->str, reply->len);
+    }
+    succeeded->push_back(ok);
+    freeReplyObject(reply);
+  }
+
+  return common::Error();
+}
+
+// containers replace previous value of key, redis doesn't keep empty ones,
+// ttl is set in the same pipeline
+void makeSetKeyCommands(const NDbKValue& key, std::vector<command_args_t>* commands) {
+  const std::string key_str = key.KeyString();
+  const ttl_t ttl = key.Key().TTL();
+  NValue value = key.Value();
+  const common::Value::Type type = value ? value->GetType() : common::Value::TYPE_NULL;
+  if (type != common::Value::TYPE_ARRAY && type != common::Value::TYPE_SET &&
+      type != common::Value::TYPE_ZSET && type != common::Value::TYPE_HASH) {
+    command_args_t set = {"SET", key_str, key.ValueString()};
+    if (ttl > 0) {
+      set.push_back("EX");
+      set.push_back(common::ConvertToString(ttl));
+    }
+    commands->push_back(set);
+    return;
+  }
+
+  command_args_t write;
+  if (type == common::Value::TYPE_ARRAY) {
+    common::ArrayValue* array = static_cast<common::ArrayValue*>(value.get());
+    write = {"RPUSH", key_str};
+    for (auto it = array->begin(); it != array->end(); ++it) {
+      write.push_back(common::ConvertToString(*it, " "));
+    }
+  } else if (type == common::Value::TYPE_SET) {
+    common::SetValue* set = static_cast<common::SetValue*>(value.get());
+    write = {"SADD", key_str};
+    for (auto it = set->begin(); it != set->end(); ++it) {
+      write.push_back(common::ConvertToString(*it, " "));
+    }
+  } else if (type == common::Value::TYPE_ZSET) {
+    common::ZSetValue* zset = static_cast<common::ZSetValue*>(value.get());
+    write = {"ZADD", key_str};
+    for (auto it = zset->begin(); it != zset->end(); ++it) {
+      write.push_back(common::ConvertToString((*it).first, " "));
+      write.push_back(common::ConvertToString((*it).second, " "));
+    }
+  } else {
+    common::HashValue* hash = static_cast<common::HashValue*>(value.get());
+    write = {"HMSET", key_str};
+    for (auto it = hash->begin(); it != hash->end(); ++it) {
+      write.push_back(common::ConvertToString((*it).first, " "));
+      write.push_back(common::ConvertToString((*it).second, " "));
+    }
+  }
+
+  commands->push_back({"DEL", key_str});
+  if (write.size() > 2) {
+    commands->push_back(write);
+    if (ttl > 0) {
+      commands->push_back({"EXPIRE", key_str, common::ConvertToString(ttl)});
+    }
+  }
+}
+
+const char* collectionSizeCommand(common::Value::Type type) {
+  if (type == common::Value::TYPE_ARRAY) {
+    return "LLEN";
+  } else if (type == common::Value::TYPE_SET) {
+    return "SCARD";
+  } else if (type == common::Value::TYPE_ZSET) {
+    return "ZCARD";
+  } else if (type == common::Value::TYPE_HASH) {
+    return "HLEN";
+  }
+
+  return nullptr;
+}
+
+const char* collectionScanCommand(common::Value::Type type) {
+  if (type == common::Value::TYPE_SET) {
+    return "SSCAN";
+  } else if (type == common::Value::TYPE_ZSET) {
+    return "ZSCAN";
+  } else if (type == common::Value::TYPE_HASH) {
+    return "HSCAN";
+  }
+
+  return nullptr;
+}
+
+// LRANGE returns elements, SSCAN members, ZSCAN member score pairs
+// and HSCAN field value pairs
+common::Value* collectionFromScanElements(common::Value::Type type, redisReply* elements) {
+  if (type == common::Value::TYPE_ARRAY) {
+    common::ArrayValue* arr = common::Value::CreateArrayValue();
+    for (size_t i = 0; i < elements->elements; ++i) {
+      redisReply* element = elements->element[i];
+      arr->AppendString(std::string(element->str, element->len));
+    }
+    return arr;
+  }
+
+  if (type == common::Value::TYPE_SET) {
+    common::SetValue* set = common::Value::CreateSetValue();
+    for (size_t i = 0; i < elements->elements; ++i) {
+      redisReply* member = elements->element[i];
+      set->Insert(common::Value::CreateStringValue(std::string(member->str, member->len)));
+    }
+    return set;
+  }
+
+  common::Value* result = nullptr;
+  common::ZSetValue* zset = nullptr;
+  common::HashValue* hash = nullptr;
+  if (type == common::Value::TYPE_ZSET) {
+    zset = common::Value::CreateZSetValue();
+    result = zset;
+  } else {
+    hash = common::Value::CreateHashValue();
+    result = hash;
+  }
+
+  for (size_t i = 0; i + 1 < elements->elements; i += 2) {
+    redisReply* first = elements->element[i];
+    redisReply* second = elements->element[i + 1];
+    common::Value* lfirst = common::Value::CreateStringValue(std::string(first->str, first->len));
+    common::Value* lsecond =
+        common::Value::CreateStringValue(std::string(second->str, second->len));
+    if (zset) {
+      zset->Insert(lsecond, lfirst);
+    } else {
+      hash->Insert(lfirst, lsecond);
+    }
+  }
+
+  return result;
+}
+
 }  // namespace
 
 RConfig::RConfig(const Config& config, const SSHInfo& sinfo) : Config(config), ssh_info(sinfo) {}
@@ -406,6 +710,36 @@ common::Error TestConnection(const RConfig& rconfig) {
   return common::Error();
 }
 
+common::Error CreateAuthorizedConnection(const RConfig& config, NativeConnection** context) {
+  if (!context) {
+    return common::make_error_value("Invalid input argument(s)", common::ErrorValue::E_ERROR);
+  }
+
+  redisContext* lcontext = NULL;
+  common::Error err = CreateConnection(config, &lcontext);
+  if (err && err->IsError()) {
+    return err;
+  }
+
+  const char* auth_str = common::utils::c_strornull(config.auth);
+  err = authContext(auth_str, lcontext);
+  if (err && err->IsError()) {
+    redisFree(lcontext);
+    return err;
+  }
+
+  if (config.dbnum > 0) {
+    err = selectContext(config.dbnum, lcontext);
+    if (err && err->IsError()) {
+      redisFree(lcontext);
+      return err;
+    }
+  }
+
+  *context = lcontext;
+  return common::Error();
+}
+
 common::Error DiscoveryClusterConnection(const RConfig& rconfig,
                                          std::vector<ServerDiscoveryClusterInfoSPtr>* infos) {
   if (!infos) {
@@ -523,7 +857,9 @@ common::Error DiscoverySentinelConnection(const RConfig& rconfig,
 DBConnection::DBConnection(CDBConnectionClient* client)
     : base_class(client, new CommandTranslator(base_class::Commands())),
       isAuth_(false),
-      cur_db_(-1) {}
+      cur_db_(-1),
+      unlink_probed_(false),
+      has_unlink_(false) {}
 
 bool DBConnection::IsAuthenticated() const {
   if (!IsConnected()) {
@@ -539,6 +875,7 @@ common::Error DBConnection::Connect(const config_t& config) {
     return err;
   }
 
+  unlink_probed_ = false;
   /* Do AUTH and select the right DB. */
   err = Auth(connection_.config_.auth);
   if (err && err->IsError()) {
@@ -776,26 +1113,47 @@ common::Error DBConnection::SelectImpl(const std::string& name, IDataBaseInfo**
 }
 
 common::Error DBConnection::DeleteImpl(const NKeys& keys, NKeys* deleted_keys) {
-  for (size_t i = 0; i < keys.size(); ++i) {
-    NKey key = keys[i];
-    std::string del_cmd;
-    translator_t tran = Translator();
-    common::Error err = tran->DeleteKeyCommand(key, &del_cmd);
+  if (!unlink_probed_) {
+    common::Error err = ProbeUnlink();
     if (err && err->IsError()) {
       return err;
     }
-    redisReply* reply =
-        reinterpret_cast<redisReply*>(redisCommand(connection_.handle_, del_cmd.c_str()));
-    if (!reply) {
-      return cliPrintContextError(connection_.handle_);
-    }
+  }
+
+  // UNLINK frees values in background, servers before 4.0 have only DEL
+  const char* command = has_unlink_ ? "UNLINK" : "DEL";
+  std::vector<command_args_t> pipeline;
+  for (size_t i = 0; i < keys.size(); ++i) {
+    pipeline.push_back({command, keys[i].Key()});
+  }
 
-    if (reply->type == REDIS_REPLY_INTEGER && reply->integer == 1) {
-      deleted_keys->push_back(key);
+  std::vector<bool> deleted;
+  std::string first_error;
+  common::Error err = execPipeline(connection_.handle_, pipeline, &deleted, &first_error);
+  if (err && err->IsError()) {
+    return err;
+  }
+
+  for (size_t i = 0; i < deleted.size(); ++i) {
+    if (deleted[i]) {
+      deleted_keys->push_back(keys[i]);
     }
-    freeReplyObject(reply);
+  }
+  return common::Error();
+}
+
+common::Error DBConnection::ProbeUnlink() {
+  // COMMAND INFO replies nil for unknown command, servers before 2.8.13 haven't COMMAND at all
+  redisReply* reply =
+      reinterpret_cast<redisReply*>(redisCommand(connection_.handle_, "COMMAND INFO UNLINK"));
+  if (!reply) {
+    return cliPrintContextError(connection_.handle_);
   }
 
+  has_unlink_ = reply->type == REDIS_REPLY_ARRAY && reply->elements == 1 &&
+                reply->element[0]->type == REDIS_REPLY_ARRAY;
+  unlink_probed_ = true;
+  freeReplyObject(reply);
   return common::Error();
 }
 
@@ -819,6 +1177,53 @@ common::Error DBConnection::SetImpl(const NDbKValue& key, NDbKValue* added_key)
   return common::Error();
 }
 
+common::Error DBConnection::SetBatchImpl(const NDbKValues& keys, NDbKValues* added_keys) {
+  // every key is written by one or more commands of one pipeline
+  std::vector<size_t> commands_per_key;
+  for (size_t i = 0; i < keys.size(); ++i) {
+    std::vector<command_args_t> commands;
+    makeSetKeyCommands(keys[i], &commands);
+    for (size_t j = 0; j < commands.size(); ++j) {
+      const command_args_t& args = commands[j];
+      std::vector<const char*> argv;
+      std::vector<size_t> argvlen;
+      for (size_t k = 0; k < args.size(); ++k) {
+        argv.push_back(args[k].data());
+        argvlen.push_back(args[k].size());
+      }
+      redisAppendCommandArgv(connection_.handle_, argv.size(), argv.data(), argvlen.data());
+    }
+    commands_per_key.push_back(commands.size());
+  }
+
+  common::Error first_error;
+  for (size_t i = 0; i < keys.size(); ++i) {
+    bool failed = false;
+    for (size_t j = 0; j < commands_per_key[i]; ++j) {
+      void* rep = NULL;
+      if (redisGetReply(connection_.handle_, &rep) != REDIS_OK) {
+        return cliPrintContextError(connection_.handle_);
+      }
+
+      redisReply* reply = static_cast<redisReply*>(rep);
+      if (reply->type == REDIS_REPLY_ERROR) {
+        failed = true;
+        if (!first_error) {
+          first_error = common::make_error_value(std::string(reply->str, reply->len),
+                                                 common::Value::E_ERROR);
+        }
+      }
+      freeReplyObject(reply);
+    }
+
+    if (!failed) {
+      added_keys->push_back(keys[i]);
+    }
+  }
+
+  return first_error;
+}
+
 common::Error DBConnection::GetImpl(const NKey& key, NDbKValue* loaded_key) {
   std::string key_str = key.Key();
   redisReply* reply =
@@ -898,6 +1303,57 @@ common::Error DBConnection::SetTTLImpl(const NKey& key, ttl_t ttl) {
   return common::Error();
 }
 
+common::Error DBConnection::SetTTLBatchImpl(const NKeys& keys, ttl_t ttl, NKeys* changed_keys) {
+  std::string ttl_str = common::ConvertToString(ttl);
+  std::vector<command_args_t> pipeline;
+  for (size_t i = 0; i < keys.size(); ++i) {
+    if (ttl == NO_TTL) {
+      pipeline.push_back({"PERSIST", keys[i].Key()});
+    } else {
+      pipeline.push_back({"EXPIRE", keys[i].Key(), ttl_str});
+    }
+  }
+
+  std::vector<bool> changed;
+  std::string first_error;
+  common::Error err = execPipeline(connection_.handle_, pipeline, &changed, &first_error);
+  if (err && err->IsError()) {
+    return err;
+  }
+
+  for (size_t i = 0; i < changed.size(); ++i) {
+    if (changed[i]) {
+      changed_keys->push_back(keys[i]);
+    }
+  }
+
+  return common::Error();
+}
+
+common::Error DBConnection::RenameBatchImpl(const NKeys& keys,
+                                            const std::vector<std::string>& new_keys,
+                                            NKeys* renamed_keys) {
+  std::vector<command_args_t> pipeline;
+  for (size_t i = 0; i < keys.size(); ++i) {
+    pipeline.push_back({"RENAME", keys[i].Key(), new_keys[i]});
+  }
+
+  std::vector<bool> renamed;
+  std::string first_error;
+  common::Error err = execPipeline(connection_.handle_, pipeline, &renamed, &first_error);
+  if (err && err->IsError()) {
+    return err;
+  }
+
+  for (size_t i = 0; i < renamed.size(); ++i) {
+    if (renamed[i]) {
+      renamed_keys->push_back(keys[i]);
+    }
+  }
+
+  return common::Error();
+}
+
 common::Error DBConnection::GetTTLImpl(const NKey& key, ttl_t* ttl) {
   translator_t tran = Translator();
   std::string ttl_cmd;
@@ -1128,6 +1584,128 @@ common::Error DBConnection::ExecuteAsPipeline(
   return common::Error();
 }
 
+common::Error DBConnection::PipeImport(ImportReader* reader,
+                                       size_t max_inflight,
+                                       ImportStats* stats,
+                                       import_progress_callback_t progress_cb) {
+  if (!reader || !stats || max_inflight == 0) {
+    DNOTREACHED();
+    return common::make_error_value("Invalid input argument(s)", common::ErrorValue::E_ERROR);
+  }
+
+  if (!IsConnected()) {
+    return common::make_error_value("Not connected", common::Value::E_ERROR);
+  }
+
+  // replies of import shouldn't interleave with interactive commands
+  RConfig config = connection_.config_;
+  config.dbnum = cur_db_;
+  redisContext* context = NULL;
+  common::Error err = CreateAuthorizedConnection(config, &context);
+  if (err && err->IsError()) {
+    return err;
+  }
+
+  err = PipeImportImpl(context, reader, max_inflight, stats, progress_cb);
+  redisFree(context);
+  return err;
+}
+
+common::Error DBConnection::Migrate(const RConfig& target,
+                                    const MigrateOptions& options,
+                                    MigrateStats* stats,
+                                    migrate_progress_callback_t progress_cb) {
+  if (!stats) {
+    DNOTREACHED();
+    return common::make_error_value("Invalid input argument(s)", common::ErrorValue::E_ERROR);
+  }
+
+  if (!IsConnected()) {
+    return common::make_error_value("Not connected", common::Value::E_ERROR);
+  }
+
+  RConfig source = connection_.config_;
+  source.dbnum = cur_db_;
+  Migrator migrator(source, target, options);
+  return migrator.Run([this]() { return IsInterrupted(); }, progress_cb, stats);
+}
+
+common::Error DBConnection::PipeImportImpl(NativeConnection* context,
+                                           ImportReader* reader,
+                                           size_t max_inflight,
+                                           ImportStats* stats,
+                                           import_progress_callback_t progress_cb) {
+  const bool pollable = isPollableConnection(connection_.config_);
+  std::deque<uint64_t> inflight;
+  bool eof = false;
+  while (true) {
+    if (IsInterrupted()) {
+      return common::make_error_value("Interrupted.", common::ErrorValue::E_INTERRUPTED);
+    }
+
+    ImportRecord record;
+    common::Error err = reader->Next(&record, &eof);
+    if (err && err->IsError()) {
+      if (eof) {
+        return err;
+      }
+
+      stats->AddError(record.line, err->Description());
+      continue;
+    }
+
+    if (eof) {
+      break;
+    }
+
+    err = appendImportRecord(record, context);
+    if (err && err->IsError()) {
+      if (context->err) {
+        return err;
+      }
+
+      stats->AddError(record.line, err->Description());
+      continue;
+    }
+
+    inflight.push_back(record.line);
+    stats->sent++;
+    if (sdslen(context->obuf) < PIPE_IMPORT_FLUSH_BYTES && inflight.size() < max_inflight) {
+      continue;
+    }
+
+    err = flushImportBuffer(context);
+    if (err && err->IsError()) {
+      return err;
+    }
+
+    err = readImportReplies(context, pollable, max_inflight / 2, &inflight, stats);
+    if (err && err->IsError()) {
+      return err;
+    }
+
+    if (progress_cb) {
+      progress_cb(*stats);
+    }
+  }
+
+  common::Error err = flushImportBuffer(context);
+  if (err && err->IsError()) {
+    return err;
+  }
+
+  err = readImportReplies(context, pollable, 0, &inflight, stats);
+  if (err && err->IsError()) {
+    return err;
+  }
+
+  if (progress_cb) {
+    progress_cb(*stats);
+  }
+
+  return common::Error();
+}
+
 common::Error DBConnection::CommonExec(int argc, const char** argv, FastoObject* out) {
   if (!out || argc < 1) {
     DNOTREACHED();
@@ -1706,6 +2284,129 @@ common::Error DBConnection::Hgetall(const NKey& key, NDbKValue* loaded_key) {
   return common::Error();
 }
 
+common::Error DBConnection::CollectionSize(const NKey& key,
+                                           common::Value::Type type,
+                                           size_t* size) {
+  const char* command = collectionSizeCommand(type);
+  if (!command || !size) {
+    DNOTREACHED();
+    return common::make_error_value("Invalid input argument(s)", common::ErrorValue::E_ERROR);
+  }
+
+  if (!IsConnected()) {
+    return common::make_error_value("Not connected", common::Value::E_ERROR);
+  }
+
+  std::string key_str = key.Key();
+  redisReply* reply = reinterpret_cast<redisReply*>(
+      redisCommand(connection_.handle_, "%s %b", command, key_str.data(), key_str.size()));
+  if (!reply) {
+    return cliPrintContextError(connection_.handle_);
+  }
+
+  if (reply->type == REDIS_REPLY_INTEGER) {
+    *size = reply->integer;
+    freeReplyObject(reply);
+    return common::Error();
+  } else if (reply->type == REDIS_REPLY_ERROR) {
+    common::Error err =
+        common::make_error_value(std::string(reply->str, reply->len), common::Value::E_ERROR);
+    freeReplyObject(reply);
+    return err;
+  }
+
+  NOTREACHED();
+  freeReplyObject(reply);
+  return common::Error();
+}
+
+common::Error DBConnection::LoadCollectionChunk(const NKey& key,
+                                                common::Value::Type type,
+                                                uint64_t cursor_in,
+                                                uint64_t count,
+                                                NValue* chunk,
+                                                uint64_t* cursor_out) {
+  if (!chunk || !cursor_out || count == 0) {
+    DNOTREACHED();
+    return common::make_error_value("Invalid input argument(s)", common::ErrorValue::E_ERROR);
+  }
+
+  if (!IsConnected()) {
+    return common::make_error_value("Not connected", common::Value::E_ERROR);
+  }
+
+  std::string key_str = key.Key();
+  if (type == common::Value::TYPE_ARRAY) {
+    // windowed LRANGE, cursor is offset of the first element,
+    // window isn't reported to client, it isn't whole value of key
+    std::string start_str = common::ConvertToString(cursor_in);
+    std::string stop_str = common::ConvertToString(cursor_in + count - 1);
+    redisReply* reply = reinterpret_cast<redisReply*>(
+        redisCommand(connection_.handle_, "LRANGE %b %s %s", key_str.data(), key_str.size(),
+                     start_str.c_str(), stop_str.c_str()));
+    if (!reply) {
+      return cliPrintContextError(connection_.handle_);
+    }
+
+    if (reply->type == REDIS_REPLY_ERROR) {
+      common::Error err =
+          common::make_error_value(std::string(reply->str, reply->len), common::Value::E_ERROR);
+      freeReplyObject(reply);
+      return err;
+    }
+
+    if (reply->type != REDIS_REPLY_ARRAY) {
+      freeReplyObject(reply);
+      return common::make_error_value("I/O error", common::Value::E_ERROR);
+    }
+
+    size_t loaded = reply->elements;
+    *chunk = NValue(collectionFromScanElements(type, reply));
+    *cursor_out = loaded < count ? 0 : cursor_in + loaded;
+    freeReplyObject(reply);
+    return common::Error();
+  }
+
+  const char* command = collectionScanCommand(type);
+  if (!command) {
+    DNOTREACHED();
+    return common::make_error_value("Invalid input argument(s)", common::ErrorValue::E_ERROR);
+  }
+
+  std::string cursor_str = common::ConvertToString(cursor_in);
+  std::string count_str = common::ConvertToString(count);
+  redisReply* reply = reinterpret_cast<redisReply*>(
+      redisCommand(connection_.handle_, "%s %b %s COUNT %s", command, key_str.data(),
+                   key_str.size(), cursor_str.c_str(), count_str.c_str()));
+  if (!reply) {
+    return cliPrintContextError(connection_.handle_);
+  }
+
+  if (reply->type == REDIS_REPLY_ERROR) {
+    common::Error err =
+        common::make_error_value(std::string(reply->str, reply->len), common::Value::E_ERROR);
+    freeReplyObject(reply);
+    return err;
+  }
+
+  if (reply->type != REDIS_REPLY_ARRAY || reply->elements != 2 ||
+      reply->element[0]->type != REDIS_REPLY_STRING ||
+      reply->element[1]->type != REDIS_REPLY_ARRAY) {
+    freeReplyObject(reply);
+    return common::make_error_value("I/O error", common::Value::E_ERROR);
+  }
+
+  std::string next_cursor(reply->element[0]->str, reply->element[0]->len);
+  if (!common::ConvertFromString(next_cursor, cursor_out)) {
+    freeReplyObject(reply);
+    return common::make_error_value("Invalid cursor", common::Value::E_ERROR);
+  }
+
+  *chunk = NValue(collectionFromScanElements(type, reply->element[1]));
+  freeReplyObject(reply);
+  return common::Error();
+}
+
 common::Error DBConnection::Decr(const NKey& key, long long* decr) {
   if (!decr) {
     DNOTREACHED();
@@ -21,8 +21,9 @@
 #include <stddef.h>  // for size_t
 #include <stdint.h>  // for uint64_t
 
-#include <string>  // for string
-#include <vector>  // for vector
+#include <functional>  // for function
+#include <string>      // for string
+#include <vector>      // for vector
 
 #include <common/error.h>   // for Error
 #include <common/macros.h>  // for PROJECT_VERSION_GENERATE, etc
@@ -35,6 +36,7 @@
 #include "core/internal/cdb_connection.h"  // for CDBConnection
 #include "core/db/redis/config.h"          // for Config
 #include "core/global.h"                   // for FastoObject (ptr only), etc
+#include "core/import_reader.h"            // for ImportReader, ImportStats
 
 namespace fastonosql {
 namespace core {
@@ -66,6 +68,9 @@ namespace core {
 namespace redis {
 
 typedef redisContext NativeConnection;
+struct MigrateOptions;
+struct MigrateStats;
+
 struct RConfig : public Config {
   explicit RConfig(const Config& config, const SSHInfo& sinfo);
   RConfig();
@@ -74,6 +79,8 @@ struct RConfig : public Config {
 };
 
 common::Error CreateConnection(const RConfig& config, NativeConnection** context);
+// AUTH and SELECT of config.dbnum are done
+common::Error CreateAuthorizedConnection(const RConfig& config, NativeConnection** context);
 common::Error TestConnection(const RConfig& rconfig);
 
 common::Error DiscoveryClusterConnection(const RConfig& rconfig,
@@ -84,6 +91,8 @@ common::Error DiscoverySentinelConnection(const RConfig& rconfig,
 class DBConnection : public core::internal::CDBConnection<NativeConnection, RConfig, REDIS> {
  public:
   typedef core::internal::CDBConnection<NativeConnection, RConfig, REDIS> base_class;
+  typedef std::function<void(const ImportStats&)> import_progress_callback_t;
+  typedef std::function<void(const MigrateStats&)> migrate_progress_callback_t;
   explicit DBConnection(CDBConnectionClient* client);
 
   bool IsAuthenticated() const;
@@ -98,6 +107,19 @@ class DBConnection : public core::internal::CDBConnection<NativeConnection, RCon
                                   void (*log_command_cb)(FastoObjectCommandIPtr))
       WARN_UNUSED_RESULT;
 
+  // streams raw RESP on a dedicated connection like redis-cli --pipe,
+  // at most max_inflight commands wait for reply
+  common::Error PipeImport(ImportReader* reader,
+                           size_t max_inflight,
+                           ImportStats* stats,
+                           import_progress_callback_t progress_cb) WARN_UNUSED_RESULT;
+
+  // copies keys of current database into target, see Migrator
+  common::Error Migrate(const RConfig& target,
+                        const MigrateOptions& options,
+                        MigrateStats* stats,
+                        migrate_progress_callback_t progress_cb) WARN_UNUSED_RESULT;
+
   common::Error CommonExec(int argc, const char** argv, FastoObject* out) WARN_UNUSED_RESULT;
   common::Error Auth(const std::string& password) WARN_UNUSED_RESULT;
   common::Error Monitor(int argc,
@@ -126,6 +148,20 @@ class DBConnection : public core::internal::CDBConnection<NativeConnection, RCon
   common::Error Hmset(const NKey& key, NValue hash);
   common::Error Hgetall(const NKey& key, NDbKValue* loaded_key);
 
+  // LLEN, SCARD, ZCARD or HLEN, cheap for any collection size
+  common::Error CollectionSize(const NKey& key,
+                               common::Value::Type type,
+                               size_t* size) WARN_UNUSED_RESULT;
+  // page of list, set, zset or hash: offset of windowed LRANGE for lists,
+  // SSCAN/ZSCAN/HSCAN cursor for others, *cursor_out is 0 on the last page,
+  // scans may return element twice, so pages of them should be deduplicated
+  common::Error LoadCollectionChunk(const NKey& key,
+                                    common::Value::Type type,
+                                    uint64_t cursor_in,
+                                    uint64_t count,
+                                    NValue* chunk,
+                                    uint64_t* cursor_out) WARN_UNUSED_RESULT;
+
   common::Error Decr(const NKey& key, long long* decr);
   common::Error DecrBy(const NKey& key, int inc, long long* decr);
 
@@ -148,13 +184,26 @@ class DBConnection : public core::internal::CDBConnection<NativeConnection, RCon
   virtual common::Error SelectImpl(const std::string& name, IDataBaseInfo** info) override;
   virtual common::Error DeleteImpl(const NKeys& keys, NKeys* deleted_keys) override;
   virtual common::Error SetImpl(const NDbKValue& key, NDbKValue* added_key) override;
+  virtual common::Error SetBatchImpl(const NDbKValues& keys, NDbKValues* added_keys) override;
   virtual common::Error GetImpl(const NKey& key, NDbKValue* loaded_key) override;
   virtual common::Error RenameImpl(const NKey& key, const std::string& new_key) override;
   virtual common::Error SetTTLImpl(const NKey& key, ttl_t ttl) override;
+  virtual common::Error SetTTLBatchImpl(const NKeys& keys,
+                                        ttl_t ttl,
+                                        NKeys* changed_keys) override;
+  virtual common::Error RenameBatchImpl(const NKeys& keys,
+                                        const std::vector<std::string>& new_keys,
+                                        NKeys* renamed_keys) override;
   virtual common::Error GetTTLImpl(const NKey& key, ttl_t* ttl) override;
   virtual common::Error QuitImpl() override;
 
   common::Error SendSync(unsigned long long* payload) WARN_UNUSED_RESULT;
+  common::Error ProbeUnlink() WARN_UNUSED_RESULT;
+  common::Error PipeImportImpl(NativeConnection* context,
+                               ImportReader* reader,
+                               size_t max_inflight,
+                               ImportStats* stats,
+                               import_progress_callback_t progress_cb) WARN_UNUSED_RESULT;
 
   common::Error CliFormatReplyRaw(FastoObjectArray* ar, redisReply* r) WARN_UNUSED_RESULT;
   common::Error CliFormatReplyRaw(FastoObject* out, redisReply* r) WARN_UNUSED_RESULT;
@@ -162,6 +211,8 @@ class DBConnection : public core::internal::CDBConnection<NativeConnection, RCon
 
   bool isAuth_;
   int cur_db_;
+  bool unlink_probed_;  // once per connection, by first delete
+  bool has_unlink_;
 };
 
 }  // namespace redis
@@ -0,0 +1,548 @@
+/*  Copyright (C) 2014-2016 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "core/db/redis/migrator.h"
+
+#include <string.h>  // for strcasecmp
+
+#include <string>  // for string
+#include <thread>  // for thread
+#include <vector>  // for vector
+
+#include <hiredis/hiredis.h>
+
+#include <common/convert2string.h>  // for ConvertFromString, ConvertToString
+#include <common/sprintf.h>         // for MemSPrintf
+#include <common/time.h>            // for current_mstime
+#include <common/value.h>           // for ErrorValue, etc
+
+#include "core/internal/cdb_connection.h"  // for ALL_KEYS_PATTERNS
+
+#define MIGRATE_DEFAULT_PARTITIONS 4
+#define MIGRATE_DEFAULT_BATCH_SIZE 500
+#define MIGRATE_DEFAULT_TIMEOUT_MSEC 5000
+#define MIGRATE_QUEUE_BATCHES_PER_PARTITION 2
+#define MIGRATE_DEFAULT_MAX_INFLIGHT_BYTES (64 * 1024 * 1024)
+
+namespace fastonosql {
+namespace core {
+namespace redis {
+namespace {
+
+common::Error contextError(redisContext* context) {
+  std::string buff = common::MemSPrintf("Error: %s", context->errstr);
+  return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+}
+
+common::Error scanKeys(redisContext* context,
+                       uint64_t cursor_in,
+                       const std::string& pattern,
+                       size_t count,
+                       std::vector<std::string>* keys_out,
+                       uint64_t* cursor_out) {
+  std::string cursor_str = common::ConvertToString(cursor_in);
+  std::string count_str = common::ConvertToString(static_cast<uint64_t>(count));
+  redisReply* reply = static_cast<redisReply*>(
+      redisCommand(context, "SCAN %s MATCH %b COUNT %s", cursor_str.c_str(), pattern.data(),
+                   pattern.size(), count_str.c_str()));
+  if (!reply) {
+    return contextError(context);
+  }
+
+  if (reply->type == REDIS_REPLY_ERROR) {
+    std::string buff = common::MemSPrintf("Scan error: %s", std::string(reply->str, reply->len));
+    freeReplyObject(reply);
+    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+  }
+
+  if (reply->type != REDIS_REPLY_ARRAY || reply->elements != 2 ||
+      reply->element[0]->type != REDIS_REPLY_STRING ||
+      reply->element[1]->type != REDIS_REPLY_ARRAY) {
+    freeReplyObject(reply);
+    return common::make_error_value("Invalid SCAN reply", common::ErrorValue::E_ERROR);
+  }
+
+  std::string next_cursor(reply->element[0]->str, reply->element[0]->len);
+  if (!common::ConvertFromString(next_cursor, cursor_out)) {
+    freeReplyObject(reply);
+    return common::make_error_value("Invalid SCAN cursor", common::ErrorValue::E_ERROR);
+  }
+
+  redisReply* keys = reply->element[1];
+  for (size_t i = 0; i < keys->elements; ++i) {
+    redisReply* key = keys->element[i];
+    if (key->type == REDIS_REPLY_STRING) {
+      keys_out->push_back(std::string(key->str, key->len));
+    }
+  }
+
+  freeReplyObject(reply);
+  return common::Error();
+}
+
+bool isDirectlyReachable(const RConfig& config) {
+  return config.hostsocket.empty() &&
+         (config.ssh_info.current_method == SSHInfo::UNKNOWN || config.ssh_info.host.host.empty());
+}
+
+}  // namespace
+
+MigrateOptions::MigrateOptions()
+    : pattern(ALL_KEYS_PATTERNS),
+      cursor(0),
+      partitions(MIGRATE_DEFAULT_PARTITIONS),
+      batch_size(MIGRATE_DEFAULT_BATCH_SIZE),
+      use_migrate(false),
+      migrate_timeout_msec(MIGRATE_DEFAULT_TIMEOUT_MSEC),
+      max_inflight_bytes(MIGRATE_DEFAULT_MAX_INFLIGHT_BYTES) {}
+
+MigrateStats::MigrateStats()
+    : scanned(0),
+      migrated(0),
+      skipped(0),
+      errors(0),
+      bytes(0),
+      cursor(0),
+      finished(false),
+      elapsed_msec(0),
+      error_keys() {}
+
+double MigrateStats::KeysPerSecond() const {
+  if (elapsed_msec <= 0) {
+    return 0;
+  }
+
+  return static_cast<double>(migrated) * 1000 / elapsed_msec;
+}
+
+Migrator::Migrator(const RConfig& source, const RConfig& target, const MigrateOptions& options)
+    : source_(source),
+      target_(target),
+      options_(options),
+      mutex_(),
+      queue_cond_(),
+      space_cond_(),
+      bytes_cond_(),
+      queue_(),
+      scan_finished_(false),
+      stop_(false),
+      fatal_error_(),
+      inflight_bytes_(0),
+      next_done_seq_(0),
+      done_seqs_(),
+      cursors_(),
+      stats_() {}
+
+common::Error Migrator::Run(interrupt_callback_t is_interrupted,
+                            progress_callback_t progress_cb,
+                            MigrateStats* stats) {
+  if (!stats || options_.partitions == 0 || options_.batch_size == 0 ||
+      options_.max_inflight_bytes == 0) {
+    DNOTREACHED();
+    return common::make_error_value("Invalid input argument(s)", common::ErrorValue::E_ERROR);
+  }
+
+  if (options_.use_migrate && !isDirectlyReachable(target_)) {
+    return common::make_error_value("MIGRATE needs target reachable by tcp from source server",
+                                    common::ErrorValue::E_ERROR);
+  }
+
+  // migrator can be run again after stop or error
+  queue_.clear();
+  scan_finished_ = false;
+  stop_ = false;
+  fatal_error_ = common::Error();
+  inflight_bytes_ = 0;
+  next_done_seq_ = 0;
+  done_seqs_.clear();
+  cursors_.clear();
+  stats_ = MigrateStats();
+  stats_.cursor = options_.cursor;
+  const common::time64_t start_ts = common::time::current_mstime();
+
+  redisContext* scan_context = NULL;
+  common::Error err = CreateAuthorizedConnection(source_, &scan_context);
+  if (err && err->IsError()) {
+    return err;
+  }
+
+  std::vector<std::thread> workers;
+  for (size_t i = 0; i < options_.partitions; ++i) {
+    workers.push_back(std::thread(&Migrator::WorkerRoutine, this));
+  }
+
+  uint64_t cursor = options_.cursor;
+  uint64_t seq = 0;
+  do {
+    if (is_interrupted && is_interrupted()) {
+      err = common::make_error_value("Interrupted.", common::ErrorValue::E_INTERRUPTED);
+      break;
+    }
+
+    Batch batch;
+    batch.seq = seq++;
+    err = scanKeys(scan_context, cursor, options_.pattern, options_.batch_size, &batch.keys,
+                   &batch.cursor_after);
+    if (err && err->IsError()) {
+      break;
+    }
+
+    MigrateStats snapshot;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      stats_.scanned += batch.keys.size();
+      stats_.elapsed_msec = common::time::current_mstime() - start_ts;
+      snapshot = stats_;
+    }
+
+    if (!PushBatch(batch)) {  // stopped by worker error
+      break;
+    }
+
+    cursor = batch.cursor_after;
+    if (progress_cb) {
+      progress_cb(snapshot);
+    }
+  } while (cursor != 0);
+
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    scan_finished_ = true;
+    if (err && err->IsError()) {
+      stop_ = true;
+    }
+  }
+  queue_cond_.notify_all();
+  space_cond_.notify_all();
+  bytes_cond_.notify_all();
+
+  for (size_t i = 0; i < workers.size(); ++i) {
+    workers[i].join();
+  }
+  redisFree(scan_context);
+
+  stats_.elapsed_msec = common::time::current_mstime() - start_ts;
+  stats_.finished = !stop_ && cursor == 0;
+  *stats = stats_;
+  if (progress_cb) {
+    progress_cb(stats_);
+  }
+
+  if (fatal_error_ && fatal_error_->IsError()) {
+    return fatal_error_;
+  }
+
+  return err;
+}
+
+void Migrator::WorkerRoutine() {
+  redisContext* source = NULL;
+  common::Error err = CreateAuthorizedConnection(source_, &source);
+  if (err && err->IsError()) {
+    SetFatalError(err);
+    return;
+  }
+
+  redisContext* target = NULL;
+  if (!options_.use_migrate) {
+    err = CreateAuthorizedConnection(target_, &target);
+    if (err && err->IsError()) {
+      redisFree(source);
+      SetFatalError(err);
+      return;
+    }
+  }
+
+  Batch batch;
+  while (PopBatch(&batch)) {
+    if (options_.use_migrate) {
+      err = MigrateBatch(source, batch);
+    } else {
+      err = DumpRestoreBatch(source, target, batch);
+    }
+
+    if (err && err->IsError()) {
+      SetFatalError(err);
+      break;
+    }
+
+    FinishBatch(batch);
+  }
+
+  if (target) {
+    redisFree(target);
+  }
+  redisFree(source);
+}
+
+common::Error Migrator::DumpRestoreBatch(NativeConnection* source,
+                                         NativeConnection* target,
+                                         const Batch& batch) {
+  const std::vector<std::string>& keys = batch.keys;
+  for (size_t i = 0; i < keys.size(); ++i) {
+    redisAppendCommand(source, "DUMP %b", keys[i].data(), keys[i].size());
+    redisAppendCommand(source, "PTTL %b", keys[i].data(), keys[i].size());
+  }
+
+  std::vector<DumpedKey> dumped;
+  dumped.reserve(keys.size());
+  uint64_t held = 0;  // payload bytes of dumped keys
+  uint64_t skipped = 0;
+  common::Error err;
+  for (size_t i = 0; i < keys.size(); ++i) {
+    void* dump_reply = NULL;
+    if (redisGetReply(source, &dump_reply) != REDIS_OK) {
+      ReleaseBytes(held);
+      return contextError(source);
+    }
+
+    void* ttl_reply = NULL;
+    if (redisGetReply(source, &ttl_reply) != REDIS_OK) {
+      freeReplyObject(dump_reply);
+      ReleaseBytes(held);
+      return contextError(source);
+    }
+
+    redisReply* dump = static_cast<redisReply*>(dump_reply);
+    redisReply* ttl = static_cast<redisReply*>(ttl_reply);
+    if (dump->type == REDIS_REPLY_ERROR) {
+      AddKeyError(keys[i], std::string(dump->str, dump->len));
+    } else if (dump->type != REDIS_REPLY_STRING || ttl->type != REDIS_REPLY_INTEGER ||
+               ttl->integer == EXPIRED_TTL) {
+      skipped++;
+    } else {
+      if (!AcquireBytes(dump->len, held)) {
+        // budget is taken by other workers, restore what is dumped and wait with empty hands
+        err = RestoreKeys(target, &dumped);
+        ReleaseBytes(held);
+        held = 0;
+        if (err && err->IsError()) {
+          freeReplyObject(dump);
+          freeReplyObject(ttl);
+          return err;
+        }
+        AcquireBytes(dump->len, held);
+      }
+
+      held += dump->len;
+      DumpedKey dkey;
+      dkey.key = &keys[i];
+      dkey.payload = std::string(dump->str, dump->len);
+      dkey.ttl_msec = ttl->integer == NO_TTL ? 0 : ttl->integer;
+      dumped.push_back(dkey);
+    }
+    freeReplyObject(dump);
+    freeReplyObject(ttl);
+  }
+
+  err = RestoreKeys(target, &dumped);
+  ReleaseBytes(held);
+  if (err && err->IsError()) {
+    return err;
+  }
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  stats_.skipped += skipped;
+  return common::Error();
+}
+
+common::Error Migrator::RestoreKeys(NativeConnection* target, std::vector<DumpedKey>* dumped) {
+  for (size_t i = 0; i < dumped->size(); ++i) {
+    const DumpedKey& dkey = (*dumped)[i];
+    redisAppendCommand(target, "RESTORE %b %lld %b REPLACE", dkey.key->data(), dkey.key->size(),
+                       dkey.ttl_msec, dkey.payload.data(), dkey.payload.size());
+  }
+
+  uint64_t migrated = 0;
+  uint64_t bytes = 0;
+  for (size_t i = 0; i < dumped->size(); ++i) {
+    void* restore_reply = NULL;
+    if (redisGetReply(target, &restore_reply) != REDIS_OK) {
+      return contextError(target);
+    }
+
+    redisReply* restore = static_cast<redisReply*>(restore_reply);
+    if (restore->type == REDIS_REPLY_ERROR) {
+      AddKeyError(*(*dumped)[i].key, std::string(restore->str, restore->len));
+    } else {
+      migrated++;
+      bytes += (*dumped)[i].payload.size();
+    }
+    freeReplyObject(restore);
+  }
+  dumped->clear();
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  stats_.migrated += migrated;
+  stats_.bytes += bytes;
+  return common::Error();
+}
+
+common::Error Migrator::MigrateBatch(NativeConnection* source, const Batch& batch) {
+  const std::vector<std::string>& keys = batch.keys;
+  if (keys.empty()) {
+    return common::Error();
+  }
+
+  std::string port_str = common::ConvertToString(target_.host.port);
+  std::string db_str = common::ConvertToString(target_.dbnum > 0 ? target_.dbnum : 0);
+  std::string timeout_str = common::ConvertToString(options_.migrate_timeout_msec);
+  std::vector<const char*> argv;
+  std::vector<size_t> argvlen;
+  const char* head[] = {"MIGRATE", target_.host.host.c_str(), port_str.c_str(), "",
+                        db_str.c_str(), timeout_str.c_str(), "COPY", "REPLACE"};
+  for (size_t i = 0; i < SIZEOFMASS(head); ++i) {
+    argv.push_back(head[i]);
+    argvlen.push_back(strlen(head[i]));
+  }
+
+  if (!target_.auth.empty()) {
+    argv.push_back("AUTH");
+    argvlen.push_back(4);
+    argv.push_back(target_.auth.c_str());
+    argvlen.push_back(target_.auth.size());
+  }
+
+  argv.push_back("KEYS");
+  argvlen.push_back(4);
+  for (size_t i = 0; i < keys.size(); ++i) {
+    argv.push_back(keys[i].data());
+    argvlen.push_back(keys[i].size());
+  }
+
+  redisReply* reply = static_cast<redisReply*>(
+      redisCommandArgv(source, static_cast<int>(argv.size()), &argv[0], &argvlen[0]));
+  if (!reply) {
+    return contextError(source);
+  }
+
+  if (reply->type == REDIS_REPLY_ERROR) {
+    std::string error(reply->str, reply->len);
+    freeReplyObject(reply);
+    for (size_t i = 0; i < keys.size(); ++i) {
+      AddKeyError(keys[i], error);
+    }
+    return common::Error();
+  }
+
+  bool nokey = reply->type == REDIS_REPLY_STATUS && strcasecmp(reply->str, "NOKEY") == 0;
+  freeReplyObject(reply);
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (nokey) {
+    stats_.skipped += keys.size();
+  } else {
+    stats_.migrated += keys.size();
+  }
+  return common::Error();
+}
+
+bool Migrator::PushBatch(const Batch& batch) {
+  const size_t capacity = options_.partitions * MIGRATE_QUEUE_BATCHES_PER_PARTITION;
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (queue_.size() >= capacity && !stop_) {
+    space_cond_.wait(lock);
+  }
+
+  if (stop_) {
+    return false;
+  }
+
+  cursors_[batch.seq] = batch.cursor_after;
+  queue_.push_back(batch);
+  queue_cond_.notify_one();
+  return true;
+}
+
+bool Migrator::PopBatch(Batch* batch) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (queue_.empty() && !scan_finished_ && !stop_) {
+    queue_cond_.wait(lock);
+  }
+
+  if (stop_ || queue_.empty()) {
+    return false;
+  }
+
+  *batch = queue_.front();
+  queue_.pop_front();
+  space_cond_.notify_one();
+  return true;
+}
+
+void Migrator::FinishBatch(const Batch& batch) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  done_seqs_.insert(batch.seq);
+  // cursor moves only when all previous batches are done
+  while (done_seqs_.erase(next_done_seq_)) {
+    stats_.cursor = cursors_[next_done_seq_];
+    cursors_.erase(next_done_seq_);
+    next_done_seq_++;
+  }
+}
+
+bool Migrator::AcquireBytes(uint64_t size, uint64_t held) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (inflight_bytes_ + size > options_.max_inflight_bytes && held != 0) {
+    return false;  // caller should release own bytes first, so workers never wait on each other
+  }
+
+  // payload bigger than whole budget passes when nothing else is held
+  while (inflight_bytes_ != 0 && inflight_bytes_ + size > options_.max_inflight_bytes && !stop_) {
+    bytes_cond_.wait(lock);
+  }
+  inflight_bytes_ += size;
+  return true;
+}
+
+void Migrator::ReleaseBytes(uint64_t size) {
+  if (size == 0) {
+    return;
+  }
+
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    inflight_bytes_ -= size;
+  }
+  bytes_cond_.notify_all();
+}
+
+void Migrator::SetFatalError(common::Error err) {
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!fatal_error_) {
+      fatal_error_ = err;
+    }
+    stop_ = true;
+  }
+  queue_cond_.notify_all();
+  space_cond_.notify_all();
+  bytes_cond_.notify_all();
+}
+
+void Migrator::AddKeyError(const std::string& key, const std::string& error) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  stats_.errors++;
+  if (stats_.error_keys.size() < MIGRATE_MAX_REPORTED_ERRORS) {
+    stats_.error_keys.push_back(common::MemSPrintf("%s: %s", key, error));
+  }
+}
+
+}  // namespace redis
+}  // namespace core
+}  // namespace fastonosql
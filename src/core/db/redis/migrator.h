@@ -0,0 +1,137 @@
+/*  Copyright (C) 2014-2016 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <stddef.h>  // for size_t
+#include <stdint.h>  // for uint64_t
+
+#include <condition_variable>  // for condition_variable
+#include <deque>               // for deque
+#include <functional>          // for function
+#include <map>                 // for map
+#include <mutex>               // for mutex
+#include <set>                 // for set
+#include <string>              // for string
+#include <vector>              // for vector
+
+#include <common/error.h>   // for Error
+#include <common/macros.h>  // for WARN_UNUSED_RESULT
+#include <common/types.h>   // for time64_t
+
+#include "core/db/redis/db_connection.h"  // for RConfig, NativeConnection
+
+#define MIGRATE_MAX_REPORTED_ERRORS 100
+
+namespace fastonosql {
+namespace core {
+namespace redis {
+
+struct MigrateOptions {
+  MigrateOptions();
+
+  std::string pattern;
+  uint64_t cursor;    // SCAN cursor to resume from
+  size_t partitions;  // parallel workers, each with own pair of connections
+  size_t batch_size;  // SCAN COUNT and keys per pipeline
+  bool use_migrate;   // MIGRATE ... COPY REPLACE KEYS, target should be reachable from source
+  int migrate_timeout_msec;
+  uint64_t max_inflight_bytes;  // DUMP payloads held by all workers before RESTORE
+};
+
+struct MigrateStats {
+  MigrateStats();
+
+  double KeysPerSecond() const;
+
+  uint64_t scanned;
+  uint64_t migrated;
+  uint64_t skipped;  // expired or removed while migrating
+  uint64_t errors;
+  uint64_t bytes;   // DUMP payloads transferred through client
+  uint64_t cursor;  // resume point, every key scanned before it is migrated
+  bool finished;
+  common::time64_t elapsed_msec;
+  std::vector<std::string> error_keys;  // first MIGRATE_MAX_REPORTED_ERRORS errors
+};
+
+// SCAN on source feeds batches of keys into bounded queue,
+// workers copy them with DUMP + PTTL / RESTORE ... REPLACE pipelines
+class Migrator {
+ public:
+  typedef std::function<void(const MigrateStats&)> progress_callback_t;
+  typedef std::function<bool()> interrupt_callback_t;
+
+  Migrator(const RConfig& source, const RConfig& target, const MigrateOptions& options);
+
+  common::Error Run(interrupt_callback_t is_interrupted,
+                    progress_callback_t progress_cb,
+                    MigrateStats* stats) WARN_UNUSED_RESULT;
+
+ private:
+  struct Batch {
+    uint64_t seq;
+    uint64_t cursor_after;
+    std::vector<std::string> keys;
+  };
+
+  struct DumpedKey {
+    const std::string* key;
+    std::string payload;
+    long long ttl_msec;
+  };
+
+  void WorkerRoutine();
+  common::Error DumpRestoreBatch(NativeConnection* source,
+                                 NativeConnection* target,
+                                 const Batch& batch) WARN_UNUSED_RESULT;
+  common::Error RestoreKeys(NativeConnection* target,
+                            std::vector<DumpedKey>* dumped) WARN_UNUSED_RESULT;
+  common::Error MigrateBatch(NativeConnection* source, const Batch& batch) WARN_UNUSED_RESULT;
+
+  bool PushBatch(const Batch& batch);
+  bool PopBatch(Batch* batch);
+  void FinishBatch(const Batch& batch);
+  bool AcquireBytes(uint64_t size, uint64_t held);
+  void ReleaseBytes(uint64_t size);
+  void SetFatalError(common::Error err);
+  void AddKeyError(const std::string& key, const std::string& error);
+
+  const RConfig source_;
+  const RConfig target_;
+  const MigrateOptions options_;
+
+  std::mutex mutex_;
+  std::condition_variable queue_cond_;
+  std::condition_variable space_cond_;
+  std::condition_variable bytes_cond_;
+  std::deque<Batch> queue_;
+  bool scan_finished_;
+  bool stop_;
+  common::Error fatal_error_;
+  uint64_t inflight_bytes_;
+
+  uint64_t next_done_seq_;
+  std::set<uint64_t> done_seqs_;
+  std::map<uint64_t, uint64_t> cursors_;  // cursor_after of not finished batches by seq
+  MigrateStats stats_;
+};
+
+}  // namespace redis
+}  // namespace core
+}  // namespace fastonosql
@@ -53,6 +53,40 @@ Config parseOptions(int argc, char** argv) {
       cfg.dbname = argv[++i];
     } else if (!strcmp(argv[i], "-c")) {
       cfg.create_if_missing = true;
+    } else if (!strcmp(argv[i], "-ro")) {
+      cfg.open_mode = OPEN_READ_ONLY;
+    } else if (!strcmp(argv[i], "-secondary") && !lastarg) {
+      cfg.open_mode = OPEN_SECONDARY;
+      cfg.secondary_path = argv[++i];
+    } else if (!strcmp(argv[i], "-catch-up") && !lastarg) {
+      int interval;
+      if (common::ConvertFromString(argv[++i], &interval)) {
+        cfg.catch_up_interval_msec = interval;
+      }
+    } else if (!strcmp(argv[i], "-block-cache") && !lastarg) {
+      size_t size;
+      if (common::ConvertFromString(argv[++i], &size)) {
+        cfg.block_cache_size = size;
+      }
+    } else if (!strcmp(argv[i], "-bloom-bits") && !lastarg) {
+      int bits;
+      if (common::ConvertFromString(argv[++i], &bits)) {
+        cfg.bloom_bits_per_key = bits;
+      }
+    } else if (!strcmp(argv[i], "-max-open-files") && !lastarg) {
+      int files;
+      if (common::ConvertFromString(argv[++i], &files)) {
+        cfg.max_open_files = files;
+      }
+    } else if (!strcmp(argv[i], "-readahead") && !lastarg) {
+      size_t size;
+      if (common::ConvertFromString(argv[++i], &size)) {
+        cfg.readahead_size = size;
+      }
+    } else if (!strcmp(argv[i], "-no-stats")) {
+      cfg.enable_statistics = false;
+    } else if (!strcmp(argv[i], "-scan-snapshots")) {
+      cfg.scan_snapshots = true;
     } else {
       if (argv[i][0] == '-') {
         const std::string buff = common::MemSPrintf(
@@ -73,7 +107,25 @@ Config parseOptions(int argc, char** argv) {
 }  // namespace
 
 Config::Config()
-    : LocalConfig(common::file_system::prepare_path("~/test.rocksdb")), create_if_missing(false) {}
+    : LocalConfig(common::file_system::prepare_path("~/test.rocksdb")),
+      create_if_missing(false),
+      open_mode(OPEN_READ_WRITE),
+      secondary_path(),
+      catch_up_interval_msec(ROCKSDB_DEFAULT_CATCH_UP_INTERVAL_MSEC),
+      block_cache_size(ROCKSDB_DEFAULT_BLOCK_CACHE_SIZE),
+      bloom_bits_per_key(0),
+      max_open_files(-1),
+      readahead_size(0),
+      enable_statistics(true),
+      scan_snapshots(false) {}
+
+std::string Config::SecondaryPath() const {
+  if (!secondary_path.empty()) {
+    return secondary_path;
+  }
+
+  return dbname + ".secondary";
+}
 
 }  // namespace rocksdb
 }  // namespace core
@@ -88,6 +140,30 @@ std::string ConvertToString(const fastonosql::core::rocksdb::Config& conf) {
     argv.push_back("-c");
   }
 
+  if (conf.open_mode == fastonosql::core::rocksdb::OPEN_READ_ONLY) {
+    argv.push_back("-ro");
+  } else if (conf.open_mode == fastonosql::core::rocksdb::OPEN_SECONDARY) {
+    argv.push_back("-secondary");
+    argv.push_back(conf.SecondaryPath());
+  }
+
+  argv.push_back("-catch-up");
+  argv.push_back(ConvertToString(conf.catch_up_interval_msec));
+  argv.push_back("-block-cache");
+  argv.push_back(ConvertToString(conf.block_cache_size));
+  argv.push_back("-bloom-bits");
+  argv.push_back(ConvertToString(conf.bloom_bits_per_key));
+  argv.push_back("-max-open-files");
+  argv.push_back(ConvertToString(conf.max_open_files));
+  argv.push_back("-readahead");
+  argv.push_back(ConvertToString(conf.readahead_size));
+  if (!conf.enable_statistics) {
+    argv.push_back("-no-stats");
+  }
+  if (conf.scan_snapshots) {
+    argv.push_back("-scan-snapshots");
+  }
+
   return fastonosql::core::ConvertToStringConfigArgs(argv);
 }
 
@@ -20,16 +20,38 @@
 
 #include <string>
 
+#include <stddef.h>  // for size_t
+
 #include "core/config/config.h"
 
+#define ROCKSDB_DEFAULT_BLOCK_CACHE_SIZE (64 * 1024 * 1024)
+#define ROCKSDB_DEFAULT_CATCH_UP_INTERVAL_MSEC 1000
+
 namespace fastonosql {
 namespace core {
 namespace rocksdb {
 
+enum OpenMode {
+  OPEN_READ_WRITE = 0,
+  OPEN_READ_ONLY,  // no db lock, db can be owned by other process
+  OPEN_SECONDARY   // follows primary with TryCatchUpWithPrimary
+};
+
 struct Config : public LocalConfig {
   Config();
 
+  std::string SecondaryPath() const;  // secondary_path or folder near dbname
+
   bool create_if_missing;
+  OpenMode open_mode;
+  std::string secondary_path;  // own info log and manifest copy of secondary instance
+  int catch_up_interval_msec;
+  size_t block_cache_size;  // bytes, 0 - rocksdb default
+  int bloom_bits_per_key;   // 0 - without bloom filter
+  int max_open_files;       // -1 - unlimited
+  size_t readahead_size;    // bytes of iterator readahead, 0 - disabled
+  bool enable_statistics;   // tickers and histograms for info, costs some cpu
+  bool scan_snapshots;      // pages of one SCAN are read from same snapshot
 };
 
 }  // namespace rocksdb
@@ -20,22 +20,38 @@
 
 #include <string.h>  // for strtok
 
-#include <memory>  // for __shared_ptr
+#include <algorithm>  // for sort
+#include <map>        // for map
+#include <memory>  // for shared_ptr
 #include <string>  // for string, operator<, etc
 #include <vector>  // for vector
 
+#include <rocksdb/cache.h>        // for NewLRUCache
 #include <rocksdb/db.h>
+#include <rocksdb/filter_policy.h>  // for NewBloomFilterPolicy
+#include <rocksdb/iostats_context.h>  // for get_iostats_context
+#include <rocksdb/metadata.h>         // for LiveFileMetaData
+#include <rocksdb/perf_context.h>     // for get_perf_context
+#include <rocksdb/perf_level.h>       // for SetPerfLevel
+#include <rocksdb/statistics.h>       // for CreateDBStatistics
+#include <rocksdb/table.h>          // for BlockBasedTableOptions
+#include <rocksdb/utilities/checkpoint.h>  // for Checkpoint
+#include <rocksdb/version.h>        // for ROCKSDB_MAJOR
+#include <rocksdb/write_batch.h>    // for WriteBatch
 
 #include <common/file_system.h>     // for is_directory
 #include <common/string_util.h>     // for MatchPattern
 #include <common/types.h>           // for tribool, tribool::SUCCESS
 #include <common/convert2string.h>  // for ConvertFromString
 #include <common/sprintf.h>         // for MemSPrintf
+#include <common/time.h>            // for current_mstime
 #include <common/value.h>           // for Value::ErrorsType::E_ERROR, etc
 
 #include "core/command_holder.h"       // for CommandHolder
 #include "core/internal/connection.h"  // for Connection<>::handle_t, etc
 #include "core/internal/db_connection.h"
+#include "core/global.h"               // for FastoObject
+#include "core/partitioned_scan.h"     // for CountKeysPartitioned, CDBPartitionedSource
 
 #include "core/db/rocksdb/config.h"  // for Config
 #include "core/db/rocksdb/database_info.h"
@@ -55,6 +71,10 @@
   "-----"                                                  \
   "--------------------------------------\n"
 
+#define ROCKSDB_MB (1024 * 1024)
+#define ROCKSDB_KEYSPACE_END "\xff\xff\xff\xff"
+#define ROCKSDB_SIZE_ERROR_MARGIN 0.1
+
 namespace fastonosql {
 namespace core {
 namespace internal {
@@ -106,64 +126,60 @@ CDBConnection<rocksdb::NativeConnection, rocksdb::Config, ROCKSDB>::Commands() {
 }
 }  // namespace internal
 namespace rocksdb {
+namespace {
 
-common::Error CreateConnection(const Config& config, NativeConnection** context) {
-  if (!context) {
-    return common::make_error_value("Invalid input argument(s)", common::ErrorValue::E_ERROR);
-  }
-
-  DCHECK(*context == nullptr);
-  ::rocksdb::DB* lcontext = nullptr;
-  std::string folder = config.dbname;  // start point must be folder
-  common::tribool is_dir = common::file_system::is_directory(folder);
-  if (is_dir != common::SUCCESS) {
-    return common::make_error_value(common::MemSPrintf("Invalid input path(%s)", folder),
-                                    common::ErrorValue::E_ERROR);
-  }
-
+::rocksdb::Options makeOptions(const Config& config) {
   ::rocksdb::Options rs;
   rs.create_if_missing = config.create_if_missing;
-  auto st = ::rocksdb::DB::Open(rs, folder, &lcontext);
-  if (!st.ok()) {
-    std::string buff = common::MemSPrintf("Fail open database: %s!", st.ToString());
-    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
-  }
-
-  *context = lcontext;
-  return common::Error();
-}
+  rs.max_open_files = config.max_open_files;
 
-common::Error TestConnection(const Config& config) {
-  ::rocksdb::DB* ldb = nullptr;
-  common::Error er = CreateConnection(config, &ldb);
-  if (er && er->IsError()) {
-    return er;
+  ::rocksdb::BlockBasedTableOptions table_options;
+  if (config.block_cache_size) {
+    table_options.block_cache = ::rocksdb::NewLRUCache(config.block_cache_size);
   }
-
-  delete ldb;
-  return common::Error();
+  if (config.bloom_bits_per_key > 0) {
+    table_options.filter_policy.reset(
+        ::rocksdb::NewBloomFilterPolicy(config.bloom_bits_per_key, false));
+  }
+  rs.table_factory.reset(::rocksdb::NewBlockBasedTableFactory(table_options));
+  if (config.enable_statistics) {
+    rs.statistics = ::rocksdb::CreateDBStatistics();
+  }
+  return rs;
 }
 
-DBConnection::DBConnection(CDBConnectionClient* client)
-    : base_class(client, new CommandTranslator(base_class::Commands())) {}
-
-common::Error DBConnection::Info(const char* args, ServerInfo::Stats* statsout) {
-  UNUSED(args);
-  if (!statsout) {
-    DNOTREACHED();
-    return common::make_error_value("Invalid input argument(s)", common::ErrorValue::E_ERROR);
+double cfStatsValue(const std::map<std::string, std::string>& cfstats, const std::string& name) {
+  auto it = cfstats.find(name);
+  if (it == cfstats.end()) {
+    return 0;
   }
 
-  if (!IsConnected()) {
-    return common::make_error_value("Not connected", common::Value::E_ERROR);
+  double value;
+  if (!common::ConvertFromString(it->second, &value)) {
+    return 0;
   }
 
-  std::string rets;
-  bool isok = connection_.handle_->GetProperty("rocksdb.stats", &rets);
-  if (!isok) {
-    return common::make_error_value("info function failed", common::ErrorValue::E_ERROR);
+  return value;
+}
+
+ServerInfo::Stats statsFromCFStats(const std::map<std::string, std::string>& cfstats,
+                                   int levels) {
+  // compaction stats of all levels are in "Sum" row
+  ServerInfo::Stats lstatsout;
+  for (int i = 0; i < levels; ++i) {
+    if (cfStatsValue(cfstats, common::MemSPrintf("compaction.L%d.NumFiles", i))) {
+      lstatsout.compactions_level = i + 1;
+    }
   }
+  lstatsout.file_size_mb = cfStatsValue(cfstats, "compaction.Sum.SizeBytes") / ROCKSDB_MB;
+  lstatsout.time_sec = cfStatsValue(cfstats, "compaction.Sum.CompSec");
+  lstatsout.read_mb = cfStatsValue(cfstats, "compaction.Sum.ReadGB") * 1024;
+  lstatsout.write_mb = cfStatsValue(cfstats, "compaction.Sum.WriteGB") * 1024;
+  return lstatsout;
+}
 
+// rocksdb without map properties
+ServerInfo::Stats statsFromText(std::string rets) {
   ServerInfo::Stats lstatsout;
   if (rets.size() > sizeof(ROCKSDB_HEADER_STATS)) {
     const char* retsc = rets.c_str() + sizeof(ROCKSDB_HEADER_STATS);
@@ -213,7 +229,251 @@ common::Error DBConnection::Info(const char* args, ServerInfo::Stats* statsout)
     }
   }
 
-  *statsout = lstatsout;
+  return lstatsout;
+}
+
+}  // namespace
+
+common::Error CreateConnection(const Config& config, NativeConnection** context) {
+  if (!context) {
+    return common::make_error_value("Invalid input argument(s)", common::ErrorValue::E_ERROR);
+  }
+
+  DCHECK(*context == nullptr);
+  ::rocksdb::DB* lcontext = nullptr;
+  std::string folder = config.dbname;  // start point must be folder
+  common::tribool is_dir = common::file_system::is_directory(folder);
+  if (is_dir != common::SUCCESS) {
+    return common::make_error_value(common::MemSPrintf("Invalid input path(%s)", folder),
+                                    common::ErrorValue::E_ERROR);
+  }
+
+  ::rocksdb::Options rs = makeOptions(config);
+  ::rocksdb::Status st;
+  if (config.open_mode == OPEN_READ_ONLY) {
+    st = ::rocksdb::DB::OpenForReadOnly(rs, folder, &lcontext);
+  } else if (config.open_mode == OPEN_SECONDARY) {
+    // secondary instance keeps all table files opened
+    rs.create_if_missing = false;
+    rs.max_open_files = -1;
+    st = ::rocksdb::DB::OpenAsSecondary(rs, folder, config.SecondaryPath(), &lcontext);
+  } else {
+    st = ::rocksdb::DB::Open(rs, folder, &lcontext);
+  }
+  if (!st.ok()) {
+    std::string buff = common::MemSPrintf("Fail open database: %s!", st.ToString());
+    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+  }
+
+  *context = lcontext;
+  return common::Error();
+}
+
+common::Error TestConnection(const Config& config) {
+  ::rocksdb::DB* ldb = nullptr;
+  common::Error er = CreateConnection(config, &ldb);
+  if (er && er->IsError()) {
+    return er;
+  }
+
+  delete ldb;
+  return common::Error();
+}
+
+common::Error RestoreBackup(const Config& config,
+                            const std::string& path,
+                            backup_progress_callback_t progress_cb,
+                            BackupStats* stats) {
+  if (!stats) {
+    DNOTREACHED();
+    return common::make_error_value("Invalid input argument(s)", common::ErrorValue::E_ERROR);
+  }
+
+  ::rocksdb::Env* env = ::rocksdb::Env::Default();
+  auto st = env->FileExists(path + "/CURRENT");
+  if (!st.ok()) {
+    std::string buff = common::MemSPrintf("Invalid backup path(%s): %s", path, st.ToString());
+    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+  }
+
+  auto remove_db = [](const std::string& db_path) {
+    auto st = ::rocksdb::DestroyDB(db_path, ::rocksdb::Options());
+    UNUSED(st);
+  };
+
+  BackupProgress progress(progress_cb, stats);
+  const std::string restored = RestoreTempPath(config.dbname);
+  remove_db(restored);
+  common::Error err = CopyDBFiles(env, path, restored, &progress);
+  if (err && err->IsError()) {
+    remove_db(restored);
+    return err;
+  }
+
+  err = SwapRestored(restored, config.dbname, remove_db);
+  if (err && err->IsError()) {
+    remove_db(restored);
+    return err;
+  }
+
+  progress.Finish();
+  return common::Error();
+}
+
+DBConnection::DBConnection(CDBConnectionClient* client)
+    : base_class(client, new CommandTranslator(base_class::Commands())),
+      last_catch_up_msec_(0),
+      pinned_snapshot_(nullptr),
+      pinned_count_(0),
+      paging_snapshots_() {}
+
+DBConnection::~DBConnection() {
+  ReleaseSnapshots();
+}
+
+void DBConnection::OnDisconnect() {
+  ReleaseSnapshots();
+}
+
+common::Error DBConnection::CatchUpWithPrimary() {
+  if (connection_.config_.open_mode != OPEN_SECONDARY) {
+    return common::Error();
+  }
+
+  const common::time64_t cur_time = common::time::current_mstime();
+  if (cur_time - last_catch_up_msec_ < connection_.config_.catch_up_interval_msec) {
+    return common::Error();
+  }
+
+  auto st = connection_.handle_->TryCatchUpWithPrimary();
+  if (!st.ok()) {
+    std::string buff = common::MemSPrintf("catch up with primary error: %s", st.ToString());
+    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+  }
+
+  last_catch_up_msec_ = cur_time;
+  return common::Error();
+}
+
+bool DBConnection::IsSnapshotsSupported() const {
+  return connection_.config_.open_mode == OPEN_READ_WRITE;
+}
+
+::rocksdb::ReadOptions DBConnection::PointReadOptions() const {
+  // interactive reads see current state even while long operation pins snapshot
+  return ::rocksdb::ReadOptions();
+}
+
+::rocksdb::ReadOptions DBConnection::SnapshotReadOptions() const {
+  ::rocksdb::ReadOptions ro;
+  ro.snapshot = pinned_snapshot_;
+  return ro;
+}
+
+::rocksdb::ReadOptions DBConnection::IteratorReadOptions() const {
+  ::rocksdb::ReadOptions ro;
+  ro.readahead_size = connection_.config_.readahead_size;
+  // full scans shouldn't evict hot blocks from block cache
+  ro.fill_cache = false;
+  ro.snapshot = pinned_snapshot_;
+  return ro;
+}
+
+::rocksdb::ReadOptions DBConnection::MultiGetReadOptions() const {
+  ::rocksdb::ReadOptions ro = PointReadOptions();
+#if ROCKSDB_MAJOR >= 7
+  // data blocks of one batch are read in parallel
+  ro.async_io = true;
+#endif
+  return ro;
+}
+
+void DBConnection::ReleaseSnapshots() {
+  if (!IsConnected()) {
+    return;
+  }
+
+  paging_snapshots_.Clear(connection_.handle_);
+  if (pinned_snapshot_) {
+    connection_.handle_->ReleaseSnapshot(pinned_snapshot_);
+    pinned_snapshot_ = nullptr;
+  }
+  pinned_count_ = 0;
+}
+
+common::Error DBConnection::Info(const char* args, ServerInfo* statsout) {
+  UNUSED(args);
+  if (!statsout) {
+    DNOTREACHED();
+    return common::make_error_value("Invalid input argument(s)", common::ErrorValue::E_ERROR);
+  }
+
+  if (!IsConnected()) {
+    return common::make_error_value("Not connected", common::Value::E_ERROR);
+  }
+
+  std::map<std::string, std::string> cfstats;
+  ServerInfo::Stats lstatsout;
+  if (connection_.handle_->GetMapProperty(::rocksdb::DB::Properties::kCFStats, &cfstats)) {
+    lstatsout = statsFromCFStats(cfstats, connection_.handle_->NumberLevels());
+  } else {
+    std::string rets;
+    bool isok = connection_.handle_->GetProperty("rocksdb.stats", &rets);
+    if (!isok) {
+      return common::make_error_value("info function failed", common::ErrorValue::E_ERROR);
+    }
+
+    lstatsout = statsFromText(rets);
+  }
+
+  ServerInfo::Internals linternals;
+  std::shared_ptr< ::rocksdb::Statistics> statistics = connection_.handle_->GetOptions().statistics;
+  if (statistics) {
+    uint64_t hits = statistics->getTickerCount(::rocksdb::BLOCK_CACHE_HIT);
+    uint64_t misses = statistics->getTickerCount(::rocksdb::BLOCK_CACHE_MISS);
+    if (hits + misses) {
+      linternals.block_cache_hit_rate = static_cast<double>(hits) * 100 / (hits + misses);
+    }
+    linternals.bloom_filter_useful = statistics->getTickerCount(::rocksdb::BLOOM_FILTER_USEFUL);
+    linternals.stall_micros = statistics->getTickerCount(::rocksdb::STALL_MICROS);
+    linternals.compact_read_mb =
+        statistics->getTickerCount(::rocksdb::COMPACT_READ_BYTES) / ROCKSDB_MB;
+    linternals.compact_write_mb =
+        statistics->getTickerCount(::rocksdb::COMPACT_WRITE_BYTES) / ROCKSDB_MB;
+    ::rocksdb::HistogramData get_histogram;
+    statistics->histogramData(::rocksdb::DB_GET, &get_histogram);
+    linternals.get_p99_micros = get_histogram.percentile99;
+  }
+
+  linternals.l0_files = cfStatsValue(cfstats, "compaction.L0.NumFiles");
+  uint64_t pending_compaction_bytes = 0;
+  if (connection_.handle_->GetIntProperty(
+          ::rocksdb::DB::Properties::kEstimatePendingCompactionBytes, &pending_compaction_bytes)) {
+    linternals.pending_compaction_mb = pending_compaction_bytes / ROCKSDB_MB;
+  }
+
+  statsout->stats_ = lstatsout;
+  statsout->internals_ = linternals;
+  return common::Error();
+}
+
+common::Error DBConnection::ExecuteWithPerfContext(const std::string& command, FastoObject* out) {
+  ::rocksdb::SetPerfLevel(::rocksdb::PerfLevel::kEnableTimeExceptForMutex);
+  ::rocksdb::get_perf_context()->Reset();
+  ::rocksdb::get_iostats_context()->Reset();
+  common::Error err = Execute(command, out);
+  ::rocksdb::SetPerfLevel(::rocksdb::PerfLevel::kDisable);
+  if (err && err->IsError()) {
+    return err;
+  }
+
+  // only not zero counters are reported
+  std::string cost = common::MemSPrintf("perf context: %s\niostats context: %s",
+                                        ::rocksdb::get_perf_context()->ToString(true),
+                                        ::rocksdb::get_iostats_context()->ToString(true));
+  common::StringValue* val = common::Value::CreateStringValue(cost);
+  FastoObject* child = new FastoObject(out, val, Delimiter());
+  out->AddChildren(child);
   return common::Error();
 }
 
@@ -231,6 +491,11 @@ common::Error DBConnection::GetInner(const std::string& key, std::string* ret_va
     return common::make_error_value("Not connected", common::Value::E_ERROR);
   }
 
+  common::Error err = CatchUpWithPrimary();
+  if (err && err->IsError()) {
+    return err;
+  }
+
   ::rocksdb::ReadOptions ro;
   auto st = connection_.handle_->Get(ro, key, ret_val);
   if (!st.ok()) {
@@ -247,20 +512,146 @@ common::Error DBConnection::Mget(const std::vector<std::string>& keys,
     return common::make_error_value("Not connected", common::Value::E_ERROR);
   }
 
+  common::Error err = CatchUpWithPrimary();
+  if (err && err->IsError()) {
+    return err;
+  }
+
   std::vector< ::rocksdb::Slice> rslice;
-  for (auto key : keys) {
+  for (const auto& key : keys) {
     rslice.push_back(key);
   }
-  ::rocksdb::ReadOptions ro;
-  auto sts = connection_.handle_->MultiGet(ro, rslice, ret);
+  auto sts = connection_.handle_->MultiGet(MultiGetReadOptions(), rslice, ret);
   for (size_t i = 0; i < sts.size(); ++i) {
     auto st = sts[i];
-    if (st.ok()) {
-      return common::Error();
+    if (!st.ok() && !st.IsNotFound()) {
+      std::string buff = common::MemSPrintf("mget function error: %s", st.ToString());
+      return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+    }
+  }
+
+  return common::Error();
+}
+
+common::Error DBConnection::SstImport(ImportReader* reader,
+                                      const SstLoadOptions& options,
+                                      ImportStats* stats,
+                                      import_progress_callback_t progress_cb) {
+  if (!reader || !stats) {
+    DNOTREACHED();
+    return common::make_error_value("Invalid input argument(s)", common::ErrorValue::E_ERROR);
+  }
+
+  if (!IsConnected()) {
+    return common::make_error_value("Not connected", common::Value::E_ERROR);
+  }
+
+  if (connection_.config_.open_mode != OPEN_READ_WRITE) {
+    return common::make_error_value("Import into read only database", common::ErrorValue::E_ERROR);
+  }
+
+  SstLoader loader(connection_.handle_, options);
+  return loader.Run(reader, [this]() { return IsInterrupted(); }, progress_cb, stats);
+}
+
+common::Error DBConnection::Backup(const std::string& path,
+                                   backup_progress_callback_t progress_cb,
+                                   BackupStats* stats) {
+  if (!stats) {
+    DNOTREACHED();
+    return common::make_error_value("Invalid input argument(s)", common::ErrorValue::E_ERROR);
+  }
+
+  if (!IsConnected()) {
+    return common::make_error_value("Not connected", common::Value::E_ERROR);
+  }
+
+  BackupProgress progress(progress_cb, stats);
+  ::rocksdb::Checkpoint* checkpoint = nullptr;
+  auto st = ::rocksdb::Checkpoint::Create(connection_.handle_, &checkpoint);
+  if (st.ok()) {
+    st = checkpoint->CreateCheckpoint(path);
+    delete checkpoint;
+  }
+  if (!st.ok()) {
+    std::string buff = common::MemSPrintf("BACKUP function error: %s", st.ToString());
+    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+  }
+
+  // checkpoint is made by one call, stats describe its files
+  ::rocksdb::Env* env = ::rocksdb::Env::Default();
+  std::vector<std::string> files;
+  st = env->GetChildren(path, &files);
+  for (size_t i = 0; st.ok() && i < files.size(); ++i) {
+    uint64_t size = 0;
+    if (files[i] == "." || files[i] == "..") {
+      continue;
+    }
+
+    if (env->GetFileSize(path + "/" + files[i], &size).ok()) {
+      stats->files++;
+      stats->total_bytes += size;
+      progress.Add(size, 0);
     }
   }
 
-  return common::make_error_value("mget function unknown error", common::ErrorValue::E_ERROR);
+  progress.Finish();
+  return common::Error();
+}
+
+common::Error DBConnection::EstimateSizes(const namespace_ranges_t& ranges,
+                                          namespace_sizes_t* sizes) {
+  if (!sizes) {
+    DNOTREACHED();
+    return common::make_error_value("Invalid input argument(s)", common::ErrorValue::E_ERROR);
+  }
+
+  if (!IsConnected()) {
+    return common::make_error_value("Not connected", common::Value::E_ERROR);
+  }
+
+  const std::string keyspace_end(ROCKSDB_KEYSPACE_END);
+  std::vector< ::rocksdb::Range> rranges;
+  for (size_t i = 0; i < ranges.size(); ++i) {
+    const std::string& limit = ranges[i].limit.empty() ? keyspace_end : ranges[i].limit;
+    rranges.push_back(::rocksdb::Range(ranges[i].start, limit));
+  }
+
+  std::vector<uint64_t> rsizes(ranges.size(), 0);
+  if (!rranges.empty()) {
+#if ROCKSDB_MAJOR >= 7
+    // files which are small part of all ranges aren't opened
+    ::rocksdb::SizeApproximationOptions options;
+    options.include_files = true;
+    options.include_memtables = false;
+    options.files_size_error_margin = ROCKSDB_SIZE_ERROR_MARGIN;
+    auto st = connection_.handle_->GetApproximateSizes(
+        options, connection_.handle_->DefaultColumnFamily(), rranges.data(),
+        static_cast<int>(rranges.size()), rsizes.data());
+    if (!st.ok()) {
+      std::string buff = common::MemSPrintf("ESTIMATE SIZES function error: %s", st.ToString());
+      return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+    }
+#else
+    connection_.handle_->GetApproximateSizes(rranges.data(), static_cast<int>(rranges.size()),
+                                             rsizes.data());
+#endif
+  }
+
+  namespace_sizes_t result;
+  for (size_t i = 0; i < ranges.size(); ++i) {
+    NamespaceSize size(ranges[i].ns);
+    size.disk_bytes = rsizes[i];
+    uint64_t count = 0;
+    uint64_t bytes = 0;
+    connection_.handle_->GetApproximateMemTableStats(rranges[i], &count, &bytes);
+    UNUSED(count);
+    size.memtable_bytes = bytes;
+    result.push_back(size);
+  }
+
+  *sizes = result;
+  return common::Error();
 }
 
 common::Error DBConnection::Merge(const std::string& key, const std::string& value) {
@@ -318,7 +709,20 @@ common::Error DBConnection::ScanImpl(uint64_t cursor_in,
                                      uint64_t count_keys,
                                      std::vector<std::string>* keys_out,
                                      uint64_t* cursor_out) {
-  ::rocksdb::ReadOptions ro;
+  common::Error err = CatchUpWithPrimary();
+  if (err && err->IsError()) {
+    return err;
+  }
+
+  ::rocksdb::ReadOptions ro = IteratorReadOptions();
+  // offsets of cursors are stable while all pages are read from one snapshot,
+  // forgotten scan continues on current keyspace
+  const ::rocksdb::Snapshot* paging_snapshot = nullptr;
+  if (!pinned_snapshot_ && connection_.config_.scan_snapshots && IsSnapshotsSupported()) {
+    paging_snapshot = paging_snapshots_.Take(connection_.handle_, cursor_in, pattern);
+    ro.snapshot = paging_snapshot;
+  }
+
   ::rocksdb::Iterator* it =
       connection_.handle_->NewIterator(ro);  // keys(key_start, key_end, limit, ret);
   uint64_t offset_pos = cursor_in;
@@ -344,10 +748,12 @@ common::Error DBConnection::ScanImpl(uint64_t cursor_in,
   delete it;
 
   if (!st.ok()) {
+    paging_snapshots_.Put(connection_.handle_, 0, pattern, paging_snapshot);
     std::string buff = common::MemSPrintf("Keys function error: %s", st.ToString());
     return common::make_error_value(buff, common::ErrorValue::E_ERROR);
   }
 
+  paging_snapshots_.Put(connection_.handle_, lcursor_out, pattern, paging_snapshot);
   *keys_out = lkeys_out;
   *cursor_out = lcursor_out;
   return common::Error();
@@ -357,7 +763,12 @@ common::Error DBConnection::KeysImpl(const std::string& key_start,
                                      const std::string& key_end,
                                      uint64_t limit,
                                      std::vector<std::string>* ret) {
-  ::rocksdb::ReadOptions ro;
+  common::Error err = CatchUpWithPrimary();
+  if (err && err->IsError()) {
+    return err;
+  }
+
+  ::rocksdb::ReadOptions ro = IteratorReadOptions();
   ::rocksdb::Iterator* it =
       connection_.handle_->NewIterator(ro);  // keys(key_start, key_end, limit, ret);
   for (it->Seek(key_start); it->Valid(); it->Next()) {
@@ -382,18 +793,20 @@ common::Error DBConnection::KeysImpl(const std::string& key_start,
 }
 
 common::Error DBConnection::DBkcountImpl(size_t* size) {
-  ::rocksdb::ReadOptions ro;
-  ::rocksdb::Iterator* it = connection_.handle_->NewIterator(ro);
-  size_t sz = 0;
-  for (it->SeekToFirst(); it->Valid(); it->Next()) {
-    sz++;
+  common::Error err = CatchUpWithPrimary();
+  if (err && err->IsError()) {
+    return err;
   }
 
-  auto st = it->status();
-  delete it;
-
-  if (!st.ok()) {
-    std::string buff = common::MemSPrintf("Couldn't determine DBKCOUNT error: %s", st.ToString());
+  // estimate-num-keys property is off by merges and deletions,
+  // so ranges of keyspace are counted in parallel
+  CDBPartitionedSource<DBConnection> source(this, false);
+  size_t sz = 0;
+  err = CountKeysPartitioned(&source, PartitionedScanOptions(),
+                             [this]() { return IsInterrupted(); }, &sz);
+  if (err && err->IsError()) {
+    std::string buff =
+        common::MemSPrintf("Couldn't determine DBKCOUNT error: %s", err->Description());
     return common::make_error_value(buff, common::ErrorValue::E_ERROR);
   }
 
@@ -402,7 +815,7 @@ common::Error DBConnection::DBkcountImpl(size_t* size) {
 }
 
 common::Error DBConnection::FlushDBImpl() {
-  ::rocksdb::ReadOptions ro;
+  ::rocksdb::ReadOptions ro = IteratorReadOptions();
   ::rocksdb::WriteOptions wo;
   ::rocksdb::Iterator* it = connection_.handle_->NewIterator(ro);
   for (it->SeekToFirst(); it->Valid(); it->Next()) {
@@ -449,34 +862,148 @@ common::Error DBConnection::SetImpl(const NDbKValue& key, NDbKValue* added_key)
   return common::Error();
 }
 
+common::Error DBConnection::SetBatchImpl(const NDbKValues& keys, NDbKValues* added_keys) {
+  ::rocksdb::WriteBatch batch;
+  for (size_t i = 0; i < keys.size(); ++i) {
+    batch.Put(keys[i].KeyString(), keys[i].ValueString());
+  }
+
+  ::rocksdb::WriteOptions wo;
+  auto st = connection_.handle_->Write(wo, &batch);
+  if (!st.ok()) {
+    std::string buff = common::MemSPrintf("write batch error: %s", st.ToString());
+    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+  }
+
+  added_keys->insert(added_keys->end(), keys.begin(), keys.end());
+  return common::Error();
+}
+
 common::Error DBConnection::GetImpl(const NKey& key, NDbKValue* loaded_key) {
-  std::string key_str = key.Key();
-  std::string value_str;
-  common::Error err = GetInner(key_str, &value_str);
+  return GetWithOptions(PointReadOptions(), key, loaded_key);
+}
+
+common::Error DBConnection::GetFromSnapshotImpl(const NKey& key, NDbKValue* loaded_key) {
+  return GetWithOptions(SnapshotReadOptions(), key, loaded_key);
+}
+
+common::Error DBConnection::GetWithOptions(const ::rocksdb::ReadOptions& ro,
+                                           const NKey& key,
+                                           NDbKValue* loaded_key) {
+  common::Error err = CatchUpWithPrimary();
   if (err && err->IsError()) {
     return err;
   }
 
+  std::string key_str = key.Key();
+  std::string value_str;
+  auto st = connection_.handle_->Get(ro, key_str, &value_str);
+  if (st.IsNotFound()) {
+    return MakeKeyNotFoundError(key_str);
+  }
+
+  if (!st.ok()) {
+    std::string buff = common::MemSPrintf("get function error: %s", st.ToString());
+    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+  }
+
   NValue val(common::Value::CreateStringValue(value_str));
   *loaded_key = NDbKValue(key, val);
   return common::Error();
 }
 
-common::Error DBConnection::DeleteImpl(const NKeys& keys, NKeys* deleted_keys) {
+common::Error DBConnection::GetBatchImpl(const NKeys& keys, NDbKValues* loaded_keys) {
+  if (keys.empty()) {
+    return common::Error();
+  }
+
+  common::Error err = CatchUpWithPrimary();
+  if (err && err->IsError()) {
+    return err;
+  }
+
+  std::vector<std::string> keys_str;
+  keys_str.reserve(keys.size());
   for (size_t i = 0; i < keys.size(); ++i) {
-    NKey key = keys[i];
-    std::string key_str = key.Key();
-    common::Error err = DelInner(key_str);
-    if (err && err->IsError()) {
+    keys_str.push_back(keys[i].Key());
+  }
+
+  std::vector< ::rocksdb::Slice> rslice(keys_str.begin(), keys_str.end());
+  std::vector<std::string> values;
+  auto sts = connection_.handle_->MultiGet(MultiGetReadOptions(), rslice, &values);
+  for (size_t i = 0; i < sts.size(); ++i) {
+    auto st = sts[i];
+    if (st.IsNotFound()) {
       continue;
     }
 
-    deleted_keys->push_back(key);
+    if (!st.ok()) {
+      std::string buff = common::MemSPrintf("mget function error: %s", st.ToString());
+      return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+    }
+
+    NValue val(common::Value::CreateStringValue(values[i]));
+    loaded_keys->push_back(NDbKValue(keys[i], val));
   }
 
   return common::Error();
 }
 
+common::Error DBConnection::DeleteImpl(const NKeys& keys, NKeys* deleted_keys) {
+  // only existing keys are reported, all of them removed by one write batch,
+  // existence is checked on live data by keys of one sorted iterator, values aren't copied
+  std::vector<size_t> order(keys.size());
+  for (size_t i = 0; i < order.size(); ++i) {
+    order[i] = i;
+  }
+  std::sort(order.begin(), order.end(),
+            [&keys](size_t lhs, size_t rhs) { return keys[lhs].Key() < keys[rhs].Key(); });
+
+  std::vector<bool> found(keys.size(), false);
+  ::rocksdb::ReadOptions ro;
+  ro.fill_cache = false;
+  ::rocksdb::Iterator* it = connection_.handle_->NewIterator(ro);
+  for (size_t i = 0; i < order.size(); ++i) {
+    const std::string key = keys[order[i]].Key();
+    if (!it->Valid() || it->key().compare(key) < 0) {
+      it->Seek(key);
+    }
+
+    found[order[i]] = it->Valid() && it->key() == key;
+  }
+
+  auto ist = it->status();
+  delete it;
+
+  if (!ist.ok()) {
+    std::string buff = common::MemSPrintf("delete function error: %s", ist.ToString());
+    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+  }
+
+  ::rocksdb::WriteBatch batch;
+  NKeys existing_keys;
+  for (size_t i = 0; i < keys.size(); ++i) {
+    if (found[i]) {
+      batch.Delete(keys[i].Key());
+      existing_keys.push_back(keys[i]);
+    }
+  }
+
+  if (existing_keys.empty()) {
+    return common::Error();
+  }
+
+  ::rocksdb::WriteOptions wo;
+  auto st = connection_.handle_->Write(wo, &batch);
+  if (!st.ok()) {
+    std::string buff = common::MemSPrintf("write batch error: %s", st.ToString());
+    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+  }
+
+  deleted_keys->insert(deleted_keys->end(), existing_keys.begin(), existing_keys.end());
+  return common::Error();
+}
+
 common::Error DBConnection::RenameImpl(const NKey& key, const std::string& new_key) {
   std::string key_str = key.Key();
   std::string value_str;
@@ -523,6 +1050,117 @@ common::Error DBConnection::QuitImpl() {
   return common::Error();
 }
 
+void DBConnection::PinSnapshotImpl() {
+  if (!IsSnapshotsSupported()) {
+    return;
+  }
+
+  if (pinned_count_++ == 0) {
+    pinned_snapshot_ = connection_.handle_->GetSnapshot();
+  }
+}
+
+void DBConnection::UnpinSnapshotImpl() {
+  if (pinned_count_ == 0) {
+    return;
+  }
+
+  if (--pinned_count_ == 0) {
+    connection_.handle_->ReleaseSnapshot(pinned_snapshot_);
+    pinned_snapshot_ = nullptr;
+  }
+}
+
+common::Error DBConnection::PartitionImpl(size_t count, key_ranges_t* ranges) {
+  common::Error err = CatchUpWithPrimary();
+  if (err && err->IsError()) {
+    return err;
+  }
+
+  // boundaries of sst files split keyspace without reading any block,
+  // pieces between them are weighted by sizes of files
+  std::vector< ::rocksdb::LiveFileMetaData> files;
+  connection_.handle_->GetLiveFilesMetaData(&files);
+  internal::weighted_bounds_t bounds;
+  for (size_t i = 0; i < files.size(); ++i) {
+    if (files[i].column_family_name == ::rocksdb::kDefaultColumnFamilyName) {
+      bounds.push_back(std::make_pair(files[i].largestkey + '\0', files[i].size));
+    }
+  }
+
+  if (bounds.size() >= count) {
+    std::sort(bounds.begin(), bounds.end());
+    *ranges = internal::SplitByWeights(bounds, count);
+    return common::Error();
+  }
+
+  // few files (small or fresh database), pieces are sized by prefixes
+  const std::string keyspace_end(ROCKSDB_KEYSPACE_END);
+  auto sizes_func = [this, &keyspace_end](const key_ranges_t& pieces,
+                                          std::vector<uint64_t>* sizes) {
+    std::vector< ::rocksdb::Range> rranges;
+    for (size_t i = 0; i < pieces.size(); ++i) {
+      const std::string& limit = pieces[i].limit.empty() ? keyspace_end : pieces[i].limit;
+      rranges.push_back(::rocksdb::Range(pieces[i].start, limit));
+    }
+
+    std::vector<uint64_t> rsizes(pieces.size(), 0);
+    connection_.handle_->GetApproximateSizes(rranges.data(), static_cast<int>(rranges.size()),
+                                             rsizes.data());
+    *sizes = rsizes;
+    return true;
+  };
+
+  *ranges = internal::SplitBySizes(sizes_func, count);
+  return common::Error();
+}
+
+common::Error DBConnection::ScanRangeImpl(const KeyRange& range,
+                                          const std::string& pattern,
+                                          size_t batch_size,
+                                          bool with_values,
+                                          range_batch_callback_t batch_cb) {
+  ::rocksdb::ReadOptions ro = IteratorReadOptions();
+  // iterator doesn't read blocks behind range
+  ::rocksdb::Slice upper_bound(range.limit);
+  if (!range.limit.empty()) {
+    ro.iterate_upper_bound = &upper_bound;
+  }
+
+  ::rocksdb::Iterator* it = connection_.handle_->NewIterator(ro);
+  NDbKValues batch;
+  bool stopped = false;
+  for (it->Seek(range.start); it->Valid() && !stopped; it->Next()) {
+    std::string key = it->key().ToString();
+    if (!common::MatchPattern(key, pattern)) {
+      continue;
+    }
+
+    NValue val;
+    if (with_values) {
+      val = NValue(common::Value::CreateStringValue(it->value().ToString()));
+    }
+    batch.push_back(NDbKValue(NKey(key), val));
+    if (batch.size() >= batch_size) {
+      stopped = !batch_cb(batch);
+      batch.clear();
+    }
+  }
+
+  auto st = it->status();
+  delete it;
+
+  if (!st.ok()) {
+    std::string buff = common::MemSPrintf("SCAN function error: %s", st.ToString());
+    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+  }
+
+  if (!stopped && !batch.empty()) {
+    batch_cb(batch);
+  }
+  return common::Error();
+}
+
 }  // namespace rocksdb
 }  // namespace core
 }  // namespace fastonosql
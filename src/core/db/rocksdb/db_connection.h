@@ -21,22 +21,30 @@
 #include <stddef.h>  // for size_t
 #include <stdint.h>  // for uint64_t
 
-#include <string>  // for string
-#include <vector>  // for vector
+#include <functional>  // for function
+#include <string>      // for string
+#include <vector>      // for vector
 
 #include <common/error.h>   // for Error
 #include <common/macros.h>  // for WARN_UNUSED_RESULT
+#include <common/types.h>   // for time64_t
 
+#include "core/backup.h"  // for BackupStats, backup_progress_callback_t
 #include "core/internal/cdb_connection.h"
+#include "core/internal/paging_snapshots.h"  // for PagingSnapshots
 
 #include "core/connection_types.h"  // for connectionTypes::ROCKSDB
 #include "core/db_key.h"            // for NKey (ptr only), etc
+#include "core/namespace_size.h"     // for namespace_ranges_t, namespace_sizes_t
 
 #include "core/db/rocksdb/config.h"
 #include "core/db/rocksdb/server_info.h"
+#include "core/db/rocksdb/sst_loader.h"  // for SstLoadOptions
 
 namespace rocksdb {
 class DB;
+class Snapshot;
+struct ReadOptions;
 }
 
 namespace fastonosql {
@@ -47,22 +55,64 @@ typedef ::rocksdb::DB NativeConnection;
 
 common::Error CreateConnection(const Config& config, NativeConnection** context);
 common::Error TestConnection(const Config& config);
+// replaces files of closed database by files of backup
+common::Error RestoreBackup(const Config& config,
+                            const std::string& path,
+                            backup_progress_callback_t progress_cb,
+                            BackupStats* stats) WARN_UNUSED_RESULT;
 
 class DBConnection : public core::internal::CDBConnection<NativeConnection, Config, ROCKSDB> {
  public:
   typedef core::internal::CDBConnection<NativeConnection, Config, ROCKSDB> base_class;
+  typedef std::function<void(const ImportStats&)> import_progress_callback_t;
   explicit DBConnection(CDBConnectionClient* client);
+  virtual ~DBConnection();
 
   std::string CurrentDBName() const;
 
-  common::Error Info(const char* args, ServerInfo::Stats* statsout) WARN_UNUSED_RESULT;
+  common::Error Info(const char* args, ServerInfo* statsout) WARN_UNUSED_RESULT;
+  // appends perf and iostats context counters of command to its output
+  common::Error ExecuteWithPerfContext(const std::string& command,
+                                       FastoObject* out) WARN_UNUSED_RESULT;
   common::Error Mget(const std::vector<std::string>& keys, std::vector<std::string>* ret);
   common::Error Merge(const std::string& key, const std::string& value) WARN_UNUSED_RESULT;
 
+  // bulk load through sst files, see SstLoader
+  common::Error SstImport(ImportReader* reader,
+                          const SstLoadOptions& options,
+                          ImportStats* stats,
+                          import_progress_callback_t progress_cb) WARN_UNUSED_RESULT;
+
+  // checkpoint: live sst files are hard linked (copied if path is on other
+  // file system) and manifest is copied, path shouldn't exist
+  common::Error Backup(const std::string& path,
+                       backup_progress_callback_t progress_cb,
+                       BackupStats* stats) WARN_UNUSED_RESULT;
+
+  // sizes of sst files of ranges by one GetApproximateSizes call and
+  // memtable stats of every range, values aren't read
+  common::Error EstimateSizes(const namespace_ranges_t& ranges,
+                              namespace_sizes_t* sizes) WARN_UNUSED_RESULT;
+
  private:
+  typedef core::internal::PagingSnapshots<NativeConnection, ::rocksdb::Snapshot> paging_snapshots_t;
+
+  // secondary instance applies new primary changes not often than catch_up_interval_msec
+  common::Error CatchUpWithPrimary() WARN_UNUSED_RESULT;
+  // read only and secondary instances don't take snapshots
+  bool IsSnapshotsSupported() const;
+  ::rocksdb::ReadOptions PointReadOptions() const;
+  ::rocksdb::ReadOptions SnapshotReadOptions() const;
+  ::rocksdb::ReadOptions IteratorReadOptions() const;
+  ::rocksdb::ReadOptions MultiGetReadOptions() const;
+  void ReleaseSnapshots();
+
   common::Error SetInner(const std::string& key, const std::string& value) WARN_UNUSED_RESULT;
   common::Error GetInner(const std::string& key, std::string* ret_val) WARN_UNUSED_RESULT;
   common::Error DelInner(const std::string& key) WARN_UNUSED_RESULT;
+  common::Error GetWithOptions(const ::rocksdb::ReadOptions& ro,
+                               const NKey& key,
+                               NDbKValue* loaded_key) WARN_UNUSED_RESULT;
 
   virtual common::Error ScanImpl(uint64_t cursor_in,
                                  const std::string& pattern,
@@ -77,12 +127,30 @@ class DBConnection : public core::internal::CDBConnection<NativeConnection, Conf
   virtual common::Error FlushDBImpl() override;
   virtual common::Error SelectImpl(const std::string& name, IDataBaseInfo** info) override;
   virtual common::Error SetImpl(const NDbKValue& key, NDbKValue* added_key) override;
+  virtual common::Error SetBatchImpl(const NDbKValues& keys, NDbKValues* added_keys) override;
   virtual common::Error GetImpl(const NKey& key, NDbKValue* loaded_key) override;
+  virtual common::Error GetBatchImpl(const NKeys& keys, NDbKValues* loaded_keys) override;
   virtual common::Error DeleteImpl(const NKeys& keys, NKeys* deleted_keys) override;
   virtual common::Error RenameImpl(const NKey& key, const std::string& new_key) override;
   virtual common::Error SetTTLImpl(const NKey& key, ttl_t ttl) override;
   virtual common::Error GetTTLImpl(const NKey& key, ttl_t* ttl) override;
   virtual common::Error QuitImpl() override;
+  // snapshots should be released before db is closed
+  virtual void OnDisconnect() override;
+  virtual void PinSnapshotImpl() override;
+  virtual void UnpinSnapshotImpl() override;
+  virtual common::Error GetFromSnapshotImpl(const NKey& key, NDbKValue* loaded_key) override;
+  virtual common::Error PartitionImpl(size_t count, key_ranges_t* ranges) override;
+  virtual common::Error ScanRangeImpl(const KeyRange& range,
+                                      const std::string& pattern,
+                                      size_t batch_size,
+                                      bool with_values,
+                                      range_batch_callback_t batch_cb) override;
+
+  common::time64_t last_catch_up_msec_;
+  const ::rocksdb::Snapshot* pinned_snapshot_;
+  size_t pinned_count_;
+  paging_snapshots_t paging_snapshots_;
 };
 
 }  // namespace rocksdb
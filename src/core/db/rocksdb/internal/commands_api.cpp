@@ -39,13 +39,13 @@ common::Error CommandsApi::Info(internal::CommandHandler* handler,
                                 const char** argv,
                                 FastoObject* out) {
   DBConnection* rocks = static_cast<DBConnection*>(handler);
-  ServerInfo::Stats statsout;
+  ServerInfo statsout;
   common::Error err = rocks->Info(argc == 1 ? argv[0] : nullptr, &statsout);
   if (err && err->IsError()) {
     return err;
   }
 
-  common::StringValue* val = common::Value::CreateStringValue(ServerInfo(statsout).ToString());
+  common::StringValue* val = common::Value::CreateStringValue(statsout.ToString());
   FastoObject* child = new FastoObject(out, val, rocks->Delimiter());
   out->AddChildren(child);
   return common::Error();
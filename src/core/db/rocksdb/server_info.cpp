@@ -45,6 +45,28 @@ const std::vector<Field> rockCommonFields = {
     Field(ROCKSDB_READ_MB_LABEL, common::Value::TYPE_UINTEGER),
     Field(ROCKSDB_WRITE_MB_LABEL, common::Value::TYPE_UINTEGER)};
 
+const std::vector<Field> rockInternalsFields = {
+    Field(ROCKSDB_BLOCK_CACHE_HIT_RATE_LABEL, common::Value::TYPE_DOUBLE),
+    Field(ROCKSDB_BLOOM_FILTER_USEFUL_LABEL, common::Value::TYPE_ULONG_LONG_INTEGER),
+    Field(ROCKSDB_STALL_MICROS_LABEL, common::Value::TYPE_ULONG_LONG_INTEGER),
+    Field(ROCKSDB_COMPACT_READ_MB_LABEL, common::Value::TYPE_UINTEGER),
+    Field(ROCKSDB_COMPACT_WRITE_MB_LABEL, common::Value::TYPE_UINTEGER),
+    Field(ROCKSDB_GET_P99_MICROS_LABEL, common::Value::TYPE_DOUBLE),
+    Field(ROCKSDB_L0_FILES_LABEL, common::Value::TYPE_UINTEGER),
+    Field(ROCKSDB_PENDING_COMPACTION_MB_LABEL, common::Value::TYPE_UINTEGER)};
+
+// text between label and next section
+std::string sectionText(const std::string& content, const std::string& label) {
+  size_t start = content.find(label);
+  if (start == std::string::npos) {
+    return std::string();
+  }
+
+  start += label.size();
+  size_t end = content.find('#', start);
+  return content.substr(start, end == std::string::npos ? std::string::npos : end - start);
+}
+
 }  // namespace
 
 template <>
@@ -55,7 +77,8 @@ std::vector<common::Value::Type> DBTraits<ROCKSDB>::SupportedTypes() {
 
 template <>
 std::vector<info_field_t> DBTraits<ROCKSDB>::InfoFields() {
-  return {std::make_pair(ROCKSDB_STATS_LABEL, rockCommonFields)};
+  return {std::make_pair(ROCKSDB_STATS_LABEL, rockCommonFields),
+          std::make_pair(ROCKSDB_INTERNALS_LABEL, rockInternalsFields)};
 }
 
 namespace rocksdb {
@@ -63,7 +86,7 @@ namespace rocksdb {
 ServerInfo::Stats::Stats()
     : compactions_level(0), file_size_mb(0), time_sec(0), read_mb(0), write_mb(0) {}
 
-ServerInfo::Stats::Stats(const std::string& common_text) {
+ServerInfo::Stats::Stats(const std::string& common_text) : Stats() {
   size_t pos = 0;
   size_t start = 0;
 
@@ -122,14 +145,109 @@ common::Value* ServerInfo::Stats::ValueByIndex(unsigned char index) const {
   return nullptr;
 }
 
+ServerInfo::Internals::Internals()
+    : block_cache_hit_rate(0),
+      bloom_filter_useful(0),
+      stall_micros(0),
+      compact_read_mb(0),
+      compact_write_mb(0),
+      get_p99_micros(0),
+      l0_files(0),
+      pending_compaction_mb(0) {}
+
+ServerInfo::Internals::Internals(const std::string& internals_text) : Internals() {
+  size_t pos = 0;
+  size_t start = 0;
+
+  while ((pos = internals_text.find(MARKER, start)) != std::string::npos) {
+    std::string line = internals_text.substr(start, pos - start);
+    size_t delem = line.find_first_of(':');
+    std::string field = line.substr(0, delem);
+    std::string value = line.substr(delem + 1);
+    if (field == ROCKSDB_BLOCK_CACHE_HIT_RATE_LABEL) {
+      double lblock_cache_hit_rate;
+      if (common::ConvertFromString(value, &lblock_cache_hit_rate)) {
+        block_cache_hit_rate = lblock_cache_hit_rate;
+      }
+    } else if (field == ROCKSDB_BLOOM_FILTER_USEFUL_LABEL) {
+      uint64_t lbloom_filter_useful;
+      if (common::ConvertFromString(value, &lbloom_filter_useful)) {
+        bloom_filter_useful = lbloom_filter_useful;
+      }
+    } else if (field == ROCKSDB_STALL_MICROS_LABEL) {
+      uint64_t lstall_micros;
+      if (common::ConvertFromString(value, &lstall_micros)) {
+        stall_micros = lstall_micros;
+      }
+    } else if (field == ROCKSDB_COMPACT_READ_MB_LABEL) {
+      uint32_t lcompact_read_mb;
+      if (common::ConvertFromString(value, &lcompact_read_mb)) {
+        compact_read_mb = lcompact_read_mb;
+      }
+    } else if (field == ROCKSDB_COMPACT_WRITE_MB_LABEL) {
+      uint32_t lcompact_write_mb;
+      if (common::ConvertFromString(value, &lcompact_write_mb)) {
+        compact_write_mb = lcompact_write_mb;
+      }
+    } else if (field == ROCKSDB_GET_P99_MICROS_LABEL) {
+      double lget_p99_micros;
+      if (common::ConvertFromString(value, &lget_p99_micros)) {
+        get_p99_micros = lget_p99_micros;
+      }
+    } else if (field == ROCKSDB_L0_FILES_LABEL) {
+      uint32_t ll0_files;
+      if (common::ConvertFromString(value, &ll0_files)) {
+        l0_files = ll0_files;
+      }
+    } else if (field == ROCKSDB_PENDING_COMPACTION_MB_LABEL) {
+      uint32_t lpending_compaction_mb;
+      if (common::ConvertFromString(value, &lpending_compaction_mb)) {
+        pending_compaction_mb = lpending_compaction_mb;
+      }
+    }
+    start = pos + 2;
+  }
+}
+
+common::Value* ServerInfo::Internals::ValueByIndex(unsigned char index) const {
+  switch (index) {
+    case 0:
+      return new common::FundamentalValue(block_cache_hit_rate);
+    case 1:
+      return common::Value::CreateULongLongIntegerValue(bloom_filter_useful);
+    case 2:
+      return common::Value::CreateULongLongIntegerValue(stall_micros);
+    case 3:
+      return new common::FundamentalValue(compact_read_mb);
+    case 4:
+      return new common::FundamentalValue(compact_write_mb);
+    case 5:
+      return new common::FundamentalValue(get_p99_micros);
+    case 6:
+      return new common::FundamentalValue(l0_files);
+    case 7:
+      return new common::FundamentalValue(pending_compaction_mb);
+    default:
+      break;
+  }
+
+  NOTREACHED();
+  return nullptr;
+}
+
 ServerInfo::ServerInfo() : IServerInfo(ROCKSDB) {}
 
 ServerInfo::ServerInfo(const Stats& stats) : IServerInfo(ROCKSDB), stats_(stats) {}
 
+ServerInfo::ServerInfo(const Stats& stats, const Internals& internals)
+    : IServerInfo(ROCKSDB), stats_(stats), internals_(internals) {}
+
 common::Value* ServerInfo::ValueByIndexes(unsigned char property, unsigned char field) const {
   switch (property) {
     case 0:
       return stats_.ValueByIndex(field);
+    case 1:
+      return internals_.ValueByIndex(field);
     default:
       break;
   }
@@ -145,6 +263,17 @@ std::ostream& operator<<(std::ostream& out, const ServerInfo::Stats& value) {
              << value.read_mb << MARKER << ROCKSDB_WRITE_MB_LABEL ":" << value.write_mb << MARKER;
 }
 
+std::ostream& operator<<(std::ostream& out, const ServerInfo::Internals& value) {
+  return out << ROCKSDB_BLOCK_CACHE_HIT_RATE_LABEL ":" << value.block_cache_hit_rate << MARKER
+             << ROCKSDB_BLOOM_FILTER_USEFUL_LABEL ":" << value.bloom_filter_useful << MARKER
+             << ROCKSDB_STALL_MICROS_LABEL ":" << value.stall_micros << MARKER
+             << ROCKSDB_COMPACT_READ_MB_LABEL ":" << value.compact_read_mb << MARKER
+             << ROCKSDB_COMPACT_WRITE_MB_LABEL ":" << value.compact_write_mb << MARKER
+             << ROCKSDB_GET_P99_MICROS_LABEL ":" << value.get_p99_micros << MARKER
+             << ROCKSDB_L0_FILES_LABEL ":" << value.l0_files << MARKER
+             << ROCKSDB_PENDING_COMPACTION_MB_LABEL ":" << value.pending_compaction_mb << MARKER;
+}
+
 std::ostream& operator<<(std::ostream& out, const ServerInfo& value) {
   return out << value.ToString();
 }
@@ -156,24 +285,17 @@ ServerInfo* MakeRocksdbServerInfo(const std::string& content) {
 
   ServerInfo* result = new ServerInfo;
   static const std::vector<info_field_t> fields = DBTraits<ROCKSDB>::InfoFields();
-  std::string word;
-  DCHECK_EQ(fields.size(), 1);
-
-  for (size_t i = 0; i < content.size(); ++i) {
-    word += content[i];
-    if (word == fields[0].first) {
-      std::string part = content.substr(i + 1);
-      result->stats_ = ServerInfo::Stats(part);
-      break;
-    }
-  }
+  DCHECK_EQ(fields.size(), 2);
 
+  result->stats_ = ServerInfo::Stats(sectionText(content, fields[0].first));
+  // history written before internals were collected hasn't this section
+  result->internals_ = ServerInfo::Internals(sectionText(content, fields[1].first));
   return result;
 }
 
 std::string ServerInfo::ToString() const {
   std::stringstream str;
-  str << ROCKSDB_STATS_LABEL MARKER << stats_;
+  str << ROCKSDB_STATS_LABEL MARKER << stats_ << ROCKSDB_INTERNALS_LABEL MARKER << internals_;
   return str.str();
 }
 
@@ -18,7 +18,7 @@
 
 #pragma once
 
-#include <stdint.h>  // for uint32_t
+#include <stdint.h>  // for uint32_t, uint64_t
 
 #include <iosfwd>  // for ostream
 #include <string>  // for string
@@ -36,6 +36,17 @@
 #define ROCKSDB_READ_MB_LABEL "read_mb"
 #define ROCKSDB_WRITE_MB_LABEL "write_mb"
 
+#define ROCKSDB_INTERNALS_LABEL "# Internals"
+
+#define ROCKSDB_BLOCK_CACHE_HIT_RATE_LABEL "block_cache_hit_rate"
+#define ROCKSDB_BLOOM_FILTER_USEFUL_LABEL "bloom_filter_useful"
+#define ROCKSDB_STALL_MICROS_LABEL "stall_micros"
+#define ROCKSDB_COMPACT_READ_MB_LABEL "compact_read_mb"
+#define ROCKSDB_COMPACT_WRITE_MB_LABEL "compact_write_mb"
+#define ROCKSDB_GET_P99_MICROS_LABEL "get_p99_micros"
+#define ROCKSDB_L0_FILES_LABEL "l0_files"
+#define ROCKSDB_PENDING_COMPACTION_MB_LABEL "pending_compaction_mb"
+
 namespace fastonosql {
 namespace core {
 namespace rocksdb {
@@ -56,8 +67,25 @@ class ServerInfo : public IServerInfo {
     uint32_t write_mb;
   } stats_;
 
+  // tickers and histograms of Options::statistics, zero if statistics disabled
+  struct Internals : IStateField {
+    Internals();
+    explicit Internals(const std::string& internals_text);
+    common::Value* ValueByIndex(unsigned char index) const override;
+
+    double block_cache_hit_rate;  // percents
+    uint64_t bloom_filter_useful;
+    uint64_t stall_micros;
+    uint32_t compact_read_mb;
+    uint32_t compact_write_mb;
+    double get_p99_micros;
+    uint32_t l0_files;
+    uint32_t pending_compaction_mb;
+  } internals_;
+
   ServerInfo();
   explicit ServerInfo(const Stats& stats);
+  ServerInfo(const Stats& stats, const Internals& internals);
 
   virtual common::Value* ValueByIndexes(unsigned char property, unsigned char field) const override;
   virtual std::string ToString() const override;
@@ -0,0 +1,506 @@
+/*  Copyright (C) 2014-2016 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "core/db/rocksdb/sst_loader.h"
+
+#include <stdint.h>  // for uint32_t
+
+#include <algorithm>  // for max, stable_sort
+#include <fstream>    // for ifstream, ofstream
+#include <queue>      // for priority_queue
+#include <thread>     // for thread
+
+#include <rocksdb/db.h>               // for DB, CompactRangeOptions
+#include <rocksdb/options.h>          // for IngestExternalFileOptions
+#include <rocksdb/sst_file_writer.h>  // for SstFileWriter
+
+#include <common/file_system.h>  // for create_directory, remove_file
+#include <common/sprintf.h>      // for MemSPrintf
+#include <common/string_util.h>  // for FullEqualsASCII
+#include <common/value.h>        // for ErrorValue
+
+// default budget is max(64MB, 5 * 16MB) = 80MB
+#define SST_DEFAULT_RUN_SIZE (64 * 1024 * 1024)
+#define SST_DEFAULT_FILE_SIZE (16 * 1024 * 1024)
+#define SST_DEFAULT_WORKERS 2
+
+namespace fastonosql {
+namespace core {
+namespace rocksdb {
+namespace {
+
+typedef std::pair<std::string, std::string> pair_t;
+
+bool writeString(std::ofstream* out, const std::string& str) {
+  uint32_t size = str.size();
+  out->write(reinterpret_cast<const char*>(&size), sizeof(size));
+  out->write(str.data(), size);
+  return out->good();
+}
+
+enum ReadStatus { READ_OK, READ_EOF, READ_FAILED };
+
+ReadStatus readString(std::ifstream* in, std::string* str) {
+  uint32_t size = 0;
+  if (!in->read(reinterpret_cast<char*>(&size), sizeof(size))) {
+    // clean end only between strings
+    return in->gcount() == 0 && in->eof() && !in->bad() ? READ_EOF : READ_FAILED;
+  }
+
+  str->resize(size);
+  if (size != 0 && !in->read(&(*str)[0], size)) {
+    return READ_FAILED;
+  }
+  return READ_OK;
+}
+
+// smallest key first, for equal keys latest run first
+struct RunReaderGreater {
+  bool operator()(const RunReader* lhs, const RunReader* rhs) const {
+    int cmp = lhs->Current().first.compare(rhs->Current().first);
+    if (cmp != 0) {
+      return cmp > 0;
+    }
+
+    return lhs->Run() < rhs->Run();
+  }
+};
+
+std::string tempFilePath(const std::string& dir, const std::string& prefix, size_t index) {
+  return dir + common::file_system::get_separator_string<char>() +
+         common::MemSPrintf("%s_%llu", prefix, static_cast<unsigned long long>(index));
+}
+
+}  // namespace
+
+RunReader::RunReader(const std::string& path, size_t run)
+    : file_(path, std::ios::in | std::ios::binary),
+      path_(path),
+      run_(run),
+      current_(),
+      failed_(!file_.is_open()) {}
+
+bool RunReader::Next() {
+  if (failed_) {
+    return false;
+  }
+
+  ReadStatus status = readString(&file_, &current_.first);
+  if (status == READ_EOF) {
+    return false;
+  }
+
+  if (status == READ_OK) {
+    status = readString(&file_, &current_.second);
+  }
+  failed_ = status != READ_OK;
+  return !failed_;
+}
+
+bool RunReader::IsFailed() const {
+  return failed_;
+}
+
+const std::pair<std::string, std::string>& RunReader::Current() const {
+  return current_;
+}
+
+size_t RunReader::Run() const {
+  return run_;
+}
+
+const std::string& RunReader::Path() const {
+  return path_;
+}
+
+SstLoadOptions::SstLoadOptions()
+    : temp_dir(),
+      run_size(SST_DEFAULT_RUN_SIZE),
+      sst_file_size(SST_DEFAULT_FILE_SIZE),
+      workers(SST_DEFAULT_WORKERS),
+      compact_after(false) {}
+
+size_t SstLoadOptions::MemoryBudget() const {
+  // merged chunk, queued chunks and chunks being written by workers
+  const size_t merge_bytes = (2 * workers + 1) * sst_file_size;
+  return std::max(run_size, merge_bytes);
+}
+
+SstLoader::SstLoader(::rocksdb::DB* db, const SstLoadOptions& options)
+    : db_(db),
+      options_(options),
+      runs_(),
+      sst_files_(),
+      mutex_(),
+      queue_cond_(),
+      space_cond_(),
+      queue_(),
+      merge_finished_(false),
+      fatal_error_() {}
+
+common::Error SstLoader::Run(ImportReader* reader,
+                             interrupt_callback_t is_interrupted,
+                             progress_callback_t progress_cb,
+                             ImportStats* stats) {
+  if (!db_ || !reader || !stats || options_.temp_dir.empty() || options_.run_size == 0 ||
+      options_.sst_file_size == 0 || options_.workers == 0) {
+    DNOTREACHED();
+    return common::make_error_value("Invalid input argument(s)", common::ErrorValue::E_ERROR);
+  }
+
+  common::Error err = common::file_system::create_directory(options_.temp_dir, true);
+  if (err && err->IsError()) {
+    return err;
+  }
+
+  err = SortRuns(reader, is_interrupted, progress_cb, stats);
+  if (err && err->IsError()) {
+    RemoveTempFiles();
+    return err;
+  }
+
+  uint64_t merged = 0;
+  err = MergeRuns(&merged);
+  if (err && err->IsError()) {
+    RemoveTempFiles();
+    return err;
+  }
+
+  if (!sst_files_.empty()) {
+    // files don't overlap, all of them become visible at once
+    ::rocksdb::IngestExternalFileOptions ifo;
+    ifo.move_files = true;
+    auto st = db_->IngestExternalFile(sst_files_, ifo);
+    if (!st.ok()) {
+      RemoveTempFiles();
+      std::string buff = common::MemSPrintf("ingest external file error: %s", st.ToString());
+      return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+    }
+  }
+
+  stats->replies = merged;
+  if (progress_cb) {
+    progress_cb(*stats);
+  }
+  RemoveTempFiles();
+
+  if (options_.compact_after && !sst_files_.empty()) {
+    auto st = db_->CompactRange(::rocksdb::CompactRangeOptions(), nullptr, nullptr);
+    if (!st.ok()) {
+      std::string buff = common::MemSPrintf("compact range error: %s", st.ToString());
+      return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+    }
+  }
+
+  return common::Error();
+}
+
+common::Error SstLoader::SortRuns(ImportReader* reader,
+                                  interrupt_callback_t is_interrupted,
+                                  progress_callback_t progress_cb,
+                                  ImportStats* stats) {
+  pairs_t pairs;
+  size_t bytes = 0;
+  bool eof = false;
+  while (true) {
+    if (is_interrupted && is_interrupted()) {
+      return common::make_error_value("Interrupted.", common::ErrorValue::E_INTERRUPTED);
+    }
+
+    ImportRecord record;
+    common::Error err = reader->Next(&record, &eof);
+    if (err && err->IsError()) {
+      if (eof) {
+        return err;
+      }
+
+      stats->AddError(record.line, err->Description());
+      continue;
+    }
+
+    if (eof) {
+      break;
+    }
+
+    pair_t pair;
+    if (record.IsCommand()) {
+      if (record.command.size() != 3 ||
+          !common::FullEqualsASCII(record.command[0], "SET", false)) {
+        stats->AddError(record.line, "Only SET key value commands can be loaded into sst files");
+        continue;
+      }
+
+      pair = std::make_pair(record.command[1], record.command[2]);
+    } else {
+      pair = std::make_pair(record.key.Key(), record.value);
+    }
+
+    bytes += sizeof(pair_t) + pair.first.size() + pair.second.size();
+    pairs.push_back(pair);
+    stats->sent++;
+    if (bytes < options_.run_size) {
+      continue;
+    }
+
+    err = SpillRun(&pairs);
+    if (err && err->IsError()) {
+      return err;
+    }
+    bytes = 0;
+    if (progress_cb) {
+      progress_cb(*stats);
+    }
+  }
+
+  if (pairs.empty()) {
+    return common::Error();
+  }
+
+  return SpillRun(&pairs);
+}
+
+common::Error SstLoader::SpillRun(pairs_t* pairs) {
+  // stable, so the last value of duplicated key is the last in its group
+  std::stable_sort(pairs->begin(), pairs->end(),
+                   [](const pair_t& lhs, const pair_t& rhs) { return lhs.first < rhs.first; });
+
+  const std::string path = tempFilePath(options_.temp_dir, "run", runs_.size());
+  std::ofstream file(path, std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!file.is_open()) {
+    std::string buff = common::MemSPrintf("Can't create sort run file: %s", path);
+    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+  }
+  runs_.push_back(path);
+
+  for (size_t i = 0; i < pairs->size(); ++i) {
+    const pair_t& pair = (*pairs)[i];
+    if (i + 1 < pairs->size() && (*pairs)[i + 1].first == pair.first) {
+      continue;
+    }
+
+    if (!writeString(&file, pair.first) || !writeString(&file, pair.second)) {
+      std::string buff = common::MemSPrintf("Can't write sort run file: %s", path);
+      return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+    }
+  }
+
+  // last buffered bytes are written only here
+  file.close();
+  if (file.fail()) {
+    std::string buff = common::MemSPrintf("Can't write sort run file: %s", path);
+    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+  }
+
+  pairs->clear();
+  return common::Error();
+}
+
+common::Error SstLoader::MergeRuns(uint64_t* merged) {
+  std::vector<RunReader*> readers;
+  std::priority_queue<RunReader*, std::vector<RunReader*>, RunReaderGreater> heap;
+  // failed run would silently lose its tail, so nothing is ingested then
+  RunReader* failed = nullptr;
+  auto next = [&heap, &failed](RunReader* reader) {
+    if (reader->Next()) {
+      heap.push(reader);
+    } else if (reader->IsFailed() && !failed) {
+      failed = reader;
+    }
+  };
+
+  for (size_t i = 0; i < runs_.size(); ++i) {
+    RunReader* reader = new RunReader(runs_[i], i);
+    readers.push_back(reader);
+    next(reader);
+  }
+
+  std::vector<std::thread> workers;
+  for (size_t i = 0; i < options_.workers; ++i) {
+    workers.push_back(std::thread(&SstLoader::WorkerRoutine, this));
+  }
+
+  Chunk chunk;
+  chunk.seq = 0;
+  size_t chunk_bytes = 0;
+  uint64_t lmerged = 0;
+  bool stopped = false;
+  while (!heap.empty() && !stopped && !failed) {
+    RunReader* top = heap.top();
+    heap.pop();
+    pair_t pair = top->Current();
+    next(top);
+
+    // older values of the same key
+    while (!heap.empty() && heap.top()->Current().first == pair.first) {
+      RunReader* older = heap.top();
+      heap.pop();
+      next(older);
+    }
+
+    chunk_bytes += sizeof(pair_t) + pair.first.size() + pair.second.size();
+    chunk.pairs.push_back(pair);
+    lmerged++;
+    if (chunk_bytes >= options_.sst_file_size) {
+      size_t next_seq = chunk.seq + 1;
+      stopped = !PushChunk(&chunk);
+      chunk = Chunk();
+      chunk.seq = next_seq;
+      chunk_bytes = 0;
+    }
+  }
+
+  if (failed) {
+    std::string buff = common::MemSPrintf("Can't read sort run file: %s", failed->Path());
+    SetFatalError(common::make_error_value(buff, common::ErrorValue::E_ERROR));
+  } else if (!stopped && !chunk.pairs.empty()) {
+    PushChunk(&chunk);
+  }
+
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    merge_finished_ = true;
+    queue_cond_.notify_all();
+  }
+
+  for (size_t i = 0; i < workers.size(); ++i) {
+    workers[i].join();
+  }
+
+  for (size_t i = 0; i < readers.size(); ++i) {
+    delete readers[i];
+  }
+
+  if (fatal_error_ && fatal_error_->IsError()) {
+    return fatal_error_;
+  }
+
+  *merged = lmerged;
+  return common::Error();
+}
+
+void SstLoader::WorkerRoutine() {
+  Chunk chunk;
+  while (PopChunk(&chunk)) {
+    std::string path;
+    common::Error err = WriteSstFile(chunk, &path);
+    if (err && err->IsError()) {
+      SetFatalError(err);
+      return;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (sst_files_.size() <= chunk.seq) {
+      sst_files_.resize(chunk.seq + 1);
+    }
+    sst_files_[chunk.seq] = path;
+  }
+}
+
+common::Error SstLoader::WriteSstFile(const Chunk& chunk, std::string* path) {
+  const std::string lpath = tempFilePath(options_.temp_dir, "sst", chunk.seq) + ".sst";
+  ::rocksdb::SstFileWriter writer(::rocksdb::EnvOptions(), db_->GetOptions());
+  auto st = writer.Open(lpath);
+  if (!st.ok()) {
+    std::string buff = common::MemSPrintf("sst file open error: %s", st.ToString());
+    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+  }
+
+  for (size_t i = 0; i < chunk.pairs.size(); ++i) {
+    st = writer.Put(chunk.pairs[i].first, chunk.pairs[i].second);
+    if (!st.ok()) {
+      std::string buff = common::MemSPrintf("sst file put error: %s", st.ToString());
+      return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+    }
+  }
+
+  st = writer.Finish();
+  if (!st.ok()) {
+    std::string buff = common::MemSPrintf("sst file finish error: %s", st.ToString());
+    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+  }
+
+  *path = lpath;
+  return common::Error();
+}
+
+bool SstLoader::PushChunk(Chunk* chunk) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (queue_.size() >= options_.workers && !fatal_error_) {
+    space_cond_.wait(lock);
+  }
+
+  if (fatal_error_) {
+    return false;
+  }
+
+  queue_.push_back(Chunk());
+  queue_.back().seq = chunk->seq;
+  queue_.back().pairs.swap(chunk->pairs);
+  queue_cond_.notify_one();
+  return true;
+}
+
+bool SstLoader::PopChunk(Chunk* chunk) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (queue_.empty() && !merge_finished_ && !fatal_error_) {
+    queue_cond_.wait(lock);
+  }
+
+  if (fatal_error_ || queue_.empty()) {
+    return false;
+  }
+
+  chunk->seq = queue_.front().seq;
+  chunk->pairs.swap(queue_.front().pairs);
+  queue_.pop_front();
+  space_cond_.notify_one();
+  return true;
+}
+
+void SstLoader::SetFatalError(common::Error err) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (!fatal_error_) {
+    fatal_error_ = err;
+  }
+  queue_.clear();
+  queue_cond_.notify_all();
+  space_cond_.notify_all();
+}
+
+void SstLoader::RemoveTempFiles() {
+  for (size_t i = 0; i < runs_.size(); ++i) {
+    common::Error err = common::file_system::remove_file(runs_[i]);
+    UNUSED(err);
+  }
+  runs_.clear();
+
+  // ingested files are moved into db, failed import leaves them here
+  for (size_t i = 0; i < sst_files_.size(); ++i) {
+    if (!sst_files_[i].empty() && common::file_system::is_file_exist(sst_files_[i])) {
+      common::Error err = common::file_system::remove_file(sst_files_[i]);
+      UNUSED(err);
+    }
+  }
+
+  common::Error err = common::file_system::remove_directory(options_.temp_dir, false);
+  UNUSED(err);
+}
+
+}  // namespace rocksdb
+}  // namespace core
+}  // namespace fastonosql
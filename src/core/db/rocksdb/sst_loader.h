@@ -0,0 +1,134 @@
+/*  Copyright (C) 2014-2016 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <stddef.h>  // for size_t
+#include <stdint.h>  // for uint64_t
+
+#include <condition_variable>  // for condition_variable
+#include <deque>               // for deque
+#include <fstream>             // for ifstream
+#include <functional>          // for function
+#include <mutex>               // for mutex
+#include <string>              // for string
+#include <utility>             // for pair
+#include <vector>              // for vector
+
+#include <common/error.h>   // for Error
+#include <common/macros.h>  // for WARN_UNUSED_RESULT
+
+#include "core/import_reader.h"  // for ImportReader, ImportStats
+
+namespace rocksdb {
+class DB;
+}
+
+namespace fastonosql {
+namespace core {
+namespace rocksdb {
+
+// sequential reader of spilled sort run: key size, key, value size, value;
+// run which can't be opened or ends inside of pair is failed, not finished
+class RunReader {
+ public:
+  RunReader(const std::string& path, size_t run);
+
+  bool Next();  // false at the end of run or on error
+  bool IsFailed() const;
+  const std::pair<std::string, std::string>& Current() const;
+  size_t Run() const;
+  const std::string& Path() const;
+
+ private:
+  std::ifstream file_;
+  const std::string path_;
+  const size_t run_;
+  std::pair<std::string, std::string> current_;
+  bool failed_;
+};
+
+struct SstLoadOptions {
+  SstLoadOptions();
+
+  size_t MemoryBudget() const;  // peak bytes of pairs held in memory
+
+  std::string temp_dir;  // sorted runs and sst files, should be on same disk as db
+  size_t run_size;       // bytes of pairs sorted in memory before spill to disk
+  size_t sst_file_size;  // bytes of pairs per sst file
+  size_t workers;        // threads writing sst files
+  bool compact_after;    // CompactRange of whole db after ingestion
+};
+
+// imports pairs bypassing memtable and WAL:
+// external merge sort of input (last value of duplicated key wins),
+// merged stream is cut into non overlapping sst files written by workers,
+// all files are ingested by one IngestExternalFile call
+class SstLoader {
+ public:
+  typedef std::function<void(const ImportStats&)> progress_callback_t;
+  typedef std::function<bool()> interrupt_callback_t;
+
+  SstLoader(::rocksdb::DB* db, const SstLoadOptions& options);
+
+  // stats->sent - read records, stats->replies - ingested keys
+  common::Error Run(ImportReader* reader,
+                    interrupt_callback_t is_interrupted,
+                    progress_callback_t progress_cb,
+                    ImportStats* stats) WARN_UNUSED_RESULT;
+
+ private:
+  typedef std::pair<std::string, std::string> pair_t;
+  typedef std::vector<pair_t> pairs_t;
+
+  struct Chunk {
+    size_t seq;
+    pairs_t pairs;
+  };
+
+  common::Error SortRuns(ImportReader* reader,
+                         interrupt_callback_t is_interrupted,
+                         progress_callback_t progress_cb,
+                         ImportStats* stats) WARN_UNUSED_RESULT;
+  common::Error SpillRun(pairs_t* pairs) WARN_UNUSED_RESULT;
+  common::Error MergeRuns(uint64_t* merged) WARN_UNUSED_RESULT;
+  void WorkerRoutine();
+  common::Error WriteSstFile(const Chunk& chunk, std::string* path) WARN_UNUSED_RESULT;
+
+  bool PushChunk(Chunk* chunk);
+  bool PopChunk(Chunk* chunk);
+  void SetFatalError(common::Error err);
+  void RemoveTempFiles();
+
+  ::rocksdb::DB* const db_;
+  const SstLoadOptions options_;
+
+  std::vector<std::string> runs_;
+  std::vector<std::string> sst_files_;  // by chunk seq, so in key order
+
+  std::mutex mutex_;
+  std::condition_variable queue_cond_;
+  std::condition_variable space_cond_;
+  std::deque<Chunk> queue_;
+  bool merge_finished_;
+  common::Error fatal_error_;
+};
+
+}  // namespace rocksdb
+}  // namespace core
+}  // namespace fastonosql
@@ -18,7 +18,8 @@
 
 #include "core/db/ssdb/db_connection.h"
 
-#include <memory>  // for __shared_ptr
+#include <algorithm>  // for max, min
+#include <memory>     // for __shared_ptr
 
 #include <SSDB.h>  // for Status, Client
 
@@ -32,8 +33,40 @@
 #include "core/db/ssdb/command_translator.h"
 #include "core/db/ssdb/internal/commands_api.h"
 
+#define SSDB_KEYS_PAGE_SIZE 1000
+#define SSDB_PIPELINE_MAX_COMMANDS 256
+
 namespace fastonosql {
 namespace core {
+namespace ssdb {
+namespace {
+
+typedef std::vector<std::string> command_args_t;
+
+// commands are sent by chunks, every chunk before reading its first reply,
+// so neither side has to buffer replies of whole batch
+common::Error execPipeline(NativeConnection* context,
+                           const std::vector<command_args_t>& commands,
+                           std::vector<command_args_t>* replies) {
+  for (size_t i = 0; i < commands.size(); i += SSDB_PIPELINE_MAX_COMMANDS) {
+    size_t end = std::min<size_t>(i + SSDB_PIPELINE_MAX_COMMANDS, commands.size());
+    std::vector<command_args_t> chunk(commands.begin() + i, commands.begin() + end);
+    auto st = context->pipeline(chunk, replies);
+    if (st.error()) {
+      std::string buff = common::MemSPrintf("pipeline error: %s", st.code());
+      return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+    }
+  }
+
+  return common::Error();
+}
+
+bool isReplyOne(const command_args_t& reply) {
+  return reply.size() > 1 && reply[0] == "ok" && reply[1] == "1";
+}
+
+}  // namespace
+}  // namespace ssdb
 namespace internal {
 template <>
 common::Error ConnectionAllocatorTraits<ssdb::NativeConnection, ssdb::Config>::Connect(
@@ -110,7 +143,7 @@ common::Error TestConnection(const Config& config) {
 }
 
 DBConnection::DBConnection(CDBConnectionClient* client)
-    : base_class(client, new CommandTranslator(base_class::Commands())) {}
+    : base_class(client, new CommandTranslator(base_class::Commands())), scan_cursors_() {}
 
 common::Error DBConnection::Info(const char* args, ServerInfo::Stats* statsout) {
   if (!statsout) {
@@ -178,6 +211,43 @@ common::Error DBConnection::DBsize(int64_t* size) {
   return common::Error();
 }
 
+common::Error DBConnection::MultiTTL(const std::vector<std::string>& keys,
+                                     std::vector<ttl_t>* ttls) {
+  if (!ttls) {
+    DNOTREACHED();
+    return common::make_error_value("Invalid input argument(s)", common::ErrorValue::E_ERROR);
+  }
+
+  if (!IsConnected()) {
+    return common::make_error_value("Not connected", common::Value::E_ERROR);
+  }
+
+  std::vector<command_args_t> pipeline;
+  for (size_t i = 0; i < keys.size(); ++i) {
+    pipeline.push_back({"ttl", keys[i]});
+  }
+
+  std::vector<command_args_t> replies;
+  common::Error err = execPipeline(connection_.handle_, pipeline, &replies);
+  if (err && err->IsError()) {
+    return err;
+  }
+
+  for (size_t i = 0; i < replies.size(); ++i) {
+    ttl_t ttl = NO_TTL;
+    const command_args_t& reply = replies[i];
+    if (reply.size() > 1 && reply[0] == "ok") {
+      ttl_t lttl;
+      if (common::ConvertFromString(reply[1], &lttl)) {
+        ttl = lttl;
+      }
+    }
+    ttls->push_back(ttl);
+  }
+
+  return common::Error();
+}
+
 common::Error DBConnection::Auth(const std::string& password) {
   if (!IsConnected()) {
     return common::make_error_value("Not connected", common::Value::E_ERROR);
@@ -223,6 +293,10 @@ common::Error DBConnection::GetInner(const std::string& key, std::string* ret_va
   }
 
   auto st = connection_.handle_->get(key, ret_val);
+  if (st.not_found()) {
+    return MakeKeyNotFoundError(key);
+  }
+
   if (st.error()) {
     std::string buff = common::MemSPrintf("GET function error: %s", st.code());
     return common::make_error_value(buff, common::ErrorValue::E_ERROR);
@@ -831,32 +905,66 @@ common::Error DBConnection::ScanImpl(uint64_t cursor_in,
                                      uint64_t count_keys,
                                      std::vector<std::string>* keys_out,
                                      uint64_t* cursor_out) {
-  std::vector<std::string> ret;
-  auto st = connection_.handle_->keys(std::string(), std::string(), 0, &ret);
-  if (st.error()) {
-    std::string buff = common::MemSPrintf("Flushdb function error: %s", st.code());
-    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+  // server returns keys of range (key_start, range_end] in order,
+  // only keys with literal prefix of pattern can match it
+  const std::string prefix = internal::GlobPrefix(pattern);
+  const std::string range_end = internal::PrefixEnd(prefix);
+  std::string key_start;
+  uint64_t offset_pos = 0;
+  std::vector<std::string> lkeys_out;
+  if (!scan_cursors_.Take(cursor_in, pattern, &key_start)) {
+    // new or forgotten scan, cursor is offset from start of range
+    offset_pos = cursor_in;
+    key_start = prefix;
+    if (!prefix.empty() && common::MatchPattern(prefix, pattern)) {
+      // start of range is excluded
+      const std::vector<std::string>* resp = connection_.handle_->request("exists", prefix);
+      ::ssdb::Status st(resp);
+      if (st.error()) {
+        std::string buff = common::MemSPrintf("Scan function error: %s", st.code());
+        return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+      }
+
+      if (resp->size() > 1 && resp->at(1) == "1") {
+        if (offset_pos == 0) {
+          lkeys_out.push_back(prefix);
+        } else {
+          offset_pos--;
+        }
+      }
+    }
   }
 
-  uint64_t offset_pos = cursor_in;
-  uint64_t lcursor_out = 0;
-  std::vector<std::string> lkeys_out;
-  for (size_t i = 0; i < ret.size(); ++i) {
-    std::string key = ret[i];
-    if (lkeys_out.size() < count_keys) {
-      if (common::MatchPattern(key, pattern)) {
+  const uint64_t page_size = std::max<uint64_t>(count_keys, SSDB_KEYS_PAGE_SIZE);
+  bool finished = false;
+  while (lkeys_out.size() < count_keys) {
+    std::vector<std::string> ret;
+    auto st = connection_.handle_->keys(key_start, range_end, page_size, &ret);
+    if (st.error()) {
+      std::string buff = common::MemSPrintf("Scan function error: %s", st.code());
+      return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+    }
+
+    size_t i = 0;
+    for (; i < ret.size() && lkeys_out.size() < count_keys; ++i) {
+      key_start = ret[i];
+      if (common::MatchPattern(ret[i], pattern)) {
         if (offset_pos == 0) {
-          lkeys_out.push_back(key);
+          lkeys_out.push_back(ret[i]);
         } else {
           offset_pos--;
         }
       }
-    } else {
-      lcursor_out = cursor_in + count_keys;
+    }
+
+    if (ret.size() < page_size && i == ret.size()) {
+      finished = true;
       break;
     }
   }
 
+  uint64_t lcursor_out = finished ? 0 : cursor_in + lkeys_out.size();
+  scan_cursors_.Put(lcursor_out, pattern, key_start);
   *keys_out = lkeys_out;
   *cursor_out = lcursor_out;
   return common::Error();
@@ -875,30 +983,52 @@ common::Error DBConnection::KeysImpl(const std::string& key_start,
 }
 
 common::Error DBConnection::DBkcountImpl(size_t* size) {
-  std::vector<std::string> ret;
-  auto st = connection_.handle_->keys(std::string(), std::string(), UINT64_MAX, &ret);
-  if (st.error()) {
-    std::string buff = common::MemSPrintf("Couldn't determine DBKCOUNT error: %s", st.code());
-    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+  // dbsize of ssdb is size of data in bytes, keys are counted by pages,
+  // so they never are kept in memory all together
+  std::string key_start;
+  size_t sz = 0;
+  while (true) {
+    std::vector<std::string> ret;
+    auto st = connection_.handle_->keys(key_start, std::string(), SSDB_KEYS_PAGE_SIZE, &ret);
+    if (st.error()) {
+      std::string buff = common::MemSPrintf("Couldn't determine DBKCOUNT error: %s", st.code());
+      return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+    }
+
+    sz += ret.size();
+    if (ret.size() < SSDB_KEYS_PAGE_SIZE) {
+      break;
+    }
+    key_start = ret.back();
   }
 
-  *size = ret.size();
+  *size = sz;
   return common::Error();
 }
 
 common::Error DBConnection::FlushDBImpl() {
-  std::vector<std::string> ret;
-  auto st = connection_.handle_->keys(std::string(), std::string(), 0, &ret);
-  if (st.error()) {
-    std::string buff = common::MemSPrintf("Flushdb function error: %s", st.code());
-    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
-  }
+  ::ssdb::Status st(connection_.handle_->request("flushdb"));
+  if (st.ok()) {
+    return common::Error();
+  }
+
+  // servers without flushdb, keys are removed by pages
+  while (true) {
+    std::vector<std::string> ret;
+    st = connection_.handle_->keys(std::string(), std::string(), SSDB_KEYS_PAGE_SIZE, &ret);
+    if (st.error()) {
+      std::string buff = common::MemSPrintf("Flushdb function error: %s", st.code());
+      return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+    }
 
-  for (size_t i = 0; i < ret.size(); ++i) {
-    std::string key = ret[i];
-    common::Error err = DelInner(key);
-    if (err && err->IsError()) {
-      return err;
+    if (ret.empty()) {
+      break;
+    }
+
+    st = connection_.handle_->multi_del(ret);
+    if (st.error()) {
+      std::string buff = common::MemSPrintf("Flushdb function error: %s", st.code());
+      return common::make_error_value(buff, common::ErrorValue::E_ERROR);
     }
   }
 
@@ -918,17 +1048,19 @@ common::Error DBConnection::SelectImpl(const std::string& name, IDataBaseInfo**
 }
 
 common::Error DBConnection::DeleteImpl(const NKeys& keys, NKeys* deleted_keys) {
+  // del of ssdb succeeds for missing keys too, so all keys are reported
+  std::vector<std::string> keys_str;
   for (size_t i = 0; i < keys.size(); ++i) {
-    NKey key = keys[i];
-    std::string key_str = key.Key();
-    common::Error err = DelInner(key_str);
-    if (err && err->IsError()) {
-      continue;
-    }
+    keys_str.push_back(keys[i].Key());
+  }
 
-    deleted_keys->push_back(key);
+  auto st = connection_.handle_->multi_del(keys_str);
+  if (st.error()) {
+    std::string buff = common::MemSPrintf("multi_del function error: %s", st.code());
+    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
   }
 
+  deleted_keys->insert(deleted_keys->end(), keys.begin(), keys.end());
   return common::Error();
 }
 
@@ -965,6 +1097,36 @@ common::Error DBConnection::SetImpl(const NDbKValue& key, NDbKValue* added_key)
   return common::Error();
 }
 
+common::Error DBConnection::SetBatchImpl(const NDbKValues& keys, NDbKValues* added_keys) {
+  // last value of duplicated key wins, ttls are set by one pipeline after values
+  std::map<std::string, std::string> kvs;
+  std::vector<command_args_t> expires;
+  for (size_t i = 0; i < keys.size(); ++i) {
+    kvs[keys[i].KeyString()] = keys[i].ValueString();
+    ttl_t ttl = keys[i].Key().TTL();
+    if (ttl > 0) {
+      expires.push_back({"expire", keys[i].KeyString(), common::ConvertToString(ttl)});
+    }
+  }
+
+  auto st = connection_.handle_->multi_set(kvs);
+  if (st.error()) {
+    std::string buff = common::MemSPrintf("multi_set function error: %s", st.code());
+    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+  }
+
+  if (!expires.empty()) {
+    std::vector<command_args_t> replies;
+    common::Error err = execPipeline(connection_.handle_, expires, &replies);
+    if (err && err->IsError()) {
+      return err;
+    }
+  }
+
+  added_keys->insert(added_keys->end(), keys.begin(), keys.end());
+  return common::Error();
+}
+
 common::Error DBConnection::GetImpl(const NKey& key, NDbKValue* loaded_key) {
   std::string key_str = key.Key();
   std::string value_str;
@@ -978,6 +1140,35 @@ common::Error DBConnection::GetImpl(const NKey& key, NDbKValue* loaded_key) {
   return common::Error();
 }
 
+common::Error DBConnection::GetBatchImpl(const NKeys& keys, NDbKValues* loaded_keys) {
+  std::vector<std::string> keys_str;
+  std::map<std::string, size_t> key_indexes;
+  for (size_t i = 0; i < keys.size(); ++i) {
+    keys_str.push_back(keys[i].Key());
+    key_indexes[keys_str.back()] = i;
+  }
+
+  // pairs of found keys and values
+  std::vector<std::string> ret;
+  auto st = connection_.handle_->multi_get(keys_str, &ret);
+  if (st.error()) {
+    std::string buff = common::MemSPrintf("multi_get function error: %s", st.code());
+    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+  }
+
+  for (size_t i = 0; i + 1 < ret.size(); i += 2) {
+    auto it = key_indexes.find(ret[i]);
+    if (it == key_indexes.end()) {
+      continue;
+    }
+
+    NValue val(common::Value::CreateStringValue(ret[i + 1]));
+    loaded_keys->push_back(NDbKValue(keys[it->second], val));
+  }
+
+  return common::Error();
+}
+
 common::Error DBConnection::SetTTLImpl(const NKey& key, ttl_t ttl) {
   std::string key_str = key.Key();
   common::Error err = Expire(key_str, ttl);
@@ -988,6 +1179,80 @@ common::Error DBConnection::SetTTLImpl(const NKey& key, ttl_t ttl) {
   return common::Error();
 }
 
+common::Error DBConnection::SetTTLBatchImpl(const NKeys& keys, ttl_t ttl, NKeys* changed_keys) {
+  std::string ttl_str = common::ConvertToString(ttl);
+  std::vector<command_args_t> pipeline;
+  for (size_t i = 0; i < keys.size(); ++i) {
+    pipeline.push_back({"expire", keys[i].Key(), ttl_str});
+  }
+
+  std::vector<command_args_t> replies;
+  common::Error err = execPipeline(connection_.handle_, pipeline, &replies);
+  if (err && err->IsError()) {
+    return err;
+  }
+
+  for (size_t i = 0; i < replies.size(); ++i) {
+    if (isReplyOne(replies[i])) {
+      changed_keys->push_back(keys[i]);
+    }
+  }
+
+  return common::Error();
+}
+
+common::Error DBConnection::RenameBatchImpl(const NKeys& keys,
+                                            const std::vector<std::string>& new_keys,
+                                            NKeys* renamed_keys) {
+  // values of all keys are moved by three requests, missing keys are skipped
+  NDbKValues loaded_keys;
+  common::Error err = GetBatchImpl(keys, &loaded_keys);
+  if (err && err->IsError()) {
+    return err;
+  }
+
+  std::map<std::string, std::string> new_kvs;
+  std::vector<std::string> old_keys;
+  NKeys lrenamed_keys;
+  for (size_t i = 0; i < keys.size(); ++i) {
+    for (size_t j = 0; j < loaded_keys.size(); ++j) {
+      if (loaded_keys[j].KeyString() == keys[i].Key()) {
+        new_kvs[new_keys[i]] = loaded_keys[j].ValueString();
+        old_keys.push_back(keys[i].Key());
+        lrenamed_keys.push_back(keys[i]);
+        break;
+      }
+    }
+  }
+
+  if (lrenamed_keys.empty()) {
+    return common::Error();
+  }
+
+  auto st = connection_.handle_->multi_set(new_kvs);
+  if (st.error()) {
+    std::string buff = common::MemSPrintf("multi_set function error: %s", st.code());
+    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+  }
+
+  // old names which became new names of other keys stay
+  std::vector<std::string> del_keys;
+  for (size_t i = 0; i < old_keys.size(); ++i) {
+    if (new_kvs.find(old_keys[i]) == new_kvs.end()) {
+      del_keys.push_back(old_keys[i]);
+    }
+  }
+
+  st = connection_.handle_->multi_del(del_keys);
+  if (st.error()) {
+    std::string buff = common::MemSPrintf("multi_del function error: %s", st.code());
+    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+  }
+
+  renamed_keys->insert(renamed_keys->end(), lrenamed_keys.begin(), lrenamed_keys.end());
+  return common::Error();
+}
+
 common::Error DBConnection::GetTTLImpl(const NKey& key, ttl_t* ttl) {
   std::string key_str = key.Key();
   common::Error err = TTL(key_str, ttl);
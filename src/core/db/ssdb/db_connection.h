@@ -30,6 +30,7 @@
 
 #include "core/connection_types.h"  // for connectionTypes::SSDB
 #include "core/internal/cdb_connection.h"
+#include "core/internal/range_scan.h"  // for RangeScanCursors
 
 #include "core/db_key.h"  // for ttl_t, NKey (ptr only), etc
 #include "core/db/ssdb/config.h"
@@ -159,6 +160,9 @@ class DBConnection : public core::internal::CDBConnection<NativeConnection, Conf
                        std::vector<std::string>* ret) WARN_UNUSED_RESULT;
   common::Error Qclear(const std::string& name, int64_t* ret) WARN_UNUSED_RESULT;
   common::Error DBsize(int64_t* size) WARN_UNUSED_RESULT;
+  // one pipeline for all keys, NO_TTL for keys without reply
+  common::Error MultiTTL(const std::vector<std::string>& keys,
+                         std::vector<ttl_t>* ttls) WARN_UNUSED_RESULT;
 
   common::Error Expire(const std::string& key, ttl_t ttl) WARN_UNUSED_RESULT;
   common::Error TTL(const std::string& key, ttl_t* ttl) WARN_UNUSED_RESULT;
@@ -181,12 +185,20 @@ class DBConnection : public core::internal::CDBConnection<NativeConnection, Conf
   virtual common::Error FlushDBImpl() override;
   virtual common::Error SelectImpl(const std::string& name, IDataBaseInfo** info) override;
   virtual common::Error SetImpl(const NDbKValue& key, NDbKValue* added_key) override;
+  virtual common::Error SetBatchImpl(const NDbKValues& keys, NDbKValues* added_keys) override;
   virtual common::Error GetImpl(const NKey& key, NDbKValue* loaded_key) override;
+  virtual common::Error GetBatchImpl(const NKeys& keys, NDbKValues* loaded_keys) override;
   virtual common::Error DeleteImpl(const NKeys& keys, NKeys* deleted_keys) override;
   virtual common::Error RenameImpl(const NKey& key, const std::string& new_key) override;
   virtual common::Error SetTTLImpl(const NKey& key, ttl_t ttl) override;
+  virtual common::Error SetTTLBatchImpl(const NKeys& keys, ttl_t ttl, NKeys* changed_keys) override;
+  virtual common::Error RenameBatchImpl(const NKeys& keys,
+                                        const std::vector<std::string>& new_keys,
+                                        NKeys* renamed_keys) override;
   virtual common::Error GetTTLImpl(const NKey& key, ttl_t* ttl) override;
   virtual common::Error QuitImpl() override;
+
+  internal::RangeScanCursors scan_cursors_;
 };
 
 }  // namespace ssdb
@@ -56,6 +56,11 @@ Config parseOptions(int argc, char** argv) {
       if (common::ConvertFromString(argv[++i], &env_flags)) {
         cfg.env_flags = env_flags;
       }
+    } else if (!strcmp(argv[i], "-page-cache") && !lastarg) {
+      int max_page_cache;
+      if (common::ConvertFromString(argv[++i], &max_page_cache)) {
+        cfg.max_page_cache = max_page_cache;
+      }
     } else {
       if (argv[i][0] == '-') {
         const std::string buff = common::MemSPrintf(
@@ -77,7 +82,8 @@ Config parseOptions(int argc, char** argv) {
 
 Config::Config()
     : LocalConfig(common::file_system::prepare_path("~/test.unqlite")),
-      env_flags(UNQLITE_DEFAULT_ENV_FLAGS) {}
+      env_flags(UNQLITE_DEFAULT_ENV_FLAGS),
+      max_page_cache(0) {}
 
 bool Config::ReadOnlyDB() const {
   return env_flags & UNQLITE_OPEN_READONLY;
@@ -119,6 +125,18 @@ void Config::SetCreateIfMissingDB(bool ro) {
   }
 }
 
+bool Config::InMemoryDB() const {
+  return env_flags & UNQLITE_OPEN_IN_MEMORY || dbname == UNQLITE_IN_MEMORY_DB_NAME;
+}
+
+void Config::SetInMemoryDB(bool mem) {
+  if (mem) {
+    env_flags |= UNQLITE_OPEN_IN_MEMORY;
+  } else {
+    env_flags &= ~UNQLITE_OPEN_IN_MEMORY;
+  }
+}
+
 }  // namespace unqlite
 }  // namespace core
 }  // namespace fastonosql
@@ -133,6 +151,11 @@ std::string ConvertToString(const fastonosql::core::unqlite::Config& conf) {
     argv.push_back(common::ConvertToString(conf.env_flags));
   }
 
+  if (conf.max_page_cache) {
+    argv.push_back("-page-cache");
+    argv.push_back(common::ConvertToString(conf.max_page_cache));
+  }
+
   return fastonosql::core::ConvertToStringConfigArgs(argv);
 }
 
@@ -24,6 +24,7 @@
 
 #define UNQLITE_DEFAULT_ENV_FLAGS 0x00000002  // unqlite Environment Flags
                                               // UNQLITE_OPEN_READWRITE        0x00000002
+#define UNQLITE_IN_MEMORY_DB_NAME ":mem:"
 
 namespace fastonosql {
 namespace core {
@@ -40,7 +41,12 @@ struct Config : public LocalConfig {
   bool CreateIfMissingDB() const;
   void SetCreateIfMissingDB(bool ro);
 
+  // private database in memory, it is gone after disconnect
+  bool InMemoryDB() const;
+  void SetInMemoryDB(bool mem);
+
   int env_flags;
+  int max_page_cache;  // raw pages cached in memory, 0 - unqlite default
 };
 
 }  // namespace unqlite
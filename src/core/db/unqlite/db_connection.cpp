@@ -32,6 +32,7 @@ extern "C" {
 #include <common/convert2string.h>
 #include <common/file_system.h>
 
+#include "core/byte_source.h"         // for ChunkedByteSource
 #include "core/db/unqlite/config.h"  // for Config
 #include "core/db/unqlite/database_info.h"
 #include "core/db/unqlite/command_translator.h"
@@ -103,12 +104,27 @@ std::string unqlite_strerror(int unqlite_error) {
   }
 }
 
+// big keys and values are handed out page by page
 int unqlite_data_callback(const void* pData, unsigned int nDatalen, void* str) {
   std::string* out = static_cast<std::string*>(str);
-  out->assign(reinterpret_cast<const char*>(pData), nDatalen);
+  out->append(reinterpret_cast<const char*>(pData), nDatalen);
   return UNQLITE_OK;
 }
 
+int unqlite_source_callback(const void* pData, unsigned int nDatalen, void* source) {
+  fastonosql::core::ChunkedByteSource* out =
+      static_cast<fastonosql::core::ChunkedByteSource*>(source);
+  out->Append(reinterpret_cast<const char*>(pData), nDatalen);
+  return UNQLITE_OK;
+}
+
+// key is read into buffer reused for all keys of cursor,
+// so rejected keys cost no allocations
+void unqlite_cursor_key(unqlite_kv_cursor* pCur, std::string* buffer) {
+  buffer->clear();
+  unqlite_kv_cursor_key_callback(pCur, unqlite_data_callback, buffer);
+}
+
 }  // namespace
 
 namespace fastonosql {
@@ -169,12 +185,15 @@ common::Error CreateConnection(const Config& config, NativeConnection** context)
 
   DCHECK(*context == NULL);
   struct unqlite* lcontext = NULL;
-  std::string db_path = config.dbname;  // start point must be folder
-  std::string folder = common::file_system::get_dir_path(db_path);
-  common::tribool is_dir = common::file_system::is_directory(folder);
-  if (is_dir != common::SUCCESS) {
-    return common::make_error_value(common::MemSPrintf("Invalid input path(%s)", db_path),
-                                    common::ErrorValue::E_ERROR);
+  std::string db_path = UNQLITE_IN_MEMORY_DB_NAME;
+  if (!config.InMemoryDB()) {
+    db_path = config.dbname;  // start point must be folder
+    std::string folder = common::file_system::get_dir_path(db_path);
+    common::tribool is_dir = common::file_system::is_directory(folder);
+    if (is_dir != common::SUCCESS) {
+      return common::make_error_value(common::MemSPrintf("Invalid input path(%s)", db_path),
+                                      common::ErrorValue::E_ERROR);
+    }
   }
 
   const char* dbname = common::utils::c_strornull(db_path);
@@ -185,6 +204,15 @@ common::Error CreateConnection(const Config& config, NativeConnection** context)
     return common::make_error_value(buff, common::ErrorValue::E_ERROR);
   }
 
+  if (config.max_page_cache) {
+    st = unqlite_config(lcontext, UNQLITE_CONFIG_MAX_PAGE_CACHE, config.max_page_cache);
+    if (st != UNQLITE_OK) {
+      unqlite_close(lcontext);
+      std::string buff = common::MemSPrintf("Fail set page cache: %s!", unqlite_strerror(st));
+      return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+    }
+  }
+
   *context = lcontext;
   return common::Error();
 }
@@ -216,11 +244,105 @@ common::Error DBConnection::Info(const char* args, ServerInfo::Stats* statsout)
 
   ServerInfo::Stats linfo;
   Config conf = config();
-  linfo.file_name = conf.dbname;
+  linfo.file_name = conf.InMemoryDB() ? UNQLITE_IN_MEMORY_DB_NAME : conf.dbname;
   *statsout = linfo;
   return common::Error();
 }
 
+common::Error DBConnection::OpenValueSource(const NKey& key, byte_source_t* source) {
+  if (!source) {
+    DNOTREACHED();
+    return common::make_error_value("Invalid input argument(s)", common::ErrorValue::E_ERROR);
+  }
+
+  if (!IsConnected()) {
+    return common::make_error_value("Not connected", common::Value::E_ERROR);
+  }
+
+  std::string key_str = key.Key();
+  std::shared_ptr<ChunkedByteSource> lsource(new ChunkedByteSource);
+  int rc = unqlite_kv_fetch_callback(connection_.handle_, key_str.c_str(), key_str.size(),
+                                     unqlite_source_callback, lsource.get());
+  if (rc != UNQLITE_OK) {
+    std::string buff = common::MemSPrintf("get function error: %s", unqlite_strerror(rc));
+    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+  }
+
+  *source = lsource;
+  return common::Error();
+}
+
+common::Error DBConnection::SampleSizes(const namespace_ranges_t& ranges,
+                                        size_t sample_keys,
+                                        namespace_sizes_t* sizes) {
+  if (!sizes) {
+    DNOTREACHED();
+    return common::make_error_value("Invalid input argument(s)", common::ErrorValue::E_ERROR);
+  }
+
+  if (!IsConnected()) {
+    return common::make_error_value("Not connected", common::Value::E_ERROR);
+  }
+
+  unqlite_kv_cursor* pCur; /* Cursor handle */
+  int rc = unqlite_kv_cursor_init(connection_.handle_, &pCur);
+  if (rc != UNQLITE_OK) {
+    std::string buff = common::MemSPrintf("SAMPLE SIZES function error: %s", unqlite_strerror(rc));
+    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+  }
+
+  namespace_sizes_t result;
+  for (size_t i = 0; i < ranges.size(); ++i) {
+    result.push_back(NamespaceSize(ranges[i].ns));
+  }
+
+  std::string key;
+  size_t visited = 0;
+  uint64_t visited_bytes = 0;
+  for (unqlite_kv_cursor_first_entry(pCur); unqlite_kv_cursor_valid_entry(pCur);
+       unqlite_kv_cursor_next_entry(pCur)) {
+    if (visited >= sample_keys || IsInterrupted()) {
+      break;
+    }
+
+    unqlite_cursor_key(pCur, &key);
+    unqlite_int64 data_size = 0;
+    unqlite_kv_cursor_data(pCur, NULL, &data_size);
+    uint64_t bytes = key.size() + data_size;
+    for (size_t i = 0; i < ranges.size(); ++i) {
+      if (ranges[i].Contains(key)) {
+        result[i].keys++;
+        result[i].disk_bytes += bytes;
+      }
+    }
+    visited++;
+    visited_bytes += bytes;
+  }
+  bool finished = !unqlite_kv_cursor_valid_entry(pCur);
+  unqlite_kv_cursor_release(connection_.handle_, pCur);
+
+  Config conf = config();
+  off_t file_size = 0;
+  if (!finished && visited_bytes && !conf.InMemoryDB()) {
+    common::Error err = common::file_system::get_file_size_by_path(conf.dbname, &file_size);
+    if (err && err->IsError()) {
+      file_size = 0;
+    }
+  }
+
+  for (size_t i = 0; i < result.size(); ++i) {
+    result[i].exact = finished;
+    if (file_size) {
+      double scale = static_cast<double>(file_size) / visited_bytes;
+      result[i].keys = static_cast<uint64_t>(result[i].keys * scale);
+      result[i].disk_bytes = static_cast<uint64_t>(result[i].disk_bytes * scale);
+    }
+  }
+
+  *sizes = result;
+  return common::Error();
+}
+
 common::Error DBConnection::SetInner(const std::string& key, const std::string& value) {
   if (!IsConnected()) {
     return common::make_error_value("Not connected", common::Value::E_ERROR);
@@ -255,8 +377,19 @@ common::Error DBConnection::GetInner(const std::string& key, std::string* ret_va
     return common::make_error_value("Not connected", common::Value::E_ERROR);
   }
 
-  int rc = unqlite_kv_fetch_callback(connection_.handle_, key.c_str(), key.size(),
-                                     unqlite_data_callback, ret_val);
+  // size first, so pages of value are appended without reallocations
+  unqlite_int64 size = 0;
+  int rc = unqlite_kv_fetch(connection_.handle_, key.c_str(), key.size(), NULL, &size);
+  if (rc == UNQLITE_OK) {
+    ret_val->clear();
+    ret_val->reserve(size);
+    rc = unqlite_kv_fetch_callback(connection_.handle_, key.c_str(), key.size(),
+                                   unqlite_data_callback, ret_val);
+  }
+  if (rc == UNQLITE_NOTFOUND) {
+    return MakeKeyNotFoundError(key);
+  }
+
   if (rc != UNQLITE_OK) {
     std::string buff = common::MemSPrintf("get function error: %s", unqlite_strerror(rc));
     return common::make_error_value(buff, common::ErrorValue::E_ERROR);
@@ -283,10 +416,10 @@ common::Error DBConnection::ScanImpl(uint64_t cursor_in,
   uint64_t offset_pos = cursor_in;
   uint64_t lcursor_out = 0;
   std::vector<std::string> lkeys_out;
+  std::string skey;
   while (unqlite_kv_cursor_valid_entry(pCur)) {
     if (lkeys_out.size() < count_keys) {
-      std::string skey;
-      unqlite_kv_cursor_key_callback(pCur, unqlite_data_callback, &skey);
+      unqlite_cursor_key(pCur, &skey);
       if (common::MatchPattern(skey, pattern)) {
         if (offset_pos == 0) {
           lkeys_out.push_back(skey);
@@ -325,9 +458,9 @@ common::Error DBConnection::KeysImpl(
   unqlite_kv_cursor_first_entry(pCur);
 
   /* Iterate over the entries */
+  std::string key;
   while (unqlite_kv_cursor_valid_entry(pCur) && limit > ret->size()) {
-    std::string key;
-    unqlite_kv_cursor_key_callback(pCur, unqlite_data_callback, &key);
+    unqlite_cursor_key(pCur, &key);
     if (key_start < key && key_end > key) {
       ret->push_back(key);
     }
@@ -377,9 +510,9 @@ common::Error DBConnection::FlushDBImpl() {
   unqlite_kv_cursor_first_entry(pCur);
 
   /* Iterate over the entries */
+  std::string key;
   while (unqlite_kv_cursor_valid_entry(pCur)) {
-    std::string key;
-    unqlite_kv_cursor_key_callback(pCur, unqlite_data_callback, &key);
+    unqlite_cursor_key(pCur, &key);
     common::Error err = DelInner(key);
     if (err && err->IsError()) {
       return err;
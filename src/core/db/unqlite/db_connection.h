@@ -27,6 +27,8 @@
 #include <common/error.h>   // for Error
 #include <common/macros.h>  // for WARN_UNUSED_RESULT
 
+#include "core/byte_source.h"     // for byte_source_t
+#include "core/namespace_size.h"  // for namespace_ranges_t, namespace_sizes_t
 #include "core/internal/cdb_connection.h"
 
 #include "core/db/unqlite/config.h"
@@ -49,6 +51,14 @@ class DBConnection : public core::internal::CDBConnection<NativeConnection, Conf
   explicit DBConnection(CDBConnectionClient* client);
 
   common::Error Info(const char* args, ServerInfo::Stats* statsout) WARN_UNUSED_RESULT;
+  // unqlite can't read part of record, value is streamed into chunks of source
+  common::Error OpenValueSource(const NKey& key, byte_source_t* source) WARN_UNUSED_RESULT;
+  // records are stored in hash order, so first sample_keys records of walk
+  // are sample of all namespaces, sizes of unfinished walk are scaled
+  // by size of database file, values aren't read
+  common::Error SampleSizes(const namespace_ranges_t& ranges,
+                            size_t sample_keys,
+                            namespace_sizes_t* sizes) WARN_UNUSED_RESULT;
 
  private:
   common::Error DelInner(const std::string& key) WARN_UNUSED_RESULT;
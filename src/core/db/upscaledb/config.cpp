@@ -58,6 +58,31 @@ Config parseOptions(int argc, char** argv) {
       if (common::ConvertFromString(argv[++i], &dbnum)) {
         cfg.dbnum = dbnum;
       }
+    } else if (!strcmp(argv[i], "-cache-size") && !lastarg) {
+      size_t cache_size;
+      if (common::ConvertFromString(argv[++i], &cache_size)) {
+        cfg.cache_size = cache_size;
+      }
+    } else if (!strcmp(argv[i], "-page-size") && !lastarg) {
+      uint32_t page_size;
+      if (common::ConvertFromString(argv[++i], &page_size)) {
+        cfg.page_size = page_size;
+      }
+    } else if (!strcmp(argv[i], "-key-type") && !lastarg) {
+      int key_type;
+      if (common::ConvertFromString(argv[++i], &key_type)) {
+        cfg.key_type = static_cast<KeyType>(key_type);
+      }
+    } else if (!strcmp(argv[i], "-key-size") && !lastarg) {
+      uint32_t key_size;
+      if (common::ConvertFromString(argv[++i], &key_size)) {
+        cfg.key_size = key_size;
+      }
+    } else if (!strcmp(argv[i], "-record-compression") && !lastarg) {
+      int compression;
+      if (common::ConvertFromString(argv[++i], &compression)) {
+        cfg.record_compression = static_cast<RecordCompression>(compression);
+      }
     } else {
       if (argv[i][0] == '-') {
         const std::string buff = common::MemSPrintf(
@@ -80,7 +105,12 @@ Config parseOptions(int argc, char** argv) {
 Config::Config()
     : LocalConfig(common::file_system::prepare_path("~/test.upscaledb")),
       create_if_missing(false),
-      dbnum(1) {}
+      dbnum(1),
+      cache_size(UPSCALEDB_DEFAULT_CACHE_SIZE),
+      page_size(0),
+      key_type(KEY_BINARY),
+      key_size(0),
+      record_compression(COMPRESSION_NONE) {}
 
 }  // namespace upscaledb
 }  // namespace core
@@ -100,6 +130,31 @@ std::string ConvertToString(const fastonosql::core::upscaledb::Config& conf) {
     argv.push_back(ConvertToString(conf.dbnum));
   }
 
+  if (conf.cache_size != UPSCALEDB_DEFAULT_CACHE_SIZE) {
+    argv.push_back("-cache-size");
+    argv.push_back(ConvertToString(conf.cache_size));
+  }
+
+  if (conf.page_size) {
+    argv.push_back("-page-size");
+    argv.push_back(ConvertToString(conf.page_size));
+  }
+
+  if (conf.key_type != fastonosql::core::upscaledb::KEY_BINARY) {
+    argv.push_back("-key-type");
+    argv.push_back(ConvertToString(static_cast<int>(conf.key_type)));
+  }
+
+  if (conf.key_size) {
+    argv.push_back("-key-size");
+    argv.push_back(ConvertToString(conf.key_size));
+  }
+
+  if (conf.record_compression != fastonosql::core::upscaledb::COMPRESSION_NONE) {
+    argv.push_back("-record-compression");
+    argv.push_back(ConvertToString(static_cast<int>(conf.record_compression)));
+  }
+
   return fastonosql::core::ConvertToStringConfigArgs(argv);
 }
 
@@ -18,21 +18,42 @@
 
 #pragma once
 
-#include <stdint.h>  // for uint16_t
+#include <stddef.h>  // for size_t
+#include <stdint.h>  // for uint16_t, uint32_t
 
 #include <string>
 
 #include "core/config/config.h"
 
+#define UPSCALEDB_DEFAULT_CACHE_SIZE (64 * 1024 * 1024)
+
 namespace fastonosql {
 namespace core {
 namespace upscaledb {
 
+// values of UPS_TYPE_*
+enum KeyType { KEY_BINARY = 0, KEY_UINT8 = 3, KEY_UINT16 = 5, KEY_UINT32 = 7, KEY_UINT64 = 9 };
+
+// values of UPS_COMPRESSOR_*
+enum RecordCompression {
+  COMPRESSION_NONE = 0,
+  COMPRESSION_ZLIB = 1,
+  COMPRESSION_SNAPPY = 2,
+  COMPRESSION_LZF = 3
+};
+
+// page size, key type/size and compression are persistent,
+// they are used only when env or database is created
 struct Config : public LocalConfig {
   Config();
 
   bool create_if_missing;
   uint16_t dbnum;
+  size_t cache_size;   // bytes of page cache, 0 - upscaledb default (2MB)
+  uint32_t page_size;  // bytes, 0 - upscaledb default (16KB)
+  KeyType key_type;    // numeric keys are written as decimal strings
+  uint32_t key_size;   // bytes of binary key, 0 - unlimited
+  RecordCompression record_compression;
 };
 
 }  // namespace upscaledb
@@ -20,8 +20,10 @@
 
 #include <stdlib.h>  // for NULL, free, calloc
 #include <string.h>  // for memset
-#include <string>    // for string
-#include <memory>    // for __shared_ptr
+#include <algorithm>  // for min
+#include <string>     // for string
+#include <memory>     // for __shared_ptr
+#include <mutex>      // for mutex, unique_lock
 
 #include <ups/upscaledb.h>
 
@@ -35,6 +37,7 @@
 
 #include "core/command_holder.h"       // for CommandHolder
 #include "core/internal/connection.h"  // for Connection<>::handle_t, etc
+#include "core/internal/range_scan.h"  // for GlobPrefix, PrefixEnd
 #include "core/db/upscaledb/config.h"  // for Config
 #include "core/db/upscaledb/command_translator.h"
 #include "core/db/upscaledb/database_info.h"
@@ -44,46 +47,171 @@ namespace fastonosql {
 namespace core {
 namespace upscaledb {
 
+static_assert(KEY_UINT64 == UPS_TYPE_UINT64 && KEY_UINT8 == UPS_TYPE_UINT8,
+              "KeyType should mirror UPS_TYPE_*");
+static_assert(COMPRESSION_LZF == UPS_COMPRESSOR_LZF, "RecordCompression should mirror UPS_COMPRESSOR_*");
+
 struct upscaledb {
   ups_env_t* env;
   ups_db_t* db;
   uint16_t cur_db;
+  uint16_t key_type;  // of opened database, not of config
 };
 
 namespace {
 
+uint16_t upscaledb_key_type(ups_db_t* db) {
+  ups_parameter_t params[] = {{UPS_PARAM_KEY_TYPE, 0}, {0, 0}};
+  ups_status_t st = ups_db_get_parameters(db, params);
+  if (st != UPS_SUCCESS) {
+    return UPS_TYPE_BINARY;
+  }
+
+  return static_cast<uint16_t>(params[0].value);
+}
+
 ups_status_t upscaledb_open(upscaledb** context,
                             const char* dbpath,
                             uint16_t db,
-                            bool create_if_missing) {
+                            const Config& config) {
   upscaledb* lcontext = reinterpret_cast<upscaledb*>(calloc(1, sizeof(upscaledb)));
   bool need_to_create = false;
-  if (create_if_missing) {
+  if (config.create_if_missing) {
     bool exist = common::file_system::is_file_exist(std::string(dbpath));
     if (!exist) {
       need_to_create = true;
     }
   }
 
-  ups_status_t st = need_to_create ? ups_env_create(&lcontext->env, dbpath, 0, 0664, 0)
-                                   : ups_env_open(&lcontext->env, dbpath, 0, 0);
+  ups_parameter_t env_params[3];
+  memset(env_params, 0, sizeof(env_params));
+  size_t env_count = 0;
+  if (config.cache_size) {
+    env_params[env_count].name = UPS_PARAM_CACHE_SIZE;
+    env_params[env_count++].value = config.cache_size;
+  }
+  if (need_to_create && config.page_size) {
+    env_params[env_count].name = UPS_PARAM_PAGE_SIZE;
+    env_params[env_count++].value = config.page_size;
+  }
+
+  ups_status_t st = need_to_create
+                        ? ups_env_create(&lcontext->env, dbpath, 0, 0664, env_params)
+                        : ups_env_open(&lcontext->env, dbpath, 0, env_params);
   if (st != UPS_SUCCESS) {
     free(lcontext);
     return st;
   }
 
-  st = need_to_create ? ups_env_create_db(lcontext->env, &lcontext->db, db, 0, NULL)
+  ups_parameter_t db_params[4];
+  memset(db_params, 0, sizeof(db_params));
+  size_t db_count = 0;
+  if (config.key_type != KEY_BINARY) {
+    db_params[db_count].name = UPS_PARAM_KEY_TYPE;
+    db_params[db_count++].value = config.key_type;
+  } else if (config.key_size) {
+    db_params[db_count].name = UPS_PARAM_KEY_SIZE;
+    db_params[db_count++].value = config.key_size;
+  }
+  if (config.record_compression != COMPRESSION_NONE) {
+    db_params[db_count].name = UPS_PARAM_RECORD_COMPRESSION;
+    db_params[db_count++].value = config.record_compression;
+  }
+
+  st = need_to_create ? ups_env_create_db(lcontext->env, &lcontext->db, db, 0, db_params)
                       : ups_env_open_db(lcontext->env, &lcontext->db, db, 0, NULL);
   if (st != UPS_SUCCESS) {
+    ups_env_close(lcontext->env, 0);
     free(lcontext);
     return st;
   }
 
   lcontext->cur_db = db;
+  lcontext->key_type = upscaledb_key_type(lcontext->db);
   *context = lcontext;
   return UPS_SUCCESS;
 }
 
+size_t upscaledb_key_type_size(uint16_t key_type) {
+  switch (key_type) {
+    case UPS_TYPE_UINT8:
+      return sizeof(uint8_t);
+    case UPS_TYPE_UINT16:
+      return sizeof(uint16_t);
+    case UPS_TYPE_UINT32:
+      return sizeof(uint32_t);
+    case UPS_TYPE_UINT64:
+      return sizeof(uint64_t);
+    default:
+      return 0;
+  }
+}
+
+// numeric keys are typed in as decimal strings,
+// but stored as integers in host byte order
+bool upscaledb_encode_key(uint16_t key_type, const std::string& key, std::string* raw) {
+  const size_t size = upscaledb_key_type_size(key_type);
+  if (!size) {
+    *raw = key;
+    return true;
+  }
+
+  uint64_t num;
+  if (!common::ConvertFromString(key, &num)) {
+    return false;
+  }
+
+  if (size < sizeof(uint64_t) && (num >> (size * 8))) {
+    return false;
+  }
+
+  char buff[sizeof(uint64_t)];
+  if (key_type == UPS_TYPE_UINT8) {
+    uint8_t val = static_cast<uint8_t>(num);
+    memcpy(buff, &val, size);
+  } else if (key_type == UPS_TYPE_UINT16) {
+    uint16_t val = static_cast<uint16_t>(num);
+    memcpy(buff, &val, size);
+  } else if (key_type == UPS_TYPE_UINT32) {
+    uint32_t val = static_cast<uint32_t>(num);
+    memcpy(buff, &val, size);
+  } else {
+    memcpy(buff, &num, size);
+  }
+  *raw = std::string(buff, size);
+  return true;
+}
+
+std::string upscaledb_decode_key(uint16_t key_type, const ups_key_t& key) {
+  const size_t size = upscaledb_key_type_size(key_type);
+  if (!size || key.size != size) {
+    return std::string(reinterpret_cast<const char*>(key.data), key.size);
+  }
+
+  uint64_t num = 0;
+  if (key_type == UPS_TYPE_UINT8) {
+    uint8_t val;
+    memcpy(&val, key.data, size);
+    num = val;
+  } else if (key_type == UPS_TYPE_UINT16) {
+    uint16_t val;
+    memcpy(&val, key.data, size);
+    num = val;
+  } else if (key_type == UPS_TYPE_UINT32) {
+    uint32_t val;
+    memcpy(&val, key.data, size);
+    num = val;
+  } else {
+    memcpy(&num, key.data, size);
+  }
+  return common::ConvertToString(num);
+}
+
+common::Error upscaledb_key_error(const char* command, const std::string& key) {
+  std::string buff = common::MemSPrintf("%s function error: invalid numeric key %s", command, key);
+  return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+}
+
 void upscaledb_close(upscaledb** context) {
   if (!context) {
     return;
@@ -101,6 +229,60 @@ void upscaledb_close(upscaledb** context) {
   free(lcontext);
   *context = NULL;
 }
+
+// record isn't loaded at once, every page is a partial find
+// which copies bytes straight into buffer of reader
+class PartialValueSource : public IByteSource {
+ public:
+  PartialValueSource(ups_db_t* db, const std::string& key, uint64_t size)
+      : mutex_(), db_(db), key_(key), size_(size) {}
+
+  virtual uint64_t Size() const override { return size_; }
+
+  virtual size_t Read(uint64_t offset, char* out, size_t size) override {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!db_ || offset >= size_) {
+      return 0;
+    }
+
+    ups_key_t dkey;
+    memset(&dkey, 0, sizeof(dkey));
+    dkey.size = key_.size();
+    dkey.data = const_cast<char*>(key_.c_str());
+
+    ups_record_t rec;
+    memset(&rec, 0, sizeof(rec));
+    rec.data = out;
+    rec.flags = UPS_RECORD_USER_ALLOC;
+    rec.partial_offset = static_cast<uint32_t>(offset);
+    rec.partial_size = static_cast<uint32_t>(std::min<uint64_t>(size, size_ - offset));
+    ups_status_t st = ups_db_find(db_, NULL, &dkey, &rec, UPS_PARTIAL);
+    if (st != UPS_SUCCESS) {
+      last_error_ = ups_strerror(st);
+      return 0;
+    }
+
+    last_error_.clear();
+    return rec.partial_size;
+  }
+
+  virtual std::string LastError() const override {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return last_error_;
+  }
+
+  virtual void Close() override {
+    std::unique_lock<std::mutex> lock(mutex_);
+    db_ = NULL;
+  }
+
+ private:
+  mutable std::mutex mutex_;
+  ups_db_t* db_;
+  const std::string key_;
+  const uint64_t size_;
+  std::string last_error_;
+};
 }
 }
 namespace internal {
@@ -169,7 +351,7 @@ common::Error CreateConnection(const Config& config, NativeConnection** context)
   }
 
   const char* dbname = common::utils::c_strornull(db_path);
-  int st = upscaledb_open(&lcontext, dbname, config.dbnum, config.create_if_missing);
+  int st = upscaledb_open(&lcontext, dbname, config.dbnum, config);
   if (st != UPS_SUCCESS) {
     std::string buff = common::MemSPrintf("Fail open database: %s", ups_strerror(st));
     return common::make_error_value(buff, common::ErrorValue::E_ERROR);
@@ -190,8 +372,90 @@ common::Error TestConnection(const Config& config) {
   return common::Error();
 }
 
+common::Error RestoreBackup(const Config& config,
+                            const std::string& path,
+                            backup_progress_callback_t progress_cb,
+                            BackupStats* stats) {
+  if (!stats) {
+    DNOTREACHED();
+    return common::make_error_value("Invalid input argument(s)", common::ErrorValue::E_ERROR);
+  }
+
+  off_t size = 0;
+  common::Error err = common::file_system::get_file_size_by_path(path, &size);
+  if (err && err->IsError()) {
+    return common::make_error_value(common::MemSPrintf("Invalid backup path(%s)", path),
+                                    common::ErrorValue::E_ERROR);
+  }
+
+  stats->total_bytes = size;
+  BackupProgress progress(progress_cb, stats);
+  const std::string restored = RestoreTempPath(config.dbname);
+  err = CopyFileWithProgress(path, restored, &progress);
+  if (err && err->IsError()) {
+    RemoveRestoredFile(restored);
+    return err;
+  }
+
+  err = SwapRestored(restored, config.dbname, RemoveRestoredFile);
+  if (err && err->IsError()) {
+    RemoveRestoredFile(restored);
+    return err;
+  }
+
+  progress.Finish();
+  return common::Error();
+}
+
 DBConnection::DBConnection(CDBConnectionClient* client)
-    : base_class(client, new CommandTranslator(base_class::Commands())) {}
+    : base_class(client, new CommandTranslator(base_class::Commands())),
+      value_sources_(),
+      scan_cursors_() {}
+
+DBConnection::~DBConnection() {
+  value_sources_.CloseAll();
+  CloseScanCursors();
+}
+
+void DBConnection::OnDisconnect() {
+  value_sources_.CloseAll();
+  CloseScanCursors();
+}
+
+ups_cursor_t* DBConnection::TakeScanCursor(uint64_t cursor, const std::string& pattern) {
+  for (auto it = scan_cursors_.begin(); it != scan_cursors_.end(); ++it) {
+    if (it->cursor == cursor && it->pattern == pattern) {
+      ups_cursor_t* handle = it->handle;
+      scan_cursors_.erase(it);
+      return handle;
+    }
+  }
+
+  return NULL;
+}
+
+void DBConnection::PutScanCursor(uint64_t cursor,
+                                 const std::string& pattern,
+                                 ups_cursor_t* handle) {
+  if (cursor == 0) {
+    ups_cursor_close(handle);
+    return;
+  }
+
+  ScanCursor scan = {cursor, pattern, handle};
+  scan_cursors_.push_back(scan);
+  if (scan_cursors_.size() > UPSCALEDB_SCAN_CURSORS_MAX_COUNT) {
+    ups_cursor_close(scan_cursors_.front().handle);
+    scan_cursors_.pop_front();
+  }
+}
+
+void DBConnection::CloseScanCursors() {
+  for (auto it = scan_cursors_.begin(); it != scan_cursors_.end(); ++it) {
+    ups_cursor_close(it->handle);
+  }
+  scan_cursors_.clear();
+}
 
 std::string DBConnection::CurrentDBName() const {
   if (connection_.handle_) {
@@ -235,15 +499,120 @@ common::Error DBConnection::Info(const char* args, ServerInfo::Stats* statsout)
   return common::Error();
 }
 
+common::Error DBConnection::Backup(const std::string& path,
+                                   backup_progress_callback_t progress_cb,
+                                   BackupStats* stats) {
+  if (!stats) {
+    DNOTREACHED();
+    return common::make_error_value("Invalid input argument(s)", common::ErrorValue::E_ERROR);
+  }
+
+  if (!IsConnected()) {
+    return common::make_error_value("Not connected", common::Value::E_ERROR);
+  }
+
+  // dirty pages of page cache should be on disk before copy
+  ups_status_t st = ups_env_flush(connection_.handle_->env, 0);
+  if (st != UPS_SUCCESS) {
+    std::string buff = common::MemSPrintf("BACKUP function error: %s", ups_strerror(st));
+    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+  }
+
+  const std::string dbname = connection_.config_.dbname;
+  off_t size = 0;
+  common::Error err = common::file_system::get_file_size_by_path(dbname, &size);
+  if (err && err->IsError()) {
+    return err;
+  }
+
+  stats->total_bytes = size;
+  BackupProgress progress(progress_cb, stats);
+  err = CopyFileWithProgress(dbname, path, &progress);
+  if (err && err->IsError()) {
+    return err;
+  }
+
+  progress.Finish();
+  return common::Error();
+}
+
+common::Error DBConnection::OpenValueSource(const NKey& key, byte_source_t* source) {
+  if (!source) {
+    DNOTREACHED();
+    return common::make_error_value("Invalid input argument(s)", common::ErrorValue::E_ERROR);
+  }
+
+  if (!IsConnected()) {
+    return common::make_error_value("Not connected", common::Value::E_ERROR);
+  }
+
+  std::string key_str;
+  if (!upscaledb_encode_key(connection_.handle_->key_type, key.Key(), &key_str)) {
+    return upscaledb_key_error("GET", key.Key());
+  }
+
+  ups_key_t dkey;
+  memset(&dkey, 0, sizeof(dkey));
+  dkey.size = key_str.size();
+  dkey.data = const_cast<char*>(key_str.c_str());
+
+  // compressed records can't be read partially, they are loaded once
+  if (connection_.config_.record_compression != COMPRESSION_NONE) {
+    ups_record_t rec;
+    memset(&rec, 0, sizeof(rec));
+    ups_status_t st = ups_db_find(connection_.handle_->db, NULL, &dkey, &rec, 0);
+    if (st != UPS_SUCCESS) {
+      std::string buff = common::MemSPrintf("GET function error: %s", ups_strerror(st));
+      return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+    }
+
+    ChunkedByteSource* chunked = new ChunkedByteSource;
+    chunked->Append(static_cast<const char*>(rec.data), rec.size);
+    *source = byte_source_t(chunked);
+    return common::Error();
+  }
+
+  // size of record without reading it
+  ups_cursor_t* cursor = NULL;
+  ups_status_t st = ups_cursor_create(&cursor, connection_.handle_->db, NULL, 0);
+  if (st == UPS_SUCCESS) {
+    st = ups_cursor_find(cursor, &dkey, NULL, 0);
+  }
+
+  uint32_t size = 0;
+  if (st == UPS_SUCCESS) {
+    st = ups_cursor_get_record_size(cursor, &size);
+  }
+
+  if (cursor) {
+    ups_cursor_close(cursor);
+  }
+
+  if (st != UPS_SUCCESS) {
+    std::string buff = common::MemSPrintf("GET function error: %s", ups_strerror(st));
+    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+  }
+
+  byte_source_t lsource(new PartialValueSource(connection_.handle_->db, key_str, size));
+  value_sources_.Add(lsource);
+  *source = lsource;
+  return common::Error();
+}
+
 common::Error DBConnection::SetInner(const std::string& key, const std::string& value) {
   if (!IsConnected()) {
     return common::make_error_value("Not connected", common::Value::E_ERROR);
   }
 
+  std::string raw_key;
+  if (!upscaledb_encode_key(connection_.handle_->key_type, key, &raw_key)) {
+    return upscaledb_key_error("SET", key);
+  }
+
   ups_key_t dkey;
   memset(&dkey, 0, sizeof(dkey));
-  dkey.size = key.size();
-  dkey.data = const_cast<char*>(key.c_str());
+  dkey.size = raw_key.size();
+  dkey.data = const_cast<char*>(raw_key.c_str());
 
   ups_record_t rec;
   memset(&rec, 0, sizeof(rec));
@@ -263,15 +632,24 @@ common::Error DBConnection::GetInner(const std::string& key, std::string* ret_va
     return common::make_error_value("Not connected", common::Value::E_ERROR);
   }
 
+  std::string raw_key;
+  if (!upscaledb_encode_key(connection_.handle_->key_type, key, &raw_key)) {
+    return upscaledb_key_error("GET", key);
+  }
+
   ups_key_t dkey;
   memset(&dkey, 0, sizeof(dkey));
-  dkey.size = key.size();
-  dkey.data = const_cast<char*>(key.c_str());
+  dkey.size = raw_key.size();
+  dkey.data = const_cast<char*>(raw_key.c_str());
 
   ups_record_t rec;
   memset(&rec, 0, sizeof(rec));
 
   ups_status_t st = ups_db_find(connection_.handle_->db, NULL, &dkey, &rec, 0);
+  if (st == UPS_KEY_NOT_FOUND) {
+    return MakeKeyNotFoundError(key);
+  }
+
   if (st != UPS_SUCCESS) {
     std::string buff = common::MemSPrintf("GET function error: %s", ups_strerror(st));
     return common::make_error_value(buff, common::ErrorValue::E_ERROR);
@@ -286,12 +664,19 @@ common::Error DBConnection::DelInner(const std::string& key) {
     return common::make_error_value("Not connected", common::Value::E_ERROR);
   }
 
+  std::string raw_key;
+  if (!upscaledb_encode_key(connection_.handle_->key_type, key, &raw_key)) {
+    return upscaledb_key_error("DEL", key);
+  }
+
   ups_key_t dkey;
   memset(&dkey, 0, sizeof(dkey));
 
-  dkey.size = key.size();
-  dkey.data = const_cast<char*>(key.c_str());
+  dkey.size = raw_key.size();
+  dkey.data = const_cast<char*>(raw_key.c_str());
 
+  // cursor coupled to erased key would restart from first key
+  CloseScanCursors();
   ups_status_t st = ups_db_erase(connection_.handle_->db, 0, &dkey, 0);
   if (st != UPS_SUCCESS) {
     std::string buff = common::MemSPrintf("DEL function error: %s", ups_strerror(st));
@@ -306,30 +691,59 @@ common::Error DBConnection::ScanImpl(uint64_t cursor_in,
                                      uint64_t count_keys,
                                      std::vector<std::string>* keys_out,
                                      uint64_t* cursor_out) {
-  ups_cursor_t* cursor; /* upscaledb cursor object */
+  const uint16_t key_type = connection_.handle_->key_type;
   ups_key_t key;
   ups_record_t rec;
 
   memset(&key, 0, sizeof(key));
   memset(&rec, 0, sizeof(rec));
 
-  /* create a new cursor */
-  ups_status_t st = ups_cursor_create(&cursor, connection_.handle_->db, 0, 0);
-  if (st != UPS_SUCCESS) {
-    std::string buff = common::MemSPrintf("KEYS function error: %s", ups_strerror(st));
+  // next page continues from cursor left open by previous one,
+  // forgotten scan is walked again from start
+  uint64_t offset_pos = 0;
+  ups_status_t st = UPS_SUCCESS;
+  bool positioned = false;
+  ups_cursor_t* cursor = cursor_in ? TakeScanCursor(cursor_in, pattern) : NULL;
+  const bool resumed = cursor != NULL;
+  if (!resumed) {
+    offset_pos = cursor_in;
+    st = ups_cursor_create(&cursor, connection_.handle_->db, 0, 0);
+    if (st != UPS_SUCCESS) {
+      std::string buff = common::MemSPrintf("SCAN function error: %s", ups_strerror(st));
+      return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+    }
+  }
+
+  // binary keys are sorted bytewise, so matched keys are in range of pattern prefix
+  std::string prefix = key_type == UPS_TYPE_BINARY ? internal::GlobPrefix(pattern) : std::string();
+  std::string prefix_end = internal::PrefixEnd(prefix);
+  if (!prefix.empty() && !resumed) {
+    key.size = prefix.size();
+    key.data = const_cast<char*>(prefix.c_str());
+    st = ups_cursor_find(cursor, &key, NULL, UPS_FIND_GEQ_MATCH);
+    positioned = st == UPS_SUCCESS;
+  }
+
+  if (st != UPS_SUCCESS && st != UPS_KEY_NOT_FOUND) {
+    ups_cursor_close(cursor);
+    std::string buff = common::MemSPrintf("SCAN function error: %s", ups_strerror(st));
     return common::make_error_value(buff, common::ErrorValue::E_ERROR);
   }
 
-  uint64_t offset_pos = cursor_in;
   uint64_t lcursor_out = 0;
   std::vector<std::string> lkeys_out;
   while (st == UPS_SUCCESS) {
     if (lkeys_out.size() < count_keys) {
-      /* fetch the next item, and repeat till we've reached the end
-       * of the database */
-      st = ups_cursor_move(cursor, &key, &rec, UPS_CURSOR_NEXT | UPS_SKIP_DUPLICATES);
+      if (!positioned) {
+        st = ups_cursor_move(cursor, &key, &rec, UPS_CURSOR_NEXT | UPS_SKIP_DUPLICATES);
+      }
+      positioned = false;
       if (st == UPS_SUCCESS) {
-        std::string skey(reinterpret_cast<const char*>(key.data), key.size);
+        std::string skey = upscaledb_decode_key(key_type, key);
+        if (!prefix_end.empty() && skey >= prefix_end) {
+          break;
+        }
+
         if (common::MatchPattern(skey, pattern)) {
           if (offset_pos == 0) {
             lkeys_out.push_back(skey);
@@ -348,7 +762,7 @@ common::Error DBConnection::ScanImpl(uint64_t cursor_in,
     }
   }
 
-  ups_cursor_close(cursor);
+  PutScanCursor(lcursor_out, pattern, cursor);
   *keys_out = lkeys_out;
   *cursor_out = lcursor_out;
   return common::Error();
@@ -358,6 +772,7 @@ common::Error DBConnection::KeysImpl(const std::string& key_start,
                                      const std::string& key_end,
                                      uint64_t limit,
                                      std::vector<std::string>* ret) {
+  const uint16_t key_type = connection_.handle_->key_type;
   ups_cursor_t* cursor; /* upscaledb cursor object */
   ups_key_t key;
   ups_record_t rec;
@@ -372,10 +787,27 @@ common::Error DBConnection::KeysImpl(const std::string& key_start,
     return common::make_error_value(buff, common::ErrorValue::E_ERROR);
   }
 
-  do {
-    st = ups_cursor_move(cursor, &key, &rec, UPS_CURSOR_NEXT | UPS_SKIP_DUPLICATES);
+  // binary keys are sorted bytewise, range starts right at key_start
+  bool positioned = false;
+  const bool sorted = key_type == UPS_TYPE_BINARY;
+  if (sorted && !key_start.empty()) {
+    key.size = key_start.size();
+    key.data = const_cast<char*>(key_start.c_str());
+    st = ups_cursor_find(cursor, &key, NULL, UPS_FIND_GEQ_MATCH);
+    positioned = st == UPS_SUCCESS;
+  }
+
+  while (st == UPS_SUCCESS && limit > ret->size()) {
+    if (!positioned) {
+      st = ups_cursor_move(cursor, &key, &rec, UPS_CURSOR_NEXT | UPS_SKIP_DUPLICATES);
+    }
+    positioned = false;
     if (st == UPS_SUCCESS) {
-      std::string skey(reinterpret_cast<const char*>(key.data), key.size);
+      std::string skey = upscaledb_decode_key(key_type, key);
+      if (sorted && key_end <= skey) {
+        break;
+      }
+
       if (key_start < skey && key_end > skey) {
         ret->push_back(skey);
       }
@@ -384,15 +816,17 @@ common::Error DBConnection::KeysImpl(const std::string& key_start,
       std::string buff = common::MemSPrintf("SCAN function error: %s", ups_strerror(st));
       return common::make_error_value(buff, common::ErrorValue::E_ERROR);
     }
-  } while (st == UPS_SUCCESS && limit > ret->size());
+  }
 
   ups_cursor_close(cursor);
   return common::Error();
 }
 
+// estimate is taken from btree pages statistics without walking leafs
 common::Error DBConnection::DBkcountImpl(size_t* size) {
   uint64_t sz = 0;
-  ups_status_t st = ups_db_count(connection_.handle_->db, NULL, UPS_SKIP_DUPLICATES, &sz);
+  ups_status_t st = ups_db_count(connection_.handle_->db, NULL,
+                                 UPS_SKIP_DUPLICATES | UPS_FAST_ESTIMATE, &sz);
   if (st != UPS_SUCCESS) {
     std::string buff = common::MemSPrintf("DBKCOUNT function error: %s", ups_strerror(st));
     return common::make_error_value(buff, common::ErrorValue::E_ERROR);
@@ -410,6 +844,7 @@ common::Error DBConnection::FlushDBImpl() {
   memset(&key, 0, sizeof(key));
   memset(&rec, 0, sizeof(rec));
 
+  CloseScanCursors();
   /* create a new cursor */
   ups_status_t st = ups_cursor_create(&cursor, connection_.handle_->db, 0, 0);
   if (st != UPS_SUCCESS) {
@@ -447,9 +882,12 @@ common::Error DBConnection::SelectImpl(const std::string& name, IDataBaseInfo**
   }
 
   if (st == UPS_SUCCESS) {  // if ready to change
+    value_sources_.CloseAll();
+    CloseScanCursors();
     st = ups_db_close(connection_.handle_->db, 0);
     DCHECK(st == UPS_SUCCESS);
     connection_.handle_->db = db;
+    connection_.handle_->key_type = upscaledb_key_type(db);
     connection_.config_.dbnum = num;
     connection_.handle_->cur_db = num;
   }
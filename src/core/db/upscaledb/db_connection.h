@@ -21,12 +21,15 @@
 #include <stdint.h>  // for uint64_t
 #include <stddef.h>  // for size_t
 
+#include <deque>   // for deque
 #include <vector>  // for vector
 #include <string>  // for string
 
 #include <common/error.h>   // for Error
 #include <common/macros.h>  // for WARN_UNUSED_RESULT
 
+#include "core/backup.h"                   // for BackupStats, backup_progress_callback_t
+#include "core/byte_source.h"              // for byte_source_t, ByteSources
 #include "core/connection_types.h"         // for connectionTypes::UPSCALEDB
 #include "core/db_key.h"                   // for NDbKValue, NKey, NKeys
 #include "core/internal/cdb_connection.h"  // for CDBConnection
@@ -34,6 +37,10 @@
 #include "core/db/upscaledb/server_info.h"  // for ServerInfo
 #include "core/db/upscaledb/config.h"
 
+#define UPSCALEDB_SCAN_CURSORS_MAX_COUNT 16
+
+struct ups_cursor_t;
+
 namespace fastonosql {
 namespace core {
 class CDBConnectionClient;
@@ -60,22 +67,45 @@ typedef upscaledb NativeConnection;
 
 common::Error CreateConnection(const Config& config, NativeConnection** context);
 common::Error TestConnection(const Config& config);
+// replaces file of closed environment by backup file
+common::Error RestoreBackup(const Config& config,
+                            const std::string& path,
+                            backup_progress_callback_t progress_cb,
+                            BackupStats* stats) WARN_UNUSED_RESULT;
 
 class DBConnection : public core::internal::CDBConnection<NativeConnection, Config, UPSCALEDB> {
  public:
   typedef core::internal::CDBConnection<NativeConnection, Config, UPSCALEDB> base_class;
   explicit DBConnection(CDBConnectionClient* client);
+  virtual ~DBConnection();
 
   common::Error Connect(const config_t& config);
 
   std::string CurrentDBName() const;
   common::Error Info(const char* args, ServerInfo::Stats* statsout) WARN_UNUSED_RESULT;
+  // pages of value are read by partial finds right into buffer of reader
+  common::Error OpenValueSource(const NKey& key, byte_source_t* source) WARN_UNUSED_RESULT;
+  // environment is flushed and its file is copied into file path
+  common::Error Backup(const std::string& path,
+                       backup_progress_callback_t progress_cb,
+                       BackupStats* stats) WARN_UNUSED_RESULT;
 
  private:
   common::Error SetInner(const std::string& key, const std::string& value) WARN_UNUSED_RESULT;
   common::Error GetInner(const std::string& key, std::string* ret_val) WARN_UNUSED_RESULT;
   common::Error DelInner(const std::string& key) WARN_UNUSED_RESULT;
 
+  // cursors of paginated scans stay open keyed by cursor of next page,
+  // they are closed when keys are erased or database is changed
+  struct ScanCursor {
+    uint64_t cursor;
+    std::string pattern;
+    ups_cursor_t* handle;
+  };
+  ups_cursor_t* TakeScanCursor(uint64_t cursor, const std::string& pattern);
+  void PutScanCursor(uint64_t cursor, const std::string& pattern, ups_cursor_t* handle);
+  void CloseScanCursors();
+
   virtual common::Error ScanImpl(uint64_t cursor_in,
                                  const std::string& pattern,
                                  uint64_t count_keys,
@@ -95,6 +125,11 @@ class DBConnection : public core::internal::CDBConnection<NativeConnection, Conf
   virtual common::Error SetTTLImpl(const NKey& key, ttl_t ttl) override;
   virtual common::Error GetTTLImpl(const NKey& key, ttl_t* ttl) override;
   virtual common::Error QuitImpl() override;
+  // value sources and scan cursors should be closed before env is closed
+  virtual void OnDisconnect() override;
+
+  ByteSources value_sources_;
+  std::deque<ScanCursor> scan_cursors_;
 };
 
 }  // namespace upscaledb
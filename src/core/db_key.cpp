@@ -22,6 +22,7 @@
 #include <string>  // for string
 #include <vector>  // for vector
 
+#include <common/sprintf.h>      // for MemSPrintf
 #include <common/string_util.h>  // for JoinString, Tokenize
 
 #include "core/global.h"
@@ -149,5 +150,14 @@ bool NDbKValue::Equals(const NDbKValue& other) const {
   return value_->Equals(other.value_.get());
 }
 
+common::Error MakeKeyNotFoundError(const std::string& key) {
+  std::string buff = common::MemSPrintf("Key %s not found.", key);
+  return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+}
+
+bool IsKeyNotFoundError(common::Error err, const std::string& key) {
+  return err && err->IsError() && err->Description() == MakeKeyNotFoundError(key)->Description();
+}
+
 }  // namespace core
 }  // namespace fastonosql
@@ -24,6 +24,7 @@
 #include <string>  // for string
 #include <vector>  // for vector
 
+#include <common/error.h>  // for Error
 #include <common/value.h>  // for Value, Value::Type, etc
 
 #define NO_TTL -1
@@ -110,5 +111,10 @@ inline bool operator==(const NDbKValue& r, const NDbKValue& l) {
 
 typedef std::vector<NDbKValue> NDbKValues;
 
+// error of Get for key which doesn't exist, so readers of whole keyspace
+// tell keys removed while they were running from failed reads
+common::Error MakeKeyNotFoundError(const std::string& key);
+bool IsKeyNotFoundError(common::Error err, const std::string& key);
+
 }  // namespace core
 }  // namespace fastonosql
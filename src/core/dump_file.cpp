@@ -0,0 +1,723 @@
+/*  Copyright (C) 2014-2016 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "core/dump_file.h"
+
+#include <string.h>  // for memcpy
+#include <zlib.h>    // for compress2, uncompress, crc32
+
+#include <common/sprintf.h>      // for MemSPrintf
+#include <common/string_util.h>  // for MatchPattern
+
+#include "core/global.h"  // for ConvertToString
+
+#define DUMP_MAGIC_SIZE 8
+#define DUMP_BLOCK_HEADER_SIZE 13  // raw size, stored size, crc32, compression
+#define DUMP_FOOTER_SIZE 32        // index offset, index size, crc32, records, magic
+#define DUMP_CONVERTED_VALUES_DELIMITER " "
+
+namespace fastonosql {
+namespace core {
+
+namespace {
+
+void PutFixed32(uint32_t value, std::string* out) {
+  for (int i = 0; i < 4; ++i) {
+    out->push_back(static_cast<char>((value >> (i * 8)) & 0xff));
+  }
+}
+
+void PutFixed64(uint64_t value, std::string* out) {
+  for (int i = 0; i < 8; ++i) {
+    out->push_back(static_cast<char>((value >> (i * 8)) & 0xff));
+  }
+}
+
+void PutString(const std::string& value, std::string* out) {
+  PutFixed32(static_cast<uint32_t>(value.size()), out);
+  out->append(value);
+}
+
+// reads fixed size fields of buffer, any read out of bounds makes reader invalid
+class BufferReader {
+ public:
+  BufferReader(const std::string& data, size_t pos) : data_(data), pos_(pos), valid_(true) {}
+
+  bool IsValid() const { return valid_; }
+  size_t Pos() const { return pos_; }
+  bool IsEnd() const { return pos_ >= data_.size(); }
+
+  uint8_t Fixed8() {
+    if (!Has(1)) {
+      return 0;
+    }
+    return static_cast<uint8_t>(data_[pos_++]);
+  }
+
+  uint32_t Fixed32() {
+    if (!Has(4)) {
+      return 0;
+    }
+    uint32_t res = 0;
+    for (int i = 0; i < 4; ++i) {
+      res |= static_cast<uint32_t>(static_cast<uint8_t>(data_[pos_++])) << (i * 8);
+    }
+    return res;
+  }
+
+  uint64_t Fixed64() {
+    if (!Has(8)) {
+      return 0;
+    }
+    uint64_t res = 0;
+    for (int i = 0; i < 8; ++i) {
+      res |= static_cast<uint64_t>(static_cast<uint8_t>(data_[pos_++])) << (i * 8);
+    }
+    return res;
+  }
+
+  std::string String() {
+    uint32_t size = Fixed32();
+    if (!Has(size)) {
+      return std::string();
+    }
+    std::string res = data_.substr(pos_, size);
+    pos_ += size;
+    return res;
+  }
+
+ private:
+  bool Has(size_t size) {
+    if (!valid_ || pos_ > data_.size() || data_.size() - pos_ < size) {
+      valid_ = false;
+      return false;
+    }
+    return true;
+  }
+
+  const std::string& data_;
+  size_t pos_;
+  bool valid_;
+};
+
+uint32_t Checksum(const std::string& data) {
+  uLong crc = crc32(0L, Z_NULL, 0);
+  crc = crc32(crc, reinterpret_cast<const Bytef*>(data.data()), static_cast<uInt>(data.size()));
+  return static_cast<uint32_t>(crc);
+}
+
+common::Error MakeCorruptedError(const std::string& what) {
+  std::string buff = common::MemSPrintf("Corrupted dump file: %s", what);
+  return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+}
+
+void EncodeElement(common::Value* value, std::string* out) {
+  std::string payload;
+  EncodeDumpValue(value, &payload);
+  common::Value::Type type = value->GetType();
+  if (type == common::Value::TYPE_BYTE_ARRAY) {
+    type = common::Value::TYPE_STRING;
+  }
+  out->push_back(static_cast<char>(type));
+  PutString(payload, out);
+}
+
+common::Error DecodeElement(BufferReader* reader, common::Value** out) {
+  common::Value::Type type = static_cast<common::Value::Type>(reader->Fixed8());
+  std::string payload = reader->String();
+  if (!reader->IsValid()) {
+    return MakeCorruptedError("container element");
+  }
+  return DecodeDumpValue(type, payload, out);
+}
+
+}  // namespace
+
+DumpOptions::DumpOptions()
+    : compression(DUMP_COMPRESSION_ZLIB), block_size(DUMP_DEFAULT_BLOCK_SIZE) {}
+
+void EncodeDumpValue(common::Value* value, std::string* out) {
+  const common::Value::Type type = value->GetType();
+  common::FundamentalValue* number = static_cast<common::FundamentalValue*>(value);
+  if (type == common::Value::TYPE_NULL) {
+    // null has empty payload
+  } else if (type == common::Value::TYPE_BOOLEAN) {
+    bool res = false;
+    number->GetAsBoolean(&res);
+    out->push_back(res ? 1 : 0);
+  } else if (type == common::Value::TYPE_INTEGER) {
+    int res = 0;
+    number->GetAsInteger(&res);
+    PutFixed64(static_cast<uint64_t>(static_cast<int64_t>(res)), out);
+  } else if (type == common::Value::TYPE_UINTEGER) {
+    unsigned int res = 0;
+    number->GetAsUInteger(&res);
+    PutFixed64(res, out);
+  } else if (type == common::Value::TYPE_LONG_INTEGER) {
+    long res = 0;
+    number->GetAsLongInteger(&res);
+    PutFixed64(static_cast<uint64_t>(static_cast<int64_t>(res)), out);
+  } else if (type == common::Value::TYPE_ULONG_INTEGER) {
+    unsigned long res = 0;
+    number->GetAsULongInteger(&res);
+    PutFixed64(res, out);
+  } else if (type == common::Value::TYPE_LONG_LONG_INTEGER) {
+    long long res = 0;
+    number->GetAsLongLongInteger(&res);
+    PutFixed64(static_cast<uint64_t>(res), out);
+  } else if (type == common::Value::TYPE_ULONG_LONG_INTEGER) {
+    unsigned long long res = 0;
+    number->GetAsULongLongInteger(&res);
+    PutFixed64(res, out);
+  } else if (type == common::Value::TYPE_DOUBLE) {
+    double res = 0;
+    number->GetAsDouble(&res);
+    uint64_t bits = 0;
+    memcpy(&bits, &res, sizeof(bits));
+    PutFixed64(bits, out);
+  } else if (type == common::Value::TYPE_ARRAY) {
+    common::ArrayValue* array = static_cast<common::ArrayValue*>(value);
+    PutFixed32(static_cast<uint32_t>(array->GetSize()), out);
+    for (auto it = array->begin(); it != array->end(); ++it) {
+      EncodeElement(*it, out);
+    }
+  } else if (type == common::Value::TYPE_SET) {
+    common::SetValue* set = static_cast<common::SetValue*>(value);
+    PutFixed32(static_cast<uint32_t>(set->GetSize()), out);
+    for (auto it = set->begin(); it != set->end(); ++it) {
+      EncodeElement(*it, out);
+    }
+  } else if (type == common::Value::TYPE_ZSET) {
+    common::ZSetValue* zset = static_cast<common::ZSetValue*>(value);
+    PutFixed32(static_cast<uint32_t>(zset->GetSize()), out);
+    for (auto it = zset->begin(); it != zset->end(); ++it) {
+      EncodeElement((*it).first, out);
+      EncodeElement((*it).second, out);
+    }
+  } else if (type == common::Value::TYPE_HASH) {
+    common::HashValue* hash = static_cast<common::HashValue*>(value);
+    PutFixed32(static_cast<uint32_t>(hash->GetSize()), out);
+    for (auto it = hash->begin(); it != hash->end(); ++it) {
+      EncodeElement((*it).first, out);
+      EncodeElement((*it).second, out);
+    }
+  } else {
+    // strings, byte arrays are stored as strings
+    out->append(common::ConvertToString(value, DUMP_CONVERTED_VALUES_DELIMITER));
+  }
+}
+
+common::Error DecodeDumpValue(common::Value::Type type,
+                              const std::string& payload,
+                              common::Value** out) {
+  if (!out) {
+    DNOTREACHED();
+    return common::make_error_value("Invalid input argument(s)", common::ErrorValue::E_ERROR);
+  }
+
+  BufferReader reader(payload, 0);
+  common::Value* value = nullptr;
+  if (type == common::Value::TYPE_NULL) {
+    value = common::Value::CreateNullValue();
+  } else if (type == common::Value::TYPE_STRING) {
+    value = common::Value::CreateStringValue(payload);
+  } else if (type == common::Value::TYPE_BOOLEAN) {
+    value = common::Value::CreateBooleanValue(reader.Fixed8() != 0);
+  } else if (type == common::Value::TYPE_INTEGER) {
+    value = common::Value::CreateIntegerValue(static_cast<int>(reader.Fixed64()));
+  } else if (type == common::Value::TYPE_UINTEGER) {
+    value = common::Value::CreateUIntegerValue(static_cast<unsigned int>(reader.Fixed64()));
+  } else if (type == common::Value::TYPE_LONG_INTEGER ||
+             type == common::Value::TYPE_LONG_LONG_INTEGER) {
+    value = common::Value::CreateLongLongIntegerValue(static_cast<long long>(reader.Fixed64()));
+  } else if (type == common::Value::TYPE_ULONG_INTEGER ||
+             type == common::Value::TYPE_ULONG_LONG_INTEGER) {
+    value = common::Value::CreateULongLongIntegerValue(reader.Fixed64());
+  } else if (type == common::Value::TYPE_DOUBLE) {
+    uint64_t bits = reader.Fixed64();
+    double res = 0;
+    memcpy(&res, &bits, sizeof(res));
+    value = common::Value::CreateDoubleValue(res);
+  } else if (type == common::Value::TYPE_ARRAY || type == common::Value::TYPE_SET) {
+    uint32_t count = reader.Fixed32();
+    common::ArrayValue* array =
+        type == common::Value::TYPE_ARRAY ? common::Value::CreateArrayValue() : nullptr;
+    common::SetValue* set = array ? nullptr : common::Value::CreateSetValue();
+    value = array ? static_cast<common::Value*>(array) : static_cast<common::Value*>(set);
+    for (uint32_t i = 0; i < count && reader.IsValid(); ++i) {
+      common::Value* element = nullptr;
+      common::Error err = DecodeElement(&reader, &element);
+      if (err && err->IsError()) {
+        delete value;
+        return err;
+      }
+      if (array) {
+        array->Append(element);
+      } else {
+        set->Insert(element);
+      }
+    }
+  } else if (type == common::Value::TYPE_ZSET || type == common::Value::TYPE_HASH) {
+    uint32_t count = reader.Fixed32();
+    common::ZSetValue* zset =
+        type == common::Value::TYPE_ZSET ? common::Value::CreateZSetValue() : nullptr;
+    common::HashValue* hash = zset ? nullptr : common::Value::CreateHashValue();
+    value = zset ? static_cast<common::Value*>(zset) : static_cast<common::Value*>(hash);
+    for (uint32_t i = 0; i < count && reader.IsValid(); ++i) {
+      common::Value* first = nullptr;
+      common::Error err = DecodeElement(&reader, &first);
+      if (err && err->IsError()) {
+        delete value;
+        return err;
+      }
+      common::Value* second = nullptr;
+      err = DecodeElement(&reader, &second);
+      if (err && err->IsError()) {
+        delete first;
+        delete value;
+        return err;
+      }
+      if (zset) {
+        zset->Insert(first, second);
+      } else {
+        hash->Insert(first, second);
+      }
+    }
+  } else {
+    return MakeCorruptedError(common::MemSPrintf("unknown value type %d", type));
+  }
+
+  if (!reader.IsValid()) {
+    delete value;
+    return MakeCorruptedError("value payload");
+  }
+
+  *out = value;
+  return common::Error();
+}
+
+DumpWriter::DumpWriter(const DumpOptions& options)
+    : options_(options), file_(), offset_(0), records_(0), block_(), block_entry_(), index_() {}
+
+DumpWriter::~DumpWriter() {
+  if (file_.is_open()) {
+    file_.close();
+  }
+}
+
+common::Error DumpWriter::Open(const std::string& path) {
+  file_.open(path.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!file_.is_open()) {
+    std::string buff = common::MemSPrintf("Can't open dump file for writing: %s", path);
+    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+  }
+
+  offset_ = 0;
+  records_ = 0;
+  index_.clear();
+  return Write(std::string(DUMP_FILE_MAGIC, DUMP_MAGIC_SIZE));
+}
+
+common::Error DumpWriter::Close() {
+  if (!file_.is_open()) {
+    return common::Error();
+  }
+
+  common::Error err = FlushBlock();
+  if (err && err->IsError()) {
+    file_.close();
+    return err;
+  }
+
+  std::string index;
+  for (size_t i = 0; i < index_.size(); ++i) {
+    PutFixed64(index_[i].offset, &index);
+    PutFixed32(index_[i].records, &index);
+    PutString(index_[i].first_key, &index);
+  }
+
+  std::string footer;
+  PutFixed64(offset_, &footer);
+  PutFixed32(static_cast<uint32_t>(index.size()), &footer);
+  PutFixed32(Checksum(index), &footer);
+  PutFixed64(records_, &footer);
+  footer.append(DUMP_FILE_MAGIC, DUMP_MAGIC_SIZE);
+
+  err = Write(index);
+  if (!err) {
+    err = Write(footer);
+  }
+  file_.close();
+  return err;
+}
+
+bool DumpWriter::IsSupportedType(common::Value::Type type) const {
+  UNUSED(type);
+  return true;
+}
+
+bool DumpWriter::IsSupportedTTL() const {
+  return true;
+}
+
+common::Error DumpWriter::SetBatch(const NDbKValues& keys, NDbKValues* added_keys) {
+  if (!added_keys) {
+    DNOTREACHED();
+    return common::make_error_value("Invalid input argument(s)", common::ErrorValue::E_ERROR);
+  }
+
+  if (!file_.is_open()) {
+    return common::make_error_value("Dump file isn't opened", common::ErrorValue::E_ERROR);
+  }
+
+  for (size_t i = 0; i < keys.size(); ++i) {
+    NKey key = keys[i].Key();
+    NValue value = keys[i].Value();
+    if (block_.empty()) {
+      block_entry_.offset = offset_;
+      block_entry_.records = 0;
+      block_entry_.first_key = key.Key();
+    }
+
+    common::Value::Type type = value->GetType();
+    if (type == common::Value::TYPE_BYTE_ARRAY) {
+      type = common::Value::TYPE_STRING;
+    }
+    std::string payload;
+    EncodeDumpValue(value.get(), &payload);
+    PutString(key.Key(), &block_);
+    PutFixed64(static_cast<uint64_t>(key.TTL()), &block_);
+    block_.push_back(static_cast<char>(type));
+    PutString(payload, &block_);
+    block_entry_.records++;
+    records_++;
+    added_keys->push_back(keys[i]);
+
+    if (block_.size() >= options_.block_size) {
+      common::Error err = FlushBlock();
+      if (err && err->IsError()) {
+        return err;
+      }
+    }
+  }
+
+  return common::Error();
+}
+
+uint64_t DumpWriter::Records() const {
+  return records_;
+}
+
+uint64_t DumpWriter::WrittenBytes() const {
+  return offset_;
+}
+
+common::Error DumpWriter::FlushBlock() {
+  if (block_.empty()) {
+    return common::Error();
+  }
+
+  const uint32_t raw_size = static_cast<uint32_t>(block_.size());
+  DumpCompression compression = DUMP_COMPRESSION_NONE;
+  std::string stored;
+  if (options_.compression == DUMP_COMPRESSION_ZLIB) {
+    uLongf stored_size = compressBound(static_cast<uLong>(block_.size()));
+    stored.resize(stored_size);
+    int rc = compress2(reinterpret_cast<Bytef*>(&stored[0]), &stored_size,
+                       reinterpret_cast<const Bytef*>(block_.data()),
+                       static_cast<uLong>(block_.size()), Z_DEFAULT_COMPRESSION);
+    // incompressible blocks are stored as is
+    if (rc == Z_OK && stored_size < block_.size()) {
+      stored.resize(stored_size);
+      compression = DUMP_COMPRESSION_ZLIB;
+    }
+  }
+  if (compression == DUMP_COMPRESSION_NONE) {
+    stored.swap(block_);
+  }
+
+  std::string header;
+  PutFixed32(raw_size, &header);
+  PutFixed32(static_cast<uint32_t>(stored.size()), &header);
+  PutFixed32(Checksum(stored), &header);
+  header.push_back(static_cast<char>(compression));
+
+  common::Error err = Write(header);
+  if (!err) {
+    err = Write(stored);
+  }
+  if (err && err->IsError()) {
+    return err;
+  }
+
+  index_.push_back(block_entry_);
+  block_.clear();
+  return common::Error();
+}
+
+common::Error DumpWriter::Write(const std::string& data) {
+  file_.write(data.data(), data.size());
+  if (!file_.good()) {
+    return common::make_error_value("Dump file write error", common::ErrorValue::E_ERROR);
+  }
+
+  offset_ += data.size();
+  return common::Error();
+}
+
+DumpReader::DumpReader()
+    : file_(),
+      index_(),
+      records_(0),
+      read_records_(0),
+      next_block_(0),
+      block_(),
+      block_pos_(0),
+      page_() {}
+
+DumpReader::~DumpReader() {
+  Close();
+}
+
+common::Error DumpReader::Open(const std::string& path) {
+  file_.open(path.c_str(), std::ios::in | std::ios::binary);
+  if (!file_.is_open()) {
+    std::string buff = common::MemSPrintf("Can't open dump file: %s", path);
+    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+  }
+
+  std::string magic(DUMP_MAGIC_SIZE, 0);
+  file_.read(&magic[0], DUMP_MAGIC_SIZE);
+  file_.seekg(0, std::ios::end);
+  const uint64_t file_size = file_.tellg();
+  if (!file_.good() || magic != DUMP_FILE_MAGIC ||
+      file_size < DUMP_MAGIC_SIZE + DUMP_FOOTER_SIZE) {
+    Close();
+    return MakeCorruptedError("header");
+  }
+
+  std::string footer(DUMP_FOOTER_SIZE, 0);
+  file_.seekg(file_size - DUMP_FOOTER_SIZE);
+  file_.read(&footer[0], DUMP_FOOTER_SIZE);
+  BufferReader footer_reader(footer, 0);
+  const uint64_t index_offset = footer_reader.Fixed64();
+  const uint32_t index_size = footer_reader.Fixed32();
+  const uint32_t index_crc = footer_reader.Fixed32();
+  records_ = footer_reader.Fixed64();
+  if (!file_.good() || footer.substr(footer_reader.Pos()) != DUMP_FILE_MAGIC ||
+      index_offset + index_size + DUMP_FOOTER_SIZE != file_size) {
+    Close();
+    return MakeCorruptedError("footer");
+  }
+
+  std::string index(index_size, 0);
+  file_.seekg(index_offset);
+  file_.read(&index[0], index_size);
+  if (!file_.good() || Checksum(index) != index_crc) {
+    Close();
+    return MakeCorruptedError("index checksum mismatch");
+  }
+
+  BufferReader index_reader(index, 0);
+  while (!index_reader.IsEnd()) {
+    DumpIndexEntry entry;
+    entry.offset = index_reader.Fixed64();
+    entry.records = index_reader.Fixed32();
+    entry.first_key = index_reader.String();
+    if (!index_reader.IsValid()) {
+      Close();
+      return MakeCorruptedError("index");
+    }
+    index_.push_back(entry);
+  }
+
+  read_records_ = 0;
+  next_block_ = 0;
+  block_.clear();
+  block_pos_ = 0;
+  return common::Error();
+}
+
+void DumpReader::Close() {
+  if (file_.is_open()) {
+    file_.close();
+  }
+  index_.clear();
+  block_.clear();
+  page_.clear();
+}
+
+common::Error DumpReader::Scan(uint64_t cursor_in,
+                               const std::string& pattern,
+                               uint64_t count_keys,
+                               std::vector<std::string>* keys_out,
+                               uint64_t* cursor_out) {
+  if (!keys_out || !cursor_out) {
+    DNOTREACHED();
+    return common::make_error_value("Invalid input argument(s)", common::ErrorValue::E_ERROR);
+  }
+
+  if (!file_.is_open()) {
+    return common::make_error_value("Dump file isn't opened", common::ErrorValue::E_ERROR);
+  }
+
+  if (cursor_in != read_records_) {
+    return common::make_error_value("Dump file can be read only sequentially",
+                                    common::ErrorValue::E_ERROR);
+  }
+
+  page_.clear();
+  uint64_t page_records = 0;
+  while (page_records < count_keys && read_records_ < records_) {
+    NDbKValue record;
+    common::Error err = NextRecord(&record);
+    if (err && err->IsError()) {
+      return err;
+    }
+
+    page_records++;
+    std::string key = record.KeyString();
+    if (common::MatchPattern(key, pattern)) {
+      keys_out->push_back(key);
+      page_[key] = record;
+    }
+  }
+
+  *cursor_out = read_records_ < records_ ? read_records_ : 0;
+  return common::Error();
+}
+
+common::Error DumpReader::Get(const NKey& key, NDbKValue* loaded_key) {
+  if (!loaded_key) {
+    DNOTREACHED();
+    return common::make_error_value("Invalid input argument(s)", common::ErrorValue::E_ERROR);
+  }
+
+  auto it = page_.find(key.Key());
+  if (it == page_.end()) {
+    return common::make_error_value("Key isn't in scanned page of dump",
+                                    common::ErrorValue::E_ERROR);
+  }
+
+  *loaded_key = it->second;
+  return common::Error();
+}
+
+common::Error DumpReader::DBkcount(size_t* size) {
+  if (!size) {
+    DNOTREACHED();
+    return common::make_error_value("Invalid input argument(s)", common::ErrorValue::E_ERROR);
+  }
+
+  *size = records_;
+  return common::Error();
+}
+
+common::Error DumpReader::GetTTL(const NKey& key, ttl_t* ttl) {
+  if (!ttl) {
+    DNOTREACHED();
+    return common::make_error_value("Invalid input argument(s)", common::ErrorValue::E_ERROR);
+  }
+
+  NDbKValue loaded_key;
+  common::Error err = Get(key, &loaded_key);
+  if (err && err->IsError()) {
+    return err;
+  }
+
+  *ttl = loaded_key.Key().TTL();
+  return common::Error();
+}
+
+const std::vector<DumpIndexEntry>& DumpReader::Index() const {
+  return index_;
+}
+
+common::Error DumpReader::ReadBlock(size_t pos) {
+  std::string header(DUMP_BLOCK_HEADER_SIZE, 0);
+  file_.seekg(index_[pos].offset);
+  file_.read(&header[0], DUMP_BLOCK_HEADER_SIZE);
+  BufferReader header_reader(header, 0);
+  const uint32_t raw_size = header_reader.Fixed32();
+  const uint32_t stored_size = header_reader.Fixed32();
+  const uint32_t crc = header_reader.Fixed32();
+  const uint8_t compression = header_reader.Fixed8();
+  if (!file_.good()) {
+    return MakeCorruptedError("block header");
+  }
+
+  std::string stored(stored_size, 0);
+  file_.read(&stored[0], stored_size);
+  if (!file_.good() || Checksum(stored) != crc) {
+    return MakeCorruptedError("block checksum mismatch");
+  }
+
+  if (compression == DUMP_COMPRESSION_NONE) {
+    block_.swap(stored);
+  } else if (compression == DUMP_COMPRESSION_ZLIB) {
+    block_.resize(raw_size);
+    uLongf size = raw_size;
+    int rc = uncompress(reinterpret_cast<Bytef*>(&block_[0]), &size,
+                        reinterpret_cast<const Bytef*>(stored.data()), stored_size);
+    if (rc != Z_OK || size != raw_size) {
+      return MakeCorruptedError("block decompression");
+    }
+  } else {
+    return MakeCorruptedError("unknown block compression");
+  }
+
+  block_pos_ = 0;
+  return common::Error();
+}
+
+common::Error DumpReader::NextRecord(NDbKValue* record) {
+  if (block_pos_ >= block_.size()) {
+    if (next_block_ >= index_.size()) {
+      return MakeCorruptedError("records count");
+    }
+
+    common::Error err = ReadBlock(next_block_++);
+    if (err && err->IsError()) {
+      return err;
+    }
+  }
+
+  BufferReader reader(block_, block_pos_);
+  std::string key = reader.String();
+  ttl_t ttl = static_cast<ttl_t>(reader.Fixed64());
+  common::Value::Type type = static_cast<common::Value::Type>(reader.Fixed8());
+  std::string payload = reader.String();
+  if (!reader.IsValid()) {
+    return MakeCorruptedError("record");
+  }
+
+  common::Value* value = nullptr;
+  common::Error err = DecodeDumpValue(type, payload, &value);
+  if (err && err->IsError()) {
+    return err;
+  }
+
+  block_pos_ = reader.Pos();
+  read_records_++;
+  *record = NDbKValue(NKey(key, ttl), NValue(value));
+  return common::Error();
+}
+
+}  // namespace core
+}  // namespace fastonosql
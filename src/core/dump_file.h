@@ -0,0 +1,140 @@
+/*  Copyright (C) 2014-2016 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <stddef.h>  // for size_t
+#include <stdint.h>  // for uint32_t, uint64_t
+
+#include <fstream>  // for ifstream, ofstream
+#include <map>      // for map
+#include <string>   // for string
+#include <vector>   // for vector
+
+#include <common/error.h>   // for Error
+#include <common/macros.h>  // for WARN_UNUSED_RESULT
+#include <common/value.h>   // for Value, Value::Type
+
+#include "core/copy_pipeline.h"  // for ICopySource, ICopyTarget
+#include "core/db_key.h"         // for NDbKValues, NKey
+
+#define DUMP_FILE_MAGIC "FNODUMP1"
+#define DUMP_DEFAULT_BLOCK_SIZE (256 * 1024)
+
+namespace fastonosql {
+namespace core {
+
+// file layout, integers are little endian:
+// header: magic (8 bytes)
+// block: u32 raw size, u32 stored size, u32 crc32 of stored bytes, u8 compression, stored bytes
+//   raw block is sequence of records:
+//   u32 key size, key, i64 ttl, u8 value type, u32 payload size, payload
+// index: for every block u64 offset, u32 records, u32 first key size, first key
+// footer: u64 index offset, u32 index size, u32 crc32 of index, u64 records, magic
+enum DumpCompression { DUMP_COMPRESSION_NONE = 0, DUMP_COMPRESSION_ZLIB };
+
+struct DumpOptions {
+  DumpOptions();
+
+  DumpCompression compression;
+  size_t block_size;  // raw bytes of records per block
+};
+
+struct DumpIndexEntry {
+  uint64_t offset;
+  uint32_t records;
+  std::string first_key;
+};
+
+// payload of strings is raw value, of numbers fixed size integer or double,
+// of containers u32 count and typed elements (pairs for zset and hash)
+void EncodeDumpValue(common::Value* value, std::string* out);
+common::Error DecodeDumpValue(common::Value::Type type,
+                              const std::string& payload,
+                              common::Value** out) WARN_UNUSED_RESULT;
+
+// target of copy pipeline, any value type is written as is
+class DumpWriter : public ICopyTarget {
+ public:
+  explicit DumpWriter(const DumpOptions& options);
+  virtual ~DumpWriter();
+
+  common::Error Open(const std::string& path) WARN_UNUSED_RESULT;
+  // flushes last block, writes index and footer
+  common::Error Close() WARN_UNUSED_RESULT;
+
+  virtual bool IsSupportedType(common::Value::Type type) const override;
+  virtual bool IsSupportedTTL() const override;
+  virtual common::Error SetBatch(const NDbKValues& keys, NDbKValues* added_keys) override;
+
+  uint64_t Records() const;
+  uint64_t WrittenBytes() const;
+
+ private:
+  common::Error FlushBlock() WARN_UNUSED_RESULT;
+  common::Error Write(const std::string& data) WARN_UNUSED_RESULT;
+
+  const DumpOptions options_;
+  std::ofstream file_;
+  uint64_t offset_;
+  uint64_t records_;
+  std::string block_;
+  DumpIndexEntry block_entry_;
+  std::vector<DumpIndexEntry> index_;
+};
+
+// source of copy pipeline, blocks are read one by one in file order,
+// so scan cursor is number of read records and can't go back,
+// values of last scanned page are kept for Get
+class DumpReader : public ICopySource {
+ public:
+  DumpReader();
+  virtual ~DumpReader();
+
+  // checks magic and checksum of index
+  common::Error Open(const std::string& path) WARN_UNUSED_RESULT;
+  void Close();
+
+  virtual common::Error Scan(uint64_t cursor_in,
+                             const std::string& pattern,
+                             uint64_t count_keys,
+                             std::vector<std::string>* keys_out,
+                             uint64_t* cursor_out) override;
+  virtual common::Error Get(const NKey& key, NDbKValue* loaded_key) override;
+  virtual common::Error DBkcount(size_t* size) override;
+  virtual common::Error GetTTL(const NKey& key, ttl_t* ttl) override;
+
+  const std::vector<DumpIndexEntry>& Index() const;
+
+ private:
+  common::Error ReadBlock(size_t pos) WARN_UNUSED_RESULT;
+  common::Error NextRecord(NDbKValue* record) WARN_UNUSED_RESULT;
+
+  std::ifstream file_;
+  std::vector<DumpIndexEntry> index_;
+  uint64_t records_;
+  uint64_t read_records_;
+  size_t next_block_;
+  std::string block_;
+  size_t block_pos_;
+  std::map<std::string, NDbKValue> page_;
+};
+
+}  // namespace core
+}  // namespace fastonosql
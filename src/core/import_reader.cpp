@@ -0,0 +1,330 @@
+/*  Copyright (C) 2014-2016 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "core/import_reader.h"
+
+#include <inttypes.h>  // for PRIu64
+
+#include <string>  // for string
+#include <vector>  // for vector
+
+extern "C" {
+#include "sds.h"
+}
+
+#include <common/convert2string.h>  // for ConvertFromString
+#include <common/macros.h>          // for SIZEOFMASS
+#include <common/sprintf.h>         // for MemSPrintf
+#include <common/value.h>           // for ErrorValue, etc
+
+#include "third-party/json-c/json-c/json_tokener.h"
+
+#include "core/types.h"  // for StableCommand
+
+#define IMPORT_JSON_KEY_FIELD "key"
+#define IMPORT_JSON_VALUE_FIELD "value"
+#define IMPORT_JSON_TTL_FIELD "ttl"
+
+#define IMPORT_COMMENT_CHAR '#'
+#define IMPORT_CSV_SEPARATOR ','
+#define IMPORT_CSV_QUOTE '"'
+
+namespace {
+
+const std::string import_formats[] = {"Commands", "CSV", "JSON lines"};
+
+bool isEmptyLine(const std::string& line) {
+  for (size_t i = 0; i < line.size(); ++i) {
+    char c = line[i];
+    if (c != ' ' && c != '\t') {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool isCommentLine(const std::string& line) {
+  size_t pos = line.find_first_not_of(" \t");
+  return pos != std::string::npos && line[pos] == IMPORT_COMMENT_CHAR;
+}
+
+// RFC 4180 fields, quoted fields can't span lines
+bool splitCsvLine(const std::string& line, std::vector<std::string>* fields) {
+  std::string field;
+  bool in_quotes = false;
+  for (size_t i = 0; i < line.size(); ++i) {
+    char c = line[i];
+    if (in_quotes) {
+      if (c == IMPORT_CSV_QUOTE) {
+        if (i + 1 < line.size() && line[i + 1] == IMPORT_CSV_QUOTE) {
+          field += IMPORT_CSV_QUOTE;
+          ++i;
+        } else {
+          in_quotes = false;
+        }
+      } else {
+        field += c;
+      }
+    } else if (c == IMPORT_CSV_QUOTE && field.empty()) {
+      in_quotes = true;
+    } else if (c == IMPORT_CSV_SEPARATOR) {
+      fields->push_back(field);
+      field.clear();
+    } else {
+      field += c;
+    }
+  }
+
+  if (in_quotes) {
+    return false;
+  }
+
+  fields->push_back(field);
+  return true;
+}
+
+common::Error parseCommandLine(const std::string& line, fastonosql::core::ImportRecord* record) {
+  int argc = 0;
+  sds* argv = sdssplitargslong(line.c_str(), &argc);
+  if (!argv) {
+    return common::make_error_value("Unbalanced quotes", common::ErrorValue::E_ERROR);
+  }
+
+  for (int i = 0; i < argc; ++i) {
+    record->command.push_back(std::string(argv[i], sdslen(argv[i])));
+  }
+  sdsfreesplitres(argv, argc);
+
+  if (record->command.empty()) {
+    return common::make_error_value("Empty command", common::ErrorValue::E_ERROR);
+  }
+
+  return common::Error();
+}
+
+common::Error parseCsvLine(const std::string& line, fastonosql::core::ImportRecord* record) {
+  std::vector<std::string> fields;
+  if (!splitCsvLine(line, &fields)) {
+    return common::make_error_value("Unbalanced quotes", common::ErrorValue::E_ERROR);
+  }
+
+  if (fields.size() != 2 && fields.size() != 3) {
+    std::string buff = common::MemSPrintf("Expected key,value[,ttl] but got %" PRIu64 " field(s)",
+                                          static_cast<uint64_t>(fields.size()));
+    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+  }
+
+  fastonosql::core::ttl_t ttl = NO_TTL;
+  if (fields.size() == 3 && !fields[2].empty() && !common::ConvertFromString(fields[2], &ttl)) {
+    std::string buff = common::MemSPrintf("Invalid ttl: %s", fields[2]);
+    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+  }
+
+  record->key = fastonosql::core::NKey(fields[0], ttl);
+  record->value = fields[1];
+  return common::Error();
+}
+
+common::Error parseJsonLine(const std::string& line, fastonosql::core::ImportRecord* record) {
+  json_object* obj = json_tokener_parse(line.c_str());
+  if (!obj) {
+    return common::make_error_value("Invalid json", common::ErrorValue::E_ERROR);
+  }
+
+  json_object* jkey = NULL;
+  json_object* jvalue = NULL;
+  if (!json_object_object_get_ex(obj, IMPORT_JSON_KEY_FIELD, &jkey) ||
+      !json_object_object_get_ex(obj, IMPORT_JSON_VALUE_FIELD, &jvalue)) {
+    json_object_put(obj);
+    return common::make_error_value("Expected \"" IMPORT_JSON_KEY_FIELD
+                                    "\" and \"" IMPORT_JSON_VALUE_FIELD "\" fields",
+                                    common::ErrorValue::E_ERROR);
+  }
+
+  fastonosql::core::ttl_t ttl = NO_TTL;
+  json_object* jttl = NULL;
+  if (json_object_object_get_ex(obj, IMPORT_JSON_TTL_FIELD, &jttl) && jttl) {
+    if (!json_object_is_type(jttl, json_type_int)) {
+      json_object_put(obj);
+      return common::make_error_value("Invalid ttl", common::ErrorValue::E_ERROR);
+    }
+    ttl = json_object_get_int64(jttl);
+  }
+
+  const char* key = json_object_get_string(jkey);
+  record->key = fastonosql::core::NKey(key ? key : std::string(), ttl);
+  if (json_object_is_type(jvalue, json_type_string)) {
+    record->value = std::string(json_object_get_string(jvalue), json_object_get_string_len(jvalue));
+  } else {
+    // nested objects and numbers are stored as their json text
+    const char* value = json_object_to_json_string(jvalue);
+    record->value = value ? value : std::string();
+  }
+
+  json_object_put(obj);
+  return common::Error();
+}
+
+}  // namespace
+
+namespace fastonosql {
+namespace core {
+
+ImportRecord::ImportRecord() : line(0), command(), key(), value() {}
+
+bool ImportRecord::IsCommand() const {
+  return !command.empty();
+}
+
+common::Error ParseImportLine(ImportFormat format, const std::string& line, ImportRecord* record) {
+  if (!record) {
+    DNOTREACHED();
+    return common::make_error_value("Invalid input argument(s)", common::ErrorValue::E_ERROR);
+  }
+
+  if (format == IMPORT_COMMANDS) {
+    return parseCommandLine(line, record);
+  } else if (format == IMPORT_CSV) {
+    return parseCsvLine(line, record);
+  } else if (format == IMPORT_JSON_LINES) {
+    return parseJsonLine(line, record);
+  }
+
+  NOTREACHED();
+  return common::make_error_value("Unknown import format", common::ErrorValue::E_ERROR);
+}
+
+ImportStats::ImportStats() : sent(0), replies(0), errors(0), error_lines() {}
+
+void ImportStats::AddError(uint64_t line, const std::string& error) {
+  errors++;
+  if (error_lines.size() < IMPORT_MAX_REPORTED_ERRORS) {
+    error_lines.push_back(common::MemSPrintf("Line %" PRIu64 ": %s", line, error));
+  }
+}
+
+ImportReader::ImportReader(ImportFormat format)
+    : format_(format), file_(), line_(0), file_size_(0) {}
+
+common::Error ImportReader::Open(const std::string& path) {
+  if (IsOpened()) {
+    Close();
+  }
+
+  file_.open(path.c_str(), std::ios::in | std::ios::binary);
+  if (!file_.is_open()) {
+    std::string buff = common::MemSPrintf("Can't open file: %s", path);
+    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+  }
+
+  file_.seekg(0, std::ios::end);
+  file_size_ = file_.tellg();
+  file_.seekg(0, std::ios::beg);
+  line_ = 0;
+  return common::Error();
+}
+
+bool ImportReader::IsOpened() const {
+  return file_.is_open();
+}
+
+void ImportReader::Close() {
+  file_.close();
+  file_.clear();
+}
+
+common::Error ImportReader::Next(ImportRecord* record, bool* eof) {
+  if (!record || !eof) {
+    DNOTREACHED();
+    return common::make_error_value("Invalid input argument(s)", common::ErrorValue::E_ERROR);
+  }
+
+  if (!IsOpened()) {
+    *eof = true;
+    return common::make_error_value("File not opened", common::ErrorValue::E_ERROR);
+  }
+
+  std::string line;
+  while (std::getline(file_, line)) {
+    line_++;
+    line = StableCommand(line);
+    if (isEmptyLine(line) || (format_ == IMPORT_COMMANDS && isCommentLine(line))) {
+      continue;
+    }
+
+    *record = ImportRecord();
+    record->line = line_;
+    *eof = false;
+    return ParseImportLine(format_, line, record);
+  }
+
+  *eof = true;
+  if (file_.bad()) {
+    return common::make_error_value("Read file error", common::ErrorValue::E_ERROR);
+  }
+
+  return common::Error();
+}
+
+uint64_t ImportReader::CurrentLine() const {
+  return line_;
+}
+
+ImportFormat ImportReader::Format() const {
+  return format_;
+}
+
+int ImportReader::Progress() const {
+  if (file_size_ == 0) {
+    return 100;
+  }
+
+  std::streamoff pos = file_.tellg();
+  if (pos < 0) {  // eof reached
+    return 100;
+  }
+
+  return static_cast<int>(static_cast<uint64_t>(pos) * 100 / file_size_);
+}
+
+}  // namespace core
+}  // namespace fastonosql
+
+namespace common {
+
+std::string ConvertToString(fastonosql::core::ImportFormat format) {
+  return import_formats[format];
+}
+
+bool ConvertFromString(const std::string& from, fastonosql::core::ImportFormat* out) {
+  if (!out) {
+    return false;
+  }
+
+  for (size_t i = 0; i < SIZEOFMASS(import_formats); ++i) {
+    if (from == import_formats[i]) {
+      *out = static_cast<fastonosql::core::ImportFormat>(i);
+      return true;
+    }
+  }
+
+  return false;
+}
+
+}  // namespace common
@@ -0,0 +1,97 @@
+/*  Copyright (C) 2014-2016 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <stdint.h>  // for uint64_t
+
+#include <fstream>  // for ifstream
+#include <string>   // for string
+#include <vector>   // for vector
+
+#include <common/error.h>   // for Error
+#include <common/macros.h>  // for WARN_UNUSED_RESULT
+
+#include "core/db_key.h"  // for NKey
+
+#define IMPORT_MAX_REPORTED_ERRORS 100
+
+namespace fastonosql {
+namespace core {
+
+// commands: one shell command per line (SET key value)
+// csv: key,value[,ttl]
+// json lines: {"key": "k", "value": "v", "ttl": 10}
+enum ImportFormat { IMPORT_COMMANDS = 0, IMPORT_CSV, IMPORT_JSON_LINES };
+
+struct ImportRecord {
+  ImportRecord();
+
+  bool IsCommand() const;
+
+  uint64_t line;
+  std::vector<std::string> command;  // only for IMPORT_COMMANDS
+  NKey key;
+  std::string value;
+};
+
+struct ImportStats {
+  ImportStats();
+
+  void AddError(uint64_t line, const std::string& error);
+
+  uint64_t sent;
+  uint64_t replies;
+  uint64_t errors;
+  std::vector<std::string> error_lines;  // first IMPORT_MAX_REPORTED_ERRORS errors
+};
+
+common::Error ParseImportLine(ImportFormat format,
+                              const std::string& line,
+                              ImportRecord* record) WARN_UNUSED_RESULT;
+
+// reads input file line by line, memory usage doesn't depend on file size
+class ImportReader {
+ public:
+  explicit ImportReader(ImportFormat format);
+
+  common::Error Open(const std::string& path) WARN_UNUSED_RESULT;
+  bool IsOpened() const;
+  void Close();
+
+  // skips empty lines and comments of commands format, sets *eof when file is over,
+  // after a parse error *eof is false, record->line is valid and reading can go on
+  common::Error Next(ImportRecord* record, bool* eof) WARN_UNUSED_RESULT;
+  uint64_t CurrentLine() const;
+  ImportFormat Format() const;
+  int Progress() const;  // percents of read bytes
+
+ private:
+  const ImportFormat format_;
+  mutable std::ifstream file_;
+  uint64_t line_;
+  uint64_t file_size_;
+};
+
+}  // namespace core
+}  // namespace fastonosql
+
+namespace common {
+std::string ConvertToString(fastonosql::core::ImportFormat format);
+bool ConvertFromString(const std::string& from, fastonosql::core::ImportFormat* out);
+}  // namespace common
@@ -38,6 +38,7 @@
 #include "core/internal/command_handler.h"  // for CommandHandler, etc
 #include "core/internal/cdb_connection_client.h"
 #include "core/internal/db_connection.h"  // for DBConnection
+#include "core/internal/key_partitions.h"  // for KeyRange, key_ranges_t
 
 #define ALL_COMMANDS "*"
 #define ALL_KEYS_PATTERNS "*"
@@ -87,6 +88,9 @@ class CDBConnection : public DBConnection<NConnection, Config, ContType>, public
   static const char* BasedOn();
   static const char* VersionApi();
 
+  CDBConnectionClient* Client() const { return client_; }
+  void SetClient(CDBConnectionClient* client) { client_ = client; }
+
   std::string CurrentDBName() const;                                                        //
   common::Error Help(int argc, const char** argv, std::string* answer) WARN_UNUSED_RESULT;  //
 
@@ -104,11 +108,40 @@ class CDBConnection : public DBConnection<NConnection, Config, ContType>, public
   common::Error Select(const std::string& name, IDataBaseInfo** info) WARN_UNUSED_RESULT;  // nvi
   common::Error Delete(const NKeys& keys, NKeys* deleted_keys) WARN_UNUSED_RESULT;         // nvi
   common::Error Set(const NDbKValue& key, NDbKValue* added_key) WARN_UNUSED_RESULT;        // nvi
+  common::Error SetBatch(const NDbKValues& keys,
+                         NDbKValues* added_keys) WARN_UNUSED_RESULT;  // nvi
   common::Error Get(const NKey& key, NDbKValue* loaded_key) WARN_UNUSED_RESULT;            // nvi
+  common::Error GetBatch(const NKeys& keys,
+                         NDbKValues* loaded_keys) WARN_UNUSED_RESULT;  // nvi
   common::Error Rename(const NKey& key, const std::string& new_key) WARN_UNUSED_RESULT;    // nvi
   common::Error SetTTL(const NKey& key, ttl_t ttl) WARN_UNUSED_RESULT;                     // nvi
+  common::Error SetTTLBatch(const NKeys& keys,
+                            ttl_t ttl,
+                            NKeys* changed_keys) WARN_UNUSED_RESULT;  // nvi
+  common::Error RenameBatch(const NKeys& keys,
+                            const std::vector<std::string>& new_keys,
+                            NKeys* renamed_keys) WARN_UNUSED_RESULT;  // nvi
   common::Error GetTTL(const NKey& key, ttl_t* ttl) WARN_UNUSED_RESULT;                    // nvi
   common::Error Quit() WARN_UNUSED_RESULT;                                                 // nvi
+  // long operations (copy, export, bulk) read all keys from one snapshot, calls can be nested
+  void PinSnapshot();    // nvi
+  void UnpinSnapshot();  // nvi
+  // value of key in pinned snapshot for reads of those operations,
+  // interactive Get always reads current state, keys aren't reported to client
+  common::Error GetFromSnapshot(const NKey& key,
+                                NDbKValue* loaded_key) WARN_UNUSED_RESULT;  // nvi
+  // writes of copy or import may trade durability of every batch for speed,
+  // data is flushed on end, calls can be nested
+  void BeginBulkLoad();  // nvi
+  void EndBulkLoad();    // nvi
+  // ranges of similar size covering keyspace, every range can be scanned by
+  // ScanRange from own thread with own iterator (keys of pinned snapshot)
+  common::Error Partition(size_t count, key_ranges_t* ranges) WARN_UNUSED_RESULT;  // nvi
+  common::Error ScanRange(const KeyRange& range,
+                          const std::string& pattern,
+                          size_t batch_size,
+                          bool with_values,
+                          range_batch_callback_t batch_cb) WARN_UNUSED_RESULT;  // nvi
 
  protected:
   CDBConnectionClient* client_;
@@ -128,11 +161,35 @@ class CDBConnection : public DBConnection<NConnection, Config, ContType>, public
   virtual common::Error SelectImpl(const std::string& name, IDataBaseInfo** info) = 0;
   virtual common::Error DeleteImpl(const NKeys& keys, NKeys* deleted_keys) = 0;
   virtual common::Error SetImpl(const NDbKValue& key, NDbKValue* added_key) = 0;
+  // engines with native write batches override it
+  virtual common::Error SetBatchImpl(const NDbKValues& keys, NDbKValues* added_keys);
   virtual common::Error GetImpl(const NKey& key, NDbKValue* loaded_key) = 0;
+  // engines with native multi get override it, missing keys are skipped
+  virtual common::Error GetBatchImpl(const NKeys& keys, NDbKValues* loaded_keys);
   virtual common::Error RenameImpl(const NKey& key, const std::string& new_key) = 0;
   virtual common::Error SetTTLImpl(const NKey& key, ttl_t ttl) = 0;
+  // engines able to pipeline commands override them,
+  // keys which can't be changed are skipped
+  virtual common::Error SetTTLBatchImpl(const NKeys& keys, ttl_t ttl, NKeys* changed_keys);
+  virtual common::Error RenameBatchImpl(const NKeys& keys,
+                                        const std::vector<std::string>& new_keys,
+                                        NKeys* renamed_keys);
   virtual common::Error GetTTLImpl(const NKey& key, ttl_t* ttl) = 0;
   virtual common::Error QuitImpl() = 0;
+  // engines with snapshots override them
+  virtual void PinSnapshotImpl();
+  virtual void UnpinSnapshotImpl();
+  virtual common::Error GetFromSnapshotImpl(const NKey& key, NDbKValue* loaded_key);
+  // engines with relaxed durability modes override them
+  virtual void BeginBulkLoadImpl();
+  virtual void EndBulkLoadImpl();
+  // engines with ordered keyspace override them, by default keyspace is one range
+  virtual common::Error PartitionImpl(size_t count, key_ranges_t* ranges);
+  virtual common::Error ScanRangeImpl(const KeyRange& range,
+                                      const std::string& pattern,
+                                      size_t batch_size,
+                                      bool with_values,
+                                      range_batch_callback_t batch_cb);
 };
 
 template <typename NConnection, typename Config, connectionTypes ContType>
@@ -344,6 +401,48 @@ common::Error CDBConnection<NConnection, Config, ContType>::Set(const NDbKValue&
   return common::Error();
 }
 
+template <typename NConnection, typename Config, connectionTypes ContType>
+common::Error CDBConnection<NConnection, Config, ContType>::SetBatch(const NDbKValues& keys,
+                                                                     NDbKValues* added_keys) {
+  if (!added_keys) {
+    DNOTREACHED();
+    return common::make_error_value("Invalid input argument(s)", common::ErrorValue::E_ERROR);
+  }
+
+  if (!CDBConnection<NConnection, Config, ContType>::IsConnected()) {
+    return common::make_error_value("Not connected", common::Value::E_ERROR);
+  }
+
+  common::Error err = SetBatchImpl(keys, added_keys);
+  if (err && err->IsError()) {
+    return err;
+  }
+
+  if (client_) {
+    for (size_t i = 0; i < added_keys->size(); ++i) {
+      client_->OnKeyAdded((*added_keys)[i]);
+    }
+  }
+
+  return common::Error();
+}
+
+template <typename NConnection, typename Config, connectionTypes ContType>
+common::Error CDBConnection<NConnection, Config, ContType>::SetBatchImpl(const NDbKValues& keys,
+                                                                         NDbKValues* added_keys) {
+  for (size_t i = 0; i < keys.size(); ++i) {
+    NDbKValue added_key;
+    common::Error err = SetImpl(keys[i], &added_key);
+    if (err && err->IsError()) {
+      return err;
+    }
+
+    added_keys->push_back(added_key);
+  }
+
+  return common::Error();
+}
+
 template <typename NConnection, typename Config, connectionTypes ContType>
 common::Error CDBConnection<NConnection, Config, ContType>::Get(const NKey& key,
                                                                 NDbKValue* loaded_key) {
@@ -368,6 +467,38 @@ common::Error CDBConnection<NConnection, Config, ContType>::Get(const NKey& key,
   return common::Error();
 }
 
+template <typename NConnection, typename Config, connectionTypes ContType>
+common::Error CDBConnection<NConnection, Config, ContType>::GetBatch(const NKeys& keys,
+                                                                     NDbKValues* loaded_keys) {
+  if (!loaded_keys) {
+    DNOTREACHED();
+    return common::make_error_value("Invalid input argument(s)", common::ErrorValue::E_ERROR);
+  }
+
+  if (!CDBConnection<NConnection, Config, ContType>::IsConnected()) {
+    return common::make_error_value("Not connected", common::Value::E_ERROR);
+  }
+
+  // pages of values are prefetched for views, so they aren't reported to client one by one
+  return GetBatchImpl(keys, loaded_keys);
+}
+
+template <typename NConnection, typename Config, connectionTypes ContType>
+common::Error CDBConnection<NConnection, Config, ContType>::GetBatchImpl(const NKeys& keys,
+                                                                         NDbKValues* loaded_keys) {
+  for (size_t i = 0; i < keys.size(); ++i) {
+    NDbKValue loaded_key;
+    common::Error err = GetImpl(keys[i], &loaded_key);
+    if (err && err->IsError()) {
+      continue;
+    }
+
+    loaded_keys->push_back(loaded_key);
+  }
+
+  return common::Error();
+}
+
 template <typename NConnection, typename Config, connectionTypes ContType>
 common::Error CDBConnection<NConnection, Config, ContType>::Rename(const NKey& key,
                                                                    const std::string& new_key) {
@@ -404,6 +535,99 @@ common::Error CDBConnection<NConnection, Config, ContType>::SetTTL(const NKey& k
 
   return common::Error();
 }
+
+template <typename NConnection, typename Config, connectionTypes ContType>
+common::Error CDBConnection<NConnection, Config, ContType>::SetTTLBatch(const NKeys& keys,
+                                                                        ttl_t ttl,
+                                                                        NKeys* changed_keys) {
+  if (!changed_keys) {
+    DNOTREACHED();
+    return common::make_error_value("Invalid input argument(s)", common::ErrorValue::E_ERROR);
+  }
+
+  if (!CDBConnection<NConnection, Config, ContType>::IsConnected()) {
+    return common::make_error_value("Not connected", common::Value::E_ERROR);
+  }
+
+  common::Error err = SetTTLBatchImpl(keys, ttl, changed_keys);
+  if (err && err->IsError()) {
+    return err;
+  }
+
+  if (client_) {
+    for (size_t i = 0; i < changed_keys->size(); ++i) {
+      client_->OnKeyTTLChanged((*changed_keys)[i], ttl);
+    }
+  }
+
+  return common::Error();
+}
+
+template <typename NConnection, typename Config, connectionTypes ContType>
+common::Error CDBConnection<NConnection, Config, ContType>::SetTTLBatchImpl(const NKeys& keys,
+                                                                            ttl_t ttl,
+                                                                            NKeys* changed_keys) {
+  for (size_t i = 0; i < keys.size(); ++i) {
+    common::Error err = SetTTLImpl(keys[i], ttl);
+    if (err && err->IsError()) {
+      continue;
+    }
+
+    changed_keys->push_back(keys[i]);
+  }
+
+  return common::Error();
+}
+
+template <typename NConnection, typename Config, connectionTypes ContType>
+common::Error CDBConnection<NConnection, Config, ContType>::RenameBatch(
+    const NKeys& keys,
+    const std::vector<std::string>& new_keys,
+    NKeys* renamed_keys) {
+  if (!renamed_keys || keys.size() != new_keys.size()) {
+    DNOTREACHED();
+    return common::make_error_value("Invalid input argument(s)", common::ErrorValue::E_ERROR);
+  }
+
+  if (!CDBConnection<NConnection, Config, ContType>::IsConnected()) {
+    return common::make_error_value("Not connected", common::Value::E_ERROR);
+  }
+
+  size_t renamed_before = renamed_keys->size();
+  common::Error err = RenameBatchImpl(keys, new_keys, renamed_keys);
+  if (err && err->IsError()) {
+    return err;
+  }
+
+  if (client_) {
+    for (size_t i = 0, j = renamed_before; i < keys.size() && j < renamed_keys->size(); ++i) {
+      if ((*renamed_keys)[j].Key() == keys[i].Key()) {
+        client_->OnKeyRenamed(keys[i], new_keys[i]);
+        j++;
+      }
+    }
+  }
+
+  return common::Error();
+}
+
+template <typename NConnection, typename Config, connectionTypes ContType>
+common::Error CDBConnection<NConnection, Config, ContType>::RenameBatchImpl(
+    const NKeys& keys,
+    const std::vector<std::string>& new_keys,
+    NKeys* renamed_keys) {
+  for (size_t i = 0; i < keys.size(); ++i) {
+    common::Error err = RenameImpl(keys[i], new_keys[i]);
+    if (err && err->IsError()) {
+      continue;
+    }
+
+    renamed_keys->push_back(keys[i]);
+  }
+
+  return common::Error();
+}
+
 template <typename NConnection, typename Config, connectionTypes ContType>
 common::Error CDBConnection<NConnection, Config, ContType>::GetTTL(const NKey& key, ttl_t* ttl) {
   if (!ttl) {
@@ -444,6 +668,145 @@ common::Error CDBConnection<NConnection, Config, ContType>::Quit() {
 
   return common::Error();
 }
+
+template <typename NConnection, typename Config, connectionTypes ContType>
+void CDBConnection<NConnection, Config, ContType>::PinSnapshot() {
+  if (!CDBConnection<NConnection, Config, ContType>::IsConnected()) {
+    return;
+  }
+
+  PinSnapshotImpl();
+}
+
+template <typename NConnection, typename Config, connectionTypes ContType>
+void CDBConnection<NConnection, Config, ContType>::UnpinSnapshot() {
+  if (!CDBConnection<NConnection, Config, ContType>::IsConnected()) {
+    return;
+  }
+
+  UnpinSnapshotImpl();
+}
+
+template <typename NConnection, typename Config, connectionTypes ContType>
+void CDBConnection<NConnection, Config, ContType>::PinSnapshotImpl() {}
+
+template <typename NConnection, typename Config, connectionTypes ContType>
+void CDBConnection<NConnection, Config, ContType>::UnpinSnapshotImpl() {}
+
+template <typename NConnection, typename Config, connectionTypes ContType>
+common::Error CDBConnection<NConnection, Config, ContType>::GetFromSnapshot(
+    const NKey& key,
+    NDbKValue* loaded_key) {
+  if (!loaded_key) {
+    DNOTREACHED();
+    return common::make_error_value("Invalid input argument(s)", common::ErrorValue::E_ERROR);
+  }
+
+  if (!CDBConnection<NConnection, Config, ContType>::IsConnected()) {
+    return common::make_error_value("Not connected", common::Value::E_ERROR);
+  }
+
+  return GetFromSnapshotImpl(key, loaded_key);
+}
+
+template <typename NConnection, typename Config, connectionTypes ContType>
+common::Error CDBConnection<NConnection, Config, ContType>::GetFromSnapshotImpl(
+    const NKey& key,
+    NDbKValue* loaded_key) {
+  return GetImpl(key, loaded_key);
+}
+
+template <typename NConnection, typename Config, connectionTypes ContType>
+void CDBConnection<NConnection, Config, ContType>::BeginBulkLoad() {
+  if (!CDBConnection<NConnection, Config, ContType>::IsConnected()) {
+    return;
+  }
+
+  BeginBulkLoadImpl();
+}
+
+template <typename NConnection, typename Config, connectionTypes ContType>
+void CDBConnection<NConnection, Config, ContType>::EndBulkLoad() {
+  if (!CDBConnection<NConnection, Config, ContType>::IsConnected()) {
+    return;
+  }
+
+  EndBulkLoadImpl();
+}
+
+template <typename NConnection, typename Config, connectionTypes ContType>
+void CDBConnection<NConnection, Config, ContType>::BeginBulkLoadImpl() {}
+
+template <typename NConnection, typename Config, connectionTypes ContType>
+void CDBConnection<NConnection, Config, ContType>::EndBulkLoadImpl() {}
+
+template <typename NConnection, typename Config, connectionTypes ContType>
+common::Error CDBConnection<NConnection, Config, ContType>::Partition(size_t count,
+                                                                     key_ranges_t* ranges) {
+  if (!ranges || count == 0) {
+    DNOTREACHED();
+    return common::make_error_value("Invalid input argument(s)", common::ErrorValue::E_ERROR);
+  }
+
+  if (!CDBConnection<NConnection, Config, ContType>::IsConnected()) {
+    return common::make_error_value("Not connected", common::Value::E_ERROR);
+  }
+
+  common::Error err = PartitionImpl(count, ranges);
+  if (err && err->IsError()) {
+    return err;
+  }
+
+  return common::Error();
+}
+
+template <typename NConnection, typename Config, connectionTypes ContType>
+common::Error CDBConnection<NConnection, Config, ContType>::ScanRange(
+    const KeyRange& range,
+    const std::string& pattern,
+    size_t batch_size,
+    bool with_values,
+    range_batch_callback_t batch_cb) {
+  if (batch_size == 0 || !batch_cb) {
+    DNOTREACHED();
+    return common::make_error_value("Invalid input argument(s)", common::ErrorValue::E_ERROR);
+  }
+
+  if (!CDBConnection<NConnection, Config, ContType>::IsConnected()) {
+    return common::make_error_value("Not connected", common::Value::E_ERROR);
+  }
+
+  common::Error err = ScanRangeImpl(range, pattern, batch_size, with_values, batch_cb);
+  if (err && err->IsError()) {
+    return err;
+  }
+
+  return common::Error();
+}
+
+template <typename NConnection, typename Config, connectionTypes ContType>
+common::Error CDBConnection<NConnection, Config, ContType>::PartitionImpl(size_t count,
+                                                                         key_ranges_t* ranges) {
+  UNUSED(count);
+  *ranges = key_ranges_t(1, KeyRange());
+  return common::Error();
+}
+
+template <typename NConnection, typename Config, connectionTypes ContType>
+common::Error CDBConnection<NConnection, Config, ContType>::ScanRangeImpl(
+    const KeyRange& range,
+    const std::string& pattern,
+    size_t batch_size,
+    bool with_values,
+    range_batch_callback_t batch_cb) {
+  UNUSED(range);
+  UNUSED(pattern);
+  UNUSED(batch_size);
+  UNUSED(with_values);
+  UNUSED(batch_cb);
+  return common::make_error_value("Range scans aren't supported by this database.",
+                                  common::ErrorValue::E_ERROR);
+}
 }
 }  // namespace core
 }  // namespace fastonosql
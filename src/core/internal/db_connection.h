@@ -40,12 +40,18 @@ class DBConnection {
   static constexpr connectionTypes connection_t = ContType;
 
   DBConnection() : connection_(), interrupted_(false) {}
+  virtual ~DBConnection() {}
 
   static connectionTypes ConnectionType() { return connection_t; }
 
   common::Error Connect(const config_t& config) { return connection_.Connect(config); }
 
-  common::Error Disconnect() { return connection_.Disconnect(); }
+  common::Error Disconnect() {
+    if (IsConnected()) {
+      OnDisconnect();
+    }
+    return connection_.Disconnect();
+  }
 
   bool IsConnected() const { return connection_.IsConnected(); }
 
@@ -60,6 +66,10 @@ class DBConnection {
   config_t config() const { return connection_.config_; }
 
  protected:
+  // engines release what is bound to opened handle, called by Disconnect
+  // whatever pointer it is called through
+  virtual void OnDisconnect() {}
+
   dbconnection_t connection_;
   bool interrupted_;
 };
@@ -0,0 +1,269 @@
+/*  Copyright (C) 2014-2016 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "core/internal/key_partitions.h"
+
+#include <algorithm>  // for min
+#include <deque>      // for deque
+#include <mutex>      // for mutex, lock_guard
+#include <thread>     // for thread
+
+#include "core/internal/range_scan.h"  // for PrefixEnd
+
+#define PARTITION_BYTE_VALUES 256
+
+namespace fastonosql {
+namespace core {
+
+KeyRange::KeyRange() : start(), limit() {}
+
+KeyRange::KeyRange(const std::string& start, const std::string& limit)
+    : start(start), limit(limit) {}
+
+bool KeyRange::Contains(const std::string& key) const {
+  if (key < start) {
+    return false;
+  }
+
+  return limit.empty() || key < limit;
+}
+
+namespace internal {
+
+namespace {
+
+// pieces of keys with one more byte after prefix, they cover [start, limit)
+key_ranges_t SplitByNextByte(const std::string& prefix,
+                             const std::string& start,
+                             const std::string& limit) {
+  key_ranges_t pieces;
+  for (int b = 0; b < PARTITION_BYTE_VALUES; ++b) {
+    std::string piece_start = b == 0 ? start : prefix + static_cast<char>(b);
+    std::string piece_limit =
+        b == PARTITION_BYTE_VALUES - 1 ? limit : prefix + static_cast<char>(b + 1);
+    pieces.push_back(KeyRange(piece_start, piece_limit));
+  }
+  return pieces;
+}
+
+// piece of keys with prefix is sized again by one more byte while it is
+// heavier than max_weight, piece stays whole if sizes aren't known
+void appendSizedPiece(range_sizes_func_t sizes_func,
+                      const std::string& prefix,
+                      const KeyRange& piece,
+                      uint64_t weight,
+                      uint64_t max_weight,
+                      weighted_bounds_t* bounds) {
+  if (weight > max_weight && prefix.size() < PARTITION_MAX_PREFIX_SIZE) {
+    key_ranges_t subpieces = SplitByNextByte(prefix, piece.start, piece.limit);
+    std::vector<uint64_t> subsizes;
+    if (sizes_func(subpieces, &subsizes) && subsizes.size() == subpieces.size()) {
+      for (size_t i = 0; i < subpieces.size(); ++i) {
+        appendSizedPiece(sizes_func, prefix + static_cast<char>(i), subpieces[i], subsizes[i],
+                         max_weight, bounds);
+      }
+      return;
+    }
+  }
+
+  bounds->push_back(std::make_pair(piece.limit, weight));
+}
+
+// distinct prefixes one byte longer than prefix of keys with prefix (key equal
+// to prefix is its own piece), false if probes are exhausted
+bool probeSubprefixes(seek_func_t seek_func,
+                      const std::string& prefix,
+                      size_t* probes,
+                      std::vector<std::string>* subprefixes) {
+  std::string next = prefix;
+  std::string key;
+  while (*probes < PARTITION_MAX_PROBES) {
+    (*probes)++;
+    if (!seek_func(next, &key) || key.compare(0, prefix.size(), prefix) != 0) {
+      return true;
+    }
+
+    std::string subprefix = key.substr(0, prefix.size() + 1);
+    subprefixes->push_back(subprefix);
+    if (subprefix.size() == prefix.size()) {
+      next = subprefix + '\0';
+    } else {
+      next = PrefixEnd(subprefix);
+      if (next.empty()) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+}  // namespace
+
+key_ranges_t SplitByWeights(const weighted_bounds_t& bounds, size_t count) {
+  uint64_t total = 0;
+  for (size_t i = 0; i < bounds.size(); ++i) {
+    total += bounds[i].second;
+  }
+
+  key_ranges_t ranges;
+  std::string start;
+  uint64_t weight = 0;
+  for (size_t i = 0; i < bounds.size() && total && ranges.size() + 1 < count; ++i) {
+    const std::string& limit = bounds[i].first;
+    if (limit.empty()) {
+      break;
+    }
+
+    weight += bounds[i].second;
+    if (weight * count >= (ranges.size() + 1) * total && limit > start) {
+      ranges.push_back(KeyRange(start, limit));
+      start = limit;
+    }
+  }
+
+  ranges.push_back(KeyRange(start, std::string()));
+  return ranges;
+}
+
+key_ranges_t SplitBySizes(range_sizes_func_t sizes_func, size_t count) {
+  if (count <= 1) {
+    return key_ranges_t(1, KeyRange());
+  }
+
+  key_ranges_t pieces = SplitByNextByte(std::string(), std::string(), std::string());
+  std::vector<uint64_t> sizes;
+  if (!sizes_func(pieces, &sizes) || sizes.size() != pieces.size()) {
+    return key_ranges_t(1, KeyRange());
+  }
+
+  uint64_t total = 0;
+  for (size_t i = 0; i < sizes.size(); ++i) {
+    total += sizes[i];
+  }
+
+  weighted_bounds_t bounds;
+  for (size_t i = 0; i < pieces.size(); ++i) {
+    appendSizedPiece(sizes_func, std::string(1, static_cast<char>(i)), pieces[i], sizes[i],
+                     total / count, &bounds);
+  }
+
+  return SplitByWeights(bounds, count);
+}
+
+key_ranges_t SplitByPrefixProbes(seek_func_t seek_func, size_t count) {
+  if (count <= 1) {
+    return key_ranges_t(1, KeyRange());
+  }
+
+  // every seek jumps over all keys of found prefix, prefixes which can't be
+  // refined in probes budget are kept as they are, keys equal to prefix aren't
+  // refined anymore
+  std::vector<std::string> prefixes(1, std::string());
+  size_t probes = 0;
+  bool exhausted = false;
+  bool probed = true;
+  for (size_t size = 1; size <= PARTITION_MAX_PREFIX_SIZE && probed && !exhausted &&
+                        prefixes.size() < count * PARTITION_PIECES_PER_RANGE;
+       ++size) {
+    std::vector<std::string> refined;
+    probed = false;
+    for (size_t i = 0; i < prefixes.size(); ++i) {
+      std::vector<std::string> subprefixes;
+      if (exhausted || prefixes[i].size() + 1 != size) {
+        refined.push_back(prefixes[i]);
+      } else if (!probeSubprefixes(seek_func, prefixes[i], &probes, &subprefixes)) {
+        exhausted = true;
+        refined.push_back(prefixes[i]);
+      } else {
+        probed = true;
+        refined.insert(refined.end(), subprefixes.begin(), subprefixes.end());
+      }
+    }
+    prefixes.swap(refined);
+  }
+
+  weighted_bounds_t bounds;
+  for (size_t i = 0; i < prefixes.size(); ++i) {
+    std::string limit = i + 1 < prefixes.size() ? prefixes[i + 1] : std::string();
+    bounds.push_back(std::make_pair(limit, 1));
+  }
+
+  return SplitByWeights(bounds, count);
+}
+
+WorkStealingPool::WorkStealingPool(size_t workers) : workers_(workers ? workers : 1) {}
+
+size_t WorkStealingPool::Workers() const {
+  return workers_;
+}
+
+void WorkStealingPool::Run(const std::vector<task_t>& tasks) {
+  struct TaskQueue {
+    std::mutex mutex;
+    std::deque<size_t> tasks;
+  };
+
+  const size_t workers = std::min(workers_, tasks.size());
+  if (!workers) {
+    return;
+  }
+
+  std::vector<TaskQueue> queues(workers);
+  for (size_t i = 0; i < tasks.size(); ++i) {
+    queues[i % workers].tasks.push_back(i);
+  }
+
+  auto pop_task = [&queues, workers](size_t worker, size_t* task) {
+    for (size_t i = 0; i < workers; ++i) {
+      TaskQueue& queue = queues[(worker + i) % workers];
+      std::lock_guard<std::mutex> lock(queue.mutex);
+      if (queue.tasks.empty()) {
+        continue;
+      }
+
+      if (i == 0) {
+        *task = queue.tasks.front();
+        queue.tasks.pop_front();
+      } else {
+        *task = queue.tasks.back();
+        queue.tasks.pop_back();
+      }
+      return true;
+    }
+    return false;
+  };
+
+  std::vector<std::thread> threads;
+  for (size_t w = 0; w < workers; ++w) {
+    threads.push_back(std::thread([&tasks, &pop_task, w]() {
+      size_t task = 0;
+      while (pop_task(w, &task)) {
+        tasks[task]();
+      }
+    }));
+  }
+
+  for (size_t w = 0; w < threads.size(); ++w) {
+    threads[w].join();
+  }
+}
+
+}  // namespace internal
+}  // namespace core
+}  // namespace fastonosql
@@ -0,0 +1,94 @@
+/*  Copyright (C) 2014-2016 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <stddef.h>  // for size_t
+#include <stdint.h>  // for uint64_t
+
+#include <functional>  // for function
+#include <string>      // for string
+#include <utility>     // for pair
+#include <vector>      // for vector
+
+#include "core/db_key.h"  // for NDbKValues
+
+#define PARTITION_MAX_PREFIX_SIZE 64
+#define PARTITION_MAX_PROBES 4096
+#define PARTITION_PIECES_PER_RANGE 16
+
+namespace fastonosql {
+namespace core {
+
+// keys in [start, limit), empty start - from first key, empty limit - up to last key
+struct KeyRange {
+  KeyRange();
+  KeyRange(const std::string& start, const std::string& limit);
+
+  bool Contains(const std::string& key) const;
+
+  std::string start;
+  std::string limit;
+};
+
+typedef std::vector<KeyRange> key_ranges_t;
+
+// batch of range keys in key order, false stops scan of range
+typedef std::function<bool(const NDbKValues& batch)> range_batch_callback_t;
+
+namespace internal {
+
+// sorted limits of keyspace pieces (empty - up to last key) with weight of every
+// piece, consecutive pieces are joined into count ranges of similar weight
+typedef std::vector<std::pair<std::string, uint64_t> > weighted_bounds_t;
+key_ranges_t SplitByWeights(const weighted_bounds_t& bounds, size_t count);
+
+// engines which know only sizes of ranges: ranges of one byte prefixes are sized
+// by one batched call, pieces heavier than total / count are sized again by one
+// more byte of prefix, up to PARTITION_MAX_PREFIX_SIZE bytes
+typedef std::function<bool(const key_ranges_t& ranges, std::vector<uint64_t>* sizes)>
+    range_sizes_func_t;
+key_ranges_t SplitBySizes(range_sizes_func_t sizes_func, size_t count);
+
+// engines without any size estimates: distinct key prefixes are found by seeks
+// (least key not less than given one, false if there is no such key), prefixes
+// get one more byte while there are less than PARTITION_PIECES_PER_RANGE of them
+// per range, every range gets similar number of prefixes
+typedef std::function<bool(const std::string& key, std::string* found)> seek_func_t;
+key_ranges_t SplitByPrefixProbes(seek_func_t seek_func, size_t count);
+
+// tasks are dealt to queues of workers in given order, every worker runs its
+// queue from front and steals from back of other queues when its own is empty,
+// so skew of ranges sizes is evened out, Run returns when all tasks are done
+class WorkStealingPool {
+ public:
+  typedef std::function<void()> task_t;
+
+  explicit WorkStealingPool(size_t workers);
+
+  size_t Workers() const;
+  void Run(const std::vector<task_t>& tasks);
+
+ private:
+  const size_t workers_;
+};
+
+}  // namespace internal
+}  // namespace core
+}  // namespace fastonosql
@@ -0,0 +1,102 @@
+/*  Copyright (C) 2014-2016 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <stddef.h>  // for size_t
+#include <stdint.h>  // for uint64_t
+
+#include <deque>   // for deque
+#include <string>  // for string
+
+#define PAGING_SNAPSHOTS_MAX_COUNT 16
+
+namespace fastonosql {
+namespace core {
+namespace internal {
+
+// snapshots of paginated scans keyed by pattern and cursor of next page,
+// so every page of one scan sees the same keyspace,
+// the oldest scans are forgotten when there are too many of them
+template <typename NConnection, typename Snapshot>
+class PagingSnapshots {
+ public:
+  PagingSnapshots() : snapshots_() {}
+
+  // new snapshot for first page, nullptr if scan was forgotten
+  const Snapshot* Take(NConnection* db, uint64_t cursor, const std::string& pattern) {
+    if (cursor == 0) {
+      return db->GetSnapshot();
+    }
+
+    for (auto it = snapshots_.begin(); it != snapshots_.end(); ++it) {
+      if (it->cursor == cursor && it->pattern == pattern) {
+        const Snapshot* snapshot = it->snapshot;
+        snapshots_.erase(it);
+        return snapshot;
+      }
+    }
+
+    return nullptr;
+  }
+
+  // releases snapshot of finished scan
+  void Put(NConnection* db,
+           uint64_t next_cursor,
+           const std::string& pattern,
+           const Snapshot* snapshot) {
+    if (!snapshot) {
+      return;
+    }
+
+    if (next_cursor == 0) {
+      db->ReleaseSnapshot(snapshot);
+      return;
+    }
+
+    PagingSnapshot point;
+    point.cursor = next_cursor;
+    point.pattern = pattern;
+    point.snapshot = snapshot;
+    snapshots_.push_back(point);
+    if (snapshots_.size() > PAGING_SNAPSHOTS_MAX_COUNT) {
+      db->ReleaseSnapshot(snapshots_.front().snapshot);
+      snapshots_.pop_front();
+    }
+  }
+
+  void Clear(NConnection* db) {
+    for (auto it = snapshots_.begin(); it != snapshots_.end(); ++it) {
+      db->ReleaseSnapshot(it->snapshot);
+    }
+    snapshots_.clear();
+  }
+
+ private:
+  struct PagingSnapshot {
+    uint64_t cursor;
+    std::string pattern;
+    const Snapshot* snapshot;
+  };
+
+  std::deque<PagingSnapshot> snapshots_;
+};
+
+}  // namespace internal
+}  // namespace core
+}  // namespace fastonosql
@@ -0,0 +1,134 @@
+/*  Copyright (C) 2014-2016 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "core/internal/range_scan.h"
+
+#include <algorithm>  // for min, max
+
+#define RANGE_POSITION_BYTES 8
+
+namespace fastonosql {
+namespace core {
+namespace internal {
+namespace {
+
+// bytes of key after offset as fraction of [0, 1)
+double keyFraction(const std::string& key, size_t offset) {
+  double fraction = 0;
+  double scale = 1.0 / 256;
+  for (size_t i = offset; i < key.size() && i < offset + RANGE_POSITION_BYTES; ++i) {
+    fraction += static_cast<unsigned char>(key[i]) * scale;
+    scale /= 256;
+  }
+  return fraction;
+}
+
+}  // namespace
+
+std::string GlobPrefix(const std::string& pattern) {
+  std::string prefix;
+  for (size_t i = 0; i < pattern.size(); ++i) {
+    char c = pattern[i];
+    if (c == '*' || c == '?' || c == '[') {
+      break;
+    }
+
+    if (c == '\\') {
+      if (i + 1 == pattern.size()) {
+        break;
+      }
+      c = pattern[++i];
+    }
+    prefix += c;
+  }
+  return prefix;
+}
+
+std::string PrefixEnd(const std::string& prefix) {
+  std::string end = prefix;
+  while (!end.empty()) {
+    unsigned char last = static_cast<unsigned char>(end[end.size() - 1]);
+    if (last != 0xff) {
+      end[end.size() - 1] = static_cast<char>(last + 1);
+      return end;
+    }
+    end.erase(end.size() - 1);
+  }
+  return end;
+}
+
+double KeyRangePosition(const std::string& start,
+                        const std::string& limit,
+                        const std::string& key) {
+  size_t prefix = 0;
+  while (prefix < start.size() && prefix < limit.size() && start[prefix] == limit[prefix]) {
+    prefix++;
+  }
+
+  const double begin = keyFraction(start, prefix);
+  const double end = limit.empty() ? 1.0 : keyFraction(limit, prefix);
+  if (end <= begin) {
+    return 1.0;
+  }
+
+  double position = (keyFraction(key, prefix) - begin) / (end - begin);
+  return std::min(1.0, std::max(0.0, position));
+}
+
+RangeScanCursors::RangeScanCursors() : points_() {}
+
+bool RangeScanCursors::Take(uint64_t cursor, const std::string& pattern, std::string* last_key) {
+  if (cursor == 0) {
+    return false;
+  }
+
+  for (auto it = points_.begin(); it != points_.end(); ++it) {
+    if (it->cursor == cursor && it->pattern == pattern) {
+      *last_key = it->last_key;
+      points_.erase(it);
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void RangeScanCursors::Put(uint64_t cursor,
+                           const std::string& pattern,
+                           const std::string& last_key) {
+  if (cursor == 0) {
+    return;
+  }
+
+  ResumePoint point;
+  point.cursor = cursor;
+  point.pattern = pattern;
+  point.last_key = last_key;
+  points_.push_back(point);
+  if (points_.size() > RANGE_SCAN_CURSORS_MAX_COUNT) {
+    points_.pop_front();
+  }
+}
+
+void RangeScanCursors::Clear() {
+  points_.clear();
+}
+
+}  // namespace internal
+}  // namespace core
+}  // namespace fastonosql
@@ -0,0 +1,68 @@
+/*  Copyright (C) 2014-2016 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <stdint.h>  // for uint64_t
+
+#include <deque>   // for deque
+#include <string>  // for string
+
+#define RANGE_SCAN_CURSORS_MAX_COUNT 16
+
+namespace fastonosql {
+namespace core {
+namespace internal {
+
+// literal part of glob pattern before first wildcard,
+// every key matching pattern starts with it
+std::string GlobPrefix(const std::string& pattern);
+
+// least key greater than every key with prefix,
+// empty if there is no such key (empty prefix or prefix of 0xff bytes)
+std::string PrefixEnd(const std::string& prefix);
+
+// position of key in [start, limit) from 0 to 1 interpolated by first bytes
+// after common prefix of bounds, empty limit - up to last key
+double KeyRangePosition(const std::string& start,
+                        const std::string& limit,
+                        const std::string& key);
+
+// engines which scan by key ranges map cursor of next page to last seen key,
+// unknown cursor (forgotten scan) should be treated as offset
+class RangeScanCursors {
+ public:
+  RangeScanCursors();
+
+  bool Take(uint64_t cursor, const std::string& pattern, std::string* last_key);
+  void Put(uint64_t cursor, const std::string& pattern, const std::string& last_key);
+  void Clear();
+
+ private:
+  struct ResumePoint {
+    uint64_t cursor;
+    std::string pattern;
+    std::string last_key;
+  };
+
+  std::deque<ResumePoint> points_;
+};
+
+}  // namespace internal
+}  // namespace core
+}  // namespace fastonosql
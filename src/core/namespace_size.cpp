@@ -0,0 +1,67 @@
+/*  Copyright (C) 2014-2016 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "core/namespace_size.h"
+
+#include "core/internal/range_scan.h"  // for PrefixEnd
+
+namespace fastonosql {
+namespace core {
+
+NamespaceSizeOptions::NamespaceSizeOptions()
+    : sampled(false), sample_keys(NAMESPACE_SIZE_SAMPLE_KEYS) {}
+
+NamespaceRange::NamespaceRange(const std::string& ns, const std::string& separator)
+    : ns(ns), start(), limit() {
+  if (ns.empty()) {
+    return;
+  }
+
+  start = ns + separator;
+  limit = internal::PrefixEnd(start);
+}
+
+bool NamespaceRange::Contains(const std::string& key) const {
+  if (key < start) {
+    return false;
+  }
+
+  return limit.empty() || key < limit;
+}
+
+namespace_ranges_t MakeNamespaceRanges(const std::vector<std::string>& namespaces,
+                                       const std::string& separator) {
+  namespace_ranges_t ranges;
+  for (size_t i = 0; i < namespaces.size(); ++i) {
+    ranges.push_back(NamespaceRange(namespaces[i], separator));
+  }
+  return ranges;
+}
+
+NamespaceSize::NamespaceSize() : ns(), disk_bytes(0), memtable_bytes(0), keys(0), exact(false) {}
+
+NamespaceSize::NamespaceSize(const std::string& ns)
+    : ns(ns), disk_bytes(0), memtable_bytes(0), keys(0), exact(false) {}
+
+uint64_t NamespaceSize::Bytes() const {
+  return disk_bytes + memtable_bytes;
+}
+
+}  // namespace core
+}  // namespace fastonosql
@@ -0,0 +1,73 @@
+/*  Copyright (C) 2014-2016 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <stddef.h>  // for size_t
+#include <stdint.h>  // for uint64_t
+
+#include <string>  // for string
+#include <vector>  // for vector
+
+#define NAMESPACE_SIZE_SAMPLE_KEYS 100000
+
+namespace fastonosql {
+namespace core {
+
+struct NamespaceSizeOptions {
+  NamespaceSizeOptions();
+
+  bool sampled;        // walk keys of engines which can't estimate key ranges
+  size_t sample_keys;  // keys visited by walk
+};
+
+// keys of namespace "a" with separator ":" are in range [a:, a;),
+// empty namespace is whole keyspace
+struct NamespaceRange {
+  NamespaceRange(const std::string& ns, const std::string& separator);
+
+  bool Contains(const std::string& key) const;
+
+  std::string ns;
+  std::string start;
+  std::string limit;  // empty if range isn't bounded
+};
+
+typedef std::vector<NamespaceRange> namespace_ranges_t;
+
+namespace_ranges_t MakeNamespaceRanges(const std::vector<std::string>& namespaces,
+                                       const std::string& separator);
+
+struct NamespaceSize {
+  NamespaceSize();
+  explicit NamespaceSize(const std::string& ns);
+
+  uint64_t Bytes() const;
+
+  std::string ns;
+  uint64_t disk_bytes;      // approximate size of files (pages) of range
+  uint64_t memtable_bytes;  // written but not flushed yet
+  uint64_t keys;            // 0 if engine doesn't count keys
+  bool exact;               // keys of range were walked
+};
+
+typedef std::vector<NamespaceSize> namespace_sizes_t;
+
+}  // namespace core
+}  // namespace fastonosql
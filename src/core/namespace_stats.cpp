@@ -0,0 +1,253 @@
+/*  Copyright (C) 2014-2016 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "core/namespace_stats.h"
+
+#include <algorithm>  // for sort, max
+#include <utility>    // for pair
+#include <vector>     // for vector
+
+#include <common/macros.h>  // for DNOTREACHED
+
+#define NAMESPACE_STATS_MINUTE_SEC 60
+#define NAMESPACE_STATS_HOUR_SEC (60 * 60)
+#define NAMESPACE_STATS_DAY_SEC (24 * 60 * 60)
+
+namespace fastonosql {
+namespace core {
+
+namespace {
+
+typedef std::pair<std::string, std::shared_ptr<NamespaceNode> > child_t;
+
+bool BiggerChild(const child_t& left, const child_t& right) {
+  return left.second->stats.keys > right.second->stats.keys;
+}
+
+size_t CountNodes(const NamespaceNode& node) {
+  size_t count = 1;
+  for (auto it = node.children.begin(); it != node.children.end(); ++it) {
+    count += CountNodes(*it->second);
+  }
+  return count;
+}
+
+}  // namespace
+
+TTLBucket GetTTLBucket(ttl_t ttl) {
+  if (ttl < 0) {
+    return TTL_BUCKET_NONE;
+  } else if (ttl < NAMESPACE_STATS_MINUTE_SEC) {
+    return TTL_BUCKET_MINUTE;
+  } else if (ttl < NAMESPACE_STATS_HOUR_SEC) {
+    return TTL_BUCKET_HOUR;
+  } else if (ttl < NAMESPACE_STATS_DAY_SEC) {
+    return TTL_BUCKET_DAY;
+  }
+
+  return TTL_BUCKET_LONGER;
+}
+
+NamespaceStats::NamespaceStats() : keys(0), total_bytes(0), max_bytes(0), types() {
+  for (size_t i = 0; i < TTL_BUCKET_COUNT; ++i) {
+    ttl_histogram[i] = 0;
+  }
+}
+
+void NamespaceStats::Add(common::Value::Type type, ttl_t ttl, uint64_t value_bytes) {
+  keys++;
+  total_bytes += value_bytes;
+  max_bytes = std::max(max_bytes, value_bytes);
+  ttl_histogram[GetTTLBucket(ttl)]++;
+  types[type]++;
+}
+
+void NamespaceStats::Merge(const NamespaceStats& other) {
+  keys += other.keys;
+  total_bytes += other.total_bytes;
+  max_bytes = std::max(max_bytes, other.max_bytes);
+  for (size_t i = 0; i < TTL_BUCKET_COUNT; ++i) {
+    ttl_histogram[i] += other.ttl_histogram[i];
+  }
+  for (auto it = other.types.begin(); it != other.types.end(); ++it) {
+    types[it->first] += it->second;
+  }
+}
+
+NamespaceNode::NamespaceNode() : name(), stats(), other(), children() {}
+
+NamespaceNode::NamespaceNode(const std::string& name)
+    : name(name), stats(), other(), children() {}
+
+NamespaceStats NamespaceNode::DirectKeys() const {
+  NamespaceStats nested = other;
+  for (auto it = children.begin(); it != children.end(); ++it) {
+    nested.Merge(it->second->stats);
+  }
+
+  NamespaceStats res = stats;
+  res.keys -= nested.keys;
+  res.total_bytes -= nested.total_bytes;
+  for (size_t i = 0; i < TTL_BUCKET_COUNT; ++i) {
+    res.ttl_histogram[i] -= nested.ttl_histogram[i];
+  }
+  for (auto it = nested.types.begin(); it != nested.types.end(); ++it) {
+    res.types[it->first] -= it->second;
+  }
+  return res;
+}
+
+NamespaceTreeOptions::NamespaceTreeOptions()
+    : max_children(NAMESPACE_STATS_DEFAULT_MAX_CHILDREN),
+      max_depth(NAMESPACE_STATS_DEFAULT_MAX_DEPTH),
+      max_nodes(NAMESPACE_STATS_DEFAULT_MAX_NODES) {}
+
+NamespaceTree::NamespaceTree()
+    : ns_separator_(), options_(), root_(std::make_shared<NamespaceNode>()), nodes_count_(1) {}
+
+NamespaceTree::NamespaceTree(const std::string& ns_separator, const NamespaceTreeOptions& options)
+    : ns_separator_(ns_separator),
+      options_(options),
+      root_(std::make_shared<NamespaceNode>()),
+      nodes_count_(1) {}
+
+void NamespaceTree::Add(const NKey& key, common::Value::Type type, uint64_t value_bytes) {
+  const ttl_t ttl = key.TTL();
+  const std::string key_str = key.Key();
+  NamespaceNode* node = root_.get();
+  node->stats.Add(type, ttl, value_bytes);
+  if (ns_separator_.empty()) {
+    return;
+  }
+
+  // last part of key isn't namespace
+  size_t start = 0;
+  size_t depth = 0;
+  size_t pos = key_str.find(ns_separator_);
+  while (pos != std::string::npos && depth < options_.max_depth) {
+    NamespaceNode* child = Child(node, key_str.substr(start, pos - start));
+    if (!child) {
+      node->other.Add(type, ttl, value_bytes);
+      return;
+    }
+
+    child->stats.Add(type, ttl, value_bytes);
+    node = child;
+    depth++;
+    start = pos + ns_separator_.size();
+    pos = key_str.find(ns_separator_, start);
+  }
+}
+
+void NamespaceTree::Merge(const NamespaceTree& other) {
+  MergeNode(root_.get(), *other.root_);
+}
+
+const NamespaceNode& NamespaceTree::Root() const {
+  return *root_;
+}
+
+size_t NamespaceTree::NodesCount() const {
+  return nodes_count_;
+}
+
+std::string NamespaceTree::NsSeparator() const {
+  return ns_separator_;
+}
+
+NamespaceNode* NamespaceTree::Child(NamespaceNode* parent, const std::string& name) {
+  auto it = parent->children.find(name);
+  if (it != parent->children.end()) {
+    return it->second.get();
+  }
+
+  if (nodes_count_ >= options_.max_nodes) {
+    return nullptr;
+  }
+
+  std::string full_name = parent == root_.get() ? name : parent->name + ns_separator_ + name;
+  std::shared_ptr<NamespaceNode> child = std::make_shared<NamespaceNode>(full_name);
+  parent->children[name] = child;
+  nodes_count_++;
+  if (parent->children.size() > options_.max_children * 2) {
+    Compact(parent);
+    it = parent->children.find(name);
+    if (it == parent->children.end()) {
+      return nullptr;
+    }
+  }
+  return child.get();
+}
+
+void NamespaceTree::MergeNode(NamespaceNode* to, const NamespaceNode& from) {
+  to->stats.Merge(from.stats);
+  to->other.Merge(from.other);
+  for (auto it = from.children.begin(); it != from.children.end(); ++it) {
+    NamespaceNode* child = Child(to, it->first);
+    if (!child) {
+      to->other.Merge(it->second->stats);
+      continue;
+    }
+
+    MergeNode(child, *it->second);
+  }
+}
+
+void NamespaceTree::Compact(NamespaceNode* node) {
+  if (node->children.size() <= options_.max_children * 2) {
+    return;
+  }
+
+  std::vector<child_t> children(node->children.begin(), node->children.end());
+  std::sort(children.begin(), children.end(), &BiggerChild);
+  for (size_t i = options_.max_children; i < children.size(); ++i) {
+    node->other.Merge(children[i].second->stats);
+    nodes_count_ -= CountNodes(*children[i].second);
+    node->children.erase(children[i].first);
+  }
+}
+
+NamespaceStatsTarget::NamespaceStatsTarget(NamespaceTree* tree) : tree_(tree) {}
+
+bool NamespaceStatsTarget::IsSupportedType(common::Value::Type type) const {
+  UNUSED(type);
+  return true;
+}
+
+bool NamespaceStatsTarget::IsSupportedTTL() const {
+  return true;
+}
+
+common::Error NamespaceStatsTarget::SetBatch(const NDbKValues& keys, NDbKValues* added_keys) {
+  if (!added_keys) {
+    DNOTREACHED();
+    return common::make_error_value("Invalid input argument(s)", common::ErrorValue::E_ERROR);
+  }
+
+  for (size_t i = 0; i < keys.size(); ++i) {
+    const NDbKValue& key = keys[i];
+    tree_->Add(key.Key(), key.Type(), key.ValueString().size());
+    added_keys->push_back(key);
+  }
+
+  return common::Error();
+}
+
+}  // namespace core
+}  // namespace fastonosql
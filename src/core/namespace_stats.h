@@ -0,0 +1,129 @@
+/*  Copyright (C) 2014-2016 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <stddef.h>  // for size_t
+#include <stdint.h>  // for uint64_t
+
+#include <map>     // for map
+#include <memory>  // for shared_ptr
+#include <string>  // for string
+
+#include <common/value.h>  // for Value::Type
+
+#include "core/copy_pipeline.h"  // for ICopyTarget
+#include "core/db_key.h"         // for NKey, ttl_t
+
+#define NAMESPACE_STATS_DEFAULT_MAX_CHILDREN 64
+#define NAMESPACE_STATS_DEFAULT_MAX_DEPTH 8
+#define NAMESPACE_STATS_DEFAULT_MAX_NODES 100000
+
+namespace fastonosql {
+namespace core {
+
+enum TTLBucket {
+  TTL_BUCKET_NONE = 0,
+  TTL_BUCKET_MINUTE,  // expires in less than minute
+  TTL_BUCKET_HOUR,
+  TTL_BUCKET_DAY,
+  TTL_BUCKET_LONGER,
+  TTL_BUCKET_COUNT
+};
+
+TTLBucket GetTTLBucket(ttl_t ttl);
+
+struct NamespaceStats {
+  NamespaceStats();
+
+  void Add(common::Value::Type type, ttl_t ttl, uint64_t value_bytes);
+  void Merge(const NamespaceStats& other);
+
+  uint64_t keys;
+  uint64_t total_bytes;  // sizes of values
+  uint64_t max_bytes;
+  uint64_t ttl_histogram[TTL_BUCKET_COUNT];
+  std::map<int, uint64_t> types;  // keys by common::Value::Type
+};
+
+// stats of namespace include all its subnamespaces,
+// namespaces which weren't kept by limits are summed in other
+struct NamespaceNode {
+  NamespaceNode();
+  explicit NamespaceNode(const std::string& name);
+
+  NamespaceStats DirectKeys() const;  // keys without subnamespace
+
+  std::string name;  // full name, joined by separator
+  NamespaceStats stats;
+  NamespaceStats other;
+  std::map<std::string, std::shared_ptr<NamespaceNode> > children;  // by own level name
+};
+
+struct NamespaceTreeOptions {
+  NamespaceTreeOptions();
+
+  size_t max_children;  // of every namespace, others are summed in other bucket
+  size_t max_depth;
+  size_t max_nodes;
+};
+
+// prefix trie of namespaces by ns_separator, memory is bounded by options:
+// when namespace has twice more children than max_children only
+// max_children biggest of them are kept (top-K with "other" bucket)
+class NamespaceTree {
+ public:
+  NamespaceTree();
+  NamespaceTree(const std::string& ns_separator, const NamespaceTreeOptions& options);
+
+  void Add(const NKey& key, common::Value::Type type, uint64_t value_bytes);
+  // trees of partitions scanned in parallel
+  void Merge(const NamespaceTree& other);
+
+  const NamespaceNode& Root() const;
+  size_t NodesCount() const;
+  std::string NsSeparator() const;
+
+ private:
+  NamespaceNode* Child(NamespaceNode* parent, const std::string& name);
+  void MergeNode(NamespaceNode* to, const NamespaceNode& from);
+  void Compact(NamespaceNode* node);
+
+  std::string ns_separator_;
+  NamespaceTreeOptions options_;
+  std::shared_ptr<NamespaceNode> root_;
+  size_t nodes_count_;
+};
+
+// copy target which only counts scanned keys
+class NamespaceStatsTarget : public ICopyTarget {
+ public:
+  explicit NamespaceStatsTarget(NamespaceTree* tree);
+
+  virtual bool IsSupportedType(common::Value::Type type) const override;
+  // ttl is only counted, so keys keep it
+  virtual bool IsSupportedTTL() const override;
+  virtual common::Error SetBatch(const NDbKValues& keys, NDbKValues* added_keys) override;
+
+ private:
+  NamespaceTree* const tree_;
+};
+
+}  // namespace core
+}  // namespace fastonosql
@@ -0,0 +1,274 @@
+/*  Copyright (C) 2014-2016 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "core/partitioned_scan.h"
+
+#include <algorithm>  // for max
+#include <thread>     // for thread, hardware_concurrency
+
+#include <common/time.h>  // for current_mstime
+
+#define PARTITIONED_SCAN_DEFAULT_PATTERN "*"
+#define PARTITIONED_SCAN_DEFAULT_BATCH_SIZE 1000
+#define PARTITIONED_SCAN_PARTITIONS_PER_WORKER 4
+#define PARTITIONED_SCAN_DEFAULT_QUEUE_SIZE 4
+
+namespace fastonosql {
+namespace core {
+
+PartitionedScanOptions::PartitionedScanOptions()
+    : pattern(PARTITIONED_SCAN_DEFAULT_PATTERN),
+      batch_size(PARTITIONED_SCAN_DEFAULT_BATCH_SIZE),
+      workers(0),
+      partitions_per_worker(PARTITIONED_SCAN_PARTITIONS_PER_WORKER),
+      with_values(false),
+      ordered(false),
+      queue_size(PARTITIONED_SCAN_DEFAULT_QUEUE_SIZE) {}
+
+size_t PartitionedScanOptions::Workers() const {
+  if (workers) {
+    return workers;
+  }
+
+  unsigned int cores = std::thread::hardware_concurrency();
+  return cores ? cores : 1;
+}
+
+size_t PartitionedScanOptions::Partitions() const {
+  return Workers() * std::max<size_t>(partitions_per_worker, 1);
+}
+
+IPartitionedSource::~IPartitionedSource() {}
+
+PartitionedScan::RangeBuffer::RangeBuffer() : batches(), finished(false) {}
+
+PartitionedScan::PartitionedScan(IPartitionedSource* source, const PartitionedScanOptions& options)
+    : source_(source),
+      options_(options),
+      ranges_(),
+      mutex_(),
+      cond_(),
+      buffers_(),
+      head_(0),
+      done_(0),
+      scanned_(0),
+      fatal_error_() {}
+
+common::Error PartitionedScan::Partition() {
+  if (!source_) {
+    DNOTREACHED();
+    return common::make_error_value("Invalid input argument(s)", common::ErrorValue::E_ERROR);
+  }
+
+  key_ranges_t ranges;
+  common::Error err = source_->Partition(options_.Partitions(), &ranges);
+  if (err && err->IsError()) {
+    return err;
+  }
+
+  if (ranges.empty()) {
+    ranges.push_back(KeyRange());
+  }
+  ranges_ = ranges;
+  return common::Error();
+}
+
+const key_ranges_t& PartitionedScan::Ranges() const {
+  return ranges_;
+}
+
+common::Error PartitionedScan::Run(interrupt_callback_t is_interrupted,
+                                   batch_callback_t batch_cb,
+                                   progress_callback_t progress_cb,
+                                   CopyStats* stats) {
+  if (!source_ || !batch_cb || !stats || options_.batch_size == 0 || options_.queue_size == 0) {
+    DNOTREACHED();
+    return common::make_error_value("Invalid input argument(s)", common::ErrorValue::E_ERROR);
+  }
+
+  if (ranges_.empty()) {
+    common::Error err = Partition();
+    if (err && err->IsError()) {
+      return err;
+    }
+  }
+
+  buffers_ = std::vector<RangeBuffer>(ranges_.size());
+  head_ = 0;
+  done_ = 0;
+  scanned_ = 0;
+  fatal_error_ = common::Error();
+  const common::time64_t start_ts = common::time::current_mstime();
+
+  std::vector<internal::WorkStealingPool::task_t> tasks;
+  for (size_t i = 0; i < ranges_.size(); ++i) {
+    tasks.push_back([this, i, is_interrupted, batch_cb, progress_cb]() {
+      ScanRoutine(i, is_interrupted, batch_cb, progress_cb);
+    });
+  }
+
+  internal::WorkStealingPool pool(options_.Workers());
+  if (!options_.ordered) {
+    pool.Run(tasks);
+  } else {
+    // ranges are dealt to workers in key order, so head range is always
+    // scanned or next to be scanned and its batches never wait for space
+    std::thread scanner([&pool, &tasks]() { pool.Run(tasks); });
+    NDbKValues batch;
+    for (size_t i = 0; i < ranges_.size(); ++i) {
+      while (PopBatch(i, &batch)) {
+        batch_cb(i, batch);
+      }
+
+      std::unique_lock<std::mutex> lock(mutex_);
+      head_ = i + 1;
+      cond_.notify_all();
+    }
+    scanner.join();
+  }
+
+  *stats = CopyStats();
+  stats->scanned = scanned_;
+  stats->copied = scanned_;
+  stats->elapsed_msec = common::time::current_mstime() - start_ts;
+  return fatal_error_;
+}
+
+void PartitionedScan::ScanRoutine(size_t partition,
+                                  interrupt_callback_t is_interrupted,
+                                  batch_callback_t batch_cb,
+                                  progress_callback_t progress_cb) {
+  bool stopped = false;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    stopped = fatal_error_ && fatal_error_->IsError();
+  }
+
+  if (!stopped) {
+    auto range_cb = [this, partition, is_interrupted, batch_cb](const NDbKValues& batch) {
+      if (is_interrupted && is_interrupted()) {
+        SetFatalError(common::make_error_value("Interrupted.", common::ErrorValue::E_INTERRUPTED));
+        return false;
+      }
+
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        scanned_ += batch.size();
+      }
+
+      if (options_.ordered) {
+        return PushBatch(partition, batch);
+      }
+
+      batch_cb(partition, batch);
+      std::unique_lock<std::mutex> lock(mutex_);
+      return !fatal_error_;
+    };
+
+    common::Error err = source_->ScanRange(ranges_[partition], options_.pattern,
+                                           options_.batch_size, options_.with_values, range_cb);
+    if (err && err->IsError()) {
+      SetFatalError(err);
+    }
+  }
+
+  size_t done = 0;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    buffers_[partition].finished = true;
+    done = ++done_;
+    cond_.notify_all();
+  }
+
+  if (progress_cb) {
+    progress_cb(done, ranges_.size());
+  }
+}
+
+bool PartitionedScan::PushBatch(size_t partition, const NDbKValues& batch) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  RangeBuffer& buffer = buffers_[partition];
+  while (buffer.batches.size() >= options_.queue_size && partition != head_ && !fatal_error_) {
+    cond_.wait(lock);
+  }
+
+  if (fatal_error_) {
+    return false;
+  }
+
+  buffer.batches.push_back(batch);
+  cond_.notify_all();
+  return true;
+}
+
+bool PartitionedScan::PopBatch(size_t partition, NDbKValues* batch) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  RangeBuffer& buffer = buffers_[partition];
+  while (buffer.batches.empty() && !buffer.finished && !fatal_error_) {
+    cond_.wait(lock);
+  }
+
+  if (fatal_error_ || buffer.batches.empty()) {
+    return false;
+  }
+
+  batch->swap(buffer.batches.front());
+  buffer.batches.pop_front();
+  cond_.notify_all();
+  return true;
+}
+
+void PartitionedScan::SetFatalError(common::Error err) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (!fatal_error_) {
+    fatal_error_ = err;
+  }
+  cond_.notify_all();
+}
+
+common::Error CountKeysPartitioned(IPartitionedSource* source,
+                                   const PartitionedScanOptions& options,
+                                   PartitionedScan::interrupt_callback_t is_interrupted,
+                                   size_t* count) {
+  if (!source || !count) {
+    DNOTREACHED();
+    return common::make_error_value("Invalid input argument(s)", common::ErrorValue::E_ERROR);
+  }
+
+  PartitionedScanOptions count_options = options;
+  count_options.with_values = false;
+  count_options.ordered = false;
+  PartitionedScan scan(source, count_options);
+  CopyStats stats;
+  common::Error err = scan.Run(is_interrupted,
+                               [](size_t partition, const NDbKValues& batch) {
+                                 UNUSED(partition);
+                                 UNUSED(batch);
+                               },
+                               PartitionedScan::progress_callback_t(), &stats);
+  if (err && err->IsError()) {
+    return err;
+  }
+
+  *count = stats.scanned;
+  return common::Error();
+}
+
+}  // namespace core
+}  // namespace fastonosql
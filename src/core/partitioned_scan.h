@@ -0,0 +1,166 @@
+/*  Copyright (C) 2014-2016 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <stddef.h>  // for size_t
+#include <stdint.h>  // for uint64_t
+
+#include <condition_variable>  // for condition_variable
+#include <deque>               // for deque
+#include <functional>          // for function
+#include <mutex>               // for mutex
+#include <string>              // for string
+#include <vector>              // for vector
+
+#include <common/error.h>   // for Error
+#include <common/macros.h>  // for WARN_UNUSED_RESULT
+
+#include "core/copy_pipeline.h"  // for CopyStats
+#include "core/db_key.h"         // for NDbKValues
+
+#include "core/internal/cdb_connection_client.h"  // for CDBConnectionClient
+#include "core/internal/key_partitions.h"         // for KeyRange, key_ranges_t
+
+namespace fastonosql {
+namespace core {
+
+struct PartitionedScanOptions {
+  PartitionedScanOptions();
+
+  size_t Workers() const;     // cores of machine if workers is 0
+  size_t Partitions() const;  // ranges of keyspace
+
+  std::string pattern;
+  size_t batch_size;
+  size_t workers;
+  size_t partitions_per_worker;  // more ranges than workers, so they are balanced by stealing
+  bool with_values;
+  bool ordered;       // batches are handed out in key order
+  size_t queue_size;  // batches buffered by every range of ordered scan
+};
+
+// engines with ordered keyspace which can be read by independent iterators
+class IPartitionedSource {
+ public:
+  virtual ~IPartitionedSource();
+
+  virtual common::Error Partition(size_t count, key_ranges_t* ranges) WARN_UNUSED_RESULT = 0;
+  // called from threads of pool, every call reads its range by own iterator
+  virtual common::Error ScanRange(const KeyRange& range,
+                                  const std::string& pattern,
+                                  size_t batch_size,
+                                  bool with_values,
+                                  range_batch_callback_t batch_cb) WARN_UNUSED_RESULT = 0;
+};
+
+// adapter of CDBConnection, with detach_client source is detached from its
+// client and all ranges are read from snapshot pinned while scanning
+template <typename DBConnection>
+class CDBPartitionedSource : public IPartitionedSource {
+ public:
+  CDBPartitionedSource(DBConnection* db, bool detach_client)
+      : db_(db), client_(db->Client()), detach_client_(detach_client) {
+    if (detach_client_) {
+      db_->SetClient(nullptr);
+      db_->PinSnapshot();
+    }
+  }
+  virtual ~CDBPartitionedSource() {
+    if (detach_client_) {
+      db_->UnpinSnapshot();
+      db_->SetClient(client_);
+    }
+  }
+
+  virtual common::Error Partition(size_t count, key_ranges_t* ranges) override {
+    return db_->Partition(count, ranges);
+  }
+
+  virtual common::Error ScanRange(const KeyRange& range,
+                                  const std::string& pattern,
+                                  size_t batch_size,
+                                  bool with_values,
+                                  range_batch_callback_t batch_cb) override {
+    return db_->ScanRange(range, pattern, batch_size, with_values, batch_cb);
+  }
+
+ private:
+  DBConnection* const db_;
+  CDBConnectionClient* const client_;
+  const bool detach_client_;
+};
+
+// ranges of keyspace are read in parallel on work stealing pool,
+// unordered scan calls batch_cb from threads of pool (batches of one range
+// are serialized), ordered scan calls it from thread of Run in key order
+// and memory is limited by queue_size batches of every range
+class PartitionedScan {
+ public:
+  typedef std::function<void(size_t partition, const NDbKValues& batch)> batch_callback_t;
+  typedef std::function<void(size_t done, size_t total)> progress_callback_t;
+  typedef std::function<bool()> interrupt_callback_t;
+
+  PartitionedScan(IPartitionedSource* source, const PartitionedScanOptions& options);
+
+  common::Error Partition() WARN_UNUSED_RESULT;  // done by Run if it wasn't called
+  const key_ranges_t& Ranges() const;
+
+  common::Error Run(interrupt_callback_t is_interrupted,
+                    batch_callback_t batch_cb,
+                    progress_callback_t progress_cb,
+                    CopyStats* stats) WARN_UNUSED_RESULT;
+
+ private:
+  struct RangeBuffer {
+    RangeBuffer();
+
+    std::deque<NDbKValues> batches;
+    bool finished;
+  };
+
+  void ScanRoutine(size_t partition,
+                   interrupt_callback_t is_interrupted,
+                   batch_callback_t batch_cb,
+                   progress_callback_t progress_cb);
+  bool PushBatch(size_t partition, const NDbKValues& batch);
+  bool PopBatch(size_t partition, NDbKValues* batch);
+  void SetFatalError(common::Error err);
+
+  IPartitionedSource* const source_;
+  const PartitionedScanOptions options_;
+  key_ranges_t ranges_;
+
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  std::vector<RangeBuffer> buffers_;
+  size_t head_;  // range handed out by ordered scan
+  size_t done_;
+  uint64_t scanned_;
+  common::Error fatal_error_;
+};
+
+// keys of all ranges counted in parallel, values aren't read
+common::Error CountKeysPartitioned(IPartitionedSource* source,
+                                   const PartitionedScanOptions& options,
+                                   PartitionedScan::interrupt_callback_t is_interrupted,
+                                   size_t* count) WARN_UNUSED_RESULT;
+
+}  // namespace core
+}  // namespace fastonosql
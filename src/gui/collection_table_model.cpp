@@ -0,0 +1,218 @@
+/*  Copyright (C) 2014-2016 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "gui/collection_table_model.h"
+
+#include <vector>  // for vector
+
+#include <common/macros.h>             // for VERIFY, UNUSED
+#include <common/qt/convert2string.h>  // for ConvertFromString
+#include <common/qt/utils_qt.h>        // for item
+
+#include "core/global.h"  // for ConvertToString
+
+#include "proxy/events/events_info.h"  // for LoadCollectionChunkRequest, etc
+#include "proxy/server/iserver.h"      // for IServer
+
+#include "gui/key_value_table_item.h"
+
+#include "translations/global.h"  // for trKey, trValue
+
+namespace fastonosql {
+namespace gui {
+
+CollectionTableModel::CollectionTableModel(proxy::IServerSPtr server,
+                                           const core::NKey& key,
+                                           common::Value::Type type,
+                                           size_t chunk_size,
+                                           QObject* parent)
+    : common::qt::gui::TableModel(parent),
+      server_(server),
+      key_(key),
+      type_(type),
+      chunk_size_(chunk_size),
+      cursor_(0),
+      pending_(false),
+      finished_(false),
+      total_(0),
+      members_() {
+  CHECK(server_);
+  VERIFY(connect(server_.get(), &proxy::IServer::LoadCollectionChunkFinished, this,
+                 &CollectionTableModel::finishLoadCollectionChunk));
+}
+
+CollectionTableModel::~CollectionTableModel() {}
+
+QVariant CollectionTableModel::data(const QModelIndex& index, int role) const {
+  if (!index.isValid() || role != Qt::DisplayRole) {
+    return QVariant();
+  }
+
+  KeyValueTableItem* node =
+      common::qt::item<common::qt::gui::TableItem*, KeyValueTableItem*>(index);
+  int col = index.column();
+  if (col == KeyValueTableItem::kKey) {
+    return node->key();
+  } else if (col == KeyValueTableItem::kValue) {
+    return node->value();
+  }
+
+  return QVariant();
+}
+
+QVariant CollectionTableModel::headerData(int section,
+                                          Qt::Orientation orientation,
+                                          int role) const {
+  if (orientation == Qt::Horizontal && role == Qt::DisplayRole) {
+    if (section == KeyValueTableItem::kKey) {
+      return translations::trKey;
+    } else if (section == KeyValueTableItem::kValue) {
+      return translations::trValue;
+    }
+  }
+
+  return TableModel::headerData(section, orientation, role);
+}
+
+int CollectionTableModel::columnCount(const QModelIndex& parent) const {
+  UNUSED(parent);
+  if (type_ == common::Value::TYPE_ZSET || type_ == common::Value::TYPE_HASH) {
+    return KeyValueTableItem::kValue + 1;
+  }
+
+  return KeyValueTableItem::kKey + 1;
+}
+
+bool CollectionTableModel::canFetchMore(const QModelIndex& parent) const {
+  if (parent.isValid()) {
+    return false;
+  }
+
+  return !finished_ && !pending_;
+}
+
+void CollectionTableModel::fetchMore(const QModelIndex& parent) {
+  if (!canFetchMore(parent)) {
+    return;
+  }
+
+  pending_ = true;
+  proxy::events_info::LoadCollectionChunkRequest req(this, key_, type_, cursor_, chunk_size_);
+  server_->LoadCollectionChunk(req);
+}
+
+size_t CollectionTableModel::totalCount() const {
+  return total_;
+}
+
+size_t CollectionTableModel::loadedCount() const {
+  return data_.size();
+}
+
+void CollectionTableModel::finishLoadCollectionChunk(
+    const proxy::events_info::LoadCollectionChunkResponce& res) {
+  // server is shared, skip chunks requested by other views
+  if (!pending_ || res.key.Key() != key_.Key() || res.cursor_in != cursor_) {
+    return;
+  }
+
+  pending_ = false;
+  common::Error er = res.errorInfo();
+  if (er && er->IsError()) {
+    finished_ = true;
+    return;
+  }
+
+  if (res.cursor_in == 0) {
+    total_ = res.total;
+    emit totalCountChanged(total_);
+  }
+
+  cursor_ = res.cursor_out;
+  finished_ = cursor_ == 0;
+  if (appendChunk(res.chunk) == 0 && !finished_) {
+    // SCAN may return no new members with non zero cursor, view wouldn't ask again
+    fetchMore(QModelIndex());
+  }
+}
+
+size_t CollectionTableModel::appendChunk(core::NValue chunk) {
+  if (!chunk) {
+    return 0;
+  }
+
+  std::vector<common::qt::gui::TableItem*> rows;
+  common::ArrayValue* arr = nullptr;
+  common::SetValue* set = nullptr;
+  common::ZSetValue* zset = nullptr;
+  common::HashValue* hash = nullptr;
+  if (chunk->GetAsList(&arr)) {
+    for (auto it = arr->begin(); it != arr->end(); ++it) {
+      rows.push_back(createRow(*it, nullptr));
+    }
+  } else if (chunk->GetAsSet(&set)) {
+    for (auto it = set->begin(); it != set->end(); ++it) {
+      if (isNewMember(*it)) {
+        rows.push_back(createRow(*it, nullptr));
+      }
+    }
+  } else if (chunk->GetAsZSet(&zset)) {
+    for (auto it = zset->begin(); it != zset->end(); ++it) {
+      auto element = (*it);
+      if (isNewMember(element.second)) {
+        rows.push_back(createRow(element.second, element.first));  // member, score
+      }
+    }
+  } else if (chunk->GetAsHash(&hash)) {
+    for (auto it = hash->begin(); it != hash->end(); ++it) {
+      auto element = (*it);
+      if (isNewMember(element.first)) {
+        rows.push_back(createRow(element.first, element.second));
+      }
+    }
+  }
+
+  if (rows.empty()) {
+    return 0;
+  }
+
+  size_t size = data_.size();
+  beginInsertRows(QModelIndex(), size, size + rows.size() - 1);
+  data_.insert(data_.end(), rows.begin(), rows.end());
+  endInsertRows();
+  emit loadedCountChanged(data_.size());
+  return rows.size();
+}
+
+bool CollectionTableModel::isNewMember(common::Value* member) {
+  return members_.insert(common::ConvertToString(member, "")).second;
+}
+
+common::qt::gui::TableItem* CollectionTableModel::createRow(common::Value* key,
+                                                            common::Value* value) const {
+  QString key_str;
+  common::ConvertFromString(common::ConvertToString(key, ""), &key_str);
+  QString value_str;
+  if (value) {
+    common::ConvertFromString(common::ConvertToString(value, ""), &value_str);
+  }
+  return new KeyValueTableItem(key_str, value_str, KeyValueTableItem::RemoveAction);
+}
+
+}  // namespace gui
+}  // namespace fastonosql
@@ -0,0 +1,93 @@
+/*  Copyright (C) 2014-2016 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <stddef.h>  // for size_t
+#include <stdint.h>  // for uint64_t
+
+#include <set>     // for set
+#include <string>  // for string
+
+#include <common/qt/gui/base/table_model.h>
+#include <common/value.h>  // for Value::Type
+
+#include "core/db_key.h"      // for NKey, NValue
+#include "proxy/proxy_fwd.h"  // for IServerSPtr
+
+namespace fastonosql {
+namespace proxy {
+namespace events_info {
+struct LoadCollectionChunkResponce;
+}
+}
+}
+
+namespace fastonosql {
+namespace gui {
+
+// read only rows of list, set, zset or hash,
+// next chunk is requested from server when view scrolls to the end
+class CollectionTableModel : public common::qt::gui::TableModel {
+  Q_OBJECT
+ public:
+  enum { default_chunk_size = 500 };
+
+  CollectionTableModel(proxy::IServerSPtr server,
+                       const core::NKey& key,
+                       common::Value::Type type,
+                       size_t chunk_size = default_chunk_size,
+                       QObject* parent = Q_NULLPTR);
+  virtual ~CollectionTableModel();
+
+  virtual QVariant data(const QModelIndex& index, int role) const override;
+  virtual QVariant headerData(int section, Qt::Orientation orientation, int role) const override;
+  virtual int columnCount(const QModelIndex& parent) const override;
+
+  virtual bool canFetchMore(const QModelIndex& parent) const override;
+  virtual void fetchMore(const QModelIndex& parent) override;
+
+  size_t totalCount() const;  // HLEN, SCARD, ZCARD or LLEN
+  size_t loadedCount() const;
+
+ Q_SIGNALS:
+  void totalCountChanged(size_t total);
+  void loadedCountChanged(size_t loaded);
+
+ private Q_SLOTS:
+  void finishLoadCollectionChunk(const proxy::events_info::LoadCollectionChunkResponce& res);
+
+ private:
+  size_t appendChunk(core::NValue chunk);  // returns count of added rows
+  common::qt::gui::TableItem* createRow(common::Value* key, common::Value* value) const;
+  bool isNewMember(common::Value* member);
+
+  const proxy::IServerSPtr server_;
+  const core::NKey key_;
+  const common::Value::Type type_;
+  const size_t chunk_size_;
+
+  uint64_t cursor_;
+  bool pending_;
+  bool finished_;
+  size_t total_;
+  std::set<std::string> members_;  // of set, zset or hash, scans may repeat them
+};
+
+}  // namespace gui
+}  // namespace fastonosql
@@ -22,6 +22,10 @@
 
 #include "proxy/db/leveldb/connection_settings.h"
 
+namespace {
+const QString trScanSnapshots = QObject::tr("Consistent pages of keys (snapshot per scan)");
+}
+
 namespace fastonosql {
 namespace gui {
 namespace leveldb {
@@ -30,6 +34,8 @@ ConnectionWidget::ConnectionWidget(QWidget* parent)
     : ConnectionLocalWidget(true, trDBPath, trCaption, trFilter, parent) {
   createDBIfMissing_ = new QCheckBox;
   addWidget(createDBIfMissing_);
+  scanSnapshots_ = new QCheckBox;
+  addWidget(scanSnapshots_);
 }
 
 void ConnectionWidget::syncControls(proxy::IConnectionSettingsBase* connection) {
@@ -38,12 +44,14 @@ void ConnectionWidget::syncControls(proxy::IConnectionSettingsBase* connection)
   if (lev) {
     core::leveldb::Config config = lev->Info();
     createDBIfMissing_->setChecked(config.create_if_missing);
+    scanSnapshots_->setChecked(config.scan_snapshots);
   }
   ConnectionLocalWidget::syncControls(lev);
 }
 
 void ConnectionWidget::retranslateUi() {
   createDBIfMissing_->setText(trCreateDBIfMissing);
+  scanSnapshots_->setText(trScanSnapshots);
   ConnectionLocalWidget::retranslateUi();
 }
 
@@ -52,6 +60,7 @@ proxy::IConnectionSettingsLocal* ConnectionWidget::createConnectionLocalImpl(
   proxy::leveldb::ConnectionSettings* conn = new proxy::leveldb::ConnectionSettings(path);
   core::leveldb::Config config = conn->Info();
   config.create_if_missing = createDBIfMissing_->isChecked();
+  config.scan_snapshots = scanSnapshots_->isChecked();
   conn->SetInfo(config);
   return conn;
 }
@@ -19,9 +19,26 @@
 #include "gui/db/lmdb/connection_widget.h"
 
 #include <QCheckBox>
+#include <QGridLayout>
+#include <QLabel>
+#include <QSpinBox>
+
+#include <common/macros.h>  // for VERIFY
 
 #include "proxy/db/lmdb/connection_settings.h"
 
+namespace {
+const QString trMapSizeMb = QObject::tr("Initial map size (MB):");
+const QString trMaxReaders = QObject::tr("Max readers:");
+const QString trMaxDbs = QObject::tr("Max named databases:");
+const QString trWriteMap = QObject::tr("Writable memory map");
+const QString trNoSync = QObject::tr("Don't sync commits");
+const QString trMapAsync = QObject::tr("Flush writable map asynchronously");
+const QString trNoReadahead = QObject::tr("Disable OS readahead");
+
+const size_t kMb = 1024 * 1024;
+}  // namespace
+
 namespace fastonosql {
 namespace gui {
 namespace lmdb {
@@ -30,6 +47,42 @@ ConnectionWidget::ConnectionWidget(QWidget* parent)
     : ConnectionLocalWidget(true, trDBPath, trCaption, trFilter, parent) {
   readOnlyDB_ = new QCheckBox;
   addWidget(readOnlyDB_);
+
+  QGridLayout* options_layout = new QGridLayout;
+  mapSizeLabel_ = new QLabel;
+  mapSizeMb_ = new QSpinBox;
+  mapSizeMb_->setRange(1, INT32_MAX);
+  options_layout->addWidget(mapSizeLabel_, 0, 0);
+  options_layout->addWidget(mapSizeMb_, 0, 1);
+
+  maxReadersLabel_ = new QLabel;
+  maxReaders_ = new QSpinBox;
+  maxReaders_->setRange(1, INT32_MAX);
+  options_layout->addWidget(maxReadersLabel_, 1, 0);
+  options_layout->addWidget(maxReaders_, 1, 1);
+
+  maxDbsLabel_ = new QLabel;
+  maxDbs_ = new QSpinBox;
+  maxDbs_->setRange(0, INT32_MAX);
+  options_layout->addWidget(maxDbsLabel_, 2, 0);
+  options_layout->addWidget(maxDbs_, 2, 1);
+  addLayout(options_layout);
+
+  writeMap_ = new QCheckBox;
+  VERIFY(connect(writeMap_, &QCheckBox::stateChanged, this, &ConnectionWidget::writeMapChange));
+  addWidget(writeMap_);
+  noSync_ = new QCheckBox;
+  addWidget(noSync_);
+  mapAsync_ = new QCheckBox;
+  addWidget(mapAsync_);
+  noReadahead_ = new QCheckBox;
+  addWidget(noReadahead_);
+
+  core::lmdb::Config def;
+  mapSizeMb_->setValue(def.map_size / kMb);
+  maxReaders_->setValue(def.max_readers);
+  maxDbs_->setValue(def.max_dbs);
+  writeMapChange(writeMap_->checkState());
 }
 
 void ConnectionWidget::syncControls(proxy::IConnectionSettingsBase* connection) {
@@ -37,20 +90,45 @@ void ConnectionWidget::syncControls(proxy::IConnectionSettingsBase* connection)
   if (lmdb) {
     core::lmdb::Config config = lmdb->Info();
     readOnlyDB_->setChecked(config.ReadOnlyDB());
+    mapSizeMb_->setValue(config.map_size / kMb);
+    maxReaders_->setValue(config.max_readers);
+    maxDbs_->setValue(config.max_dbs);
+    writeMap_->setChecked(config.IsEnvFlag(LMDB_ENV_WRITEMAP));
+    noSync_->setChecked(config.IsEnvFlag(LMDB_ENV_NOSYNC));
+    mapAsync_->setChecked(config.IsEnvFlag(LMDB_ENV_MAPASYNC));
+    noReadahead_->setChecked(config.IsEnvFlag(LMDB_ENV_NORDAHEAD));
   }
   ConnectionLocalWidget::syncControls(lmdb);
 }
 
 void ConnectionWidget::retranslateUi() {
   readOnlyDB_->setText(trReadOnlyDB);
+  mapSizeLabel_->setText(trMapSizeMb);
+  maxReadersLabel_->setText(trMaxReaders);
+  maxDbsLabel_->setText(trMaxDbs);
+  writeMap_->setText(trWriteMap);
+  noSync_->setText(trNoSync);
+  mapAsync_->setText(trMapAsync);
+  noReadahead_->setText(trNoReadahead);
   ConnectionLocalWidget::retranslateUi();
 }
 
+void ConnectionWidget::writeMapChange(int state) {
+  mapAsync_->setEnabled(state == Qt::Checked);
+}
+
 proxy::IConnectionSettingsLocal* ConnectionWidget::createConnectionLocalImpl(
     const proxy::connection_path_t& path) const {
   proxy::lmdb::ConnectionSettings* conn = new proxy::lmdb::ConnectionSettings(path);
   core::lmdb::Config config = conn->Info();
   config.SetReadOnlyDB(readOnlyDB_->isChecked());
+  config.map_size = static_cast<size_t>(mapSizeMb_->value()) * kMb;
+  config.max_readers = maxReaders_->value();
+  config.max_dbs = maxDbs_->value();
+  config.SetEnvFlag(LMDB_ENV_WRITEMAP, writeMap_->isChecked());
+  config.SetEnvFlag(LMDB_ENV_NOSYNC, noSync_->isChecked());
+  config.SetEnvFlag(LMDB_ENV_MAPASYNC, writeMap_->isChecked() && mapAsync_->isChecked());
+  config.SetEnvFlag(LMDB_ENV_NORDAHEAD, noReadahead_->isChecked());
   conn->SetInfo(config);
   return conn;
 }
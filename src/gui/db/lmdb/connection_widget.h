@@ -22,6 +22,9 @@
 
 #include "gui/widgets/connection_local_widget.h"
 
+class QLabel;
+class QSpinBox;
+
 namespace fastonosql {
 namespace gui {
 namespace lmdb {
@@ -34,11 +37,24 @@ class ConnectionWidget : public ConnectionLocalWidget {
   virtual void syncControls(proxy::IConnectionSettingsBase* connection) override;
   virtual void retranslateUi() override;
 
+ private Q_SLOTS:
+  void writeMapChange(int state);
+
  private:
   virtual proxy::IConnectionSettingsLocal* createConnectionLocalImpl(
       const proxy::connection_path_t& path) const override;
 
   QCheckBox* readOnlyDB_;
+  QLabel* mapSizeLabel_;
+  QSpinBox* mapSizeMb_;
+  QLabel* maxReadersLabel_;
+  QSpinBox* maxReaders_;
+  QLabel* maxDbsLabel_;
+  QSpinBox* maxDbs_;
+  QCheckBox* writeMap_;
+  QCheckBox* noSync_;
+  QCheckBox* mapAsync_;
+  QCheckBox* noReadahead_;
 };
 
 }  // namespace lmdb
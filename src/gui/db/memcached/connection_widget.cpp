@@ -35,6 +35,9 @@ namespace {
 const QString trUserPassword = QObject::tr("User Password:");
 const QString trUserName = QObject::tr("User Name:");
 const QString trUseSasl = QObject::tr("Use SASL");
+const QString trPoolServers = QObject::tr("Other servers of pool:");
+const QString trPoolServersPlaceholder = QObject::tr("host:port[:weight],...");
+const QString trKetama = QObject::tr("Ketama distribution (weighted)");
 }  // namespace
 
 namespace fastonosql {
@@ -51,6 +54,16 @@ ConnectionWidget::ConnectionWidget(QWidget* parent) : ConnectionRemoteWidget(par
   user_layout->setContentsMargins(0, 0, 0, 0);
   addWidget(userPasswordWidget_);
 
+  QHBoxLayout* servers_layout = new QHBoxLayout;
+  serversLabel_ = new QLabel;
+  servers_ = new QLineEdit;
+  servers_layout->addWidget(serversLabel_);
+  servers_layout->addWidget(servers_);
+  addLayout(servers_layout);
+
+  ketama_ = new QCheckBox;
+  addWidget(ketama_);
+
   // sync
   useSasl_->setChecked(false);
   userPasswordWidget_->setEnabled(false);
@@ -72,12 +85,20 @@ void ConnectionWidget::syncControls(proxy::IConnectionSettingsBase* connection)
     QString qpass;
     common::ConvertFromString(pass, &qpass);
     userPasswordWidget_->setPassword(qpass);
+
+    QString qservers;
+    common::ConvertFromString(config.servers, &qservers);
+    servers_->setText(qservers);
+    ketama_->setChecked(config.ketama);
   }
   ConnectionRemoteWidget::syncControls(memc);
 }
 
 void ConnectionWidget::retranslateUi() {
   useSasl_->setText(trUseSasl);
+  serversLabel_->setText(trPoolServers);
+  servers_->setPlaceholderText(trPoolServersPlaceholder);
+  ketama_->setText(trKetama);
   ConnectionRemoteWidget::retranslateUi();
 }
 
@@ -109,6 +130,8 @@ proxy::IConnectionSettingsRemote* ConnectionWidget::createConnectionRemoteImpl(
     config.user = common::ConvertToString(userPasswordWidget_->userName());
     config.password = common::ConvertToString(userPasswordWidget_->password());
   }
+  config.servers = common::ConvertToString(servers_->text().trimmed());
+  config.ketama = ketama_->isChecked();
   conn->SetInfo(config);
   return conn;
 }
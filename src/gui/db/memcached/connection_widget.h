@@ -20,6 +20,9 @@
 
 #include "gui/widgets/connection_remote_widget.h"
 
+class QLabel;
+class QLineEdit;
+
 namespace fastonosql {
 namespace gui {
 class UserPasswordWidget;
@@ -44,6 +47,9 @@ class ConnectionWidget : public ConnectionRemoteWidget {
 
   QCheckBox* useSasl_;
   UserPasswordWidget* userPasswordWidget_;
+  QLabel* serversLabel_;
+  QLineEdit* servers_;
+  QCheckBox* ketama_;
 };
 
 }  // namespace memcached
@@ -19,9 +19,34 @@
 #include "gui/db/rocksdb/connection_widget.h"
 
 #include <QCheckBox>
+#include <QComboBox>
+#include <QGridLayout>
+#include <QLabel>
+#include <QLineEdit>
+#include <QSpinBox>
+
+#include <common/macros.h>             // for VERIFY
+#include <common/qt/convert2string.h>  // for ConvertToString
 
 #include "proxy/db/rocksdb/connection_settings.h"
 
+namespace {
+const QString trOpenMode = QObject::tr("Open mode:");
+const QString trReadWrite = QObject::tr("Read/Write");
+const QString trReadOnly = QObject::tr("Read only");
+const QString trSecondary = QObject::tr("Secondary instance");
+const QString trSecondaryPath = QObject::tr("Secondary path:");
+const QString trBlockCacheMb = QObject::tr("Block cache (MB):");
+const QString trBloomBits = QObject::tr("Bloom filter bits per key:");
+const QString trMaxOpenFiles = QObject::tr("Max open files:");
+const QString trReadaheadKb = QObject::tr("Iterator readahead (KB):");
+const QString trEnableStatistics = QObject::tr("Collect statistics");
+const QString trScanSnapshots = QObject::tr("Consistent pages of keys (snapshot per scan)");
+
+const size_t kMb = 1024 * 1024;
+const size_t kKb = 1024;
+}  // namespace
+
 namespace fastonosql {
 namespace gui {
 namespace rocksdb {
@@ -30,6 +55,59 @@ ConnectionWidget::ConnectionWidget(QWidget* parent)
     : ConnectionLocalWidget(true, trDBPath, trCaption, trFilter, parent) {
   createDBIfMissing_ = new QCheckBox;
   addWidget(createDBIfMissing_);
+
+  QGridLayout* options_layout = new QGridLayout;
+  openModeLabel_ = new QLabel;
+  openMode_ = new QComboBox;
+  openMode_->addItem(QString(), core::rocksdb::OPEN_READ_WRITE);
+  openMode_->addItem(QString(), core::rocksdb::OPEN_READ_ONLY);
+  openMode_->addItem(QString(), core::rocksdb::OPEN_SECONDARY);
+  typedef void (QComboBox::*ind)(int);
+  VERIFY(connect(openMode_, static_cast<ind>(&QComboBox::currentIndexChanged), this,
+                 &ConnectionWidget::openModeChange));
+  options_layout->addWidget(openModeLabel_, 0, 0);
+  options_layout->addWidget(openMode_, 0, 1);
+
+  secondaryPathLabel_ = new QLabel;
+  secondaryPath_ = new QLineEdit;
+  options_layout->addWidget(secondaryPathLabel_, 1, 0);
+  options_layout->addWidget(secondaryPath_, 1, 1);
+
+  blockCacheLabel_ = new QLabel;
+  blockCacheMb_ = new QSpinBox;
+  blockCacheMb_->setRange(0, INT32_MAX);
+  options_layout->addWidget(blockCacheLabel_, 2, 0);
+  options_layout->addWidget(blockCacheMb_, 2, 1);
+
+  bloomBitsLabel_ = new QLabel;
+  bloomBits_ = new QSpinBox;
+  bloomBits_->setRange(0, 64);
+  options_layout->addWidget(bloomBitsLabel_, 3, 0);
+  options_layout->addWidget(bloomBits_, 3, 1);
+
+  maxOpenFilesLabel_ = new QLabel;
+  maxOpenFiles_ = new QSpinBox;
+  maxOpenFiles_->setRange(-1, INT32_MAX);
+  options_layout->addWidget(maxOpenFilesLabel_, 4, 0);
+  options_layout->addWidget(maxOpenFiles_, 4, 1);
+
+  readaheadLabel_ = new QLabel;
+  readaheadKb_ = new QSpinBox;
+  readaheadKb_->setRange(0, INT32_MAX);
+  options_layout->addWidget(readaheadLabel_, 5, 0);
+  options_layout->addWidget(readaheadKb_, 5, 1);
+  addLayout(options_layout);
+
+  enableStatistics_ = new QCheckBox;
+  addWidget(enableStatistics_);
+  scanSnapshots_ = new QCheckBox;
+  addWidget(scanSnapshots_);
+
+  core::rocksdb::Config def;
+  blockCacheMb_->setValue(def.block_cache_size / kMb);
+  maxOpenFiles_->setValue(def.max_open_files);
+  enableStatistics_->setChecked(def.enable_statistics);
+  openModeChange(openMode_->currentIndex());
 }
 
 void ConnectionWidget::syncControls(proxy::IConnectionSettingsBase* connection) {
@@ -38,20 +116,61 @@ void ConnectionWidget::syncControls(proxy::IConnectionSettingsBase* connection)
   if (rock) {
     core::rocksdb::Config config = rock->Info();
     createDBIfMissing_->setChecked(config.create_if_missing);
+    openMode_->setCurrentIndex(openMode_->findData(config.open_mode));
+    QString secondary_path;
+    if (common::ConvertFromString(config.secondary_path, &secondary_path)) {
+      secondaryPath_->setText(secondary_path);
+    }
+    blockCacheMb_->setValue(config.block_cache_size / kMb);
+    bloomBits_->setValue(config.bloom_bits_per_key);
+    maxOpenFiles_->setValue(config.max_open_files);
+    readaheadKb_->setValue(config.readahead_size / kKb);
+    enableStatistics_->setChecked(config.enable_statistics);
+    scanSnapshots_->setChecked(config.scan_snapshots);
   }
   ConnectionLocalWidget::syncControls(rock);
 }
 
 void ConnectionWidget::retranslateUi() {
   createDBIfMissing_->setText(trCreateDBIfMissing);
+  openModeLabel_->setText(trOpenMode);
+  openMode_->setItemText(0, trReadWrite);
+  openMode_->setItemText(1, trReadOnly);
+  openMode_->setItemText(2, trSecondary);
+  secondaryPathLabel_->setText(trSecondaryPath);
+  blockCacheLabel_->setText(trBlockCacheMb);
+  bloomBitsLabel_->setText(trBloomBits);
+  maxOpenFilesLabel_->setText(trMaxOpenFiles);
+  readaheadLabel_->setText(trReadaheadKb);
+  enableStatistics_->setText(trEnableStatistics);
+  scanSnapshots_->setText(trScanSnapshots);
   ConnectionLocalWidget::retranslateUi();
 }
 
+void ConnectionWidget::openModeChange(int index) {
+  QVariant var = openMode_->itemData(index);
+  core::rocksdb::OpenMode mode = static_cast<core::rocksdb::OpenMode>(var.toInt());
+  createDBIfMissing_->setEnabled(mode == core::rocksdb::OPEN_READ_WRITE);
+  secondaryPath_->setEnabled(mode == core::rocksdb::OPEN_SECONDARY);
+  maxOpenFiles_->setEnabled(mode != core::rocksdb::OPEN_SECONDARY);
+  scanSnapshots_->setEnabled(mode == core::rocksdb::OPEN_READ_WRITE);
+}
+
 proxy::IConnectionSettingsLocal* ConnectionWidget::createConnectionLocalImpl(
     const proxy::connection_path_t& path) const {
   proxy::rocksdb::ConnectionSettings* conn = new proxy::rocksdb::ConnectionSettings(path);
   core::rocksdb::Config config = conn->Info();
-  config.create_if_missing = createDBIfMissing_->isChecked();
+  QVariant var = openMode_->currentData();
+  config.open_mode = static_cast<core::rocksdb::OpenMode>(var.toInt());
+  config.create_if_missing =
+      config.open_mode == core::rocksdb::OPEN_READ_WRITE && createDBIfMissing_->isChecked();
+  config.secondary_path = common::ConvertToString(secondaryPath_->text());
+  config.block_cache_size = static_cast<size_t>(blockCacheMb_->value()) * kMb;
+  config.bloom_bits_per_key = bloomBits_->value();
+  config.max_open_files = maxOpenFiles_->value();
+  config.readahead_size = static_cast<size_t>(readaheadKb_->value()) * kKb;
+  config.enable_statistics = enableStatistics_->isChecked();
+  config.scan_snapshots = scanSnapshots_->isChecked();
   conn->SetInfo(config);
   return conn;
 }
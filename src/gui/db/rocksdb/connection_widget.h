@@ -22,6 +22,11 @@
 
 #include "gui/widgets/connection_local_widget.h"
 
+class QComboBox;
+class QLabel;
+class QLineEdit;
+class QSpinBox;
+
 namespace fastonosql {
 namespace gui {
 namespace rocksdb {
@@ -38,7 +43,26 @@ class ConnectionWidget : public ConnectionLocalWidget {
   virtual proxy::IConnectionSettingsLocal* createConnectionLocalImpl(
       const proxy::connection_path_t& path) const override;
 
+ private Q_SLOTS:
+  void openModeChange(int index);
+
+ private:
   QCheckBox* createDBIfMissing_;
+
+  QLabel* openModeLabel_;
+  QComboBox* openMode_;
+  QLabel* secondaryPathLabel_;
+  QLineEdit* secondaryPath_;
+  QLabel* blockCacheLabel_;
+  QSpinBox* blockCacheMb_;
+  QLabel* bloomBitsLabel_;
+  QSpinBox* bloomBits_;
+  QLabel* maxOpenFilesLabel_;
+  QSpinBox* maxOpenFiles_;
+  QLabel* readaheadLabel_;
+  QSpinBox* readaheadKb_;
+  QCheckBox* enableStatistics_;
+  QCheckBox* scanSnapshots_;
 };
 
 }  // namespace rocksdb
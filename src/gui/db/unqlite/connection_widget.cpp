@@ -19,11 +19,19 @@
 #include "gui/db/unqlite/connection_widget.h"
 
 #include <QCheckBox>
+#include <QHBoxLayout>
+#include <QLabel>
+#include <QSpinBox>
 
 #include "proxy/db/unqlite/connection_settings.h"
 
 #include "proxy/connection_settings/iconnection_settings_local.h"
 
+namespace {
+const QString trInMemoryDB = QObject::tr("In-memory database (" UNQLITE_IN_MEMORY_DB_NAME ")");
+const QString trPageCache = QObject::tr("Max cached pages (0 - default):");
+}  // namespace
+
 namespace fastonosql {
 namespace gui {
 namespace unqlite {
@@ -38,6 +46,18 @@ ConnectionWidget::ConnectionWidget(QWidget* parent)
   VERIFY(connect(readOnlyDB_, &QCheckBox::stateChanged, this,
                  &ConnectionWidget::readOnlyDBStateChange));
   addWidget(readOnlyDB_);
+  inMemoryDB_ = new QCheckBox;
+  VERIFY(connect(inMemoryDB_, &QCheckBox::stateChanged, this,
+                 &ConnectionWidget::inMemoryDBStateChange));
+  addWidget(inMemoryDB_);
+
+  QHBoxLayout* cache_layout = new QHBoxLayout;
+  pageCacheLabel_ = new QLabel;
+  pageCache_ = new QSpinBox;
+  pageCache_->setRange(0, INT32_MAX);
+  cache_layout->addWidget(pageCacheLabel_);
+  cache_layout->addWidget(pageCache_);
+  addLayout(cache_layout);
 }
 
 void ConnectionWidget::syncControls(proxy::IConnectionSettingsBase* connection) {
@@ -47,6 +67,8 @@ void ConnectionWidget::syncControls(proxy::IConnectionSettingsBase* connection)
     core::unqlite::Config config = unq->Info();
     createDBIfMissing_->setChecked(config.CreateIfMissingDB());
     readOnlyDB_->setChecked(config.ReadOnlyDB());
+    inMemoryDB_->setChecked(config.InMemoryDB());
+    pageCache_->setValue(config.max_page_cache);
   }
   ConnectionLocalWidget::syncControls(unq);
 }
@@ -54,6 +76,8 @@ void ConnectionWidget::syncControls(proxy::IConnectionSettingsBase* connection)
 void ConnectionWidget::retranslateUi() {
   createDBIfMissing_->setText(trCreateDBIfMissing);
   readOnlyDB_->setText(trReadOnlyDB);
+  inMemoryDB_->setText(trInMemoryDB);
+  pageCacheLabel_->setText(trPageCache);
   ConnectionLocalWidget::retranslateUi();
 }
 
@@ -65,12 +89,19 @@ void ConnectionWidget::readOnlyDBStateChange(int state) {
   createDBIfMissing_->setEnabled(!state);
 }
 
+void ConnectionWidget::inMemoryDBStateChange(int state) {
+  createDBIfMissing_->setEnabled(!state && !readOnlyDB_->isChecked());
+  readOnlyDB_->setEnabled(!state && !createDBIfMissing_->isChecked());
+}
+
 proxy::IConnectionSettingsLocal* ConnectionWidget::createConnectionLocalImpl(
     const proxy::connection_path_t& path) const {
   proxy::unqlite::ConnectionSettings* conn = new proxy::unqlite::ConnectionSettings(path);
   core::unqlite::Config config = conn->Info();
   config.SetCreateIfMissingDB(createDBIfMissing_->isChecked());
-  config.SetReadOnlyDB(readOnlyDB_->isChecked());
+  config.SetReadOnlyDB(readOnlyDB_->isChecked() && !inMemoryDB_->isChecked());
+  config.SetInMemoryDB(inMemoryDB_->isChecked());
+  config.max_page_cache = pageCache_->value();
   conn->SetInfo(config);
   return conn;
 }
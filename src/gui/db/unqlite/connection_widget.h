@@ -22,6 +22,9 @@
 
 #include "gui/widgets/connection_local_widget.h"
 
+class QLabel;
+class QSpinBox;
+
 namespace fastonosql {
 namespace gui {
 namespace unqlite {
@@ -37,6 +40,7 @@ class ConnectionWidget : public ConnectionLocalWidget {
  private Q_SLOTS:
   void createDBStateChange(int state);
   void readOnlyDBStateChange(int state);
+  void inMemoryDBStateChange(int state);
 
  private:
   virtual proxy::IConnectionSettingsLocal* createConnectionLocalImpl(
@@ -44,6 +48,10 @@ class ConnectionWidget : public ConnectionLocalWidget {
 
   QCheckBox* createDBIfMissing_;
   QCheckBox* readOnlyDB_;
+  QCheckBox* inMemoryDB_;
+
+  QLabel* pageCacheLabel_;
+  QSpinBox* pageCache_;
 };
 
 }  // namespace unqlite
@@ -19,6 +19,8 @@
 #include "gui/db/upscaledb/connection_widget.h"
 
 #include <QCheckBox>
+#include <QComboBox>
+#include <QGridLayout>
 #include <QSpinBox>
 #include <QHBoxLayout>
 #include <QLabel>
@@ -29,6 +31,16 @@
 
 namespace {
 const QString trDefaultDb = QObject::tr("Default database:");
+const QString trCacheSizeMb = QObject::tr("Page cache size (MB):");
+const QString trPageSizeKb = QObject::tr("Page size of new database (KB, 0 - default):");
+const QString trKeyType = QObject::tr("Key type of new database:");
+const QString trKeySize = QObject::tr("Key size of new database (0 - unlimited):");
+const QString trCompression = QObject::tr("Record compression of new database:");
+const QString trBinary = QObject::tr("Binary");
+const QString trNone = QObject::tr("None");
+
+const size_t kKb = 1024;
+const size_t kMb = 1024 * 1024;
 }
 
 namespace fastonosql {
@@ -48,6 +60,48 @@ ConnectionWidget::ConnectionWidget(QWidget* parent)
   def_layout->addWidget(defaultDBLabel_);
   def_layout->addWidget(defaultDBNum_);
   addLayout(def_layout);
+
+  QGridLayout* options_layout = new QGridLayout;
+  cacheSizeLabel_ = new QLabel;
+  cacheSizeMb_ = new QSpinBox;
+  cacheSizeMb_->setRange(0, INT32_MAX);
+  options_layout->addWidget(cacheSizeLabel_, 0, 0);
+  options_layout->addWidget(cacheSizeMb_, 0, 1);
+
+  pageSizeLabel_ = new QLabel;
+  pageSizeKb_ = new QSpinBox;
+  pageSizeKb_->setRange(0, 64);
+  options_layout->addWidget(pageSizeLabel_, 1, 0);
+  options_layout->addWidget(pageSizeKb_, 1, 1);
+
+  keyTypeLabel_ = new QLabel;
+  keyType_ = new QComboBox;
+  keyType_->addItem(QString(), core::upscaledb::KEY_BINARY);
+  keyType_->addItem("uint8", core::upscaledb::KEY_UINT8);
+  keyType_->addItem("uint16", core::upscaledb::KEY_UINT16);
+  keyType_->addItem("uint32", core::upscaledb::KEY_UINT32);
+  keyType_->addItem("uint64", core::upscaledb::KEY_UINT64);
+  options_layout->addWidget(keyTypeLabel_, 2, 0);
+  options_layout->addWidget(keyType_, 2, 1);
+
+  keySizeLabel_ = new QLabel;
+  keySize_ = new QSpinBox;
+  keySize_->setRange(0, UINT16_MAX - 1);
+  options_layout->addWidget(keySizeLabel_, 3, 0);
+  options_layout->addWidget(keySize_, 3, 1);
+
+  compressionLabel_ = new QLabel;
+  compression_ = new QComboBox;
+  compression_->addItem(QString(), core::upscaledb::COMPRESSION_NONE);
+  compression_->addItem("zlib", core::upscaledb::COMPRESSION_ZLIB);
+  compression_->addItem("snappy", core::upscaledb::COMPRESSION_SNAPPY);
+  compression_->addItem("lzf", core::upscaledb::COMPRESSION_LZF);
+  options_layout->addWidget(compressionLabel_, 4, 0);
+  options_layout->addWidget(compression_, 4, 1);
+  addLayout(options_layout);
+
+  core::upscaledb::Config def;
+  cacheSizeMb_->setValue(def.cache_size / kMb);
 }
 
 void ConnectionWidget::syncControls(proxy::IConnectionSettingsBase* connection) {
@@ -57,6 +111,11 @@ void ConnectionWidget::syncControls(proxy::IConnectionSettingsBase* connection)
     core::upscaledb::Config config = ups->Info();
     createDBIfMissing_->setChecked(config.create_if_missing);
     defaultDBNum_->setValue(config.dbnum);
+    cacheSizeMb_->setValue(config.cache_size / kMb);
+    pageSizeKb_->setValue(config.page_size / kKb);
+    keyType_->setCurrentIndex(keyType_->findData(config.key_type));
+    keySize_->setValue(config.key_size);
+    compression_->setCurrentIndex(compression_->findData(config.record_compression));
   }
   ConnectionLocalWidget::syncControls(ups);
 }
@@ -64,6 +123,13 @@ void ConnectionWidget::syncControls(proxy::IConnectionSettingsBase* connection)
 void ConnectionWidget::retranslateUi() {
   createDBIfMissing_->setText(trCreateDBIfMissing);
   defaultDBLabel_->setText(trDefaultDb);
+  cacheSizeLabel_->setText(trCacheSizeMb);
+  pageSizeLabel_->setText(trPageSizeKb);
+  keyTypeLabel_->setText(trKeyType);
+  keyType_->setItemText(0, trBinary);
+  keySizeLabel_->setText(trKeySize);
+  compressionLabel_->setText(trCompression);
+  compression_->setItemText(0, trNone);
   ConnectionLocalWidget::retranslateUi();
 }
 
@@ -73,6 +139,12 @@ proxy::IConnectionSettingsLocal* ConnectionWidget::createConnectionLocalImpl(
   core::upscaledb::Config config = conn->Info();
   config.create_if_missing = createDBIfMissing_->isChecked();
   config.dbnum = defaultDBNum_->value();
+  config.cache_size = static_cast<size_t>(cacheSizeMb_->value()) * kMb;
+  config.page_size = static_cast<uint32_t>(pageSizeKb_->value()) * kKb;
+  config.key_type = static_cast<core::upscaledb::KeyType>(keyType_->currentData().toInt());
+  config.key_size = keySize_->value();
+  config.record_compression =
+      static_cast<core::upscaledb::RecordCompression>(compression_->currentData().toInt());
   conn->SetInfo(config);
   return conn;
 }
@@ -22,6 +22,10 @@
 
 #include "gui/widgets/connection_local_widget.h"
 
+class QComboBox;
+class QLabel;
+class QSpinBox;
+
 namespace fastonosql {
 namespace gui {
 namespace upscaledb {
@@ -42,6 +46,17 @@ class ConnectionWidget : public ConnectionLocalWidget {
 
   QLabel* defaultDBLabel_;
   QSpinBox* defaultDBNum_;
+
+  QLabel* cacheSizeLabel_;
+  QSpinBox* cacheSizeMb_;
+  QLabel* pageSizeLabel_;
+  QSpinBox* pageSizeKb_;
+  QLabel* keyTypeLabel_;
+  QComboBox* keyType_;
+  QLabel* keySizeLabel_;
+  QSpinBox* keySize_;
+  QLabel* compressionLabel_;
+  QComboBox* compression_;
 };
 
 }  // namespace upscaledb
@@ -185,7 +185,10 @@ const QString trMemcachedTextServerTemplate = QObject::tr(
     "Bytes read: %19<br/>"
     "Bytes written: %20<br/>"
     "Limit max bytes: %21<br/>"
-    "Threads: %22");
+    "Threads: %22<br/>"
+    "Hit ratio: %23%");
+
+const QString trMemcachedTextNodesTemplate = QObject::tr("<br/><b>Nodes:</b><br/>%1");
 
 const QString trSsdbTextServerTemplate = QObject::tr(
     "<b>Common:</b><br/>"
@@ -209,7 +212,16 @@ const QString trRocksdbTextServerTemplate = QObject::tr(
     "File size mb: %2<br/>"
     "Time sec: %3<br/>"
     "Read mb: %4<br/>"
-    "Write mb: %5");
+    "Write mb: %5<br/>"
+    "<b>Internals:</b><br/>"
+    "Block cache hit rate: %6%<br/>"
+    "Bloom filter useful: %7<br/>"
+    "Stall micros: %8<br/>"
+    "Compaction read mb: %9<br/>"
+    "Compaction write mb: %10<br/>"
+    "Get p99 micros: %11<br/>"
+    "L0 files: %12<br/>"
+    "Pending compaction mb: %13");
 
 const QString trUnqliteTextServerTemplate = QObject::tr(
     "<b>Stats:</b><br/>"
@@ -217,7 +229,18 @@ const QString trUnqliteTextServerTemplate = QObject::tr(
 
 const QString trLmdbTextServerTemplate = QObject::tr(
     "<b>Stats:</b><br/>"
-    "Db path: %1<br/>");
+    "Db path: %1<br/>"
+    "Map size: %2<br/>"
+    "Map used: %3<br/>"
+    "Last txnid: %4<br/>"
+    "Readers: %5 of %6<br/>"
+    "<b>Selected database:</b><br/>"
+    "Page size: %7<br/>"
+    "Tree depth: %8<br/>"
+    "Branch pages: %9<br/>"
+    "Leaf pages: %10<br/>"
+    "Overflow pages: %11<br/>"
+    "Entries: %12");
 
 const QString trUpscaledbTextServerTemplate = QObject::tr(
     "<b>Stats:</b><br/>"
@@ -529,6 +552,8 @@ void InfoServerDialog::updateText(const core::memcached::ServerInfo& serv) {
   core::memcached::ServerInfo::Stats com = serv.stats_;
   QString qverson;
   common::ConvertFromString(com.version, &qverson);
+  const double gets = static_cast<double>(com.get_hits) + com.get_misses;
+  const double hit_ratio = gets ? com.get_hits * 100.0 / gets : 0.0;
 
   QString textServ = trMemcachedTextServerTemplate.arg(com.pid)
                          .arg(com.uptime)
@@ -551,7 +576,16 @@ void InfoServerDialog::updateText(const core::memcached::ServerInfo& serv) {
                          .arg(com.bytes_read)
                          .arg(com.bytes_written)
                          .arg(com.limit_maxbytes)
-                         .arg(com.threads);
+                         .arg(com.threads)
+                         .arg(hit_ratio, 0, 'f', 2);
+
+  // pool connections have summary line of every node
+  if (!com.nodes.empty()) {
+    QString qnodes;
+    common::ConvertFromString(com.nodes, &qnodes);
+    qnodes.replace(MEMCACHED_NODES_SEPARATOR, "<br/>");
+    textServ += trMemcachedTextNodesTemplate.arg(qnodes);
+  }
 
   serverTextInfo_->setText(textServ);
 }
@@ -590,11 +624,20 @@ void InfoServerDialog::updateText(const core::leveldb::ServerInfo& serv) {
 #ifdef BUILD_WITH_ROCKSDB
 void InfoServerDialog::updateText(const core::rocksdb::ServerInfo& serv) {
   core::rocksdb::ServerInfo::Stats stats = serv.stats_;
+  core::rocksdb::ServerInfo::Internals internals = serv.internals_;
   QString textServ = trRocksdbTextServerTemplate.arg(stats.compactions_level)
                          .arg(stats.file_size_mb)
                          .arg(stats.time_sec)
                          .arg(stats.read_mb)
-                         .arg(stats.write_mb);
+                         .arg(stats.write_mb)
+                         .arg(internals.block_cache_hit_rate)
+                         .arg(internals.bloom_filter_useful)
+                         .arg(internals.stall_micros)
+                         .arg(internals.compact_read_mb)
+                         .arg(internals.compact_write_mb)
+                         .arg(internals.get_p99_micros)
+                         .arg(internals.l0_files)
+                         .arg(internals.pending_compaction_mb);
 
   serverTextInfo_->setText(textServ);
 }
@@ -615,7 +658,18 @@ void InfoServerDialog::updateText(const core::lmdb::ServerInfo& serv) {
   QString qdb_path;
   common::ConvertFromString(stats.db_path, &qdb_path);
 
-  QString textServ = trLmdbTextServerTemplate.arg(qdb_path);
+  QString textServ = trLmdbTextServerTemplate.arg(qdb_path)
+                         .arg(stats.map_size)
+                         .arg(stats.map_used)
+                         .arg(stats.last_txnid)
+                         .arg(stats.num_readers)
+                         .arg(stats.max_readers)
+                         .arg(stats.page_size)
+                         .arg(stats.tree_depth)
+                         .arg(stats.branch_pages)
+                         .arg(stats.leaf_pages)
+                         .arg(stats.overflow_pages)
+                         .arg(stats.entries);
   serverTextInfo_->setText(textServ);
 }
 #endif
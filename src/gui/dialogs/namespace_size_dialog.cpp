@@ -0,0 +1,174 @@
+/*  Copyright (C) 2014-2016 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "gui/dialogs/namespace_size_dialog.h"
+
+#include <QHeaderView>
+#include <QLabel>
+#include <QTreeWidget>
+#include <QVBoxLayout>
+
+#include <common/convert2string.h>  // for ConvertFromString
+#include <common/error.h>           // for Error
+#include <common/macros.h>          // for VERIFY, UNUSED, CHECK
+
+#include <common/qt/gui/glass_widget.h>  // for GlassWidget
+
+#include "core/connection_types.h"  // for connectionTypes
+#include "core/namespace_size.h"    // for NamespaceSize, NamespaceSizeOptions
+#include "proxy/events/events_info.h"
+#include "proxy/server/iserver.h"  // for IServer
+
+#include "gui/gui_factory.h"  // for GuiFactory
+
+#include "translations/global.h"  // for trLoading
+
+namespace {
+const QString trNamespacesSizeTemplate_1S = QObject::tr("%1 namespaces size");
+const QString trNamespace = QObject::tr("Namespace");
+const QString trDiskBytes = QObject::tr("Disk, bytes");
+const QString trMemtableBytes = QObject::tr("Memtable, bytes");
+const QString trKeys = QObject::tr("Keys");
+const QString trExact = QObject::tr("Exact");
+const QString trWholeDatabase = QObject::tr("(database)");
+const QString trYes = QObject::tr("yes");
+const QString trNo = QObject::tr("no");
+const QString trEstimatedTemplate_1S = QObject::tr("Estimated in %1 msec");
+
+enum Columns {
+  NAMESPACE_COLUMN = 0,
+  DISK_BYTES_COLUMN,
+  MEMTABLE_BYTES_COLUMN,
+  KEYS_COLUMN,
+  EXACT_COLUMN,
+  COLUMNS_COUNT
+};
+
+// leveldb and rocksdb estimate ranges by index blocks, others walk keys
+bool IsRangeEstimatesSupported(fastonosql::core::connectionTypes type) {
+  return type == fastonosql::core::LEVELDB || type == fastonosql::core::ROCKSDB;
+}
+
+}  // namespace
+
+namespace fastonosql {
+namespace gui {
+
+NamespaceSizeDialog::NamespaceSizeDialog(proxy::IServerSPtr server,
+                                         const std::vector<std::string>& namespaces,
+                                         QWidget* parent)
+    : QDialog(parent), server_(server), namespaces_(namespaces) {
+  CHECK(server_);
+
+  setWindowIcon(GuiFactory::Instance().icon(server->Type()));
+  setWindowFlags(windowFlags() & ~Qt::WindowContextHelpButtonHint);  // Remove help
+                                                                     // button (?)
+
+  sizes_ = new QTreeWidget;
+  sizes_->setColumnCount(COLUMNS_COUNT);
+  sizes_->setRootIsDecorated(false);
+  sizes_->setSortingEnabled(true);
+  sizes_->sortByColumn(DISK_BYTES_COLUMN, Qt::DescendingOrder);
+  sizes_->header()->setSectionResizeMode(NAMESPACE_COLUMN, QHeaderView::ResizeToContents);
+  sizes_->setColumnHidden(MEMTABLE_BYTES_COLUMN, server->Type() != core::ROCKSDB);
+  elapsed_ = new QLabel;
+
+  QVBoxLayout* mainL = new QVBoxLayout;
+  mainL->addWidget(sizes_);
+  mainL->addWidget(elapsed_);
+
+  setMinimumSize(QSize(min_width, min_height));
+  setLayout(mainL);
+
+  glassWidget_ =
+      new common::qt::gui::GlassWidget(GuiFactory::Instance().pathToLoadingGif(),
+                                       translations::trLoading, 0.5, QColor(111, 111, 100), this);
+
+  VERIFY(connect(server.get(), &proxy::IServer::EstimateNamespacesSizeStarted, this,
+                 &NamespaceSizeDialog::startEstimateNamespacesSize));
+  VERIFY(connect(server.get(), &proxy::IServer::EstimateNamespacesSizeFinished, this,
+                 &NamespaceSizeDialog::finishEstimateNamespacesSize));
+  retranslateUi();
+}
+
+void NamespaceSizeDialog::startEstimateNamespacesSize(
+    const proxy::events_info::EstimateNamespacesSizeInfoRequest& req) {
+  UNUSED(req);
+
+  glassWidget_->start();
+}
+
+void NamespaceSizeDialog::finishEstimateNamespacesSize(
+    const proxy::events_info::EstimateNamespacesSizeInfoResponce& res) {
+  glassWidget_->stop();
+  common::Error er = res.errorInfo();
+  if (er && er->IsError()) {
+    return;
+  }
+
+  sizes_->clear();
+  for (size_t i = 0; i < res.sizes.size(); ++i) {
+    const core::NamespaceSize& size = res.sizes[i];
+    QString name = trWholeDatabase;
+    if (!size.ns.empty()) {
+      common::ConvertFromString(size.ns, &name);
+    }
+
+    // numbers are stored as data, so columns are sorted by value
+    QTreeWidgetItem* item = new QTreeWidgetItem;
+    item->setText(NAMESPACE_COLUMN, name);
+    item->setData(DISK_BYTES_COLUMN, Qt::DisplayRole, static_cast<qulonglong>(size.disk_bytes));
+    item->setData(MEMTABLE_BYTES_COLUMN, Qt::DisplayRole,
+                  static_cast<qulonglong>(size.memtable_bytes));
+    if (size.keys) {
+      item->setData(KEYS_COLUMN, Qt::DisplayRole, static_cast<qulonglong>(size.keys));
+    }
+    item->setText(EXACT_COLUMN, size.exact ? trYes : trNo);
+    sizes_->addTopLevelItem(item);
+  }
+  elapsed_->setText(trEstimatedTemplate_1S.arg(res.elapsed_msec));
+}
+
+void NamespaceSizeDialog::changeEvent(QEvent* e) {
+  if (e->type() == QEvent::LanguageChange) {
+    retranslateUi();
+  }
+  QDialog::changeEvent(e);
+}
+
+void NamespaceSizeDialog::showEvent(QShowEvent* e) {
+  QDialog::showEvent(e);
+  core::NamespaceSizeOptions options;
+  options.sampled = !IsRangeEstimatesSupported(server_->Type());
+  proxy::events_info::EstimateNamespacesSizeInfoRequest req(this, namespaces_, options);
+  server_->EstimateNamespacesSize(req);
+}
+
+void NamespaceSizeDialog::retranslateUi() {
+  QString name;
+  if (common::ConvertFromString(server_->Name(), &name)) {
+    setWindowTitle(trNamespacesSizeTemplate_1S.arg(name));
+  }
+
+  sizes_->setHeaderLabels(QStringList() << trNamespace << trDiskBytes << trMemtableBytes << trKeys
+                                        << trExact);
+}
+
+}  // namespace gui
+}  // namespace fastonosql
@@ -0,0 +1,85 @@
+/*  Copyright (C) 2014-2016 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <string>  // for string
+#include <vector>  // for vector
+
+#include <QDialog>
+
+#include "proxy/proxy_fwd.h"  // for IServerSPtr
+
+class QEvent;
+class QLabel;
+class QShowEvent;
+class QTreeWidget;
+class QWidget;
+
+namespace common {
+namespace qt {
+namespace gui {
+class GlassWidget;
+}
+}
+}
+namespace fastonosql {
+namespace proxy {
+namespace events_info {
+struct EstimateNamespacesSizeInfoRequest;
+struct EstimateNamespacesSizeInfoResponce;
+}
+}
+}
+
+namespace fastonosql {
+namespace gui {
+
+// sizes of namespaces of explorer tree, engines without
+// range estimates walk keys of namespaces
+class NamespaceSizeDialog : public QDialog {
+  Q_OBJECT
+ public:
+  NamespaceSizeDialog(proxy::IServerSPtr server,
+                      const std::vector<std::string>& namespaces,
+                      QWidget* parent = 0);
+  enum { min_width = 480, min_height = 320 };
+
+ private Q_SLOTS:
+  void startEstimateNamespacesSize(
+      const proxy::events_info::EstimateNamespacesSizeInfoRequest& req);
+  void finishEstimateNamespacesSize(
+      const proxy::events_info::EstimateNamespacesSizeInfoResponce& res);
+
+ protected:
+  virtual void changeEvent(QEvent* e) override;
+  virtual void showEvent(QShowEvent* e) override;
+
+ private:
+  void retranslateUi();
+
+  common::qt::gui::GlassWidget* glassWidget_;
+  QTreeWidget* sizes_;
+  QLabel* elapsed_;
+  const proxy::IServerSPtr server_;
+  const std::vector<std::string> namespaces_;
+};
+
+}  // namespace gui
+}  // namespace fastonosql
@@ -0,0 +1,209 @@
+/*  Copyright (C) 2014-2016 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "gui/dialogs/namespace_stats_dialog.h"
+
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QTreeWidget>
+
+#include <common/convert2string.h>  // for ConvertFromString
+#include <common/error.h>           // for Error
+#include <common/macros.h>          // for VERIFY, UNUSED, CHECK
+#include <common/value.h>           // for Value::GetTypeName
+
+#include <common/qt/convert2string.h>    // for ConvertFromString
+#include <common/qt/gui/glass_widget.h>  // for GlassWidget
+
+#include "core/namespace_stats.h"  // for NamespaceNode, NamespaceStats
+#include "proxy/events/events_info.h"
+#include "proxy/server/iserver.h"  // for IServer
+
+#include "gui/gui_factory.h"  // for GuiFactory
+
+#include "translations/global.h"  // for trLoading
+
+namespace {
+const QString trNamespacesTemplate_1S = QObject::tr("%1 namespaces");
+const QString trNamespace = QObject::tr("Namespace");
+const QString trKeys = QObject::tr("Keys");
+const QString trKeysPercent = QObject::tr("Keys, %");
+const QString trValuesBytes = QObject::tr("Values, bytes");
+const QString trMaxValueBytes = QObject::tr("Max value, bytes");
+const QString trWithTTL = QObject::tr("With TTL");
+const QString trTypes = QObject::tr("Types");
+const QString trOther = QObject::tr("(other)");
+const QString trKeysWithoutNamespace = QObject::tr("(keys)");
+
+enum Columns {
+  NAMESPACE_COLUMN = 0,
+  KEYS_COLUMN,
+  KEYS_PERCENT_COLUMN,
+  VALUES_BYTES_COLUMN,
+  MAX_VALUE_BYTES_COLUMN,
+  WITH_TTL_COLUMN,
+  TYPES_COLUMN,
+  COLUMNS_COUNT
+};
+
+// numbers are stored as data, so columns are sorted by value
+class NamespaceItem : public QTreeWidgetItem {
+ public:
+  NamespaceItem(const QString& name,
+                const fastonosql::core::NamespaceStats& stats,
+                uint64_t total_keys)
+      : QTreeWidgetItem() {
+    setText(NAMESPACE_COLUMN, name);
+    setData(KEYS_COLUMN, Qt::DisplayRole, static_cast<qulonglong>(stats.keys));
+    double percent = total_keys ? stats.keys * 100.0 / total_keys : 0;
+    setData(KEYS_PERCENT_COLUMN, Qt::DisplayRole, qRound(percent * 100) / 100.0);
+    setData(VALUES_BYTES_COLUMN, Qt::DisplayRole, static_cast<qulonglong>(stats.total_bytes));
+    setData(MAX_VALUE_BYTES_COLUMN, Qt::DisplayRole, static_cast<qulonglong>(stats.max_bytes));
+    uint64_t with_ttl = stats.keys - stats.ttl_histogram[fastonosql::core::TTL_BUCKET_NONE];
+    setData(WITH_TTL_COLUMN, Qt::DisplayRole, static_cast<qulonglong>(with_ttl));
+
+    QStringList types;
+    for (auto it = stats.types.begin(); it != stats.types.end(); ++it) {
+      if (!it->second) {
+        continue;
+      }
+      QString type;
+      common::Value::Type value_type = static_cast<common::Value::Type>(it->first);
+      if (common::ConvertFromString(common::Value::GetTypeName(value_type), &type)) {
+        types.append(QString("%1: %2").arg(type).arg(it->second));
+      }
+    }
+    setText(TYPES_COLUMN, types.join(", "));
+  }
+};
+
+}  // namespace
+
+namespace fastonosql {
+namespace gui {
+
+NamespaceStatsDialog::NamespaceStatsDialog(proxy::IServerSPtr server, QWidget* parent)
+    : QDialog(parent), server_(server) {
+  CHECK(server_);
+
+  setWindowIcon(GuiFactory::Instance().icon(server->Type()));
+  setWindowFlags(windowFlags() & ~Qt::WindowContextHelpButtonHint);  // Remove help
+                                                                     // button (?)
+
+  namespaces_ = new QTreeWidget;
+  namespaces_->setColumnCount(COLUMNS_COUNT);
+  namespaces_->setSortingEnabled(true);
+  namespaces_->sortByColumn(KEYS_COLUMN, Qt::DescendingOrder);
+  namespaces_->header()->setSectionResizeMode(NAMESPACE_COLUMN, QHeaderView::ResizeToContents);
+
+  QHBoxLayout* mainL = new QHBoxLayout;
+  mainL->addWidget(namespaces_);
+
+  setMinimumSize(QSize(min_width, min_height));
+  setLayout(mainL);
+
+  glassWidget_ =
+      new common::qt::gui::GlassWidget(GuiFactory::Instance().pathToLoadingGif(),
+                                       translations::trLoading, 0.5, QColor(111, 111, 100), this);
+
+  VERIFY(connect(server.get(), &proxy::IServer::AnalyzeNamespacesStarted, this,
+                 &NamespaceStatsDialog::startAnalyzeNamespaces));
+  VERIFY(connect(server.get(), &proxy::IServer::AnalyzeNamespacesFinished, this,
+                 &NamespaceStatsDialog::finishAnalyzeNamespaces));
+  retranslateUi();
+}
+
+void NamespaceStatsDialog::startAnalyzeNamespaces(
+    const proxy::events_info::AnalyzeNamespacesInfoRequest& req) {
+  UNUSED(req);
+
+  glassWidget_->start();
+}
+
+void NamespaceStatsDialog::finishAnalyzeNamespaces(
+    const proxy::events_info::AnalyzeNamespacesInfoResponce& res) {
+  glassWidget_->stop();
+  common::Error er = res.errorInfo();
+  if (er && er->IsError()) {
+    return;
+  }
+
+  namespaces_->clear();
+  const core::NamespaceNode& root = res.tree.Root();
+  QString name;
+  common::ConvertFromString(server_->Name(), &name);
+  NamespaceItem* root_item = new NamespaceItem(name, root.stats, root.stats.keys);
+  namespaces_->addTopLevelItem(root_item);
+  addNode(root_item, root, root.stats.keys);
+  root_item->setExpanded(true);
+}
+
+void NamespaceStatsDialog::changeEvent(QEvent* e) {
+  if (e->type() == QEvent::LanguageChange) {
+    retranslateUi();
+  }
+  QDialog::changeEvent(e);
+}
+
+void NamespaceStatsDialog::showEvent(QShowEvent* e) {
+  QDialog::showEvent(e);
+  // engines without expiration have only keys without ttl
+  core::CopyOptions options;
+  options.with_ttl = server_->IsSupportTTLKeys();
+  proxy::events_info::AnalyzeNamespacesInfoRequest req(this, options,
+                                                       core::NamespaceTreeOptions());
+  server_->AnalyzeNamespaces(req);
+}
+
+void NamespaceStatsDialog::retranslateUi() {
+  QString name;
+  if (common::ConvertFromString(server_->Name(), &name)) {
+    setWindowTitle(trNamespacesTemplate_1S.arg(name));
+  }
+
+  namespaces_->setHeaderLabels(QStringList() << trNamespace << trKeys << trKeysPercent
+                                             << trValuesBytes << trMaxValueBytes << trWithTTL
+                                             << trTypes);
+}
+
+void NamespaceStatsDialog::addNode(QTreeWidgetItem* parent,
+                                   const core::NamespaceNode& node,
+                                   uint64_t total_keys) {
+  for (auto it = node.children.begin(); it != node.children.end(); ++it) {
+    const core::NamespaceNode& child = *it->second;
+    QString name;
+    common::ConvertFromString(child.name, &name);
+    NamespaceItem* item = new NamespaceItem(name, child.stats, total_keys);
+    parent->addChild(item);
+    addNode(item, child, total_keys);
+  }
+
+  if (node.other.keys) {
+    parent->addChild(new NamespaceItem(trOther, node.other, total_keys));
+  }
+
+  // keys of namespace itself are shown only next to subnamespaces
+  core::NamespaceStats direct = node.DirectKeys();
+  if (direct.keys && parent->childCount()) {
+    parent->addChild(new NamespaceItem(trKeysWithoutNamespace, direct, total_keys));
+  }
+}
+
+}  // namespace gui
+}  // namespace fastonosql
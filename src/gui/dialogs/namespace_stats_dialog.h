@@ -0,0 +1,81 @@
+/*  Copyright (C) 2014-2016 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <stdint.h>  // for uint64_t
+
+#include <QDialog>
+
+#include "proxy/proxy_fwd.h"  // for IServerSPtr
+
+class QEvent;
+class QShowEvent;
+class QTreeWidget;
+class QTreeWidgetItem;
+class QWidget;
+
+namespace common {
+namespace qt {
+namespace gui {
+class GlassWidget;
+}
+}
+}
+namespace fastonosql {
+namespace core {
+struct NamespaceNode;
+}
+namespace proxy {
+namespace events_info {
+struct AnalyzeNamespacesInfoRequest;
+struct AnalyzeNamespacesInfoResponce;
+}
+}
+}
+
+namespace fastonosql {
+namespace gui {
+
+// table of namespaces sortable by any column
+class NamespaceStatsDialog : public QDialog {
+  Q_OBJECT
+ public:
+  explicit NamespaceStatsDialog(proxy::IServerSPtr server, QWidget* parent = 0);
+  enum { min_width = 640, min_height = 480 };
+
+ private Q_SLOTS:
+  void startAnalyzeNamespaces(const proxy::events_info::AnalyzeNamespacesInfoRequest& req);
+  void finishAnalyzeNamespaces(const proxy::events_info::AnalyzeNamespacesInfoResponce& res);
+
+ protected:
+  virtual void changeEvent(QEvent* e) override;
+  virtual void showEvent(QShowEvent* e) override;
+
+ private:
+  void retranslateUi();
+  void addNode(QTreeWidgetItem* parent, const core::NamespaceNode& node, uint64_t total_keys);
+
+  common::qt::gui::GlassWidget* glassWidget_;
+  QTreeWidget* namespaces_;
+  const proxy::IServerSPtr server_;
+};
+
+}  // namespace gui
+}  // namespace fastonosql
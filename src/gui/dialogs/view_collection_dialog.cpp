@@ -0,0 +1,97 @@
+/*  Copyright (C) 2014-2016 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "gui/dialogs/view_collection_dialog.h"
+
+#include <QDialogButtonBox>
+#include <QEvent>
+#include <QHeaderView>
+#include <QLabel>
+#include <QTableView>
+#include <QVBoxLayout>
+
+#include <common/macros.h>  // for VERIFY
+
+#include "gui/collection_table_model.h"  // for CollectionTableModel
+
+namespace {
+const QString trLoadedOfTemplate_2S = QObject::tr("Loaded %1 of %2");
+}
+
+namespace fastonosql {
+namespace gui {
+
+ViewCollectionDialog::ViewCollectionDialog(const QString& title,
+                                           proxy::IServerSPtr server,
+                                           const core::NKey& key,
+                                           common::Value::Type type,
+                                           QWidget* parent)
+    : QDialog(parent) {
+  setWindowTitle(title);
+  setWindowFlags(windowFlags() & ~Qt::WindowContextHelpButtonHint);  // Remove help
+                                                                     // button (?)
+
+  model_ = new CollectionTableModel(server, key, type, CollectionTableModel::default_chunk_size,
+                                    this);
+  VERIFY(connect(model_, &CollectionTableModel::totalCountChanged, this,
+                 &ViewCollectionDialog::updateCountLabel));
+  VERIFY(connect(model_, &CollectionTableModel::loadedCountChanged, this,
+                 &ViewCollectionDialog::updateCountLabel));
+
+  countLabel_ = new QLabel;
+
+  // view calls fetchMore while scrolling to the last row
+  valuesTable_ = new QTableView;
+  valuesTable_->setModel(model_);
+  valuesTable_->horizontalHeader()->setStretchLastSection(true);
+  valuesTable_->setSelectionBehavior(QAbstractItemView::SelectRows);
+
+  QDialogButtonBox* buttonBox = new QDialogButtonBox(QDialogButtonBox::Close);
+  buttonBox->setOrientation(Qt::Horizontal);
+  VERIFY(connect(buttonBox, &QDialogButtonBox::rejected, this, &ViewCollectionDialog::reject));
+
+  QVBoxLayout* mainlayout = new QVBoxLayout;
+  mainlayout->addWidget(countLabel_);
+  mainlayout->addWidget(valuesTable_);
+  mainlayout->addWidget(buttonBox);
+  setLayout(mainlayout);
+  setMinimumSize(QSize(min_width, min_height));
+
+  retranslateUi();
+  if (model_->canFetchMore(QModelIndex())) {
+    model_->fetchMore(QModelIndex());
+  }
+}
+
+void ViewCollectionDialog::updateCountLabel() {
+  countLabel_->setText(trLoadedOfTemplate_2S.arg(model_->loadedCount()).arg(model_->totalCount()));
+}
+
+void ViewCollectionDialog::changeEvent(QEvent* e) {
+  if (e->type() == QEvent::LanguageChange) {
+    retranslateUi();
+  }
+  QDialog::changeEvent(e);
+}
+
+void ViewCollectionDialog::retranslateUi() {
+  updateCountLabel();
+}
+
+}  // namespace gui
+}  // namespace fastonosql
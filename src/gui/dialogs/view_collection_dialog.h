@@ -0,0 +1,70 @@
+/*  Copyright (C) 2014-2016 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <stddef.h>  // for size_t
+
+#include <QDialog>
+
+#include <common/value.h>  // for Value::Type
+
+#include "core/db_key.h"      // for NKey
+#include "proxy/proxy_fwd.h"  // for IServerSPtr
+
+class QEvent;
+class QLabel;
+class QTableView;
+class QWidget;
+
+namespace fastonosql {
+namespace gui {
+class CollectionTableModel;
+}
+}
+
+namespace fastonosql {
+namespace gui {
+
+class ViewCollectionDialog : public QDialog {
+  Q_OBJECT
+ public:
+  enum { min_width = 480, min_height = 320 };
+
+  ViewCollectionDialog(const QString& title,
+                       proxy::IServerSPtr server,
+                       const core::NKey& key,
+                       common::Value::Type type,
+                       QWidget* parent = 0);
+
+ private Q_SLOTS:
+  void updateCountLabel();
+
+ protected:
+  virtual void changeEvent(QEvent* ev) override;
+
+ private:
+  void retranslateUi();
+
+  QLabel* countLabel_;
+  QTableView* valuesTable_;
+  CollectionTableModel* model_;
+};
+
+}  // namespace gui
+}  // namespace fastonosql
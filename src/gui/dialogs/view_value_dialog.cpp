@@ -0,0 +1,112 @@
+/*  Copyright (C) 2014-2016 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "gui/dialogs/view_value_dialog.h"
+
+#include <QDialogButtonBox>
+#include <QEvent>
+#include <QLabel>
+#include <QVBoxLayout>
+
+#include <common/macros.h>  // for VERIFY
+
+#include "proxy/events/events_info.h"  // for LoadValueSourceRequest, etc
+#include "proxy/server/iserver.h"      // for IServer
+
+#include "gui/editor/fasto_hex_edit.h"  // for FastoHexEdit
+
+namespace {
+const QString trLoadingValue = QObject::tr("Loading value...");
+const QString trValueSizeTemplate_1S = QObject::tr("Size: %1 bytes");
+const QString trCannotOpenValue = QObject::tr("Can't open value");
+}
+
+namespace fastonosql {
+namespace gui {
+
+ViewValueDialog::ViewValueDialog(const QString& title,
+                                 proxy::IServerSPtr server,
+                                 const core::NKey& key,
+                                 QWidget* parent)
+    : QDialog(parent), key_(key), pending_(true), size_(-1) {
+  CHECK(server);
+  setWindowTitle(title);
+  setWindowFlags(windowFlags() & ~Qt::WindowContextHelpButtonHint);  // Remove help
+                                                                     // button (?)
+
+  VERIFY(connect(server.get(), &proxy::IServer::LoadValueSourceFinished, this,
+                 &ViewValueDialog::finishLoadValueSource));
+
+  sizeLabel_ = new QLabel;
+  valueView_ = new FastoHexEdit;
+  valueView_->setMode(FastoHexEdit::HEX_MODE);
+
+  QDialogButtonBox* buttonBox = new QDialogButtonBox(QDialogButtonBox::Close);
+  buttonBox->setOrientation(Qt::Horizontal);
+  VERIFY(connect(buttonBox, &QDialogButtonBox::rejected, this, &ViewValueDialog::reject));
+
+  QVBoxLayout* mainlayout = new QVBoxLayout;
+  mainlayout->addWidget(sizeLabel_);
+  mainlayout->addWidget(valueView_);
+  mainlayout->addWidget(buttonBox);
+  setLayout(mainlayout);
+  setMinimumSize(QSize(min_width, min_height));
+
+  retranslateUi();
+  proxy::events_info::LoadValueSourceRequest req(this, key_);
+  server->LoadValueSource(req);
+}
+
+void ViewValueDialog::finishLoadValueSource(
+    const proxy::events_info::LoadValueSourceResponce& res) {
+  // server is shared, skip sources requested by other views
+  if (!pending_ || res.key.Key() != key_.Key()) {
+    return;
+  }
+
+  pending_ = false;
+  common::Error er = res.errorInfo();
+  if (er && er->IsError()) {
+    retranslateUi();
+    return;
+  }
+
+  size_ = res.source->Size();
+  valueView_->setSource(res.source);
+  retranslateUi();
+}
+
+void ViewValueDialog::changeEvent(QEvent* e) {
+  if (e->type() == QEvent::LanguageChange) {
+    retranslateUi();
+  }
+  QDialog::changeEvent(e);
+}
+
+void ViewValueDialog::retranslateUi() {
+  if (pending_) {
+    sizeLabel_->setText(trLoadingValue);
+  } else if (size_ < 0) {
+    sizeLabel_->setText(trCannotOpenValue);
+  } else {
+    sizeLabel_->setText(trValueSizeTemplate_1S.arg(size_));
+  }
+}
+
+}  // namespace gui
+}  // namespace fastonosql
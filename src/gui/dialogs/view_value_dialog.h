@@ -0,0 +1,72 @@
+/*  Copyright (C) 2014-2016 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <QDialog>
+
+#include "core/db_key.h"      // for NKey
+#include "proxy/proxy_fwd.h"  // for IServerSPtr
+
+class QEvent;
+class QLabel;
+class QWidget;
+
+namespace fastonosql {
+namespace proxy {
+namespace events_info {
+struct LoadValueSourceResponce;
+}
+}
+namespace gui {
+class FastoHexEdit;
+}
+}
+
+namespace fastonosql {
+namespace gui {
+
+// value isn't loaded into dialog, hex view reads visible part from server's value source
+class ViewValueDialog : public QDialog {
+  Q_OBJECT
+ public:
+  enum { min_width = 640, min_height = 480 };
+
+  ViewValueDialog(const QString& title,
+                  proxy::IServerSPtr server,
+                  const core::NKey& key,
+                  QWidget* parent = 0);
+
+ private Q_SLOTS:
+  void finishLoadValueSource(const proxy::events_info::LoadValueSourceResponce& res);
+
+ protected:
+  virtual void changeEvent(QEvent* ev) override;
+
+ private:
+  void retranslateUi();
+
+  const core::NKey key_;
+  bool pending_;
+  qint64 size_;
+  QLabel* sizeLabel_;
+  FastoHexEdit* valueView_;
+};
+
+}  // namespace gui
+}  // namespace fastonosql
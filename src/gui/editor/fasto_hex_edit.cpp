@@ -23,10 +23,15 @@
 #include <QPainter>
 #include <QScrollBar>
 
-#include <common/macros.h>  // for UNUSED, NOTREACHED
+#include <algorithm>  // for min
+#include <limits>     // for numeric_limits
+
+#include <common/macros.h>             // for UNUSED, NOTREACHED
+#include <common/qt/convert2string.h>  // for ConvertFromString
 
 namespace {
 const QColor selectedColor = QColor(0x6d, 0x9e, 0xff, 0xff);
+const QString trCantReadValue = QObject::tr("Can't read value: %1");
 }
 
 namespace fastonosql {
@@ -56,6 +61,7 @@ void FastoHexEdit::setMode(DisplayMode mode) {
 }
 
 void FastoHexEdit::setData(const QByteArray& arr) {
+  source_.reset();
   if (mode_ == HEX_MODE) {
     verticalScrollBar()->setValue(0);
     data_ = arr;
@@ -67,15 +73,43 @@ void FastoHexEdit::setData(const QByteArray& arr) {
   }
 }
 
+void FastoHexEdit::setSource(core::byte_source_t source) {
+  setMode(HEX_MODE);
+  verticalScrollBar()->setValue(0);
+  data_.clear();
+  source_ = source;
+  viewport()->update();
+}
+
 void FastoHexEdit::clear() {
   if (mode_ == HEX_MODE) {
     verticalScrollBar()->setValue(0);
   }
 
   data_.clear();
+  source_.reset();
   base_class::clear();
 }
 
+qint64 FastoHexEdit::dataSize() const {
+  if (source_) {
+    return source_->Size();
+  }
+
+  return data_.size();
+}
+
+QByteArray FastoHexEdit::bytesAt(qint64 offset, qint64 count) const {
+  if (!source_) {
+    return data_.mid(offset, count);
+  }
+
+  QByteArray part(count, 0);
+  size_t read = source_->Read(offset, part.data(), count);
+  part.resize(read);
+  return part;
+}
+
 int FastoHexEdit::charWidth() const {
   return fontMetrics().averageCharWidth() + 1;
 }
@@ -107,15 +141,15 @@ QSize FastoHexEdit::fullSize() const {
 
   int acharInLine = asciiCharInLine(widchars);
 
+  const qint64 size = dataSize();
   int width = xPosAscii + (acharInLine * charW);
-  int height = data_.size() / acharInLine;
-  if (data_.size() % acharInLine) {
+  qint64 height = size / acharInLine;
+  if (size % acharInLine) {
     height++;
   }
 
-  height *= charH;
-
-  return QSize(width, height);
+  height = std::min<qint64>(height * charH, std::numeric_limits<int>::max());
+  return QSize(width, static_cast<int>(height));
 }
 
 void FastoHexEdit::paintEvent(QPaintEvent* event) {
@@ -149,10 +183,11 @@ void FastoHexEdit::paintEvent(QPaintEvent* event) {
     const int xPosAscii = widchars / 4 * 3;  // line pos
     const int xPosAsciiStart = xPosAscii + TextMarginXY;
 
-    int indexCount = data_.size() / acharInLine;
+    const qint64 size = dataSize();
+    qint64 indexCount = size / acharInLine;
     if (lastLineIdx > indexCount) {
-      lastLineIdx = indexCount;
-      if (data_.size() % acharInLine) {
+      lastLineIdx = static_cast<int>(indexCount);
+      if (size % acharInLine) {
         lastLineIdx++;
       }
     }
@@ -164,17 +199,28 @@ void FastoHexEdit::paintEvent(QPaintEvent* event) {
 
     painter.setPen(Qt::black);
 
-    int size = data_.size();
+    // only visible lines are read
+    const qint64 firstOffset = static_cast<qint64>(firstLineIdx) * acharInLine;
+    const QByteArray visible =
+        lastLineIdx > firstLineIdx
+            ? bytesAt(firstOffset, static_cast<qint64>(lastLineIdx - firstLineIdx) * acharInLine)
+            : QByteArray();
+    const std::string read_error = source_ ? source_->LastError() : std::string();
+    if (!read_error.empty()) {
+      QString qerror;
+      common::ConvertFromString(read_error, &qerror);
+      painter.setPen(Qt::red);
+      painter.drawText(rect, Qt::AlignCenter, trCantReadValue.arg(qerror));
+      return;
+    }
+
     for (int lineIdx = firstLineIdx, yPos = yPosStart; lineIdx < lastLineIdx;
          lineIdx += 1, yPos += charH) {
-      QByteArray part = data_.begin() + (lineIdx * acharInLine);
-      int part_size = (size / acharInLine) ? acharInLine : size % acharInLine;
-      part.resize(part_size);
-      size -= part_size;
+      QByteArray part = visible.mid((lineIdx - firstLineIdx) * acharInLine, acharInLine);
       QByteArray hex = part.toHex();
 
       painter.setBackgroundMode(Qt::OpaqueMode);
-      for (int xPos = xPosStart, i = 0; i < hex.size(); i++, xPos += 3 * charW) {
+      for (int xPos = xPosStart, i = 0; i < part.size(); i++, xPos += 3 * charW) {
         QString val = hex.mid(i * 2, 2);
         QRect hexrect(xPos, yPos, 3 * charW, charH);
         painter.drawText(hexrect, Qt::AlignLeft, val);
@@ -21,6 +21,8 @@
 #include <QByteArray>
 #include <QTextEdit>
 
+#include "core/byte_source.h"  // for byte_source_t
+
 class QEvent;
 class QMouseEvent;
 class QPaintEvent;
@@ -48,6 +50,8 @@ class FastoHexEdit : public QTextEdit {
  public Q_SLOTS:
   void setMode(DisplayMode mode);
   void setData(const QByteArray& arr);
+  // hex mode reads only visible lines from source, so value isn't copied into widget
+  void setSource(core::byte_source_t source);
   void clear();
 
  protected:
@@ -61,8 +65,11 @@ class FastoHexEdit : public QTextEdit {
  private:
   static QRect stableRect(const QRect& rect);
   QSize fullSize() const;
+  qint64 dataSize() const;
+  QByteArray bytesAt(qint64 offset, qint64 count) const;
 
   QByteArray data_;
+  core::byte_source_t source_;
   DisplayMode mode_;
 
   bool in_selection_state_;
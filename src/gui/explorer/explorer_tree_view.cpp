@@ -26,6 +26,7 @@
 
 #include <QAction>
 #include <QFileDialog>
+#include <QFileInfo>
 #include <QHeaderView>
 #include <QInputDialog>
 #include <QMenu>
@@ -44,7 +45,10 @@
 #include <common/qt/gui/regexp_input_dialog.h>
 
 #include "core/connection_types.h"        // for connectionTypes::REDIS
+#include "core/copy_pipeline.h"           // for CopyOptions
 #include "core/db_key.h"                  // for NDbKValue
+#include "core/dump_file.h"               // for DumpOptions
+#include "core/import_reader.h"           // for ImportFormat
 #include "proxy/events/events_info.h"     // for CommandResponce, etc
 #include "proxy/cluster/icluster.h"       // for ICluster
 #include "proxy/sentinel/isentinel.h"     // for Sentinel, etc
@@ -56,8 +60,12 @@
 #include "gui/dialogs/history_server_dialog.h"  // for ServerHistoryDialog
 #include "gui/dialogs/info_server_dialog.h"     // for InfoServerDialog
 #include "gui/dialogs/load_contentdb_dialog.h"  // for LoadContentDbDialog
+#include "gui/dialogs/namespace_size_dialog.h"   // for NamespaceSizeDialog
+#include "gui/dialogs/namespace_stats_dialog.h"  // for NamespaceStatsDialog
 #include "gui/dialogs/property_server_dialog.h"
 #include "gui/dialogs/view_keys_dialog.h"  // for ViewKeysDialog
+#include "gui/dialogs/view_collection_dialog.h"  // for ViewCollectionDialog
+#include "gui/dialogs/view_value_dialog.h"       // for ViewValueDialog
 #include "gui/dialogs/pub_sub_dialog.h"
 #include "gui/explorer/explorer_tree_model.h"  // for ExplorerServerItem, etc
 #include "gui/explorer/explorer_tree_sort_filter_proxy_model.h"
@@ -71,13 +79,23 @@ const QString trEditKey_1S = QObject::tr("Edit key %1");
 const QString trRemoveBranch = QObject::tr("Remove branch");
 const QString trRemoveAllKeysTemplate_1S = QObject::tr("Really remove all keys from branch %1?");
 const QString trViewKeyTemplate_1S = QObject::tr("View key in %1 database");
+const QString trViewCollection = QObject::tr("View collection...");
+const QString trViewCollectionTemplate_1S = QObject::tr("View %1 collection");
+const QString trViewValue = QObject::tr("View value...");
+const QString trViewValueTemplate_1S = QObject::tr("View %1 value");
 const QString trViewChannelsTemplate_1S = QObject::tr("View channels in %1 server");
 const QString trConnectDisconnect = QObject::tr("Connect/Disconnect");
 const QString trClearDb = QObject::tr("Clear database");
+const QString trAnalyzeNamespaces = QObject::tr("Analyze namespaces...");
+const QString trEstimateNamespacesSize = QObject::tr("Estimate namespaces size...");
 const QString trRealyRemoveAllKeysTemplate_1S =
     QObject::tr("Really remove all keys from %1 database?");
 const QString trLoadContentTemplate_1S = QObject::tr("Load %1 content");
 const QString trReallyShutdownTemplate_1S = QObject::tr("Really shutdown \"%1\" server?");
+const QString trCompactAfterImport = QObject::tr("Compact database after import?");
+const QString trDumpKeys = QObject::tr("Dump keys...");
+const QString trLoadDump = QObject::tr("Load dump...");
+const QString trfilterForDump = QObject::tr("Dump files (*.fdump);; All Files (*.*)");
 const QString trSetMaxConnectionOnServerTemplate_1S =
     QObject::tr("Set max connection on %1 server");
 const QString trMaximumConnectionTemplate = QObject::tr("Maximum connection:");
@@ -89,6 +107,22 @@ const QString trSetTTL = QObject::tr("Set TTL");
 const QString trRenameKey = QObject::tr("Rename key");
 const QString trRenameKeyLabel = QObject::tr("New key name:");
 const QString trChangePasswordTemplate_1S = QObject::tr("Change password for %1 server");
+
+// range estimates of leveldb and rocksdb, key walks of lmdb and unqlite
+bool isNamespacesSizeSupported(fastonosql::core::connectionTypes type) {
+  return type == fastonosql::core::LEVELDB || type == fastonosql::core::ROCKSDB ||
+         type == fastonosql::core::LMDB || type == fastonosql::core::UNQLITE;
+}
+
+// redis collections are loaded by chunks, whole value can be too big for one reply
+bool isChunkedCollection(fastonosql::core::connectionTypes type, common::Value::Type key_type) {
+  if (type != fastonosql::core::REDIS) {
+    return false;
+  }
+
+  return key_type == common::Value::TYPE_ARRAY || key_type == common::Value::TYPE_SET ||
+         key_type == common::Value::TYPE_ZSET || key_type == common::Value::TYPE_HASH;
+}
 }  // namespace
 
 namespace fastonosql {
@@ -123,6 +157,14 @@ ExplorerTreeView::ExplorerTreeView(QWidget* parent) : QTreeView(parent) {
   VERIFY(connect(infoServerAction_, &QAction::triggered, this,
                  &ExplorerTreeView::openInfoServerDialog));
 
+  analyzeNamespacesAction_ = new QAction(this);
+  VERIFY(connect(analyzeNamespacesAction_, &QAction::triggered, this,
+                 &ExplorerTreeView::openNamespaceStatsDialog));
+
+  estimateNamespacesSizeAction_ = new QAction(this);
+  VERIFY(connect(estimateNamespacesSizeAction_, &QAction::triggered, this,
+                 &ExplorerTreeView::openNamespaceSizeDialog));
+
   propertyServerAction_ = new QAction(this);
   VERIFY(connect(propertyServerAction_, &QAction::triggered, this,
                  &ExplorerTreeView::openPropertyServerDialog));
@@ -164,6 +206,16 @@ ExplorerTreeView::ExplorerTreeView(QWidget* parent) : QTreeView(parent) {
   backupAction_ = new QAction(this);
   VERIFY(connect(backupAction_, &QAction::triggered, this, &ExplorerTreeView::backupServer));
 
+  massImportAction_ = new QAction(this);
+  VERIFY(
+      connect(massImportAction_, &QAction::triggered, this, &ExplorerTreeView::massImportServer));
+
+  dumpAction_ = new QAction(this);
+  VERIFY(connect(dumpAction_, &QAction::triggered, this, &ExplorerTreeView::dumpServer));
+
+  loadDumpAction_ = new QAction(this);
+  VERIFY(connect(loadDumpAction_, &QAction::triggered, this, &ExplorerTreeView::loadDumpServer));
+
   shutdownAction_ = new QAction(this);
   VERIFY(connect(shutdownAction_, &QAction::triggered, this, &ExplorerTreeView::shutdownServer));
 
@@ -336,6 +388,8 @@ void ExplorerTreeView::showContextMenu(const QPoint& point) {
     menu.addAction(loadDatabaseAction_);
     infoServerAction_->setEnabled(is_connected);
     menu.addAction(infoServerAction_);
+    analyzeNamespacesAction_->setEnabled(is_connected);
+    menu.addAction(analyzeNamespacesAction_);
     propertyServerAction_->setEnabled(is_connected && is_redis);
     menu.addAction(propertyServerAction_);
 
@@ -362,10 +416,20 @@ void ExplorerTreeView::showContextMenu(const QPoint& point) {
       is_local = host.IsLocalHost();
     }
 
-    importAction_->setEnabled(!is_connected && is_local && is_redis);
+    core::connectionTypes type = server->Type();
+    bool is_native_backup = type == core::LEVELDB || type == core::ROCKSDB ||
+                            type == core::LMDB || type == core::UPSCALEDB;
+    importAction_->setEnabled(!is_connected && is_local && (is_redis || is_native_backup));
     menu.addAction(importAction_);
-    backupAction_->setEnabled(is_connected && is_local && is_redis);
+    backupAction_->setEnabled(is_connected && is_local && (is_redis || is_native_backup));
     menu.addAction(backupAction_);
+    massImportAction_->setEnabled(is_connected && (is_redis || server->Type() == core::ROCKSDB ||
+                                                   server->Type() == core::MEMCACHED));
+    menu.addAction(massImportAction_);
+    dumpAction_->setEnabled(is_connected);
+    menu.addAction(dumpAction_);
+    loadDumpAction_->setEnabled(is_connected);
+    menu.addAction(loadDumpAction_);
     shutdownAction_->setEnabled(is_connected && is_redis);
     menu.addAction(shutdownAction_);
 
@@ -392,6 +456,10 @@ void ExplorerTreeView::showContextMenu(const QPoint& point) {
 
     menu.addAction(setDefaultDbAction_);
     setDefaultDbAction_->setEnabled(!isDefault && is_connected);
+
+    menu.addAction(estimateNamespacesSizeAction_);
+    estimateNamespacesSizeAction_->setEnabled(isDefault && is_connected &&
+                                              isNamespacesSizeSupported(server->Type()));
     menu.exec(menuPoint);
   } else if (node->type() == IExplorerTreeItem::eNamespace) {
     ExplorerNSItem* ns = static_cast<ExplorerNSItem*>(node);
@@ -404,6 +472,10 @@ void ExplorerTreeView::showContextMenu(const QPoint& point) {
 
     menu.addAction(removeBranchAction_);
     removeBranchAction_->setEnabled(isDefault && is_connected);
+
+    menu.addAction(estimateNamespacesSizeAction_);
+    estimateNamespacesSizeAction_->setEnabled(isDefault && is_connected &&
+                                              isNamespacesSizeSupported(server->Type()));
     menu.exec(menuPoint);
   } else if (node->type() == IExplorerTreeItem::eKey) {
     ExplorerKeyItem* key = static_cast<ExplorerKeyItem*>(node);
@@ -414,6 +486,20 @@ void ExplorerTreeView::showContextMenu(const QPoint& point) {
     bool is_connected = server->IsConnected();
     menu.addAction(getValueAction_);
     getValueAction_->setEnabled(is_connected);
+    if (isChunkedCollection(server->Type(), key->dbv().Type())) {
+      QAction* viewCollectionAction = new QAction(trViewCollection, this);
+      viewCollectionAction->setEnabled(is_connected);
+      VERIFY(connect(viewCollectionAction, &QAction::triggered, this,
+                     &ExplorerTreeView::viewCollection));
+      menu.addAction(viewCollectionAction);
+    }
+    if (server->Type() == core::LMDB || server->Type() == core::UPSCALEDB ||
+        server->Type() == core::UNQLITE) {
+      QAction* viewValueAction = new QAction(trViewValue, this);
+      viewValueAction->setEnabled(is_connected);
+      VERIFY(connect(viewValueAction, &QAction::triggered, this, &ExplorerTreeView::viewValue));
+      menu.addAction(viewValueAction);
+    }
     bool isTTLSupported = server->IsSupportTTLKeys();
     if (isTTLSupported) {
       QAction* setTTLKeyAction = new QAction(trSetTTL, this);
@@ -502,6 +588,59 @@ void ExplorerTreeView::openInfoServerDialog() {
   infDialog.exec();
 }
 
+void ExplorerTreeView::openNamespaceStatsDialog() {
+  QModelIndex sel = selectedIndex();
+  if (!sel.isValid()) {
+    return;
+  }
+
+  ExplorerServerItem* node = common::qt::item<common::qt::gui::TreeItem*, ExplorerServerItem*>(sel);
+  if (!node) {
+    return;
+  }
+
+  proxy::IServerSPtr server = node->server();
+  if (!server) {
+    return;
+  }
+
+  NamespaceStatsDialog diag(server, this);
+  diag.exec();
+}
+
+void ExplorerTreeView::openNamespaceSizeDialog() {
+  QModelIndex sel = selectedIndex();
+  if (!sel.isValid()) {
+    return;
+  }
+
+  // selected namespace (empty for database) and its subnamespaces
+  IExplorerTreeItem* node = common::qt::item<common::qt::gui::TreeItem*, IExplorerTreeItem*>(sel);
+  proxy::IServerSPtr server;
+  std::vector<std::string> namespaces;
+  if (ExplorerDatabaseItem* db = dynamic_cast<ExplorerDatabaseItem*>(node)) {  // +
+    server = db->server();
+    namespaces.push_back(std::string());
+  } else if (ExplorerNSItem* ns = dynamic_cast<ExplorerNSItem*>(node)) {  // +
+    server = ns->server();
+    namespaces.push_back(common::ConvertToString(ns->name()));
+  }
+
+  if (!server) {
+    return;
+  }
+
+  for (size_t i = 0; i < node->childrenCount(); ++i) {
+    ExplorerNSItem* child = dynamic_cast<ExplorerNSItem*>(node->child(i));  // +
+    if (child) {
+      namespaces.push_back(common::ConvertToString(child->name()));
+    }
+  }
+
+  NamespaceSizeDialog diag(server, namespaces, this);
+  diag.exec();
+}
+
 void ExplorerTreeView::openPropertyServerDialog() {
   QModelIndex sel = selectedIndex();
   if (!sel.isValid()) {
@@ -702,9 +841,19 @@ void ExplorerTreeView::backupServer() {
   }
 
   proxy::IServerSPtr server = node->server();
-  QString filepath = QFileDialog::getOpenFileName(this, translations::trBackup, QString(),
-                                                  translations::trfilterForRdb);
-  if (!filepath.isEmpty() && server) {
+  if (!server) {
+    return;
+  }
+
+  // engines write backup into new file (UpscaleDB) or new folder
+  QString filepath;
+  if (server->Type() == core::REDIS) {
+    filepath = QFileDialog::getOpenFileName(this, translations::trBackup, QString(),
+                                            translations::trfilterForRdb);
+  } else {
+    filepath = QFileDialog::getSaveFileName(this, translations::trBackup);
+  }
+  if (!filepath.isEmpty()) {
     proxy::events_info::BackupInfoRequest req(this, common::ConvertToString(filepath));
     server->BackupToPath(req);
   }
@@ -722,14 +871,105 @@ void ExplorerTreeView::importServer() {
   }
 
   proxy::IServerSPtr server = node->server();
-  QString filepath = QFileDialog::getOpenFileName(this, translations::trImport, QString(),
-                                                  translations::trfilterForRdb);
-  if (filepath.isEmpty() && server) {
+  if (!server) {
+    return;
+  }
+
+  QString filepath;
+  core::connectionTypes type = server->Type();
+  if (type == core::REDIS) {
+    filepath = QFileDialog::getOpenFileName(this, translations::trImport, QString(),
+                                            translations::trfilterForRdb);
+  } else if (type == core::UPSCALEDB) {
+    filepath = QFileDialog::getOpenFileName(this, translations::trImport);
+  } else {
+    filepath = QFileDialog::getExistingDirectory(this, translations::trImport);
+  }
+  if (!filepath.isEmpty()) {
     proxy::events_info::ExportInfoRequest req(this, common::ConvertToString(filepath));
     server->ExportFromPath(req);
   }
 }
 
+void ExplorerTreeView::massImportServer() {
+  QModelIndex sel = selectedIndex();
+  if (!sel.isValid()) {
+    return;
+  }
+
+  ExplorerServerItem* node = common::qt::item<common::qt::gui::TreeItem*, ExplorerServerItem*>(sel);
+  if (!node) {
+    return;
+  }
+
+  proxy::IServerSPtr server = node->server();
+  QString filepath = QFileDialog::getOpenFileName(this, translations::trMassImport, QString(),
+                                                  translations::trfilterForImport);
+  if (filepath.isEmpty() || !server) {
+    return;
+  }
+
+  core::ImportFormat format = core::IMPORT_COMMANDS;
+  QString suffix = QFileInfo(filepath).suffix().toLower();
+  if (suffix == "csv") {
+    format = core::IMPORT_CSV;
+  } else if (suffix == "json" || suffix == "jsonl") {
+    format = core::IMPORT_JSON_LINES;
+  }
+
+  proxy::events_info::ImportInfoRequest req(this, common::ConvertToString(filepath), format);
+  if (server->Type() == core::ROCKSDB) {
+    int answer = QMessageBox::question(this, translations::trMassImport, trCompactAfterImport,
+                                       QMessageBox::Yes, QMessageBox::No, QMessageBox::NoButton);
+    req.compact_after = answer == QMessageBox::Yes;
+  }
+  server->ImportFromFile(req);
+}
+
+void ExplorerTreeView::dumpServer() {
+  QModelIndex sel = selectedIndex();
+  if (!sel.isValid()) {
+    return;
+  }
+
+  ExplorerServerItem* node = common::qt::item<common::qt::gui::TreeItem*, ExplorerServerItem*>(sel);
+  if (!node) {
+    return;
+  }
+
+  proxy::IServerSPtr server = node->server();
+  QString filepath = QFileDialog::getSaveFileName(this, trDumpKeys, QString(), trfilterForDump);
+  if (filepath.isEmpty() || !server) {
+    return;
+  }
+
+  proxy::events_info::DumpInfoRequest req(this, common::ConvertToString(filepath),
+                                          core::CopyOptions(), core::DumpOptions());
+  server->DumpToFile(req);
+}
+
+void ExplorerTreeView::loadDumpServer() {
+  QModelIndex sel = selectedIndex();
+  if (!sel.isValid()) {
+    return;
+  }
+
+  ExplorerServerItem* node = common::qt::item<common::qt::gui::TreeItem*, ExplorerServerItem*>(sel);
+  if (!node) {
+    return;
+  }
+
+  proxy::IServerSPtr server = node->server();
+  QString filepath = QFileDialog::getOpenFileName(this, trLoadDump, QString(), trfilterForDump);
+  if (filepath.isEmpty() || !server) {
+    return;
+  }
+
+  proxy::events_info::LoadDumpInfoRequest req(this, common::ConvertToString(filepath),
+                                              core::CopyOptions());
+  server->LoadDumpFromFile(req);
+}
+
 void ExplorerTreeView::shutdownServer() {
   QModelIndex sel = selectedIndex();
   if (!sel.isValid()) {
@@ -893,6 +1133,39 @@ void ExplorerTreeView::viewKeys() {
   diag.exec();
 }
 
+void ExplorerTreeView::viewCollection() {
+  QModelIndex sel = selectedIndex();
+  if (!sel.isValid()) {
+    return;
+  }
+
+  ExplorerKeyItem* node = common::qt::item<common::qt::gui::TreeItem*, ExplorerKeyItem*>(sel);
+  if (!node) {
+    return;
+  }
+
+  core::NDbKValue dbv = node->dbv();
+  ViewCollectionDialog diag(trViewCollectionTemplate_1S.arg(node->name()), node->server(),
+                            dbv.Key(), dbv.Type(), this);
+  diag.exec();
+}
+
+void ExplorerTreeView::viewValue() {
+  QModelIndex sel = selectedIndex();
+  if (!sel.isValid()) {
+    return;
+  }
+
+  ExplorerKeyItem* node = common::qt::item<common::qt::gui::TreeItem*, ExplorerKeyItem*>(sel);
+  if (!node) {
+    return;
+  }
+
+  core::NDbKValue dbv = node->dbv();
+  ViewValueDialog diag(trViewValueTemplate_1S.arg(node->name()), node->server(), dbv.Key(), this);
+  diag.exec();
+}
+
 void ExplorerTreeView::loadValue() {
   QModelIndex sel = selectedIndex();
   if (!sel.isValid()) {
@@ -904,6 +1177,12 @@ void ExplorerTreeView::loadValue() {
     return;
   }
 
+  // value isn't loaded by one command, rows are fetched while view scrolls
+  if (isChunkedCollection(node->server()->Type(), node->dbv().Type())) {
+    viewCollection();
+    return;
+  }
+
   node->loadValueFromDb();
 }
 
@@ -1188,6 +1467,8 @@ void ExplorerTreeView::retranslateUi() {
   openConsoleAction_->setText(translations::trOpenConsole);
   loadDatabaseAction_->setText(translations::trLoadDataBases);
   infoServerAction_->setText(translations::trInfo);
+  analyzeNamespacesAction_->setText(trAnalyzeNamespaces);
+  estimateNamespacesSizeAction_->setText(trEstimateNamespacesSize);
   propertyServerAction_->setText(translations::trProperty);
   setServerPassword_->setText(translations::trSetPassword);
   setMaxClientConnection_->setText(translations::trSetMaxNumberOfClients);
@@ -1198,6 +1479,9 @@ void ExplorerTreeView::retranslateUi() {
   closeSentinelAction_->setText(translations::trClose);
   backupAction_->setText(translations::trBackup);
   importAction_->setText(translations::trImport);
+  massImportAction_->setText(translations::trMassImport);
+  dumpAction_->setText(trDumpKeys);
+  loadDumpAction_->setText(trLoadDump);
   shutdownAction_->setText(translations::trShutdown);
 
   loadContentAction_->setText(translations::trLoadContOfDataBases);
@@ -69,6 +69,8 @@ class ExplorerTreeView : public QTreeView {
   void openConsole();
   void loadDatabases();
   void openInfoServerDialog();
+  void openNamespaceStatsDialog();
+  void openNamespaceSizeDialog();
   void openPropertyServerDialog();
   void openSetPasswordServerDialog();
   void openMaxClientSetDialog();
@@ -80,6 +82,9 @@ class ExplorerTreeView : public QTreeView {
 
   void backupServer();
   void importServer();
+  void massImportServer();
+  void dumpServer();
+  void loadDumpServer();
   void shutdownServer();
 
   void loadContentDb();
@@ -92,6 +97,8 @@ class ExplorerTreeView : public QTreeView {
   void viewPubSub();
 
   void loadValue();
+  void viewCollection();
+  void viewValue();
   void renKey();
   void deleteKey();
   void watchKey();
@@ -141,6 +148,8 @@ class ExplorerTreeView : public QTreeView {
   QAction* deleteKeyAction_;
   QAction* watchKeyAction_;
   QAction* infoServerAction_;
+  QAction* analyzeNamespacesAction_;
+  QAction* estimateNamespacesSizeAction_;
   QAction* propertyServerAction_;
   QAction* setServerPassword_;
   QAction* setMaxClientConnection_;
@@ -150,6 +159,9 @@ class ExplorerTreeView : public QTreeView {
   QAction* closeClusterAction_;
   QAction* closeSentinelAction_;
   QAction* importAction_;
+  QAction* massImportAction_;
+  QAction* dumpAction_;
+  QAction* loadDumpAction_;
   QAction* backupAction_;
   QAction* shutdownAction_;
   ExplorerTreeModel* source_model_;
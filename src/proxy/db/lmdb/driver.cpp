@@ -27,6 +27,7 @@
 #include <common/log_levels.h>      // for LEVEL_LOG::L_WARNING
 #include <common/qt/utils_qt.h>     // for Event<>::value_type
 #include <common/sprintf.h>         // for MemSPrintf
+#include <common/time.h>            // for current_mstime
 #include <common/value.h>           // for ErrorValue, etc
 
 #include "proxy/command/command.h"         // for CreateCommand, etc
@@ -146,6 +147,22 @@ common::Error Driver::CurrentDataBaseInfo(core::IDataBaseInfo** info) {
   return impl_->Select(impl_->CurrentDBName(), info);
 }
 
+core::ICopySource* Driver::MakeCopySource() {
+  return new core::CDBCopySource<core::lmdb::DBConnection>(impl_);
+}
+
+core::ICopyTarget* Driver::MakeCopyTarget() {
+  return new core::CDBCopyTarget<core::lmdb::DBConnection>(impl_, false);
+}
+
+core::IBulkTarget* Driver::MakeBulkTarget() {
+  return new core::CDBBulkTarget<core::lmdb::DBConnection>(impl_);
+}
+
+core::IPartitionedSource* Driver::MakePartitionedSource() {
+  return new core::CDBPartitionedSource<core::lmdb::DBConnection>(impl_, true);
+}
+
 void Driver::HandleLoadDatabaseContentEvent(events::LoadDatabaseContentRequestEvent* ev) {
   QObject* sender = ev->sender();
   NotifyProgress(sender, 0);
@@ -210,6 +227,10 @@ void Driver::HandleLoadDatabaseContentEvent(events::LoadDatabaseContentRequestEv
         }
       }
 
+      if (res.with_values) {
+        PrefetchValues(impl_, &res.keys);
+      }
+
       common::Error err = impl_->DBkcount(&res.db_keys_count);
       DCHECK(!err);
     }
@@ -220,6 +241,79 @@ done:
   NotifyProgress(sender, 100);
 }
 
+void Driver::HandleLoadValueSourceEvent(events::LoadValueSourceRequestEvent* ev) {
+  QObject* sender = ev->sender();
+  NotifyProgress(sender, 0);
+  events::LoadValueSourceResponceEvent::value_type res(ev->value());
+  common::Error err = impl_->OpenValueSource(res.key, &res.source);
+  if (err && err->IsError()) {
+    res.setErrorInfo(err);
+  }
+  NotifyProgress(sender, 75);
+  Reply(sender, new events::LoadValueSourceResponceEvent(this, res));
+  NotifyProgress(sender, 100);
+}
+
+void Driver::HandleBackupEvent(events::BackupRequestEvent* ev) {
+  QObject* sender = ev->sender();
+  NotifyProgress(sender, 0);
+  events::BackupResponceEvent::value_type res(ev->value());
+  auto progress_cb = [this, sender](const core::BackupStats& stats) {
+    NotifyProgress(sender, stats.Percent() * 3 / 4);
+  };
+  common::Error err = impl_->Backup(res.path, progress_cb, &res.stats);
+  if (err && err->IsError()) {
+    res.setErrorInfo(err);
+  }
+  NotifyProgress(sender, 75);
+  Reply(sender, new events::BackupResponceEvent(this, res));
+  NotifyProgress(sender, 100);
+}
+
+void Driver::HandleExportEvent(events::ExportRequestEvent* ev) {
+  QObject* sender = ev->sender();
+  NotifyProgress(sender, 0);
+  events::ExportResponceEvent::value_type res(ev->value());
+  if (impl_->IsConnected()) {
+    res.setErrorInfo(common::make_error_value("Disconnect before restoring backup",
+                                              common::ErrorValue::E_ERROR));
+  } else {
+    auto progress_cb = [this, sender](const core::BackupStats& stats) {
+      NotifyProgress(sender, stats.Percent() * 3 / 4);
+    };
+    ConnectionSettings* set = dynamic_cast<ConnectionSettings*>(settings_.get());  // +
+    common::Error err =
+        core::lmdb::RestoreBackup(set->Info(), res.path, progress_cb, &res.stats);
+    if (err && err->IsError()) {
+      res.setErrorInfo(err);
+    }
+  }
+  NotifyProgress(sender, 75);
+  Reply(sender, new events::ExportResponceEvent(this, res));
+  NotifyProgress(sender, 100);
+}
+
+void Driver::HandleEstimateNamespacesSizeEvent(events::EstimateNamespacesSizeRequestEvent* ev) {
+  QObject* sender = ev->sender();
+  NotifyProgress(sender, 0);
+  events::EstimateNamespacesSizeResponceEvent::value_type res(ev->value());
+  const common::time64_t start_ts = common::time::current_mstime();
+  if (!res.options.sampled) {
+    res.setErrorInfo(common::make_error_value("LMDB can't estimate key ranges, use sampled mode",
+                                              common::ErrorValue::E_ERROR));
+  } else {
+    core::namespace_ranges_t ranges = core::MakeNamespaceRanges(res.namespaces, NsSeparator());
+    common::Error err = impl_->SampleSizes(ranges, res.options.sample_keys, &res.sizes);
+    if (err && err->IsError()) {
+      res.setErrorInfo(err);
+    }
+  }
+  res.elapsed_msec = common::time::current_mstime() - start_ts;
+  NotifyProgress(sender, 75);
+  Reply(sender, new events::EstimateNamespacesSizeResponceEvent(this, res));
+  NotifyProgress(sender, 100);
+}
+
 core::IServerInfoSPtr Driver::MakeServerInfoFromString(const std::string& val) {
   core::IServerInfoSPtr res(core::lmdb::MakeLmdbServerInfo(val));
   return res;
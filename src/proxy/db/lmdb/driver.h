@@ -72,8 +72,17 @@ class Driver : public IDriverLocal {
   virtual common::Error ExecuteImpl(const std::string& command, core::FastoObject* out) override;
   virtual common::Error CurrentServerInfo(core::IServerInfo** info) override;
   virtual common::Error CurrentDataBaseInfo(core::IDataBaseInfo** info) override;
+  virtual core::ICopySource* MakeCopySource() override;
+  virtual core::ICopyTarget* MakeCopyTarget() override;
+  virtual core::IBulkTarget* MakeBulkTarget() override;
+  virtual core::IPartitionedSource* MakePartitionedSource() override;
 
   virtual void HandleLoadDatabaseContentEvent(events::LoadDatabaseContentRequestEvent* ev) override;
+  virtual void HandleBackupEvent(events::BackupRequestEvent* ev) override;
+  virtual void HandleExportEvent(events::ExportRequestEvent* ev) override;
+  virtual void HandleEstimateNamespacesSizeEvent(
+      events::EstimateNamespacesSizeRequestEvent* ev) override;
+  virtual void HandleLoadValueSourceEvent(events::LoadValueSourceRequestEvent* ev) override;
 
   virtual core::IServerInfoSPtr MakeServerInfoFromString(const std::string& val) override;
 
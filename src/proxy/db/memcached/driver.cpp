@@ -32,6 +32,7 @@
 #include "proxy/command/command_logger.h"  // for LOG_COMMAND
 #include "core/connection_types.h"         // for ConvertToString, etc
 #include "core/db_key.h"                   // for NDbKValue, NValue, NKey
+#include "core/import_reader.h"            // for ImportReader
 #include "proxy/events/events_info.h"
 
 #include "proxy/db/memcached/command.h"              // for Command
@@ -145,6 +146,18 @@ common::Error Driver::CurrentDataBaseInfo(core::IDataBaseInfo** info) {
   return impl_->Select(impl_->CurrentDBName(), info);
 }
 
+core::ICopySource* Driver::MakeCopySource() {
+  return new core::CDBCopySource<core::memcached::DBConnection>(impl_);
+}
+
+core::ICopyTarget* Driver::MakeCopyTarget() {
+  return new core::CDBCopyTarget<core::memcached::DBConnection>(impl_, false);
+}
+
+core::IBulkTarget* Driver::MakeBulkTarget() {
+  return new core::CDBBulkTarget<core::memcached::DBConnection>(impl_, true);
+}
+
 void Driver::HandleLoadDatabaseContentEvent(events::LoadDatabaseContentRequestEvent* ev) {
   QObject* sender = ev->sender();
   NotifyProgress(sender, 0);
@@ -219,6 +232,10 @@ void Driver::HandleLoadDatabaseContentEvent(events::LoadDatabaseContentRequestEv
         }
       }
 
+      if (res.with_values) {
+        PrefetchValues(impl_, &res.keys);
+      }
+
       common::Error err = impl_->DBkcount(&res.db_keys_count);
       DCHECK(!err);
     }
@@ -229,6 +246,29 @@ done:
   NotifyProgress(sender, 100);
 }
 
+void Driver::HandleImportEvent(events::ImportRequestEvent* ev) {
+  QObject* sender = ev->sender();
+  NotifyProgress(sender, 0);
+  events::ImportResponceEvent::value_type res(ev->value());
+  core::ImportReader reader(res.format);
+  common::Error err = reader.Open(res.path);
+  if (err && err->IsError()) {
+    res.setErrorInfo(err);
+  } else {
+    auto progress_cb = [this, sender, &reader](const core::ImportStats& stats) {
+      UNUSED(stats);
+      NotifyProgress(sender, reader.Progress() * 3 / 4);
+    };
+    err = impl_->BulkImport(&reader, &res.stats, progress_cb);
+    if (err && err->IsError()) {
+      res.setErrorInfo(err);
+    }
+  }
+  NotifyProgress(sender, 75);
+  Reply(sender, new events::ImportResponceEvent(this, res));
+  NotifyProgress(sender, 100);
+}
+
 core::IServerInfoSPtr Driver::MakeServerInfoFromString(const std::string& val) {
   core::IServerInfoSPtr res(core::memcached::MakeMemcachedServerInfo(val));
   return res;
@@ -74,8 +74,12 @@ class Driver : public IDriverRemote {
   virtual common::Error ExecuteImpl(const std::string& command, core::FastoObject* out) override;
   virtual common::Error CurrentServerInfo(core::IServerInfo** info) override;
   virtual common::Error CurrentDataBaseInfo(core::IDataBaseInfo** info) override;
+  virtual core::ICopySource* MakeCopySource() override;
+  virtual core::ICopyTarget* MakeCopyTarget() override;
+  virtual core::IBulkTarget* MakeBulkTarget() override;
 
   virtual void HandleLoadDatabaseContentEvent(events::LoadDatabaseContentRequestEvent* ev) override;
+  virtual void HandleImportEvent(events::ImportRequestEvent* ev) override;
   virtual core::IServerInfoSPtr MakeServerInfoFromString(const std::string& val) override;
 
   core::memcached::DBConnection* const impl_;
@@ -21,8 +21,9 @@
 #include <stddef.h>  // for size_t
 #include <stdint.h>  // for uint32_t
 
-#include <memory>  // for __shared_ptr, shared_ptr
-#include <vector>  // for vector
+#include <algorithm>  // for min
+#include <memory>     // for __shared_ptr, shared_ptr
+#include <vector>     // for vector
 
 #include <common/convert2string.h>  // for ConvertFromString, etc
 #include <common/file_system.h>     // for copy_file
@@ -48,9 +49,11 @@
 #include "core/db/redis/config.h"                // for Config
 #include "proxy/db/redis/connection_settings.h"  // for ConnectionSettings
 #include "core/db/redis/database_info.h"         // for DataBaseInfo
+#include "core/db/redis/migrator.h"              // for MigrateOptions, MigrateStats
 #include "core/db/redis/server_info.h"           // for ServerInfo, etc
 
-#include "core/global.h"  // for FastoObjectCommandIPtr, etc
+#include "core/global.h"         // for FastoObjectCommandIPtr, etc
+#include "core/import_reader.h"  // for ImportReader
 
 #define REDIS_SHUTDOWN "SHUTDOWN"
 #define REDIS_BACKUP "SAVE"
@@ -59,6 +62,8 @@
 #define REDIS_GET_DATABASES "CONFIG GET databases"
 #define REDIS_GET_PROPERTY_SERVER "CONFIG GET *"
 
+#define REDIS_IMPORT_MAX_INFLIGHT_COMMANDS 10000
+
 #define REDIS_SET_DEFAULT_DATABASE_PATTERN_1ARGS_S "SELECT %s"
 #define REDIS_FLUSHDB "FLUSHDB"
 
@@ -190,6 +195,18 @@ common::Error Driver::CurrentDataBaseInfo(core::IDataBaseInfo** info) {
   return impl_->Select(impl_->CurrentDBName(), info);
 }
 
+core::ICopySource* Driver::MakeCopySource() {
+  return new core::CDBCopySource<core::redis::DBConnection>(impl_);
+}
+
+core::ICopyTarget* Driver::MakeCopyTarget() {
+  return new core::CDBCopyTarget<core::redis::DBConnection>(impl_, false);
+}
+
+core::IBulkTarget* Driver::MakeBulkTarget() {
+  return new core::CDBBulkTarget<core::redis::DBConnection>(impl_, true);
+}
+
 void Driver::HandleShutdownEvent(events::ShutDownRequestEvent* ev) {
   QObject* sender = ev->sender();
   NotifyProgress(sender, 0);
@@ -239,6 +256,116 @@ void Driver::HandleExportEvent(events::ExportRequestEvent* ev) {
   NotifyProgress(sender, 100);
 }
 
+void Driver::HandleImportEvent(events::ImportRequestEvent* ev) {
+  QObject* sender = ev->sender();
+  NotifyProgress(sender, 0);
+  events::ImportResponceEvent::value_type res(ev->value());
+  core::ImportReader reader(res.format);
+  common::Error err = reader.Open(res.path);
+  if (err && err->IsError()) {
+    res.setErrorInfo(err);
+  } else {
+    auto progress_cb = [this, sender, &reader](const core::ImportStats& stats) {
+      UNUSED(stats);
+      NotifyProgress(sender, reader.Progress() * 3 / 4);
+    };
+    err = impl_->PipeImport(&reader, REDIS_IMPORT_MAX_INFLIGHT_COMMANDS, &res.stats, progress_cb);
+    if (err && err->IsError()) {
+      res.setErrorInfo(err);
+    }
+  }
+  NotifyProgress(sender, 75);
+  Reply(sender, new events::ImportResponceEvent(this, res));
+  NotifyProgress(sender, 100);
+}
+
+void Driver::HandleMigrateEvent(events::MigrateRequestEvent* ev) {
+  QObject* sender = ev->sender();
+  NotifyProgress(sender, 0);
+  events::MigrateResponceEvent::value_type res(ev->value());
+  ConnectionSettings* target = dynamic_cast<ConnectionSettings*>(res.target.get());
+  if (!target) {
+    res.setErrorInfo(common::make_error_value("Migration target should be Redis server",
+                                              common::ErrorValue::E_ERROR));
+    Reply(sender, new events::MigrateResponceEvent(this, res));
+    NotifyProgress(sender, 100);
+    return;
+  }
+
+  core::redis::RConfig target_config(target->Info(), target->SSHInfo());
+  core::redis::MigrateOptions options;
+  if (!res.pattern.empty()) {
+    options.pattern = res.pattern;
+  }
+  options.cursor = res.cursor;
+  if (res.partitions) {
+    options.partitions = res.partitions;
+  }
+  if (res.batch_size) {
+    options.batch_size = res.batch_size;
+  }
+  options.use_migrate = res.use_server_migrate;
+
+  // SCAN cursor isn't linear, progress is estimated by keys count
+  size_t dbsize = 0;
+  common::Error err = impl_->DBkcount(&dbsize);
+  if (err && err->IsError()) {
+    dbsize = 0;
+  }
+  auto progress_cb = [this, sender, dbsize](const core::redis::MigrateStats& stats) {
+    if (dbsize) {
+      uint64_t scanned = std::min<uint64_t>(stats.scanned, dbsize);
+      NotifyProgress(sender, static_cast<int>(scanned * 75 / dbsize));
+    }
+  };
+
+  core::redis::MigrateStats stats;
+  err = impl_->Migrate(target_config, options, &stats, progress_cb);
+  if (err && err->IsError()) {
+    res.setErrorInfo(err);
+  }
+  res.scanned = stats.scanned;
+  res.migrated = stats.migrated;
+  res.skipped = stats.skipped;
+  res.errors = stats.errors;
+  res.bytes = stats.bytes;
+  res.next_cursor = stats.cursor;
+  res.finished = stats.finished;
+  res.elapsed_msec = stats.elapsed_msec;
+  res.error_keys = stats.error_keys;
+
+  NotifyProgress(sender, 75);
+  Reply(sender, new events::MigrateResponceEvent(this, res));
+  NotifyProgress(sender, 100);
+}
+
+void Driver::HandleLoadCollectionChunkEvent(events::LoadCollectionChunkRequestEvent* ev) {
+  QObject* sender = ev->sender();
+  NotifyProgress(sender, 0);
+  events::LoadCollectionChunkResponceEvent::value_type res(ev->value());
+  if (res.cursor_in == 0) {
+    common::Error err = impl_->CollectionSize(res.key, res.type, &res.total);
+    if (err && err->IsError()) {
+      res.setErrorInfo(err);
+      Reply(sender, new events::LoadCollectionChunkResponceEvent(this, res));
+      NotifyProgress(sender, 100);
+      return;
+    }
+  }
+
+  NotifyProgress(sender, 50);
+  common::Error err =
+      impl_->LoadCollectionChunk(res.key, res.type, res.cursor_in, res.count, &res.chunk,
+                                 &res.cursor_out);
+  if (err && err->IsError()) {
+    res.setErrorInfo(err);
+  }
+
+  NotifyProgress(sender, 75);
+  Reply(sender, new events::LoadCollectionChunkResponceEvent(this, res));
+  NotifyProgress(sender, 100);
+}
+
 void Driver::HandleChangePasswordEvent(events::ChangePasswordRequestEvent* ev) {
   QObject* sender = ev->sender();
   NotifyProgress(sender, 0);
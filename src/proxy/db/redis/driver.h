@@ -86,6 +86,9 @@ class Driver : public IDriverRemote {
 
   virtual common::Error CurrentServerInfo(core::IServerInfo** info) override;
   virtual common::Error CurrentDataBaseInfo(core::IDataBaseInfo** info) override;
+  virtual core::ICopySource* MakeCopySource() override;
+  virtual core::ICopyTarget* MakeCopyTarget() override;
+  virtual core::IBulkTarget* MakeBulkTarget() override;
 
   virtual void HandleLoadDatabaseInfosEvent(events::LoadDatabasesInfoRequestEvent* ev) override;
   virtual void HandleLoadServerPropertyEvent(events::ServerPropertyInfoRequestEvent* ev) override;
@@ -97,6 +100,9 @@ class Driver : public IDriverRemote {
   virtual void HandleExportEvent(events::ExportRequestEvent* ev) override;
   virtual void HandleChangePasswordEvent(events::ChangePasswordRequestEvent* ev) override;
   virtual void HandleChangeMaxConnectionEvent(events::ChangeMaxConnectionRequestEvent* ev) override;
+  virtual void HandleImportEvent(events::ImportRequestEvent* ev) override;
+  virtual void HandleMigrateEvent(events::MigrateRequestEvent* ev) override;
+  virtual void HandleLoadCollectionChunkEvent(events::LoadCollectionChunkRequestEvent* ev) override;
 
   virtual void HandleLoadDatabaseContentEvent(events::LoadDatabaseContentRequestEvent* ev) override;
 
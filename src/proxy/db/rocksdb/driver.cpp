@@ -25,6 +25,7 @@
 
 #include <common/qt/utils_qt.h>    // for Event<>::value_type
 #include <common/sprintf.h>        // for MemSPrintf
+#include <common/time.h>           // for current_mstime
 #include <common/value.h>          // for ErrorValue, etc
 #include <common/intrusive_ptr.h>  // for intrusive_ptr
 #include <common/convert2string.h>
@@ -45,6 +46,7 @@
 #include "core/db/rocksdb/server_info.h"    // for ServerInfo, etc
 
 #define ROCKSDB_INFO_REQUEST "INFO"
+#define ROCKSDB_IMPORT_TEMP_DIR_SUFFIX ".import"
 
 namespace fastonosql {
 namespace proxy {
@@ -120,19 +122,24 @@ common::Error Driver::SyncDisconnect() {
 }
 
 common::Error Driver::ExecuteImpl(const std::string& command, core::FastoObject* out) {
+  core::FastoObjectCommand* cmd = dynamic_cast<core::FastoObjectCommand*>(out);  // +
+  if (cmd && cmd->CommandLoggingType() == core::C_USER) {
+    return impl_->ExecuteWithPerfContext(command, out);
+  }
+
   return impl_->Execute(command, out);
 }
 
 common::Error Driver::CurrentServerInfo(core::IServerInfo** info) {
   core::FastoObjectCommandIPtr cmd = CreateCommandFast(ROCKSDB_INFO_REQUEST, core::C_INNER);
   LOG_COMMAND(cmd);
-  core::rocksdb::ServerInfo::Stats cm;
+  core::rocksdb::ServerInfo cm;
   common::Error err = impl_->Info(nullptr, &cm);
   if (err && err->IsError()) {
     return err;
   }
 
-  *info = new core::rocksdb::ServerInfo(cm);
+  *info = new core::rocksdb::ServerInfo(cm.stats_, cm.internals_);
   return common::Error();
 }
 
@@ -145,6 +152,22 @@ common::Error Driver::CurrentDataBaseInfo(core::IDataBaseInfo** info) {
   return impl_->Select(impl_->CurrentDBName(), info);
 }
 
+core::ICopySource* Driver::MakeCopySource() {
+  return new core::CDBCopySource<core::rocksdb::DBConnection>(impl_);
+}
+
+core::ICopyTarget* Driver::MakeCopyTarget() {
+  return new core::CDBCopyTarget<core::rocksdb::DBConnection>(impl_, false);
+}
+
+core::IBulkTarget* Driver::MakeBulkTarget() {
+  return new core::CDBBulkTarget<core::rocksdb::DBConnection>(impl_, true);
+}
+
+core::IPartitionedSource* Driver::MakePartitionedSource() {
+  return new core::CDBPartitionedSource<core::rocksdb::DBConnection>(impl_, true);
+}
+
 void Driver::HandleLoadDatabaseContentEvent(events::LoadDatabaseContentRequestEvent* ev) {
   QObject* sender = ev->sender();
   NotifyProgress(sender, 0);
@@ -209,6 +232,10 @@ void Driver::HandleLoadDatabaseContentEvent(events::LoadDatabaseContentRequestEv
         }
       }
 
+      if (res.with_values) {
+        PrefetchValues(impl_, &res.keys);
+      }
+
       common::Error err = impl_->DBkcount(&res.db_keys_count);
       DCHECK(!err);
     }
@@ -219,6 +246,87 @@ done:
   NotifyProgress(sender, 100);
 }
 
+void Driver::HandleImportEvent(events::ImportRequestEvent* ev) {
+  QObject* sender = ev->sender();
+  NotifyProgress(sender, 0);
+  events::ImportResponceEvent::value_type res(ev->value());
+  core::ImportReader reader(res.format);
+  common::Error err = reader.Open(res.path);
+  if (err && err->IsError()) {
+    res.setErrorInfo(err);
+  } else {
+    core::rocksdb::SstLoadOptions options;
+    options.temp_dir = impl_->config().dbname + ROCKSDB_IMPORT_TEMP_DIR_SUFFIX;
+    options.compact_after = res.compact_after;
+    // input is read and sorted in first half, merge and ingestion take the rest
+    auto progress_cb = [this, sender, &reader](const core::ImportStats& stats) {
+      NotifyProgress(sender, stats.replies ? 75 : reader.Progress() * 3 / 8);
+    };
+    err = impl_->SstImport(&reader, options, &res.stats, progress_cb);
+    if (err && err->IsError()) {
+      res.setErrorInfo(err);
+    }
+  }
+  NotifyProgress(sender, 75);
+  Reply(sender, new events::ImportResponceEvent(this, res));
+  NotifyProgress(sender, 100);
+}
+
+void Driver::HandleBackupEvent(events::BackupRequestEvent* ev) {
+  QObject* sender = ev->sender();
+  NotifyProgress(sender, 0);
+  events::BackupResponceEvent::value_type res(ev->value());
+  auto progress_cb = [this, sender](const core::BackupStats& stats) {
+    NotifyProgress(sender, stats.Percent() * 3 / 4);
+  };
+  common::Error err = impl_->Backup(res.path, progress_cb, &res.stats);
+  if (err && err->IsError()) {
+    res.setErrorInfo(err);
+  }
+  NotifyProgress(sender, 75);
+  Reply(sender, new events::BackupResponceEvent(this, res));
+  NotifyProgress(sender, 100);
+}
+
+void Driver::HandleExportEvent(events::ExportRequestEvent* ev) {
+  QObject* sender = ev->sender();
+  NotifyProgress(sender, 0);
+  events::ExportResponceEvent::value_type res(ev->value());
+  if (impl_->IsConnected()) {
+    res.setErrorInfo(common::make_error_value("Disconnect before restoring backup",
+                                              common::ErrorValue::E_ERROR));
+  } else {
+    auto progress_cb = [this, sender](const core::BackupStats& stats) {
+      NotifyProgress(sender, stats.Percent() * 3 / 4);
+    };
+    ConnectionSettings* set = dynamic_cast<ConnectionSettings*>(settings_.get());  // +
+    common::Error err =
+        core::rocksdb::RestoreBackup(set->Info(), res.path, progress_cb, &res.stats);
+    if (err && err->IsError()) {
+      res.setErrorInfo(err);
+    }
+  }
+  NotifyProgress(sender, 75);
+  Reply(sender, new events::ExportResponceEvent(this, res));
+  NotifyProgress(sender, 100);
+}
+
+void Driver::HandleEstimateNamespacesSizeEvent(events::EstimateNamespacesSizeRequestEvent* ev) {
+  QObject* sender = ev->sender();
+  NotifyProgress(sender, 0);
+  events::EstimateNamespacesSizeResponceEvent::value_type res(ev->value());
+  const common::time64_t start_ts = common::time::current_mstime();
+  core::namespace_ranges_t ranges = core::MakeNamespaceRanges(res.namespaces, NsSeparator());
+  common::Error err = impl_->EstimateSizes(ranges, &res.sizes);
+  if (err && err->IsError()) {
+    res.setErrorInfo(err);
+  }
+  res.elapsed_msec = common::time::current_mstime() - start_ts;
+  NotifyProgress(sender, 75);
+  Reply(sender, new events::EstimateNamespacesSizeResponceEvent(this, res));
+  NotifyProgress(sender, 100);
+}
+
 core::IServerInfoSPtr Driver::MakeServerInfoFromString(const std::string& val) {
   core::IServerInfoSPtr res(core::rocksdb::MakeRocksdbServerInfo(val));
   return res;
@@ -145,6 +145,18 @@ common::Error Driver::CurrentDataBaseInfo(core::IDataBaseInfo** info) {
   return impl_->Select(impl_->CurrentDBName(), info);
 }
 
+core::ICopySource* Driver::MakeCopySource() {
+  return new core::CDBCopySource<core::ssdb::DBConnection>(impl_);
+}
+
+core::ICopyTarget* Driver::MakeCopyTarget() {
+  return new core::CDBCopyTarget<core::ssdb::DBConnection>(impl_, false);
+}
+
+core::IBulkTarget* Driver::MakeBulkTarget() {
+  return new core::CDBBulkTarget<core::ssdb::DBConnection>(impl_, true);
+}
+
 void Driver::HandleLoadDatabaseContentEvent(events::LoadDatabaseContentRequestEvent* ev) {
   QObject* sender = ev->sender();
   NotifyProgress(sender, 0);
@@ -198,28 +210,35 @@ void Driver::HandleLoadDatabaseContentEvent(events::LoadDatabaseContentRequestEv
         goto done;
       }
 
+      std::vector<std::string> keys;
       for (size_t i = 0; i < ar->GetSize(); ++i) {
         std::string key;
         if (ar->GetString(i, &key)) {
-          core::NKey k(key);
-          core::FastoObjectCommandIPtr cmd_ttl =
-              CreateCommandFast(common::MemSPrintf("TTL %s", key), core::C_INNER);
-          LOG_COMMAND(cmd_ttl);
-          core::ttl_t ttl = NO_TTL;
-          common::Error err = impl_->TTL(key, &ttl);
-          if (err && err->IsError()) {
-            k.SetTTL(NO_TTL);
-          } else {
-            k.SetTTL(ttl);
-          }
-
-          core::NValue empty_val(
-              common::Value::CreateEmptyValueFromType(common::Value::TYPE_STRING));
-          core::NDbKValue ress(k, empty_val);
-          res.keys.push_back(ress);
+          keys.push_back(key);
         }
       }
 
+      // ttls of all keys of page by one pipeline
+      for (size_t i = 0; i < keys.size(); ++i) {
+        core::FastoObjectCommandIPtr cmd_ttl =
+            CreateCommandFast(common::MemSPrintf("TTL %s", keys[i]), core::C_INNER);
+        LOG_COMMAND(cmd_ttl);
+      }
+      std::vector<core::ttl_t> ttls;
+      common::Error ttl_err = impl_->MultiTTL(keys, &ttls);
+      if (ttl_err && ttl_err->IsError()) {
+        ttls.clear();
+      }
+
+      for (size_t i = 0; i < keys.size(); ++i) {
+        core::NKey k(keys[i]);
+        k.SetTTL(i < ttls.size() ? ttls[i] : NO_TTL);
+
+        core::NValue empty_val(common::Value::CreateEmptyValueFromType(common::Value::TYPE_STRING));
+        core::NDbKValue ress(k, empty_val);
+        res.keys.push_back(ress);
+      }
+
       common::Error err = impl_->DBkcount(&res.db_keys_count);
       DCHECK(!err);
     }
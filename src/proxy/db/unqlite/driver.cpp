@@ -27,6 +27,7 @@
 #include <common/intrusive_ptr.h>  // for intrusive_ptr
 #include <common/qt/utils_qt.h>    // for Event<>::value_type
 #include <common/sprintf.h>        // for MemSPrintf
+#include <common/time.h>           // for current_mstime
 #include <common/value.h>          // for ErrorValue, etc
 #include <common/convert2string.h>
 
@@ -148,6 +149,18 @@ common::Error Driver::CurrentDataBaseInfo(core::IDataBaseInfo** info) {
   return impl_->Select(impl_->CurrentDBName(), info);
 }
 
+core::ICopySource* Driver::MakeCopySource() {
+  return new core::CDBCopySource<core::unqlite::DBConnection>(impl_);
+}
+
+core::ICopyTarget* Driver::MakeCopyTarget() {
+  return new core::CDBCopyTarget<core::unqlite::DBConnection>(impl_, false);
+}
+
+core::IBulkTarget* Driver::MakeBulkTarget() {
+  return new core::CDBBulkTarget<core::unqlite::DBConnection>(impl_);
+}
+
 void Driver::HandleLoadDatabaseContentEvent(events::LoadDatabaseContentRequestEvent* ev) {
   QObject* sender = ev->sender();
   NotifyProgress(sender, 0);
@@ -222,6 +235,40 @@ done:
   NotifyProgress(sender, 100);
 }
 
+void Driver::HandleLoadValueSourceEvent(events::LoadValueSourceRequestEvent* ev) {
+  QObject* sender = ev->sender();
+  NotifyProgress(sender, 0);
+  events::LoadValueSourceResponceEvent::value_type res(ev->value());
+  common::Error err = impl_->OpenValueSource(res.key, &res.source);
+  if (err && err->IsError()) {
+    res.setErrorInfo(err);
+  }
+  NotifyProgress(sender, 75);
+  Reply(sender, new events::LoadValueSourceResponceEvent(this, res));
+  NotifyProgress(sender, 100);
+}
+
+void Driver::HandleEstimateNamespacesSizeEvent(events::EstimateNamespacesSizeRequestEvent* ev) {
+  QObject* sender = ev->sender();
+  NotifyProgress(sender, 0);
+  events::EstimateNamespacesSizeResponceEvent::value_type res(ev->value());
+  const common::time64_t start_ts = common::time::current_mstime();
+  if (!res.options.sampled) {
+    res.setErrorInfo(common::make_error_value("UnQLite can't estimate key ranges, use sampled mode",
+                                              common::ErrorValue::E_ERROR));
+  } else {
+    core::namespace_ranges_t ranges = core::MakeNamespaceRanges(res.namespaces, NsSeparator());
+    common::Error err = impl_->SampleSizes(ranges, res.options.sample_keys, &res.sizes);
+    if (err && err->IsError()) {
+      res.setErrorInfo(err);
+    }
+  }
+  res.elapsed_msec = common::time::current_mstime() - start_ts;
+  NotifyProgress(sender, 75);
+  Reply(sender, new events::EstimateNamespacesSizeResponceEvent(this, res));
+  NotifyProgress(sender, 100);
+}
+
 core::IServerInfoSPtr Driver::MakeServerInfoFromString(const std::string& val) {
   core::IServerInfoSPtr res(core::unqlite::MakeUnqliteServerInfo(val));
   return res;
@@ -149,6 +149,18 @@ common::Error Driver::CurrentDataBaseInfo(core::IDataBaseInfo** info) {
   return impl_->Select(impl_->CurrentDBName(), info);
 }
 
+core::ICopySource* Driver::MakeCopySource() {
+  return new core::CDBCopySource<core::upscaledb::DBConnection>(impl_);
+}
+
+core::ICopyTarget* Driver::MakeCopyTarget() {
+  return new core::CDBCopyTarget<core::upscaledb::DBConnection>(impl_, false);
+}
+
+core::IBulkTarget* Driver::MakeBulkTarget() {
+  return new core::CDBBulkTarget<core::upscaledb::DBConnection>(impl_);
+}
+
 void Driver::HandleLoadDatabaseContentEvent(events::LoadDatabaseContentRequestEvent* ev) {
   QObject* sender = ev->sender();
   NotifyProgress(sender, 0);
@@ -223,6 +235,58 @@ done:
   NotifyProgress(sender, 100);
 }
 
+void Driver::HandleLoadValueSourceEvent(events::LoadValueSourceRequestEvent* ev) {
+  QObject* sender = ev->sender();
+  NotifyProgress(sender, 0);
+  events::LoadValueSourceResponceEvent::value_type res(ev->value());
+  common::Error err = impl_->OpenValueSource(res.key, &res.source);
+  if (err && err->IsError()) {
+    res.setErrorInfo(err);
+  }
+  NotifyProgress(sender, 75);
+  Reply(sender, new events::LoadValueSourceResponceEvent(this, res));
+  NotifyProgress(sender, 100);
+}
+
+void Driver::HandleBackupEvent(events::BackupRequestEvent* ev) {
+  QObject* sender = ev->sender();
+  NotifyProgress(sender, 0);
+  events::BackupResponceEvent::value_type res(ev->value());
+  auto progress_cb = [this, sender](const core::BackupStats& stats) {
+    NotifyProgress(sender, stats.Percent() * 3 / 4);
+  };
+  common::Error err = impl_->Backup(res.path, progress_cb, &res.stats);
+  if (err && err->IsError()) {
+    res.setErrorInfo(err);
+  }
+  NotifyProgress(sender, 75);
+  Reply(sender, new events::BackupResponceEvent(this, res));
+  NotifyProgress(sender, 100);
+}
+
+void Driver::HandleExportEvent(events::ExportRequestEvent* ev) {
+  QObject* sender = ev->sender();
+  NotifyProgress(sender, 0);
+  events::ExportResponceEvent::value_type res(ev->value());
+  if (impl_->IsConnected()) {
+    res.setErrorInfo(common::make_error_value("Disconnect before restoring backup",
+                                              common::ErrorValue::E_ERROR));
+  } else {
+    auto progress_cb = [this, sender](const core::BackupStats& stats) {
+      NotifyProgress(sender, stats.Percent() * 3 / 4);
+    };
+    ConnectionSettings* set = dynamic_cast<ConnectionSettings*>(settings_.get());  // +
+    common::Error err =
+        core::upscaledb::RestoreBackup(set->Info(), res.path, progress_cb, &res.stats);
+    if (err && err->IsError()) {
+      res.setErrorInfo(err);
+    }
+  }
+  NotifyProgress(sender, 75);
+  Reply(sender, new events::ExportResponceEvent(this, res));
+  NotifyProgress(sender, 100);
+}
+
 core::IServerInfoSPtr Driver::MakeServerInfoFromString(const std::string& val) {
   core::IServerInfoSPtr res(core::upscaledb::MakeUpscaleDBServerInfo(val));
   return res;
@@ -24,9 +24,11 @@
 #include <signal.h>
 #endif
 
-#include <memory>  // for __shared_ptr
-#include <vector>  // for vector
-#include <string>  // for allocator, string, etc
+#include <algorithm>  // for min, max
+#include <atomic>     // for atomic
+#include <memory>     // for __shared_ptr
+#include <vector>     // for vector
+#include <string>     // for allocator, string, etc
 
 #include <QApplication>
 #include <QThread>
@@ -46,6 +48,9 @@
 #include "proxy/driver/first_child_update_root_locker.h"
 #include "proxy/driver/root_locker.h"  // for RootLocker
 #include "proxy/events/events_info.h"
+#include "proxy/servers_manager.h"  // for ServersManager
+
+#include "core/dump_file.h"  // for DumpReader, DumpWriter
 
 namespace {
 #ifdef OS_WIN
@@ -266,6 +271,42 @@ void IDriver::customEvent(QEvent* event) {
     events::ChangeMaxConnectionRequestEvent* ev =
         static_cast<events::ChangeMaxConnectionRequestEvent*>(event);
     HandleChangeMaxConnectionEvent(ev);  // ni
+  } else if (type == static_cast<QEvent::Type>(events::ImportRequestEvent::EventType)) {
+    events::ImportRequestEvent* ev = static_cast<events::ImportRequestEvent*>(event);
+    HandleImportEvent(ev);  // ni
+  } else if (type == static_cast<QEvent::Type>(events::MigrateRequestEvent::EventType)) {
+    events::MigrateRequestEvent* ev = static_cast<events::MigrateRequestEvent*>(event);
+    HandleMigrateEvent(ev);  // ni
+  } else if (type == static_cast<QEvent::Type>(events::CopyRequestEvent::EventType)) {
+    events::CopyRequestEvent* ev = static_cast<events::CopyRequestEvent*>(event);
+    HandleCopyEvent(ev);
+  } else if (type == static_cast<QEvent::Type>(events::DumpRequestEvent::EventType)) {
+    events::DumpRequestEvent* ev = static_cast<events::DumpRequestEvent*>(event);
+    HandleDumpEvent(ev);
+  } else if (type == static_cast<QEvent::Type>(events::LoadDumpRequestEvent::EventType)) {
+    events::LoadDumpRequestEvent* ev = static_cast<events::LoadDumpRequestEvent*>(event);
+    HandleLoadDumpEvent(ev);
+  } else if (type == static_cast<QEvent::Type>(events::AnalyzeNamespacesRequestEvent::EventType)) {
+    events::AnalyzeNamespacesRequestEvent* ev =
+        static_cast<events::AnalyzeNamespacesRequestEvent*>(event);
+    HandleAnalyzeNamespacesEvent(ev);
+  } else if (type ==
+             static_cast<QEvent::Type>(events::EstimateNamespacesSizeRequestEvent::EventType)) {
+    events::EstimateNamespacesSizeRequestEvent* ev =
+        static_cast<events::EstimateNamespacesSizeRequestEvent*>(event);
+    HandleEstimateNamespacesSizeEvent(ev);
+  } else if (type ==
+             static_cast<QEvent::Type>(events::LoadCollectionChunkRequestEvent::EventType)) {
+    events::LoadCollectionChunkRequestEvent* ev =
+        static_cast<events::LoadCollectionChunkRequestEvent*>(event);
+    HandleLoadCollectionChunkEvent(ev);  // ni
+  } else if (type == static_cast<QEvent::Type>(events::BulkOperationRequestEvent::EventType)) {
+    events::BulkOperationRequestEvent* ev = static_cast<events::BulkOperationRequestEvent*>(event);
+    HandleBulkOperationEvent(ev);
+  } else if (type == static_cast<QEvent::Type>(events::LoadValueSourceRequestEvent::EventType)) {
+    events::LoadValueSourceRequestEvent* ev =
+        static_cast<events::LoadValueSourceRequestEvent*>(event);
+    HandleLoadValueSourceEvent(ev);  // ni
   } else if (type ==
              static_cast<QEvent::Type>(events::LoadDatabaseContentRequestEvent::EventType)) {
     events::LoadDatabaseContentRequestEvent* ev =
@@ -458,6 +499,293 @@ void IDriver::HandleChangeMaxConnectionEvent(events::ChangeMaxConnectionRequestE
                                                                    "change maximum connection");
 }
 
+void IDriver::HandleImportEvent(events::ImportRequestEvent* ev) {
+  replyNotImplementedYet<events::ImportRequestEvent, events::ImportResponceEvent>(this, ev,
+                                                                                  "mass import");
+}
+
+void IDriver::HandleMigrateEvent(events::MigrateRequestEvent* ev) {
+  replyNotImplementedYet<events::MigrateRequestEvent, events::MigrateResponceEvent>(this, ev,
+                                                                                    "migrate keys");
+}
+
+void IDriver::HandleCopyEvent(events::CopyRequestEvent* ev) {
+  QObject* sender = ev->sender();
+  NotifyProgress(sender, 0);
+  events::CopyResponceEvent::value_type res(ev->value());
+  core::ICopyTarget* target = nullptr;
+  common::Error err = ServersManager::Instance().CreateCopyTarget(res.target, &target);
+  if (err && err->IsError()) {
+    res.setErrorInfo(err);
+    Reply(sender, new events::CopyResponceEvent(this, res));
+    NotifyProgress(sender, 100);
+    return;
+  }
+
+  core::ICopySource* source = MakeCopySource();
+  size_t dbsize = 0;
+  err = source->DBkcount(&dbsize);
+  if (err && err->IsError()) {
+    dbsize = 0;
+  }
+
+  auto progress_cb = [this, sender, dbsize](const core::CopyStats& stats) {
+    if (dbsize) {
+      uint64_t scanned = std::min<uint64_t>(stats.scanned, dbsize);
+      NotifyProgress(sender, static_cast<int>(scanned * 75 / dbsize));
+    }
+  };
+
+  core::CopyPipeline pipeline(source, target, res.options);
+  err = pipeline.Run([this]() { return IsInterrupted(); }, progress_cb, &res.stats);
+  if (err && err->IsError()) {
+    res.setErrorInfo(err);
+  }
+  delete source;
+  delete target;
+
+  NotifyProgress(sender, 75);
+  Reply(sender, new events::CopyResponceEvent(this, res));
+  NotifyProgress(sender, 100);
+}
+
+void IDriver::HandleDumpEvent(events::DumpRequestEvent* ev) {
+  QObject* sender = ev->sender();
+  NotifyProgress(sender, 0);
+  events::DumpResponceEvent::value_type res(ev->value());
+  // dump keeps expiration of keys, engines without ttl report NO_TTL
+  res.options.with_ttl = true;
+  core::DumpWriter writer(res.dump_options);
+  common::Error err = writer.Open(res.path);
+  if (err && err->IsError()) {
+    res.setErrorInfo(err);
+    Reply(sender, new events::DumpResponceEvent(this, res));
+    NotifyProgress(sender, 100);
+    return;
+  }
+
+  core::IPartitionedSource* partitioned = MakePartitionedSource();
+  if (partitioned) {
+    // ranges are read in parallel, writer gets their batches in key order
+    core::PartitionedScanOptions scan_options;
+    scan_options.pattern = res.options.pattern;
+    scan_options.batch_size = res.options.batch_size;
+    scan_options.queue_size = res.options.queue_size;
+    scan_options.with_values = true;
+    scan_options.ordered = true;
+    std::atomic<bool> write_failed(false);
+    common::Error write_err;
+    auto batch_cb = [&writer, &write_failed, &write_err](size_t partition,
+                                                         const core::NDbKValues& batch) {
+      UNUSED(partition);
+      core::NDbKValues added_keys;
+      if (!write_failed) {
+        write_err = writer.SetBatch(batch, &added_keys);
+        write_failed = write_err && write_err->IsError();
+      }
+    };
+    auto progress_cb = [this, sender](size_t done, size_t total) {
+      NotifyProgress(sender, static_cast<int>(done * 75 / total));
+    };
+
+    core::PartitionedScan scan(partitioned, scan_options);
+    err = scan.Run([this, &write_failed]() { return IsInterrupted() || write_failed; },
+                   batch_cb, progress_cb, &res.stats);
+    if (write_failed) {
+      err = write_err;
+    }
+    delete partitioned;
+  } else {
+    core::ICopySource* source = MakeCopySource();
+    size_t dbsize = 0;
+    err = source->DBkcount(&dbsize);
+    if (err && err->IsError()) {
+      dbsize = 0;
+    }
+
+    auto progress_cb = [this, sender, dbsize](const core::CopyStats& stats) {
+      if (dbsize) {
+        uint64_t scanned = std::min<uint64_t>(stats.scanned, dbsize);
+        NotifyProgress(sender, static_cast<int>(scanned * 75 / dbsize));
+      }
+    };
+
+    core::CopyPipeline pipeline(source, &writer, res.options);
+    err = pipeline.Run([this]() { return IsInterrupted(); }, progress_cb, &res.stats);
+    delete source;
+  }
+  common::Error close_err = writer.Close();
+  if (err && err->IsError()) {
+    res.setErrorInfo(err);
+  } else if (close_err && close_err->IsError()) {
+    res.setErrorInfo(close_err);
+  }
+  res.written_bytes = writer.WrittenBytes();
+
+  NotifyProgress(sender, 75);
+  Reply(sender, new events::DumpResponceEvent(this, res));
+  NotifyProgress(sender, 100);
+}
+
+void IDriver::HandleLoadDumpEvent(events::LoadDumpRequestEvent* ev) {
+  QObject* sender = ev->sender();
+  NotifyProgress(sender, 0);
+  events::LoadDumpResponceEvent::value_type res(ev->value());
+  core::DumpReader reader;
+  common::Error err = reader.Open(res.path);
+  if (err && err->IsError()) {
+    res.setErrorInfo(err);
+    Reply(sender, new events::LoadDumpResponceEvent(this, res));
+    NotifyProgress(sender, 100);
+    return;
+  }
+
+  size_t records = 0;
+  err = reader.DBkcount(&records);
+  if (err && err->IsError()) {
+    records = 0;
+  }
+
+  auto progress_cb = [this, sender, records](const core::CopyStats& stats) {
+    if (records) {
+      uint64_t scanned = std::min<uint64_t>(stats.scanned, records);
+      NotifyProgress(sender, static_cast<int>(scanned * 75 / records));
+    }
+  };
+
+  // records are written by batch nvi of connection
+  core::ICopyTarget* target = MakeCopyTarget();
+  core::CopyPipeline pipeline(&reader, target, res.options);
+  err = pipeline.Run([this]() { return IsInterrupted(); }, progress_cb, &res.stats);
+  if (err && err->IsError()) {
+    res.setErrorInfo(err);
+  }
+  delete target;
+
+  NotifyProgress(sender, 75);
+  Reply(sender, new events::LoadDumpResponceEvent(this, res));
+  NotifyProgress(sender, 100);
+}
+
+void IDriver::HandleAnalyzeNamespacesEvent(events::AnalyzeNamespacesRequestEvent* ev) {
+  QObject* sender = ev->sender();
+  NotifyProgress(sender, 0);
+  events::AnalyzeNamespacesResponceEvent::value_type res(ev->value());
+  res.tree = core::NamespaceTree(NsSeparator(), res.tree_options);
+  core::IPartitionedSource* partitioned = MakePartitionedSource();
+  if (partitioned) {
+    // every range is counted into own tree by thread of pool, trees share
+    // max_nodes of options and are merged when all ranges are scanned
+    core::PartitionedScanOptions scan_options;
+    scan_options.pattern = res.options.pattern;
+    scan_options.batch_size = res.options.batch_size;
+    scan_options.with_values = true;
+    core::PartitionedScan scan(partitioned, scan_options);
+    common::Error err = scan.Partition();
+    if (!err || !err->IsError()) {
+      const size_t ranges_count = scan.Ranges().size();
+      core::NamespaceTreeOptions range_options = res.tree_options;
+      range_options.max_nodes = std::max<size_t>(1, res.tree_options.max_nodes / ranges_count);
+      std::vector<core::NamespaceTree> trees;
+      for (size_t i = 0; i < ranges_count; ++i) {
+        trees.push_back(core::NamespaceTree(NsSeparator(), range_options));
+      }
+
+      auto batch_cb = [&trees](size_t partition, const core::NDbKValues& batch) {
+        core::NamespaceStatsTarget target(&trees[partition]);
+        core::NDbKValues added_keys;
+        common::Error set_err = target.SetBatch(batch, &added_keys);
+        UNUSED(set_err);
+      };
+      auto progress_cb = [this, sender](size_t done, size_t total) {
+        NotifyProgress(sender, static_cast<int>(done * 75 / total));
+      };
+
+      err = scan.Run([this]() { return IsInterrupted(); }, batch_cb, progress_cb, &res.stats);
+      for (size_t i = 0; i < trees.size(); ++i) {
+        res.tree.Merge(trees[i]);
+      }
+    }
+    if (err && err->IsError()) {
+      res.setErrorInfo(err);
+    }
+    delete partitioned;
+  } else {
+    core::ICopySource* source = MakeCopySource();
+    size_t dbsize = 0;
+    common::Error err = source->DBkcount(&dbsize);
+    if (err && err->IsError()) {
+      dbsize = 0;
+    }
+
+    auto progress_cb = [this, sender, dbsize](const core::CopyStats& stats) {
+      if (dbsize) {
+        uint64_t scanned = std::min<uint64_t>(stats.scanned, dbsize);
+        NotifyProgress(sender, static_cast<int>(scanned * 75 / dbsize));
+      }
+    };
+
+    core::NamespaceStatsTarget target(&res.tree);
+    core::CopyPipeline pipeline(source, &target, res.options);
+    err = pipeline.Run([this]() { return IsInterrupted(); }, progress_cb, &res.stats);
+    if (err && err->IsError()) {
+      res.setErrorInfo(err);
+    }
+    delete source;
+  }
+
+  NotifyProgress(sender, 75);
+  Reply(sender, new events::AnalyzeNamespacesResponceEvent(this, res));
+  NotifyProgress(sender, 100);
+}
+
+void IDriver::HandleEstimateNamespacesSizeEvent(events::EstimateNamespacesSizeRequestEvent* ev) {
+  replyNotImplementedYet<events::EstimateNamespacesSizeRequestEvent,
+                         events::EstimateNamespacesSizeResponceEvent>(this, ev,
+                                                                      "estimate namespaces size");
+}
+
+void IDriver::HandleLoadCollectionChunkEvent(events::LoadCollectionChunkRequestEvent* ev) {
+  replyNotImplementedYet<events::LoadCollectionChunkRequestEvent,
+                         events::LoadCollectionChunkResponceEvent>(this, ev,
+                                                                   "load collection chunk");
+}
+
+void IDriver::HandleBulkOperationEvent(events::BulkOperationRequestEvent* ev) {
+  QObject* sender = ev->sender();
+  NotifyProgress(sender, 0);
+  events::BulkOperationResponceEvent::value_type res(ev->value());
+  core::IBulkTarget* target = MakeBulkTarget();
+  size_t dbsize = 0;
+  common::Error err = target->DBkcount(&dbsize);
+  if (err && err->IsError()) {
+    dbsize = 0;
+  }
+
+  auto progress_cb = [this, sender, dbsize](const core::BulkStats& stats) {
+    if (dbsize) {
+      uint64_t scanned = std::min<uint64_t>(stats.scanned, dbsize);
+      NotifyProgress(sender, static_cast<int>(scanned * 75 / dbsize));
+    }
+  };
+
+  core::BulkOperation operation(target, res.options);
+  err = operation.Run([this]() { return IsInterrupted(); }, progress_cb, &res.stats);
+  if (err && err->IsError()) {
+    res.setErrorInfo(err);
+  }
+  delete target;
+
+  NotifyProgress(sender, 75);
+  Reply(sender, new events::BulkOperationResponceEvent(this, res));
+  NotifyProgress(sender, 100);
+}
+
+void IDriver::HandleLoadValueSourceEvent(events::LoadValueSourceRequestEvent* ev) {
+  replyNotImplementedYet<events::LoadValueSourceRequestEvent,
+                         events::LoadValueSourceResponceEvent>(this, ev, "load value source");
+}
+
 void IDriver::HandleLoadDatabaseInfosEvent(events::LoadDatabasesInfoRequestEvent* ev) {
   QObject* sender = ev->sender();
   NotifyProgress(sender, 0);
@@ -602,6 +930,10 @@ void IDriver::HandleDiscoveryInfoEvent(events::DiscoveryInfoRequestEvent* ev) {
   NotifyProgress(sender, 100);
 }
 
+core::IPartitionedSource* IDriver::MakePartitionedSource() {
+  return nullptr;
+}
+
 common::Error IDriver::ServerDiscoveryInfo(core::IServerInfo** sinfo,
                                            core::IDataBaseInfo** dbinfo) {
   core::IServerInfo* lsinfo = nullptr;
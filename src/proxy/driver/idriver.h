@@ -27,8 +27,11 @@
 #include <common/value.h>   // for Value, Value::CommandLogging...
 
 #include "core/connection_types.h"     // for core::connectionTypes
+#include "core/bulk_operation.h"       // for IBulkTarget
+#include "core/copy_pipeline.h"        // for ICopySource, ICopyTarget
 #include "core/db_key.h"               // for NKey (ptr only), NDbKValue (...
 #include "core/icommand_translator.h"  // for translator_t
+#include "core/partitioned_scan.h"     // for IPartitionedSource
 
 #include "core/internal/cdb_connection_client.h"             // for CDBConnectionClient
 #include "proxy/connection_settings/iconnection_settings.h"  // for IConnectionSettingsBaseSPtr
@@ -102,6 +105,28 @@ class IDriver : public QObject, public core::CDBConnectionClient {
 
   void NotifyProgress(QObject* reciver, int value);
 
+  // values of page are read by one batched read, missing keys stay empty
+  template <typename DBConnection>
+  static void PrefetchValues(DBConnection* db, std::vector<core::NDbKValue>* page) {
+    core::NKeys keys;
+    for (size_t i = 0; i < page->size(); ++i) {
+      keys.push_back((*page)[i].Key());
+    }
+
+    core::NDbKValues loaded_keys;
+    common::Error err = db->GetBatch(keys, &loaded_keys);
+    if (err && err->IsError()) {
+      return;
+    }
+
+    // loaded keys keep order of page
+    for (size_t i = 0, j = 0; i < page->size() && j < loaded_keys.size(); ++i) {
+      if ((*page)[i].KeyString() == loaded_keys[j].KeyString()) {
+        (*page)[i] = loaded_keys[j++];
+      }
+    }
+  }
+
  protected:
   explicit IDriver(IConnectionSettingsBaseSPtr settings);
 
@@ -121,6 +146,16 @@ class IDriver : public QObject, public core::CDBConnectionClient {
   virtual void HandleExportEvent(events::ExportRequestEvent* ev);
   virtual void HandleChangePasswordEvent(events::ChangePasswordRequestEvent* ev);
   virtual void HandleChangeMaxConnectionEvent(events::ChangeMaxConnectionRequestEvent* ev);
+  virtual void HandleImportEvent(events::ImportRequestEvent* ev);
+  virtual void HandleMigrateEvent(events::MigrateRequestEvent* ev);
+  virtual void HandleCopyEvent(events::CopyRequestEvent* ev);
+  virtual void HandleDumpEvent(events::DumpRequestEvent* ev);
+  virtual void HandleLoadDumpEvent(events::LoadDumpRequestEvent* ev);
+  virtual void HandleAnalyzeNamespacesEvent(events::AnalyzeNamespacesRequestEvent* ev);
+  virtual void HandleEstimateNamespacesSizeEvent(events::EstimateNamespacesSizeRequestEvent* ev);
+  virtual void HandleLoadCollectionChunkEvent(events::LoadCollectionChunkRequestEvent* ev);
+  virtual void HandleBulkOperationEvent(events::BulkOperationRequestEvent* ev);
+  virtual void HandleLoadValueSourceEvent(events::LoadValueSourceRequestEvent* ev);
   virtual void HandleLoadDatabaseInfosEvent(events::LoadDatabasesInfoRequestEvent* ev);
 
   const IConnectionSettingsBaseSPtr settings_;
@@ -159,6 +194,11 @@ class IDriver : public QObject, public core::CDBConnectionClient {
   virtual common::Error ServerDiscoveryInfo(core::IServerInfo** sinfo,
                                             core::IDataBaseInfo** dbinfo);
   virtual common::Error CurrentDataBaseInfo(core::IDataBaseInfo** info) = 0;
+  virtual core::ICopySource* MakeCopySource() = 0;
+  virtual core::ICopyTarget* MakeCopyTarget() = 0;
+  virtual core::IBulkTarget* MakeBulkTarget() = 0;
+  // engines with ordered keyspace return source for parallel scans, others nullptr
+  virtual core::IPartitionedSource* MakePartitionedSource();
   virtual void InitImpl() = 0;
   virtual void ClearImpl() = 0;
 
@@ -107,6 +107,47 @@ typedef common::qt::Event<events_info::ChangeMaxConnectionRequest, QEvent::User
 typedef common::qt::Event<events_info::ChangeMaxConnectionResponce, QEvent::User + 38>
     ChangeMaxConnectionResponceEvent;
 
+typedef common::qt::Event<events_info::ImportInfoRequest, QEvent::User + 39> ImportRequestEvent;
+typedef common::qt::Event<events_info::ImportInfoResponce, QEvent::User + 40> ImportResponceEvent;
+
+typedef common::qt::Event<events_info::MigrateInfoRequest, QEvent::User + 41> MigrateRequestEvent;
+typedef common::qt::Event<events_info::MigrateInfoResponce, QEvent::User + 42> MigrateResponceEvent;
+
+typedef common::qt::Event<events_info::CopyInfoRequest, QEvent::User + 43> CopyRequestEvent;
+typedef common::qt::Event<events_info::CopyInfoResponce, QEvent::User + 44> CopyResponceEvent;
+
+typedef common::qt::Event<events_info::LoadCollectionChunkRequest, QEvent::User + 45>
+    LoadCollectionChunkRequestEvent;
+typedef common::qt::Event<events_info::LoadCollectionChunkResponce, QEvent::User + 46>
+    LoadCollectionChunkResponceEvent;
+
+typedef common::qt::Event<events_info::BulkOperationInfoRequest, QEvent::User + 47>
+    BulkOperationRequestEvent;
+typedef common::qt::Event<events_info::BulkOperationInfoResponce, QEvent::User + 48>
+    BulkOperationResponceEvent;
+
+typedef common::qt::Event<events_info::LoadValueSourceRequest, QEvent::User + 49>
+    LoadValueSourceRequestEvent;
+typedef common::qt::Event<events_info::LoadValueSourceResponce, QEvent::User + 50>
+    LoadValueSourceResponceEvent;
+
+typedef common::qt::Event<events_info::DumpInfoRequest, QEvent::User + 51> DumpRequestEvent;
+typedef common::qt::Event<events_info::DumpInfoResponce, QEvent::User + 52> DumpResponceEvent;
+
+typedef common::qt::Event<events_info::LoadDumpInfoRequest, QEvent::User + 53>
+    LoadDumpRequestEvent;
+typedef common::qt::Event<events_info::LoadDumpInfoResponce, QEvent::User + 54>
+    LoadDumpResponceEvent;
+
+typedef common::qt::Event<events_info::AnalyzeNamespacesInfoRequest, QEvent::User + 55>
+    AnalyzeNamespacesRequestEvent;
+typedef common::qt::Event<events_info::AnalyzeNamespacesInfoResponce, QEvent::User + 56>
+    AnalyzeNamespacesResponceEvent;
+typedef common::qt::Event<events_info::EstimateNamespacesSizeInfoRequest, QEvent::User + 57>
+    EstimateNamespacesSizeRequestEvent;
+typedef common::qt::Event<events_info::EstimateNamespacesSizeInfoResponce, QEvent::User + 58>
+    EstimateNamespacesSizeResponceEvent;
+
 typedef common::qt::Event<events_info::ProgressInfoResponce, QEvent::User + 100>
     ProgressResponceEvent;
 
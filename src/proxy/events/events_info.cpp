@@ -47,12 +47,14 @@ ShutDownInfoResponce::ShutDownInfoResponce(const base_class& request) : base_cla
 BackupInfoRequest::BackupInfoRequest(initiator_type sender, const std::string& path, error_type er)
     : base_class(sender, er), path(path) {}
 
-BackupInfoResponce::BackupInfoResponce(const base_class& request) : base_class(request) {}
+BackupInfoResponce::BackupInfoResponce(const base_class& request)
+    : base_class(request), stats() {}
 
 ExportInfoRequest::ExportInfoRequest(initiator_type sender, const std::string& path, error_type er)
     : base_class(sender, er), path(path) {}
 
-ExportInfoResponce::ExportInfoResponce(const base_class& request) : base_class(request) {}
+ExportInfoResponce::ExportInfoResponce(const base_class& request)
+    : base_class(request), stats() {}
 
 ChangePasswordRequest::ChangePasswordRequest(initiator_type sender,
                                              const std::string& oldPassword,
@@ -70,6 +72,113 @@ ChangeMaxConnectionRequest::ChangeMaxConnectionRequest(initiator_type sender,
 ChangeMaxConnectionResponce::ChangeMaxConnectionResponce(const base_class& request)
     : base_class(request) {}
 
+ImportInfoRequest::ImportInfoRequest(initiator_type sender,
+                                     const std::string& path,
+                                     core::ImportFormat format,
+                                     error_type er)
+    : base_class(sender, er), path(path), format(format), compact_after(false) {}
+
+ImportInfoResponce::ImportInfoResponce(const base_class& request)
+    : base_class(request), stats() {}
+
+MigrateInfoRequest::MigrateInfoRequest(initiator_type sender,
+                                       IConnectionSettingsBaseSPtr target,
+                                       const std::string& pattern,
+                                       error_type er)
+    : base_class(sender, er),
+      target(target),
+      pattern(pattern),
+      cursor(0),
+      partitions(0),
+      batch_size(0),
+      use_server_migrate(false) {}
+
+MigrateInfoResponce::MigrateInfoResponce(const base_class& request)
+    : base_class(request),
+      scanned(0),
+      migrated(0),
+      skipped(0),
+      errors(0),
+      bytes(0),
+      next_cursor(0),
+      finished(false),
+      elapsed_msec(0),
+      error_keys() {}
+
+CopyInfoRequest::CopyInfoRequest(initiator_type sender,
+                                 IConnectionSettingsBaseSPtr target,
+                                 const core::CopyOptions& options,
+                                 error_type er)
+    : base_class(sender, er), target(target), options(options) {}
+
+CopyInfoResponce::CopyInfoResponce(const base_class& request) : base_class(request), stats() {}
+
+DumpInfoRequest::DumpInfoRequest(initiator_type sender,
+                                 const std::string& path,
+                                 const core::CopyOptions& options,
+                                 const core::DumpOptions& dump_options,
+                                 error_type er)
+    : base_class(sender, er), path(path), options(options), dump_options(dump_options) {}
+
+DumpInfoResponce::DumpInfoResponce(const base_class& request)
+    : base_class(request), stats(), written_bytes(0) {}
+
+LoadDumpInfoRequest::LoadDumpInfoRequest(initiator_type sender,
+                                         const std::string& path,
+                                         const core::CopyOptions& options,
+                                         error_type er)
+    : base_class(sender, er), path(path), options(options) {}
+
+LoadDumpInfoResponce::LoadDumpInfoResponce(const base_class& request)
+    : base_class(request), stats() {}
+
+AnalyzeNamespacesInfoRequest::AnalyzeNamespacesInfoRequest(
+    initiator_type sender,
+    const core::CopyOptions& options,
+    const core::NamespaceTreeOptions& tree_options,
+    error_type er)
+    : base_class(sender, er), options(options), tree_options(tree_options) {}
+
+AnalyzeNamespacesInfoResponce::AnalyzeNamespacesInfoResponce(const base_class& request)
+    : base_class(request), tree(), stats() {}
+
+EstimateNamespacesSizeInfoRequest::EstimateNamespacesSizeInfoRequest(
+    initiator_type sender,
+    const std::vector<std::string>& namespaces,
+    const core::NamespaceSizeOptions& options,
+    error_type er)
+    : base_class(sender, er), namespaces(namespaces), options(options) {}
+
+EstimateNamespacesSizeInfoResponce::EstimateNamespacesSizeInfoResponce(const base_class& request)
+    : base_class(request), sizes(), elapsed_msec(0) {}
+
+LoadCollectionChunkRequest::LoadCollectionChunkRequest(initiator_type sender,
+                                                       const core::NKey& key,
+                                                       common::Value::Type type,
+                                                       uint64_t cursor_in,
+                                                       size_t count,
+                                                       error_type er)
+    : base_class(sender, er), key(key), type(type), cursor_in(cursor_in), count(count) {}
+
+LoadCollectionChunkResponce::LoadCollectionChunkResponce(const base_class& request)
+    : base_class(request), chunk(), cursor_out(0), total(0) {}
+
+BulkOperationInfoRequest::BulkOperationInfoRequest(initiator_type sender,
+                                                   const core::BulkOptions& options,
+                                                   error_type er)
+    : base_class(sender, er), options(options) {}
+
+BulkOperationInfoResponce::BulkOperationInfoResponce(const base_class& request)
+    : base_class(request), stats() {}
+
+LoadValueSourceRequest::LoadValueSourceRequest(initiator_type sender,
+                                               const core::NKey& key,
+                                               error_type er)
+    : base_class(sender, er), key(key) {}
+
+LoadValueSourceResponce::LoadValueSourceResponce(const base_class& request)
+    : base_class(request), source() {}
+
 DiscoveryInfoRequest::DiscoveryInfoRequest(initiator_type sender, error_type er)
     : base_class(sender, er) {}
 
@@ -136,7 +245,8 @@ LoadDatabaseContentRequest::LoadDatabaseContentRequest(initiator_type sender,
       inf(inf),
       pattern(pattern),
       count_keys(countKeys),
-      cursor_in(cursor) {}
+      cursor_in(cursor),
+      with_values(false) {}
 
 LoadDatabaseContentResponce::LoadDatabaseContentResponce(const base_class& request)
     : base_class(request), keys(), cursor_out(0), db_keys_count(0) {}
@@ -35,7 +35,17 @@
 #include "core/database/idatabase_info.h"
 #include "core/server/iserver_info.h"  // for IDataBaseInfoSPtr, IServerInf...
 
-#include "core/global.h"  // for FastoObjectIPtr
+#include "core/backup.h"          // for BackupStats
+#include "core/bulk_operation.h"  // for BulkOptions, BulkStats
+#include "core/byte_source.h"     // for byte_source_t
+#include "core/copy_pipeline.h"   // for CopyOptions, CopyStats
+#include "core/dump_file.h"       // for DumpOptions
+#include "core/global.h"         // for FastoObjectIPtr
+#include "core/import_reader.h"  // for ImportFormat, ImportStats
+#include "core/namespace_size.h"   // for NamespaceSizeOptions, namespace_sizes_t
+#include "core/namespace_stats.h"  // for NamespaceTree, NamespaceTreeOptions
+
+#include "proxy/connection_settings/iconnection_settings.h"  // for IConnectionSettingsBaseSPtr
 
 namespace fastonosql {
 namespace proxy {
@@ -81,6 +91,8 @@ struct BackupInfoRequest : public EventInfoBase {
 struct BackupInfoResponce : BackupInfoRequest {
   typedef BackupInfoRequest base_class;
   explicit BackupInfoResponce(const base_class& request);
+
+  core::BackupStats stats;
 };
 
 struct ExportInfoRequest : public EventInfoBase {
@@ -89,9 +101,12 @@ struct ExportInfoRequest : public EventInfoBase {
   std::string path;
 };
 
+// restore of backup
 struct ExportInfoResponce : ExportInfoRequest {
   typedef ExportInfoRequest base_class;
   explicit ExportInfoResponce(const base_class& request);
+
+  core::BackupStats stats;
 };
 
 struct ChangePasswordRequest : public EventInfoBase {
@@ -122,6 +137,200 @@ struct ChangeMaxConnectionResponce : ChangeMaxConnectionRequest {
   explicit ChangeMaxConnectionResponce(const base_class& request);
 };
 
+struct ImportInfoRequest : public EventInfoBase {
+  typedef EventInfoBase base_class;
+  ImportInfoRequest(initiator_type sender,
+                    const std::string& path,
+                    core::ImportFormat format,
+                    error_type er = error_type());
+  std::string path;
+  core::ImportFormat format;
+  bool compact_after;  // engines with compactions compact all data after import
+};
+
+struct ImportInfoResponce : ImportInfoRequest {
+  typedef ImportInfoRequest base_class;
+  explicit ImportInfoResponce(const base_class& request);
+
+  core::ImportStats stats;
+};
+
+struct MigrateInfoRequest : public EventInfoBase {
+  typedef EventInfoBase base_class;
+  MigrateInfoRequest(initiator_type sender,
+                     IConnectionSettingsBaseSPtr target,
+                     const std::string& pattern,
+                     error_type er = error_type());
+  IConnectionSettingsBaseSPtr target;
+  std::string pattern;
+  uint64_t cursor;  // resume from cursor of previous interrupted migration
+  size_t partitions;
+  size_t batch_size;
+  bool use_server_migrate;  // server side MIGRATE instead of DUMP/RESTORE through client
+};
+
+struct MigrateInfoResponce : MigrateInfoRequest {
+  typedef MigrateInfoRequest base_class;
+  explicit MigrateInfoResponce(const base_class& request);
+
+  uint64_t scanned;
+  uint64_t migrated;
+  uint64_t skipped;
+  uint64_t errors;
+  uint64_t bytes;
+  uint64_t next_cursor;
+  bool finished;
+  common::time64_t elapsed_msec;
+  std::vector<std::string> error_keys;
+};
+
+struct CopyInfoRequest : public EventInfoBase {
+  typedef EventInfoBase base_class;
+  CopyInfoRequest(initiator_type sender,
+                  IConnectionSettingsBaseSPtr target,
+                  const core::CopyOptions& options,
+                  error_type er = error_type());
+  IConnectionSettingsBaseSPtr target;  // any engine
+  core::CopyOptions options;
+};
+
+struct CopyInfoResponce : CopyInfoRequest {
+  typedef CopyInfoRequest base_class;
+  explicit CopyInfoResponce(const base_class& request);
+
+  core::CopyStats stats;
+};
+
+// keyspace of current database into dump file
+struct DumpInfoRequest : public EventInfoBase {
+  typedef EventInfoBase base_class;
+  DumpInfoRequest(initiator_type sender,
+                  const std::string& path,
+                  const core::CopyOptions& options,
+                  const core::DumpOptions& dump_options,
+                  error_type er = error_type());
+  std::string path;
+  core::CopyOptions options;
+  core::DumpOptions dump_options;
+};
+
+struct DumpInfoResponce : DumpInfoRequest {
+  typedef DumpInfoRequest base_class;
+  explicit DumpInfoResponce(const base_class& request);
+
+  core::CopyStats stats;
+  uint64_t written_bytes;
+};
+
+// records of dump file into current database
+struct LoadDumpInfoRequest : public EventInfoBase {
+  typedef EventInfoBase base_class;
+  LoadDumpInfoRequest(initiator_type sender,
+                      const std::string& path,
+                      const core::CopyOptions& options,
+                      error_type er = error_type());
+  std::string path;
+  core::CopyOptions options;
+};
+
+struct LoadDumpInfoResponce : LoadDumpInfoRequest {
+  typedef LoadDumpInfoRequest base_class;
+  explicit LoadDumpInfoResponce(const base_class& request);
+
+  core::CopyStats stats;
+};
+
+// one scan of keyspace aggregated by namespaces
+struct AnalyzeNamespacesInfoRequest : public EventInfoBase {
+  typedef EventInfoBase base_class;
+  AnalyzeNamespacesInfoRequest(initiator_type sender,
+                               const core::CopyOptions& options,
+                               const core::NamespaceTreeOptions& tree_options,
+                               error_type er = error_type());
+  core::CopyOptions options;
+  core::NamespaceTreeOptions tree_options;
+};
+
+struct AnalyzeNamespacesInfoResponce : AnalyzeNamespacesInfoRequest {
+  typedef AnalyzeNamespacesInfoRequest base_class;
+  explicit AnalyzeNamespacesInfoResponce(const base_class& request);
+
+  core::NamespaceTree tree;
+  core::CopyStats stats;
+};
+
+// sizes of namespaces without reading values
+struct EstimateNamespacesSizeInfoRequest : public EventInfoBase {
+  typedef EventInfoBase base_class;
+  EstimateNamespacesSizeInfoRequest(initiator_type sender,
+                                    const std::vector<std::string>& namespaces,
+                                    const core::NamespaceSizeOptions& options,
+                                    error_type er = error_type());
+  std::vector<std::string> namespaces;  // empty one is whole database
+  core::NamespaceSizeOptions options;
+};
+
+struct EstimateNamespacesSizeInfoResponce : EstimateNamespacesSizeInfoRequest {
+  typedef EstimateNamespacesSizeInfoRequest base_class;
+  explicit EstimateNamespacesSizeInfoResponce(const base_class& request);
+
+  core::namespace_sizes_t sizes;  // in order of namespaces
+  common::time64_t elapsed_msec;
+};
+
+struct LoadCollectionChunkRequest : public EventInfoBase {
+  typedef EventInfoBase base_class;
+  LoadCollectionChunkRequest(initiator_type sender,
+                             const core::NKey& key,
+                             common::Value::Type type,
+                             uint64_t cursor_in,
+                             size_t count,
+                             error_type er = error_type());
+  core::NKey key;
+  common::Value::Type type;  // list, set, zset or hash
+  uint64_t cursor_in;
+  size_t count;
+};
+
+struct LoadCollectionChunkResponce : LoadCollectionChunkRequest {
+  typedef LoadCollectionChunkRequest base_class;
+  explicit LoadCollectionChunkResponce(const base_class& request);
+
+  core::NValue chunk;
+  uint64_t cursor_out;  // 0 when whole collection loaded
+  size_t total;         // size of collection, only for first chunk
+};
+
+struct BulkOperationInfoRequest : public EventInfoBase {
+  typedef EventInfoBase base_class;
+  BulkOperationInfoRequest(initiator_type sender,
+                           const core::BulkOptions& options,
+                           error_type er = error_type());
+  core::BulkOptions options;
+};
+
+struct BulkOperationInfoResponce : BulkOperationInfoRequest {
+  typedef BulkOperationInfoRequest base_class;
+  explicit BulkOperationInfoResponce(const base_class& request);
+
+  core::BulkStats stats;
+};
+
+struct LoadValueSourceRequest : public EventInfoBase {
+  typedef EventInfoBase base_class;
+  LoadValueSourceRequest(initiator_type sender,
+                         const core::NKey& key,
+                         error_type er = error_type());
+  core::NKey key;
+};
+
+struct LoadValueSourceResponce : LoadValueSourceRequest {
+  typedef LoadValueSourceRequest base_class;
+  explicit LoadValueSourceResponce(const base_class& request);
+
+  core::byte_source_t source;  // read by viewer on demand
+};
+
 struct DiscoveryInfoRequest : public EventInfoBase {
   typedef EventInfoBase base_class;
   explicit DiscoveryInfoRequest(initiator_type sender, error_type er = error_type());
@@ -229,6 +438,7 @@ struct LoadDatabaseContentRequest : public EventInfoBase {
   const std::string pattern;
   size_t count_keys;
   const uint64_t cursor_in;
+  bool with_values;  // engines with batched reads prefetch values of page
 };
 
 struct LoadDatabaseContentResponce : LoadDatabaseContentRequest {
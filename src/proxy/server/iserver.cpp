@@ -28,14 +28,30 @@
 #include <common/value.h>        // for ErrorValue
 #include <common/qt/utils_qt.h>  // for Event<>::value_type
 #include <common/qt/logger.h>    // for LOG_ERROR
+#include <common/sprintf.h>      // for MemSPrintf
 
 #include "proxy/connection_settings/iconnection_settings.h"
 #include "proxy/events/events_info.h"  // for LoadDatabaseContentResponce, etc
 #include "proxy/driver/idriver.h"      // for IDriver
 
+#include "core/logger.h"  // for LOG_CORE_MSG
+
 namespace fastonosql {
 namespace proxy {
 
+namespace {
+
+void LogBackupStats(const char* action, const core::BackupStats& stats) {
+  std::string msg = common::MemSPrintf(
+      "%s finished: %llu files, %llu keys, %llu bytes in %lld msec (%.0f bytes/sec)", action,
+      static_cast<unsigned long long>(stats.files), static_cast<unsigned long long>(stats.keys),
+      static_cast<unsigned long long>(stats.bytes), static_cast<long long>(stats.elapsed_msec),
+      stats.BytesPerSecond());
+  LOG_CORE_MSG(msg, common::logging::L_INFO, false);
+}
+
+}  // namespace
+
 IServer::IServer(IDriver* drv)
     : drv_(drv), server_info_(), current_database_info_(), timer_check_key_exists_id_(0) {
   VERIFY(QObject::connect(drv_, &IDriver::ChildAdded, this, &IServer::ChildAdded));
@@ -211,6 +227,66 @@ void IServer::SetMaxConnection(const events_info::ChangeMaxConnectionRequest& re
   Notify(ev);
 }
 
+void IServer::ImportFromFile(const events_info::ImportInfoRequest& req) {
+  emit ImportStarted(req);
+  QEvent* ev = new events::ImportRequestEvent(this, req);
+  Notify(ev);
+}
+
+void IServer::MigrateTo(const events_info::MigrateInfoRequest& req) {
+  emit MigrateStarted(req);
+  QEvent* ev = new events::MigrateRequestEvent(this, req);
+  Notify(ev);
+}
+
+void IServer::CopyTo(const events_info::CopyInfoRequest& req) {
+  emit CopyStarted(req);
+  QEvent* ev = new events::CopyRequestEvent(this, req);
+  Notify(ev);
+}
+
+void IServer::DumpToFile(const events_info::DumpInfoRequest& req) {
+  emit DumpStarted(req);
+  QEvent* ev = new events::DumpRequestEvent(this, req);
+  Notify(ev);
+}
+
+void IServer::LoadDumpFromFile(const events_info::LoadDumpInfoRequest& req) {
+  emit LoadDumpStarted(req);
+  QEvent* ev = new events::LoadDumpRequestEvent(this, req);
+  Notify(ev);
+}
+
+void IServer::AnalyzeNamespaces(const events_info::AnalyzeNamespacesInfoRequest& req) {
+  emit AnalyzeNamespacesStarted(req);
+  QEvent* ev = new events::AnalyzeNamespacesRequestEvent(this, req);
+  Notify(ev);
+}
+
+void IServer::EstimateNamespacesSize(const events_info::EstimateNamespacesSizeInfoRequest& req) {
+  emit EstimateNamespacesSizeStarted(req);
+  QEvent* ev = new events::EstimateNamespacesSizeRequestEvent(this, req);
+  Notify(ev);
+}
+
+void IServer::LoadCollectionChunk(const events_info::LoadCollectionChunkRequest& req) {
+  emit LoadCollectionChunkStarted(req);
+  QEvent* ev = new events::LoadCollectionChunkRequestEvent(this, req);
+  Notify(ev);
+}
+
+void IServer::BulkOperation(const events_info::BulkOperationInfoRequest& req) {
+  emit BulkOperationStarted(req);
+  QEvent* ev = new events::BulkOperationRequestEvent(this, req);
+  Notify(ev);
+}
+
+void IServer::LoadValueSource(const events_info::LoadValueSourceRequest& req) {
+  emit LoadValueSourceStarted(req);
+  QEvent* ev = new events::LoadValueSourceRequestEvent(this, req);
+  Notify(ev);
+}
+
 void IServer::LoadServerInfo(const events_info::ServerInfoRequest& req) {
   emit LoadServerInfoStarted(req);
   QEvent* ev = new events::ServerInfoRequestEvent(this, req);
@@ -323,6 +399,44 @@ void IServer::customEvent(QEvent* event) {
     events::ChangeMaxConnectionResponceEvent* ev =
         static_cast<events::ChangeMaxConnectionResponceEvent*>(event);
     HandleChangeMaxConnectionEvent(ev);
+  } else if (type == static_cast<QEvent::Type>(events::ImportResponceEvent::EventType)) {
+    events::ImportResponceEvent* ev = static_cast<events::ImportResponceEvent*>(event);
+    HandleImportEvent(ev);
+  } else if (type == static_cast<QEvent::Type>(events::MigrateResponceEvent::EventType)) {
+    events::MigrateResponceEvent* ev = static_cast<events::MigrateResponceEvent*>(event);
+    HandleMigrateEvent(ev);
+  } else if (type == static_cast<QEvent::Type>(events::CopyResponceEvent::EventType)) {
+    events::CopyResponceEvent* ev = static_cast<events::CopyResponceEvent*>(event);
+    HandleCopyEvent(ev);
+  } else if (type == static_cast<QEvent::Type>(events::DumpResponceEvent::EventType)) {
+    events::DumpResponceEvent* ev = static_cast<events::DumpResponceEvent*>(event);
+    HandleDumpEvent(ev);
+  } else if (type == static_cast<QEvent::Type>(events::LoadDumpResponceEvent::EventType)) {
+    events::LoadDumpResponceEvent* ev = static_cast<events::LoadDumpResponceEvent*>(event);
+    HandleLoadDumpEvent(ev);
+  } else if (type ==
+             static_cast<QEvent::Type>(events::AnalyzeNamespacesResponceEvent::EventType)) {
+    events::AnalyzeNamespacesResponceEvent* ev =
+        static_cast<events::AnalyzeNamespacesResponceEvent*>(event);
+    HandleAnalyzeNamespacesEvent(ev);
+  } else if (type ==
+             static_cast<QEvent::Type>(events::EstimateNamespacesSizeResponceEvent::EventType)) {
+    events::EstimateNamespacesSizeResponceEvent* ev =
+        static_cast<events::EstimateNamespacesSizeResponceEvent*>(event);
+    HandleEstimateNamespacesSizeEvent(ev);
+  } else if (type ==
+             static_cast<QEvent::Type>(events::LoadCollectionChunkResponceEvent::EventType)) {
+    events::LoadCollectionChunkResponceEvent* ev =
+        static_cast<events::LoadCollectionChunkResponceEvent*>(event);
+    HandleLoadCollectionChunkEvent(ev);
+  } else if (type == static_cast<QEvent::Type>(events::BulkOperationResponceEvent::EventType)) {
+    events::BulkOperationResponceEvent* ev =
+        static_cast<events::BulkOperationResponceEvent*>(event);
+    HandleBulkOperationEvent(ev);
+  } else if (type == static_cast<QEvent::Type>(events::LoadValueSourceResponceEvent::EventType)) {
+    events::LoadValueSourceResponceEvent* ev =
+        static_cast<events::LoadValueSourceResponceEvent*>(event);
+    HandleLoadValueSourceEvent(ev);
   } else if (type ==
              static_cast<QEvent::Type>(events::LoadDatabaseContentResponceEvent::EventType)) {
     events::LoadDatabaseContentResponceEvent* ev =
@@ -426,6 +540,8 @@ void IServer::HandleBackupEvent(events::BackupResponceEvent* ev) {
   common::Error er(v.errorInfo());
   if (er && er->IsError()) {
     LOG_ERROR(er, true);
+  } else {
+    LogBackupStats("Backup", v.stats);
   }
   emit BackupFinished(v);
 }
@@ -435,6 +551,8 @@ void IServer::HandleExportEvent(events::ExportResponceEvent* ev) {
   common::Error er(v.errorInfo());
   if (er && er->IsError()) {
     LOG_ERROR(er, true);
+  } else {
+    LogBackupStats("Restore", v.stats);
   }
   emit ExportFinished(v);
 }
@@ -459,6 +577,135 @@ void IServer::HandleChangeMaxConnectionEvent(events::ChangeMaxConnectionResponce
   emit ChangeMaxConnectionFinished(v);
 }
 
+void IServer::HandleImportEvent(events::ImportResponceEvent* ev) {
+  auto v = ev->value();
+  common::Error er(v.errorInfo());
+  if (er && er->IsError()) {
+    LOG_ERROR(er, true);
+  }
+
+  for (size_t i = 0; i < v.stats.error_lines.size(); ++i) {
+    common::Error line_er =
+        common::make_error_value(v.stats.error_lines[i], common::ErrorValue::E_ERROR);
+    LOG_ERROR(line_er, false);
+  }
+
+  emit ImportFinished(v);
+}
+
+void IServer::HandleMigrateEvent(events::MigrateResponceEvent* ev) {
+  auto v = ev->value();
+  common::Error er(v.errorInfo());
+  if (er && er->IsError()) {
+    LOG_ERROR(er, true);
+  }
+
+  for (size_t i = 0; i < v.error_keys.size(); ++i) {
+    common::Error key_er = common::make_error_value(v.error_keys[i], common::ErrorValue::E_ERROR);
+    LOG_ERROR(key_er, false);
+  }
+
+  emit MigrateFinished(v);
+}
+
+void IServer::HandleCopyEvent(events::CopyResponceEvent* ev) {
+  auto v = ev->value();
+  common::Error er(v.errorInfo());
+  if (er && er->IsError()) {
+    LOG_ERROR(er, true);
+  }
+
+  for (size_t i = 0; i < v.stats.error_keys.size(); ++i) {
+    common::Error key_er =
+        common::make_error_value(v.stats.error_keys[i], common::ErrorValue::E_ERROR);
+    LOG_ERROR(key_er, false);
+  }
+
+  emit CopyFinished(v);
+}
+
+void IServer::HandleDumpEvent(events::DumpResponceEvent* ev) {
+  auto v = ev->value();
+  common::Error er(v.errorInfo());
+  if (er && er->IsError()) {
+    LOG_ERROR(er, true);
+  }
+
+  for (size_t i = 0; i < v.stats.error_keys.size(); ++i) {
+    common::Error key_er =
+        common::make_error_value(v.stats.error_keys[i], common::ErrorValue::E_ERROR);
+    LOG_ERROR(key_er, false);
+  }
+
+  emit DumpFinished(v);
+}
+
+void IServer::HandleLoadDumpEvent(events::LoadDumpResponceEvent* ev) {
+  auto v = ev->value();
+  common::Error er(v.errorInfo());
+  if (er && er->IsError()) {
+    LOG_ERROR(er, true);
+  }
+
+  for (size_t i = 0; i < v.stats.error_keys.size(); ++i) {
+    common::Error key_er =
+        common::make_error_value(v.stats.error_keys[i], common::ErrorValue::E_ERROR);
+    LOG_ERROR(key_er, false);
+  }
+
+  emit LoadDumpFinished(v);
+}
+
+void IServer::HandleAnalyzeNamespacesEvent(events::AnalyzeNamespacesResponceEvent* ev) {
+  auto v = ev->value();
+  common::Error er(v.errorInfo());
+  if (er && er->IsError()) {
+    LOG_ERROR(er, true);
+  }
+
+  emit AnalyzeNamespacesFinished(v);
+}
+
+void IServer::HandleEstimateNamespacesSizeEvent(events::EstimateNamespacesSizeResponceEvent* ev) {
+  auto v = ev->value();
+  common::Error er(v.errorInfo());
+  if (er && er->IsError()) {
+    LOG_ERROR(er, true);
+  }
+
+  emit EstimateNamespacesSizeFinished(v);
+}
+
+void IServer::HandleLoadCollectionChunkEvent(events::LoadCollectionChunkResponceEvent* ev) {
+  auto v = ev->value();
+  common::Error er(v.errorInfo());
+  if (er && er->IsError()) {
+    LOG_ERROR(er, true);
+  }
+
+  emit LoadCollectionChunkFinished(v);
+}
+
+void IServer::HandleBulkOperationEvent(events::BulkOperationResponceEvent* ev) {
+  auto v = ev->value();
+  common::Error er(v.errorInfo());
+  if (er && er->IsError()) {
+    LOG_ERROR(er, true);
+  }
+
+  emit BulkOperationFinished(v);
+}
+
+void IServer::HandleLoadValueSourceEvent(events::LoadValueSourceResponceEvent* ev) {
+  auto v = ev->value();
+  common::Error er(v.errorInfo());
+  if (er && er->IsError()) {
+    LOG_ERROR(er, true);
+  }
+
+  emit LoadValueSourceFinished(v);
+}
+
 void IServer::HandleExecuteEvent(events::ExecuteResponceEvent* ev) {
   auto v = ev->value();
   common::Error er(v.errorInfo());
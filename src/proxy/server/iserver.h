@@ -93,6 +93,36 @@ class IServer : public IServerBase, public std::enable_shared_from_this<IServer>
   void ChangeMaxConnectionStarted(const events_info::ChangeMaxConnectionRequest& req);
   void ChangeMaxConnectionFinished(const events_info::ChangeMaxConnectionResponce& res);
 
+  void ImportStarted(const events_info::ImportInfoRequest& req);
+  void ImportFinished(const events_info::ImportInfoResponce& res);
+
+  void MigrateStarted(const events_info::MigrateInfoRequest& req);
+  void MigrateFinished(const events_info::MigrateInfoResponce& res);
+
+  void CopyStarted(const events_info::CopyInfoRequest& req);
+  void CopyFinished(const events_info::CopyInfoResponce& res);
+
+  void DumpStarted(const events_info::DumpInfoRequest& req);
+  void DumpFinished(const events_info::DumpInfoResponce& res);
+
+  void LoadDumpStarted(const events_info::LoadDumpInfoRequest& req);
+  void LoadDumpFinished(const events_info::LoadDumpInfoResponce& res);
+
+  void AnalyzeNamespacesStarted(const events_info::AnalyzeNamespacesInfoRequest& req);
+  void AnalyzeNamespacesFinished(const events_info::AnalyzeNamespacesInfoResponce& res);
+
+  void EstimateNamespacesSizeStarted(const events_info::EstimateNamespacesSizeInfoRequest& req);
+  void EstimateNamespacesSizeFinished(const events_info::EstimateNamespacesSizeInfoResponce& res);
+
+  void LoadCollectionChunkStarted(const events_info::LoadCollectionChunkRequest& req);
+  void LoadCollectionChunkFinished(const events_info::LoadCollectionChunkResponce& res);
+
+  void BulkOperationStarted(const events_info::BulkOperationInfoRequest& req);
+  void BulkOperationFinished(const events_info::BulkOperationInfoResponce& res);
+
+  void LoadValueSourceStarted(const events_info::LoadValueSourceRequest& req);
+  void LoadValueSourceFinished(const events_info::LoadValueSourceResponce& res);
+
   void ExecuteStarted(const events_info::ExecuteInfoRequest& req);
   void ExecuteFinished(const events_info::ExecuteInfoResponce& res);
 
@@ -171,6 +201,26 @@ class IServer : public IServerBase, public std::enable_shared_from_this<IServer>
   void SetMaxConnection(
       const events_info::ChangeMaxConnectionRequest& req);  // signals: ChangeMaxConnectionStarted,
                                                             // ChangeMaxConnectionFinished
+  void ImportFromFile(
+      const events_info::ImportInfoRequest& req);  // signals: ImportStarted, ImportFinished
+  void MigrateTo(
+      const events_info::MigrateInfoRequest& req);  // signals: MigrateStarted, MigrateFinished
+  void CopyTo(const events_info::CopyInfoRequest& req);  // signals: CopyStarted, CopyFinished
+  void DumpToFile(const events_info::DumpInfoRequest& req);  // signals: DumpStarted, DumpFinished
+  void LoadDumpFromFile(
+      const events_info::LoadDumpInfoRequest& req);  // signals: LoadDumpStarted, LoadDumpFinished
+  void AnalyzeNamespaces(const events_info::AnalyzeNamespacesInfoRequest&
+                             req);  // signals: AnalyzeNamespacesStarted, AnalyzeNamespacesFinished
+  void EstimateNamespacesSize(
+      const events_info::EstimateNamespacesSizeInfoRequest&
+          req);  // signals: EstimateNamespacesSizeStarted, EstimateNamespacesSizeFinished
+  void LoadCollectionChunk(const events_info::LoadCollectionChunkRequest&
+                               req);  // signals: LoadCollectionChunkStarted,
+                                      // LoadCollectionChunkFinished
+  void BulkOperation(const events_info::BulkOperationInfoRequest&
+                         req);  // signals: BulkOperationStarted, BulkOperationFinished
+  void LoadValueSource(const events_info::LoadValueSourceRequest&
+                           req);  // signals: LoadValueSourceStarted, LoadValueSourceFinished
   void LoadServerInfo(const events_info::ServerInfoRequest& req);  // signals:
   // LoadServerInfoStarted,
   // LoadServerInfoFinished
@@ -215,6 +265,16 @@ class IServer : public IServerBase, public std::enable_shared_from_this<IServer>
   virtual void HandleExportEvent(events::ExportResponceEvent* ev);
   virtual void HandleChangePasswordEvent(events::ChangePasswordResponceEvent* ev);
   virtual void HandleChangeMaxConnectionEvent(events::ChangeMaxConnectionResponceEvent* ev);
+  virtual void HandleImportEvent(events::ImportResponceEvent* ev);
+  virtual void HandleMigrateEvent(events::MigrateResponceEvent* ev);
+  virtual void HandleCopyEvent(events::CopyResponceEvent* ev);
+  virtual void HandleDumpEvent(events::DumpResponceEvent* ev);
+  virtual void HandleLoadDumpEvent(events::LoadDumpResponceEvent* ev);
+  virtual void HandleAnalyzeNamespacesEvent(events::AnalyzeNamespacesResponceEvent* ev);
+  virtual void HandleEstimateNamespacesSizeEvent(events::EstimateNamespacesSizeResponceEvent* ev);
+  virtual void HandleLoadCollectionChunkEvent(events::LoadCollectionChunkResponceEvent* ev);
+  virtual void HandleBulkOperationEvent(events::BulkOperationResponceEvent* ev);
+  virtual void HandleLoadValueSourceEvent(events::LoadValueSourceResponceEvent* ev);
   virtual void HandleExecuteEvent(events::ExecuteResponceEvent* ev);
 
   // handle database events
@@ -27,6 +27,7 @@
 #include <common/value.h>      // for ErrorValue, etc
 
 #include "core/connection_types.h"  // for core::connectionTypes, etc
+#include "core/copy_pipeline.h"     // for CDBCopyTarget
 #include "proxy/cluster/icluster.h"
 #include "proxy/sentinel/isentinel.h"  // for Sentinel
 
@@ -82,6 +83,23 @@
 
 namespace fastonosql {
 namespace proxy {
+namespace {
+
+template <typename DBConnection>
+common::Error makeCopyTarget(const typename DBConnection::config_t& config,
+                             core::ICopyTarget** target) {
+  DBConnection* db = new DBConnection(nullptr);
+  common::Error err = db->Connect(config);
+  if (err && err->IsError()) {
+    delete db;
+    return err;
+  }
+
+  *target = new core::CDBCopyTarget<DBConnection>(db, true);
+  return common::Error();
+}
+
+}  // namespace
 
 ServersManager::ServersManager() {}
 
@@ -259,6 +277,72 @@ common::Error ServersManager::TestConnection(IConnectionSettingsBaseSPtr connect
   return common::make_error_value("Invalid setting type", common::ErrorValue::E_ERROR);
 }
 
+common::Error ServersManager::CreateCopyTarget(IConnectionSettingsBaseSPtr connection,
+                                               core::ICopyTarget** target) {
+  if (!connection || !target) {
+    return common::make_error_value("Invalid input argument(s)", common::ErrorValue::E_ERROR);
+  }
+
+  core::connectionTypes type = connection->Type();
+#ifdef BUILD_WITH_REDIS
+  if (type == core::REDIS) {
+    redis::ConnectionSettings* settings = static_cast<redis::ConnectionSettings*>(connection.get());
+    core::redis::RConfig rconfig(settings->Info(), settings->SSHInfo());
+    return makeCopyTarget<core::redis::DBConnection>(rconfig, target);
+  }
+#endif
+#ifdef BUILD_WITH_MEMCACHED
+  if (type == core::MEMCACHED) {
+    memcached::ConnectionSettings* settings =
+        static_cast<memcached::ConnectionSettings*>(connection.get());
+    return makeCopyTarget<core::memcached::DBConnection>(settings->Info(), target);
+  }
+#endif
+#ifdef BUILD_WITH_SSDB
+  if (type == core::SSDB) {
+    ssdb::ConnectionSettings* settings = static_cast<ssdb::ConnectionSettings*>(connection.get());
+    return makeCopyTarget<core::ssdb::DBConnection>(settings->Info(), target);
+  }
+#endif
+#ifdef BUILD_WITH_LEVELDB
+  if (type == core::LEVELDB) {
+    leveldb::ConnectionSettings* settings =
+        static_cast<leveldb::ConnectionSettings*>(connection.get());
+    return makeCopyTarget<core::leveldb::DBConnection>(settings->Info(), target);
+  }
+#endif
+#ifdef BUILD_WITH_ROCKSDB
+  if (type == core::ROCKSDB) {
+    rocksdb::ConnectionSettings* settings =
+        static_cast<rocksdb::ConnectionSettings*>(connection.get());
+    return makeCopyTarget<core::rocksdb::DBConnection>(settings->Info(), target);
+  }
+#endif
+#ifdef BUILD_WITH_UNQLITE
+  if (type == core::UNQLITE) {
+    unqlite::ConnectionSettings* settings =
+        static_cast<unqlite::ConnectionSettings*>(connection.get());
+    return makeCopyTarget<core::unqlite::DBConnection>(settings->Info(), target);
+  }
+#endif
+#ifdef BUILD_WITH_LMDB
+  if (type == core::LMDB) {
+    lmdb::ConnectionSettings* settings = static_cast<lmdb::ConnectionSettings*>(connection.get());
+    return makeCopyTarget<core::lmdb::DBConnection>(settings->Info(), target);
+  }
+#endif
+#ifdef BUILD_WITH_UPSCALEDB
+  if (type == core::UPSCALEDB) {
+    upscaledb::ConnectionSettings* settings =
+        static_cast<upscaledb::ConnectionSettings*>(connection.get());
+    return makeCopyTarget<core::upscaledb::DBConnection>(settings->Info(), target);
+  }
+#endif
+
+  NOTREACHED();
+  return common::make_error_value("Invalid setting type", common::ErrorValue::E_ERROR);
+}
+
 common::Error ServersManager::DiscoveryClusterConnection(
     IConnectionSettingsBaseSPtr connection,
     std::vector<core::ServerDiscoveryClusterInfoSPtr>* inf) {
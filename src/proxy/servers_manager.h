@@ -29,6 +29,7 @@
 #include "proxy/connection_settings/isentinel_connection_settings.h"
 
 #include "proxy/proxy_fwd.h"  // for IClusterSPtr, ISentinelSPtr, etc
+#include "core/copy_pipeline.h"  // for ICopyTarget
 #include "core/server/iserver_info.h"
 
 namespace fastonosql {
@@ -48,6 +49,9 @@ class ServersManager : public common::patterns::LazySingleton<ServersManager> {
   cluster_t CreateCluster(IClusterSettingsBaseSPtr settings);
 
   common::Error TestConnection(IConnectionSettingsBaseSPtr connection) WARN_UNUSED_RESULT;
+  // opens own connection, which is closed with target
+  common::Error CreateCopyTarget(IConnectionSettingsBaseSPtr connection,
+                                 core::ICopyTarget** target) WARN_UNUSED_RESULT;
   common::Error DiscoveryClusterConnection(IConnectionSettingsBaseSPtr connection,
                                            std::vector<core::ServerDiscoveryClusterInfoSPtr>* inf)
       WARN_UNUSED_RESULT;
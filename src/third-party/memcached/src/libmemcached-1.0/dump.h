@@ -45,6 +45,32 @@ extern "C" {
 LIBMEMCACHED_API
 memcached_return_t memcached_dump(memcached_st *ptr, memcached_dump_fn *function, void *context, uint32_t number_of_callbacks);
 
+#ifdef FASTO
+/*
+  Streams "lru_crawler metadump all" of every server, keys are passed
+  to callbacks while reading, expire_time is 0 for keys without expiration.
+  MEMCACHED_NOT_SUPPORTED if server has no lru crawler (< 1.4.31) or it is busy.
+*/
+LIBMEMCACHED_API
+memcached_return_t memcached_metadump(memcached_st *ptr, memcached_dump_fn *function, void *context, uint32_t number_of_callbacks);
+
+/*
+  Remaining ttl of key by meta get "mg <key> t" (memcached >= 1.5.19),
+  -1 for keys without expiration.
+  MEMCACHED_NOTFOUND for missing keys, MEMCACHED_NOT_SUPPORTED for older servers.
+*/
+LIBMEMCACHED_API
+memcached_return_t memcached_meta_ttl(memcached_st *ptr, const char *key, size_t key_length, int64_t *ttl);
+
+/*
+  Flushes buffered requests and waits for "version" reply of every server,
+  so all previous noreply writes are processed. Error lines answered to
+  them before version reply are counted in failures.
+*/
+LIBMEMCACHED_API
+memcached_return_t memcached_sync(memcached_st *ptr, uint64_t *failures);
+#endif
+
 
 #ifdef __cplusplus
 }
@@ -180,3 +180,287 @@ memcached_return_t memcached_dump(memcached_st *shell, memcached_dump_fn *callba
 
   return ascii_dump(ptr, callback, context, number_of_callbacks);
 }
+
+#ifdef FASTO
+static int metadump_hex_value(char c)
+{
+  if (c >= '0' and c <= '9')
+  {
+    return c - '0';
+  }
+  if (c >= 'a' and c <= 'f')
+  {
+    return c - 'a' + 10;
+  }
+  if (c >= 'A' and c <= 'F')
+  {
+    return c - 'A' + 10;
+  }
+  return -1;
+}
+
+/* uri encoded key takes up to 3 bytes per byte, exp/la/cas/fetch/cls/size fit in the rest */
+#define METADUMP_LINE_SIZE (3 * MEMCACHED_MAX_KEY + MEMCACHED_DEFAULT_COMMAND_SIZE)
+
+/* keys of metadump are uri encoded, decodes in place */
+static size_t metadump_uri_decode(char *str, size_t length)
+{
+  size_t out= 0;
+  for (size_t in= 0; in < length; in++, out++)
+  {
+    if (str[in] == '%' and in + 2 < length)
+    {
+      int hi= metadump_hex_value(str[in + 1]);
+      int lo= metadump_hex_value(str[in + 2]);
+      if (hi != -1 and lo != -1)
+      {
+        str[out]= char(hi * 16 + lo);
+        in+= 2;
+        continue;
+      }
+    }
+    str[out]= str[in];
+  }
+  return out;
+}
+
+static memcached_return_t ascii_metadump(Memcached *memc, memcached_dump_fn *callback, void *context, uint32_t number_of_callbacks)
+{
+  libmemcached_io_vector_st vector[]=
+  {
+    { memcached_literal_param("lru_crawler metadump all\r\n") }
+  };
+
+  for (uint32_t server_key= 0; server_key < memcached_server_count(memc); server_key++)
+  {
+    memcached_instance_st* instance= memcached_instance_fetch(memc, server_key);
+
+    memcached_return_t vdo_rc;
+    if (memcached_failed(vdo_rc= memcached_vdo(instance, vector, 1, true)))
+    {
+      return vdo_rc;
+    }
+
+    /* stream is read till END even if callback stopped, so connection stays in sync */
+    bool stopped= false;
+    bool first_line= true;
+    while (true)
+    {
+      char buffer[METADUMP_LINE_SIZE];
+      size_t total_read= 0;
+      memcached_return_t rc= memcached_io_readline(instance, buffer, sizeof(buffer), total_read);
+      if (memcached_failed(rc))
+      {
+        return rc;
+      }
+
+      size_t length= total_read;
+      while (length and (buffer[length - 1] == '\n' or buffer[length - 1] == '\r'))
+      {
+        length--;
+      }
+      buffer[length]= 0;
+
+      if (strcmp(buffer, "END") == 0)
+      {
+        break;
+      }
+
+      if (strncmp(buffer, "key=", 4) != 0)
+      {
+        if (first_line)
+        {
+          /* ERROR, BUSY or CLIENT_ERROR: there is no stream to drain */
+          return memcached_set_error(*instance, MEMCACHED_NOT_SUPPORTED, MEMCACHED_AT,
+                                     memcached_literal_param("lru_crawler metadump is not available"));
+        }
+        continue;
+      }
+      first_line= false;
+
+      if (stopped)
+      {
+        continue;
+      }
+
+      char *key= buffer + 4;
+      char *key_end= strchr(key, ' ');
+      if (key_end == NULL)
+      {
+        continue;
+      }
+      *key_end= 0;
+
+      long long expire_time= 0;
+      char *exp_ptr= strstr(key_end + 1, "exp=");
+      if (exp_ptr)
+      {
+        expire_time= strtoll(exp_ptr + 4, NULL, 10);
+      }
+      if (expire_time < 0)
+      {
+        expire_time= 0;
+      }
+
+      size_t key_length= metadump_uri_decode(key, size_t(key_end - key));
+      for (uint32_t callback_counter= 0; callback_counter < number_of_callbacks; callback_counter++)
+      {
+        memcached_return_t callback_rc= (*callback[callback_counter])(memc, key, key_length, time_t(expire_time), context);
+        if (callback_rc != MEMCACHED_SUCCESS)
+        {
+          stopped= true;
+          if (callback_rc != MEMCACHED_END)
+          {
+            memcached_set_error(*instance, callback_rc, MEMCACHED_AT);
+          }
+          break;
+        }
+      }
+    }
+  }
+
+  return memcached_has_current_error(*memc) ? MEMCACHED_SOME_ERRORS : MEMCACHED_SUCCESS;
+}
+
+memcached_return_t memcached_metadump(memcached_st *shell, memcached_dump_fn *callback, void *context, uint32_t number_of_callbacks)
+{
+  Memcached* ptr= memcached2Memcached(shell);
+  memcached_return_t rc;
+  if (memcached_failed(rc= initialize_query(ptr, true)))
+  {
+    return rc;
+  }
+
+  if (memcached_is_binary(ptr))
+  {
+    return memcached_set_error(*ptr, MEMCACHED_NOT_SUPPORTED, MEMCACHED_AT, memcached_literal_param("Binary protocol is not supported for memcached_metadump()"));
+  }
+
+  return ascii_metadump(ptr, callback, context, number_of_callbacks);
+}
+
+memcached_return_t memcached_meta_ttl(memcached_st *shell, const char *key, size_t key_length, int64_t *ttl)
+{
+  Memcached* ptr= memcached2Memcached(shell);
+  memcached_return_t rc;
+  if (memcached_failed(rc= initialize_query(ptr, true)))
+  {
+    return rc;
+  }
+
+  if (ttl == NULL or key == NULL or key_length == 0)
+  {
+    return memcached_set_error(*ptr, MEMCACHED_INVALID_ARGUMENTS, MEMCACHED_AT);
+  }
+
+  if (memcached_is_binary(ptr))
+  {
+    return memcached_set_error(*ptr, MEMCACHED_NOT_SUPPORTED, MEMCACHED_AT, memcached_literal_param("Binary protocol is not supported for memcached_meta_ttl()"));
+  }
+
+  uint32_t server_key= memcached_generate_hash_with_redistribution(ptr, key, key_length);
+  memcached_instance_st* instance= memcached_instance_fetch(ptr, server_key);
+
+  libmemcached_io_vector_st vector[]=
+  {
+    { memcached_literal_param("mg ") },
+    { key, key_length },
+    { memcached_literal_param(" t\r\n") }
+  };
+
+  if (memcached_failed(rc= memcached_vdo(instance, vector, 3, true)))
+  {
+    return rc;
+  }
+
+  char buffer[MEMCACHED_DEFAULT_COMMAND_SIZE];
+  size_t total_read= 0;
+  if (memcached_failed(rc= memcached_io_readline(instance, buffer, sizeof(buffer) - 1, total_read)))
+  {
+    return rc;
+  }
+  buffer[total_read]= 0;
+
+  if (strncmp(buffer, "EN", 2) == 0)
+  {
+    return MEMCACHED_NOTFOUND;
+  }
+
+  /* HD t<ttl> without value, VA is answered only if value was requested */
+  if (strncmp(buffer, "HD", 2) != 0)
+  {
+    return memcached_set_error(*instance, MEMCACHED_NOT_SUPPORTED, MEMCACHED_AT,
+                               memcached_literal_param("meta commands are not available"));
+  }
+
+  char *flag= strstr(buffer + 2, " t");
+  if (flag == NULL)
+  {
+    return memcached_set_error(*instance, MEMCACHED_PROTOCOL_ERROR, MEMCACHED_AT);
+  }
+
+  *ttl= strtoll(flag + 2, NULL, 10);
+  return MEMCACHED_SUCCESS;
+}
+
+memcached_return_t memcached_sync(memcached_st *shell, uint64_t *failures)
+{
+  Memcached* ptr= memcached2Memcached(shell);
+  memcached_return_t rc;
+  if (memcached_failed(rc= initialize_query(ptr, true)))
+  {
+    return rc;
+  }
+
+  if (failures == NULL)
+  {
+    return memcached_set_error(*ptr, MEMCACHED_INVALID_ARGUMENTS, MEMCACHED_AT);
+  }
+
+  if (memcached_is_binary(ptr))
+  {
+    return memcached_set_error(*ptr, MEMCACHED_NOT_SUPPORTED, MEMCACHED_AT, memcached_literal_param("Binary protocol is not supported for memcached_sync()"));
+  }
+
+  libmemcached_io_vector_st vector[]=
+  {
+    { memcached_literal_param("version\r\n") }
+  };
+
+  *failures= 0;
+  for (uint32_t server_key= 0; server_key < memcached_server_count(ptr); server_key++)
+  {
+    memcached_instance_st* instance= memcached_instance_fetch(ptr, server_key);
+
+    /* buffered writes go out first, replies come in order of requests */
+    if (memcached_failed(rc= memcached_vdo(instance, vector, 1, true)))
+    {
+      return rc;
+    }
+
+    while (true)
+    {
+      char buffer[MEMCACHED_DEFAULT_COMMAND_SIZE];
+      size_t total_read= 0;
+      if (memcached_failed(rc= memcached_io_readline(instance, buffer, sizeof(buffer) - 1, total_read)))
+      {
+        return rc;
+      }
+      buffer[total_read]= 0;
+
+      if (strncmp(buffer, "VERSION", 7) == 0)
+      {
+        break;
+      }
+
+      if (strncmp(buffer, "ERROR", 5) == 0 or strncmp(buffer, "CLIENT_ERROR", 12) == 0 or
+          strncmp(buffer, "SERVER_ERROR", 12) == 0)
+      {
+        (*failures)++;
+      }
+    }
+  }
+
+  return MEMCACHED_SUCCESS;
+}
+#endif
@@ -250,6 +250,13 @@ public:
 	virtual Status qclear(const std::string &name, int64_t *ret=NULL) = 0;
 #ifdef FASTO
     virtual Status info(const std::string &args, std::vector<std::string> *ret) = 0;
+    /**
+     * Sends all requests before reading the first response,
+     * resps[n] is the response of reqs[n].
+     * Returns error status only if the link is broken.
+     */
+    virtual Status pipeline(const std::vector<std::vector<std::string> > &reqs,
+                            std::vector<std::vector<std::string> > *resps) = 0;
 #endif
 private:
 	// No copying allowed
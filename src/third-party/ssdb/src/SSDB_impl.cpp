@@ -659,6 +659,33 @@ Status ClientImpl::qclear(const std::string &name, int64_t *ret){
         }
         return s;
     }
+
+    Status ClientImpl::pipeline(const std::vector<std::vector<std::string> > &reqs,
+                                std::vector<std::vector<std::string> > *resps)
+    {
+        for(size_t i = 0; i < reqs.size(); i++){
+            if(link->send(reqs[i]) == -1){
+                return Status("error");
+            }
+        }
+        if(link->flush() == -1){
+            return Status("error");
+        }
+
+        // packet points into input buffer, it is copied before next response
+        for(size_t i = 0; i < reqs.size(); i++){
+            const std::vector<Bytes> *packet = link->response();
+            if(packet == NULL){
+                return Status("error");
+            }
+            std::vector<std::string> resp;
+            for(std::vector<Bytes>::const_iterator it = packet->begin(); it != packet->end(); it++){
+                resp.push_back(it->String());
+            }
+            resps->push_back(resp);
+        }
+        return Status("ok");
+    }
 #endif
 
 }; // namespace ssdb
@@ -26,6 +26,8 @@ namespace translations {
 const QString trfilterForScripts = QObject::tr("Text Files (*.txt);; All Files (*.*)");
 const QString trfilterForAll = QObject::tr("All Files (*.*)");
 const QString trfilterForRdb = QObject::tr("Redis database files (*.rdb)");
+const QString trfilterForImport =
+    QObject::tr("Commands (*.txt);; CSV (*.csv);; JSON lines (*.json *.jsonl)");
 
 const QString trBasic = QObject::tr("Basic");
 const QString trAdvanced = QObject::tr("Advanced");
@@ -52,6 +54,7 @@ const QString trInfo = QObject::tr("Info");
 const QString trTools = QObject::tr("Tools");
 const QString trLoadFromFile = QObject::tr("Load from file...");
 const QString trImport = QObject::tr("Import");
+const QString trMassImport = QObject::tr("Mass import...");
 const QString trExport = QObject::tr("Export...");
 const QString trProperty = QObject::tr("Property");
 const QString trSetPassword = QObject::tr("Set password");
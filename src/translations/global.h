@@ -26,6 +26,7 @@ namespace translations {
 extern const QString trfilterForScripts;
 extern const QString trfilterForAll;
 extern const QString trfilterForRdb;
+extern const QString trfilterForImport;
 
 extern const QString trBasic;
 extern const QString trAdvanced;
@@ -51,6 +52,7 @@ extern const QString trFile;
 extern const QString trInfo;
 extern const QString trTools;
 extern const QString trImport;
+extern const QString trMassImport;
 extern const QString trExport;
 extern const QString trLoadFromFile;
 extern const QString trProperty;
@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+
+#include <map>
+
+#include <common/convert2string.h>
+
+#include "core/bulk_operation.h"
+
+using namespace fastonosql::core;
+
+namespace {
+
+class MapTarget : public IBulkTarget {
+ public:
+  MapTarget() : batches(0), data() {}
+
+  virtual common::Error Scan(uint64_t cursor_in,
+                             const std::string& pattern,
+                             uint64_t count_keys,
+                             std::vector<std::string>* keys_out,
+                             uint64_t* cursor_out) override {
+    UNUSED(pattern);
+    uint64_t pos = 0;
+    for (auto it = data.begin(); it != data.end(); ++it, ++pos) {
+      if (pos >= cursor_in && keys_out->size() < count_keys) {
+        keys_out->push_back(it->first);
+      }
+    }
+    uint64_t next = cursor_in + keys_out->size();
+    *cursor_out = next >= data.size() ? 0 : next;
+    return common::Error();
+  }
+
+  virtual common::Error DBkcount(size_t* size) override {
+    *size = data.size();
+    return common::Error();
+  }
+
+  virtual common::Error Delete(const NKeys& keys, NKeys* deleted_keys) override {
+    batches++;
+    for (size_t i = 0; i < keys.size(); ++i) {
+      if (data.erase(keys[i].Key())) {
+        deleted_keys->push_back(keys[i]);
+      }
+    }
+    return common::Error();
+  }
+
+  virtual common::Error SetTTL(const NKeys& keys, ttl_t ttl, NKeys* changed_keys) override {
+    batches++;
+    for (size_t i = 0; i < keys.size(); ++i) {
+      data[keys[i].Key()] = ttl;
+      changed_keys->push_back(keys[i]);
+    }
+    return common::Error();
+  }
+
+  virtual common::Error Rename(const NKeys& keys,
+                               const std::vector<std::string>& new_keys,
+                               NKeys* renamed_keys) override {
+    batches++;
+    for (size_t i = 0; i < keys.size(); ++i) {
+      ttl_t ttl = data[keys[i].Key()];
+      data.erase(keys[i].Key());
+      data[new_keys[i]] = ttl;
+      renamed_keys->push_back(keys[i]);
+    }
+    return common::Error();
+  }
+
+  size_t batches;
+  std::map<std::string, ttl_t> data;
+};
+
+}  // namespace
+
+TEST(BulkOperation, RewriteKeyPrefix) {
+  std::string new_key;
+  ASSERT_TRUE(RewriteKeyPrefix("user:1", "user:", "client:", &new_key));
+  ASSERT_EQ(new_key, "client:1");
+  ASSERT_FALSE(RewriteKeyPrefix("order:1", "user:", "client:", &new_key));
+  ASSERT_FALSE(RewriteKeyPrefix("user:old:1", "user:", "user:old:", &new_key));
+}
+
+TEST(BulkOperation, DryRunAndRename) {
+  MapTarget target;
+  for (int i = 0; i < 10; ++i) {
+    target.data["user:" + common::ConvertToString(i)] = NO_TTL;
+    target.data["order:" + common::ConvertToString(i)] = NO_TTL;
+  }
+
+  BulkOptions options;
+  options.type = BULK_RENAME;
+  options.old_prefix = "user:";
+  options.new_prefix = "client:";
+  options.batch_size = 4;
+  options.dry_run = true;
+  BulkStats stats;
+  common::Error err = BulkOperation(&target, options)
+                          .Run(BulkOperation::interrupt_callback_t(),
+                               BulkOperation::progress_callback_t(), &stats);
+  ASSERT_FALSE(err && err->IsError());
+  ASSERT_EQ(stats.scanned, 20u);
+  ASSERT_EQ(stats.matched, 10u);
+  ASSERT_EQ(stats.processed, 0u);
+  ASSERT_EQ(target.batches, 0u);
+
+  options.dry_run = false;
+  err = BulkOperation(&target, options)
+            .Run(BulkOperation::interrupt_callback_t(), BulkOperation::progress_callback_t(),
+                 &stats);
+  ASSERT_FALSE(err && err->IsError());
+  ASSERT_EQ(stats.processed, 10u);
+  ASSERT_EQ(target.data.count("client:0"), 1u);
+  ASSERT_EQ(target.data.count("user:0"), 0u);
+  ASSERT_EQ(target.data.size(), 20u);
+}
+
+TEST(BulkOperation, DeleteManyPages) {
+  MapTarget target;
+  for (int i = 0; i < 25; ++i) {
+    target.data["user:" + common::ConvertToString(i)] = NO_TTL;
+  }
+
+  BulkOptions options;
+  options.type = BULK_DELETE;
+  options.batch_size = 4;
+  BulkStats stats;
+  common::Error err = BulkOperation(&target, options)
+                          .Run(BulkOperation::interrupt_callback_t(),
+                               BulkOperation::progress_callback_t(), &stats);
+  ASSERT_FALSE(err && err->IsError());
+  ASSERT_EQ(stats.processed, 25u);
+  ASSERT_EQ(stats.skipped, 0u);
+  ASSERT_TRUE(target.data.empty());
+}
@@ -0,0 +1,34 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "core/byte_source.h"
+
+using namespace fastonosql::core;
+
+TEST(ByteSource, ChunkedReadAcrossChunks) {
+  // pieces of odd size, so chunk borders fall inside of them
+  std::string data;
+  ChunkedByteSource source;
+  for (size_t i = 0; data.size() < 3 * BYTE_SOURCE_CHUNK_SIZE; ++i) {
+    std::string piece(1000 + i % 7, static_cast<char>('a' + i % 26));
+    source.Append(piece.data(), piece.size());
+    data += piece;
+  }
+  ASSERT_EQ(source.Size(), data.size());
+
+  const uint64_t offset = BYTE_SOURCE_CHUNK_SIZE - 10;
+  std::string out(BYTE_SOURCE_CHUNK_SIZE + 20, 0);
+  ASSERT_EQ(source.Read(offset, &out[0], out.size()), out.size());
+  ASSERT_EQ(out, data.substr(offset, out.size()));
+
+  std::string tail(100, 0);
+  size_t count = source.Read(data.size() - 30, &tail[0], tail.size());
+  ASSERT_EQ(count, 30u);
+  ASSERT_EQ(tail.substr(0, count), data.substr(data.size() - 30));
+  ASSERT_EQ(source.Read(data.size(), &tail[0], tail.size()), 0u);
+
+  std::string all(data.size(), 0);
+  ASSERT_EQ(source.Read(0, &all[0], all.size()), data.size());
+  ASSERT_EQ(all, data);
+}
@@ -0,0 +1,322 @@
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <map>
+#include <set>
+
+#include <common/convert2string.h>
+#include <common/file_system.h>
+
+#include "core/copy_pipeline.h"
+#include "core/dump_file.h"
+
+using namespace fastonosql::core;
+
+namespace {
+
+class MapSource : public ICopySource {
+ public:
+  explicit MapSource(const std::map<std::string, common::Value*>& data) : data_(data) {}
+  ~MapSource() {
+    for (auto it = data_.begin(); it != data_.end(); ++it) {
+      delete it->second;
+    }
+  }
+
+  virtual common::Error Scan(uint64_t cursor_in,
+                             const std::string& pattern,
+                             uint64_t count_keys,
+                             std::vector<std::string>* keys_out,
+                             uint64_t* cursor_out) override {
+    UNUSED(pattern);
+    uint64_t pos = 0;
+    for (auto it = data_.begin(); it != data_.end(); ++it, ++pos) {
+      if (pos >= cursor_in && keys_out->size() < count_keys) {
+        keys_out->push_back(it->first);
+      }
+    }
+    uint64_t next = cursor_in + keys_out->size();
+    *cursor_out = next >= data_.size() ? 0 : next;
+    return common::Error();
+  }
+
+  virtual common::Error Get(const NKey& key, NDbKValue* loaded_key) override {
+    if (removed.count(key.Key())) {
+      return MakeKeyNotFoundError(key.Key());
+    }
+    if (failed.count(key.Key())) {
+      return common::make_error_value("get function error", common::ErrorValue::E_ERROR);
+    }
+
+    common::Value* val = data_[key.Key()];
+    *loaded_key = NDbKValue(key, NValue(val ? val->DeepCopy() : common::Value::CreateNullValue()));
+    return common::Error();
+  }
+
+  virtual common::Error DBkcount(size_t* size) override {
+    *size = data_.size();
+    return common::Error();
+  }
+
+  virtual common::Error GetTTL(const NKey& key, ttl_t* ttl) override {
+    auto it = ttls.find(key.Key());
+    *ttl = it == ttls.end() ? NO_TTL : it->second;
+    return common::Error();
+  }
+
+  std::map<std::string, ttl_t> ttls;
+  std::set<std::string> removed;  // deleted between scan and get
+  std::set<std::string> failed;
+
+ private:
+  std::map<std::string, common::Value*> data_;
+};
+
+class MapTarget : public ICopyTarget {
+ public:
+  MapTarget() : batches(0), data() {}
+
+  virtual bool IsSupportedType(common::Value::Type type) const override {
+    return type == common::Value::TYPE_STRING;
+  }
+
+  virtual common::Error SetBatch(const NDbKValues& keys, NDbKValues* added_keys) override {
+    batches++;
+    for (size_t i = 0; i < keys.size(); ++i) {
+      data[keys[i].KeyString()] = keys[i].ValueString();
+      added_keys->push_back(keys[i]);
+    }
+    return common::Error();
+  }
+
+  size_t batches;
+  std::map<std::string, std::string> data;
+};
+
+std::string TempPath(const std::string& name) {
+  return std::string(PROJECT_TEST_TEMP_DIR) + common::file_system::get_separator_string<char>() +
+         name;
+}
+
+common::Error WriteDump(const std::string& path, size_t keys_count) {
+  std::map<std::string, common::Value*> data;
+  for (size_t i = 0; i < keys_count; ++i) {
+    data["key" + common::ConvertToString(i)] = common::Value::CreateStringValue("value");
+  }
+
+  MapSource source(data);
+  DumpOptions dump_options;
+  dump_options.block_size = 1024;
+  DumpWriter writer(dump_options);
+  common::Error err = writer.Open(path);
+  if (err && err->IsError()) {
+    return err;
+  }
+
+  CopyStats stats;
+  CopyPipeline dump(&source, &writer, CopyOptions());
+  err = dump.Run(CopyPipeline::interrupt_callback_t(), CopyPipeline::progress_callback_t(), &stats);
+  common::Error close_err = writer.Close();
+  if (err && err->IsError()) {
+    return err;
+  }
+  return close_err;
+}
+
+// inverts one byte of file
+void CorruptByte(const std::string& path, std::streamoff offset) {
+  std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+  file.seekg(offset);
+  char byte = 0;
+  file.read(&byte, 1);
+  byte = ~byte;
+  file.seekp(offset);
+  file.write(&byte, 1);
+}
+
+}  // namespace
+
+TEST(CopyPipeline, CopyAllKeys) {
+  std::map<std::string, common::Value*> data;
+  for (int i = 0; i < 25; ++i) {
+    data["key" + common::ConvertToString(i)] = common::Value::CreateStringValue("value");
+  }
+  data["number"] = common::Value::CreateIntegerValue(42);
+  data["removed"] = nullptr;
+
+  MapSource source(data);
+  MapTarget target;
+  CopyOptions options;
+  options.batch_size = 10;
+  options.queue_size = 1;
+  CopyPipeline pipeline(&source, &target, options);
+  CopyStats stats;
+  common::Error err = pipeline.Run(CopyPipeline::interrupt_callback_t(),
+                                   CopyPipeline::progress_callback_t(), &stats);
+  ASSERT_FALSE(err && err->IsError());
+  ASSERT_EQ(stats.scanned, 27u);
+  ASSERT_EQ(stats.copied, 26u);
+  ASSERT_EQ(stats.skipped, 1u);
+  ASSERT_EQ(stats.converted, 1u);
+  ASSERT_EQ(target.data.size(), 26u);
+  ASSERT_EQ(target.data["number"], "42");
+  ASSERT_EQ(target.batches, 3u);
+}
+
+TEST(CopyPipeline, RemovedKeysAreSkipped) {
+  std::map<std::string, common::Value*> data;
+  for (int i = 0; i < 10; ++i) {
+    data["key" + common::ConvertToString(i)] = common::Value::CreateStringValue("value");
+  }
+
+  MapSource source(data);
+  source.removed.insert("key3");
+  source.failed.insert("key5");
+  source.ttls["key7"] = EXPIRED_TTL;
+  MapTarget target;
+  CopyOptions options;
+  options.with_ttl = true;
+  CopyPipeline pipeline(&source, &target, options);
+  CopyStats stats;
+  common::Error err = pipeline.Run(CopyPipeline::interrupt_callback_t(),
+                                   CopyPipeline::progress_callback_t(), &stats);
+  ASSERT_FALSE(err && err->IsError());
+  ASSERT_EQ(stats.scanned, 10u);
+  ASSERT_EQ(stats.copied, 7u);
+  ASSERT_EQ(stats.skipped, 2u);
+  ASSERT_EQ(stats.errors, 1u);
+  ASSERT_EQ(stats.error_keys.size(), 1u);
+  ASSERT_EQ(target.data.count("key3"), 0u);
+  ASSERT_EQ(target.data.count("key7"), 0u);
+}
+
+TEST(CopyPipeline, Interrupt) {
+  std::map<std::string, common::Value*> data;
+  for (int i = 0; i < 100; ++i) {
+    data["key" + common::ConvertToString(i)] = common::Value::CreateStringValue("value");
+  }
+
+  MapSource source(data);
+  MapTarget target;
+  CopyOptions options;
+  options.batch_size = 10;
+  CopyPipeline pipeline(&source, &target, options);
+  CopyStats stats;
+  common::Error err =
+      pipeline.Run([]() { return true; }, CopyPipeline::progress_callback_t(), &stats);
+  ASSERT_TRUE(err && err->IsError());
+  ASSERT_EQ(stats.copied, 0u);
+  ASSERT_EQ(target.batches, 0u);
+}
+
+TEST(CopyPipeline, DumpRoundTrip) {
+  std::map<std::string, common::Value*> data;
+  for (int i = 0; i < 1000; ++i) {
+    data["key" + common::ConvertToString(i)] = common::Value::CreateStringValue("value");
+  }
+  data["number"] = common::Value::CreateIntegerValue(42);
+  common::HashValue* hash = common::Value::CreateHashValue();
+  hash->Insert(common::Value::CreateStringValue("field"), common::Value::CreateNullValue());
+  data["hash"] = hash;
+
+  const std::string path = TempPath("fastonosql_test_dump.fdump");
+  MapSource source(data);
+  source.ttls["number"] = 100;
+  DumpOptions dump_options;
+  dump_options.block_size = 1024;
+  DumpWriter writer(dump_options);
+  common::Error err = writer.Open(path);
+  ASSERT_FALSE(err && err->IsError());
+  CopyOptions options;
+  options.batch_size = 100;
+  options.with_ttl = true;
+  CopyStats stats;
+  CopyPipeline dump(&source, &writer, options);
+  err = dump.Run(CopyPipeline::interrupt_callback_t(), CopyPipeline::progress_callback_t(), &stats);
+  ASSERT_FALSE(err && err->IsError());
+  err = writer.Close();
+  ASSERT_FALSE(err && err->IsError());
+  ASSERT_EQ(writer.Records(), 1002u);
+  ASSERT_EQ(stats.converted, 0u);
+  ASSERT_EQ(stats.dropped_ttls, 0u);
+
+  DumpReader reader;
+  err = reader.Open(path);
+  ASSERT_FALSE(err && err->IsError());
+  ASSERT_GT(reader.Index().size(), 1u);
+  MapTarget target;
+  CopyPipeline load(&reader, &target, options);
+  err = load.Run(CopyPipeline::interrupt_callback_t(), CopyPipeline::progress_callback_t(), &stats);
+  ASSERT_FALSE(err && err->IsError());
+  ASSERT_EQ(stats.copied, 1002u);
+  ASSERT_EQ(stats.converted, 2u);
+  ASSERT_EQ(stats.dropped_ttls, 1u);
+  ASSERT_EQ(target.data["key7"], "value");
+  ASSERT_EQ(target.data["number"], "42");
+  reader.Close();
+
+  err = common::file_system::remove_file(path);
+  ASSERT_FALSE(err && err->IsError());
+}
+
+TEST(CopyPipeline, DumpNullValue) {
+  common::ArrayValue* array = common::Value::CreateArrayValue();
+  array->AppendString("value");
+  array->Append(common::Value::CreateNullValue());
+  std::string payload;
+  EncodeDumpValue(array, &payload);
+  delete array;
+
+  common::Value* decoded = nullptr;
+  common::Error err = DecodeDumpValue(common::Value::TYPE_ARRAY, payload, &decoded);
+  ASSERT_FALSE(err && err->IsError());
+  common::ArrayValue* decoded_array = static_cast<common::ArrayValue*>(decoded);
+  ASSERT_EQ(decoded_array->GetSize(), 2u);
+  common::Value* element = nullptr;
+  ASSERT_TRUE(decoded_array->Get(1, &element));
+  ASSERT_EQ(element->GetType(), common::Value::TYPE_NULL);
+  delete decoded;
+}
+
+TEST(CopyPipeline, DumpCorruptedBlock) {
+  const std::string path = TempPath("fastonosql_test_dump_block.fdump");
+  common::Error err = WriteDump(path, 100);
+  ASSERT_FALSE(err && err->IsError());
+  // first stored byte of first block after magic and block header
+  CorruptByte(path, 8 + 13);
+
+  DumpReader reader;
+  err = reader.Open(path);
+  ASSERT_FALSE(err && err->IsError());
+  MapTarget target;
+  CopyStats stats;
+  CopyPipeline load(&reader, &target, CopyOptions());
+  err = load.Run(CopyPipeline::interrupt_callback_t(), CopyPipeline::progress_callback_t(), &stats);
+  ASSERT_TRUE(err && err->IsError());
+  ASSERT_EQ(stats.copied, 0u);
+  reader.Close();
+
+  err = common::file_system::remove_file(path);
+  ASSERT_FALSE(err && err->IsError());
+}
+
+TEST(CopyPipeline, DumpCorruptedFooter) {
+  const std::string path = TempPath("fastonosql_test_dump_footer.fdump");
+  common::Error err = WriteDump(path, 100);
+  ASSERT_FALSE(err && err->IsError());
+  std::streamoff size = 0;
+  {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    size = file.tellg();
+  }
+  // crc32 of index in footer
+  CorruptByte(path, size - 32 + 12);
+
+  DumpReader reader;
+  err = reader.Open(path);
+  ASSERT_TRUE(err && err->IsError());
+  reader.Close();
+
+  err = common::file_system::remove_file(path);
+  ASSERT_FALSE(err && err->IsError());
+}
@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+
+#include "core/import_reader.h"
+
+using namespace fastonosql::core;
+
+TEST(ImportReader, ParseCommand) {
+  ImportRecord rec;
+  common::Error err = ParseImportLine(IMPORT_COMMANDS, "SET key \"hello world\"", &rec);
+  ASSERT_FALSE(err && err->IsError());
+  ASSERT_TRUE(rec.IsCommand());
+  ASSERT_EQ(rec.command.size(), 3u);
+  ASSERT_EQ(rec.command[0], "SET");
+  ASSERT_EQ(rec.command[2], "hello world");
+
+  ImportRecord invalid;
+  err = ParseImportLine(IMPORT_COMMANDS, "SET key \"hello", &invalid);
+  ASSERT_TRUE(err && err->IsError());
+}
+
+TEST(ImportReader, ParseCsv) {
+  ImportRecord rec;
+  common::Error err = ParseImportLine(IMPORT_CSV, "\"a,b\",\"say \"\"hi\"\"\",10", &rec);
+  ASSERT_FALSE(err && err->IsError());
+  ASSERT_FALSE(rec.IsCommand());
+  ASSERT_EQ(rec.key.Key(), "a,b");
+  ASSERT_EQ(rec.value, "say \"hi\"");
+  ASSERT_EQ(rec.key.TTL(), 10);
+
+  ImportRecord no_ttl;
+  err = ParseImportLine(IMPORT_CSV, "key,value", &no_ttl);
+  ASSERT_FALSE(err && err->IsError());
+  ASSERT_EQ(no_ttl.key.TTL(), NO_TTL);
+
+  ImportRecord invalid;
+  err = ParseImportLine(IMPORT_CSV, "key", &invalid);
+  ASSERT_TRUE(err && err->IsError());
+  err = ParseImportLine(IMPORT_CSV, "key,value,ttl", &invalid);
+  ASSERT_TRUE(err && err->IsError());
+}
+
+TEST(ImportReader, ParseJsonLines) {
+  ImportRecord rec;
+  common::Error err =
+      ParseImportLine(IMPORT_JSON_LINES, "{\"key\": \"k\", \"value\": \"v\", \"ttl\": 5}", &rec);
+  ASSERT_FALSE(err && err->IsError());
+  ASSERT_EQ(rec.key.Key(), "k");
+  ASSERT_EQ(rec.value, "v");
+  ASSERT_EQ(rec.key.TTL(), 5);
+
+  ImportRecord invalid;
+  err = ParseImportLine(IMPORT_JSON_LINES, "{\"key\": \"k\"}", &invalid);
+  ASSERT_TRUE(err && err->IsError());
+  err = ParseImportLine(IMPORT_JSON_LINES, "{\"key\": ", &invalid);
+  ASSERT_TRUE(err && err->IsError());
+}
@@ -0,0 +1,52 @@
+#include <gtest/gtest.h>
+
+#include "core/db/memcached/key_index.h"
+
+using fastonosql::core::memcached::KeyIndex;
+
+TEST(KeyIndex, RefreshKeepsWritesMadeWhileDumping) {
+  KeyIndex index;
+  KeyIndex::keys_t keys;
+  keys["old"] = 0;
+  keys["kept"] = 0;
+  index.Reset(&keys, 0);
+
+  // dump sees state before these writes
+  index.BeginRefresh();
+  index.Add("new", 10);
+  index.Remove("old");
+  KeyIndex::keys_t dumped;
+  dumped["old"] = 0;
+  dumped["kept"] = 0;
+  index.Reset(&dumped, 1);
+
+  time_t exp = 0;
+  ASSERT_TRUE(index.FindExpiration("new", &exp));
+  ASSERT_EQ(exp, 10);
+  ASSERT_FALSE(index.FindExpiration("old", &exp));
+  ASSERT_TRUE(index.FindExpiration("kept", &exp));
+  ASSERT_EQ(index.Size(), 2u);
+
+  // writes after refresh aren't journaled anymore
+  index.Remove("kept");
+  KeyIndex::keys_t next;
+  next["kept"] = 0;
+  index.Reset(&next, 2);
+  ASSERT_TRUE(index.FindExpiration("kept", &exp));
+  ASSERT_EQ(index.Size(), 1u);
+}
+
+TEST(KeyIndex, CanceledRefreshForgetsJournal) {
+  KeyIndex index;
+  KeyIndex::keys_t keys;
+  index.Reset(&keys, 0);
+
+  index.BeginRefresh();
+  index.Add("key", 0);
+  index.CancelRefresh();
+  ASSERT_EQ(index.Size(), 1u);
+
+  KeyIndex::keys_t dumped;
+  index.Reset(&dumped, 1);
+  ASSERT_EQ(index.Size(), 0u);
+}
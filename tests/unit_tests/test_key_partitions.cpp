@@ -0,0 +1,190 @@
+#include <gtest/gtest.h>
+
+#include <map>
+
+#include <common/convert2string.h>
+
+#include "core/internal/key_partitions.h"
+#include "core/partitioned_scan.h"
+
+using namespace fastonosql::core;
+
+namespace {
+
+class MapPartitionedSource : public IPartitionedSource {
+ public:
+  explicit MapPartitionedSource(const std::map<std::string, std::string>& data) : data_(data) {}
+
+  virtual common::Error Partition(size_t count, key_ranges_t* ranges) override {
+    auto seek_func = [this](const std::string& key, std::string* found) {
+      auto it = data_.lower_bound(key);
+      if (it == data_.end()) {
+        return false;
+      }
+      *found = it->first;
+      return true;
+    };
+    *ranges = internal::SplitByPrefixProbes(seek_func, count);
+    return common::Error();
+  }
+
+  virtual common::Error ScanRange(const KeyRange& range,
+                                  const std::string& pattern,
+                                  size_t batch_size,
+                                  bool with_values,
+                                  range_batch_callback_t batch_cb) override {
+    UNUSED(pattern);
+    NDbKValues batch;
+    for (auto it = data_.lower_bound(range.start); it != data_.end(); ++it) {
+      if (!range.Contains(it->first)) {
+        break;
+      }
+      NValue val;
+      if (with_values) {
+        val = NValue(common::Value::CreateStringValue(it->second));
+      }
+      batch.push_back(NDbKValue(NKey(it->first), val));
+      if (batch.size() >= batch_size) {
+        if (!batch_cb(batch)) {
+          return common::Error();
+        }
+        batch.clear();
+      }
+    }
+    if (!batch.empty()) {
+      batch_cb(batch);
+    }
+    return common::Error();
+  }
+
+ private:
+  const std::map<std::string, std::string> data_;
+};
+
+std::map<std::string, std::string> MakeData(size_t count) {
+  std::map<std::string, std::string> data;
+  for (size_t i = 0; i < count; ++i) {
+    std::string ns(1, static_cast<char>('a' + i % 26));
+    data[ns + ":" + common::ConvertToString(i)] = "value";
+  }
+  return data;
+}
+
+}  // namespace
+
+TEST(KeyPartitions, SplitByWeights) {
+  internal::weighted_bounds_t bounds;
+  bounds.push_back(std::make_pair("b", 10));
+  bounds.push_back(std::make_pair("c", 10));
+  bounds.push_back(std::make_pair("d", 10));
+  bounds.push_back(std::make_pair("", 10));
+  key_ranges_t ranges = internal::SplitByWeights(bounds, 2);
+  ASSERT_EQ(ranges.size(), 2u);
+  ASSERT_EQ(ranges[0].start, "");
+  ASSERT_EQ(ranges[0].limit, "c");
+  ASSERT_EQ(ranges[1].start, "c");
+  ASSERT_EQ(ranges[1].limit, "");
+
+  ranges = internal::SplitByWeights(bounds, 1);
+  ASSERT_EQ(ranges.size(), 1u);
+  ASSERT_TRUE(ranges[0].Contains("z"));
+}
+
+TEST(KeyPartitions, SplitByPrefixProbes) {
+  MapPartitionedSource source(MakeData(260));
+  key_ranges_t ranges;
+  ASSERT_FALSE(source.Partition(4, &ranges));
+  ASSERT_EQ(ranges.size(), 4u);
+  ASSERT_EQ(ranges.front().start, "");
+  ASSERT_EQ(ranges.back().limit, "");
+  for (size_t i = 1; i < ranges.size(); ++i) {
+    ASSERT_EQ(ranges[i - 1].limit, ranges[i].start);
+  }
+}
+
+TEST(KeyPartitions, SplitByPrefixProbesLongPrefix) {
+  // all keys share long prefix, so ranges are found only by deeper bytes
+  std::map<std::string, std::string> data;
+  for (size_t i = 0; i < 1000; ++i) {
+    data["user:session:" + common::ConvertToString(i)] = "value";
+  }
+  MapPartitionedSource source(data);
+  key_ranges_t ranges;
+  ASSERT_FALSE(source.Partition(4, &ranges));
+  ASSERT_EQ(ranges.size(), 4u);
+  for (size_t i = 0; i < ranges.size(); ++i) {
+    size_t count = 0;
+    for (auto it = data.begin(); it != data.end(); ++it) {
+      count += ranges[i].Contains(it->first);
+    }
+    ASSERT_GT(count, data.size() / 8);
+    ASSERT_LT(count, data.size() / 2);
+  }
+}
+
+TEST(KeyPartitions, SplitBySizesRefinesHeavyPieces) {
+  std::map<std::string, std::string> data;
+  for (size_t i = 0; i < 1000; ++i) {
+    data["user:" + common::ConvertToString(i)] = "value";
+  }
+  size_t calls = 0;
+  auto sizes_func = [&data, &calls](const key_ranges_t& ranges, std::vector<uint64_t>* sizes) {
+    calls++;
+    for (size_t i = 0; i < ranges.size(); ++i) {
+      uint64_t size = 0;
+      for (auto it = data.begin(); it != data.end(); ++it) {
+        size += ranges[i].Contains(it->first);
+      }
+      sizes->push_back(size);
+    }
+    return true;
+  };
+  key_ranges_t ranges = internal::SplitBySizes(sizes_func, 4);
+  ASSERT_EQ(ranges.size(), 4u);
+  // only pieces on the way to "user:" and its next byte are sized again
+  ASSERT_LE(calls, 8u);
+  for (size_t i = 0; i < ranges.size(); ++i) {
+    std::vector<uint64_t> sizes;
+    ASSERT_TRUE(sizes_func(key_ranges_t(1, ranges[i]), &sizes));
+    ASSERT_GT(sizes[0], data.size() / 8);
+    ASSERT_LT(sizes[0], data.size() / 2);
+  }
+}
+
+TEST(KeyPartitions, OrderedScan) {
+  std::map<std::string, std::string> data = MakeData(1000);
+  MapPartitionedSource source(data);
+  PartitionedScanOptions options;
+  options.workers = 4;
+  options.batch_size = 7;
+  options.queue_size = 1;
+  options.with_values = true;
+  options.ordered = true;
+  PartitionedScan scan(&source, options);
+  std::vector<std::string> keys;
+  CopyStats stats;
+  common::Error err = scan.Run(PartitionedScan::interrupt_callback_t(),
+                               [&keys](size_t partition, const NDbKValues& batch) {
+                                 UNUSED(partition);
+                                 for (size_t i = 0; i < batch.size(); ++i) {
+                                   keys.push_back(batch[i].KeyString());
+                                 }
+                               },
+                               PartitionedScan::progress_callback_t(), &stats);
+  ASSERT_FALSE(err && err->IsError());
+  ASSERT_GT(scan.Ranges().size(), 1u);
+  ASSERT_EQ(stats.scanned, 1000u);
+  ASSERT_EQ(keys.size(), data.size());
+  size_t pos = 0;
+  for (auto it = data.begin(); it != data.end(); ++it, ++pos) {
+    ASSERT_EQ(keys[pos], it->first);
+  }
+
+  size_t count = 0;
+  err = CountKeysPartitioned(&source, options, PartitionedScan::interrupt_callback_t(), &count);
+  ASSERT_FALSE(err && err->IsError());
+  ASSERT_EQ(count, 1000u);
+
+  err = CountKeysPartitioned(&source, options, []() { return true; }, &count);
+  ASSERT_TRUE(err && err->IsError());
+}
@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+
+#include <common/convert2string.h>
+
+#include "core/namespace_size.h"
+#include "core/namespace_stats.h"
+
+using namespace fastonosql::core;
+
+TEST(NamespaceTree, AggregateByLevels) {
+  NamespaceTree tree(":", NamespaceTreeOptions());
+  tree.Add(NKey("users:1:name"), common::Value::TYPE_STRING, 5);
+  tree.Add(NKey("users:1:email", 30), common::Value::TYPE_STRING, 15);
+  tree.Add(NKey("users:2"), common::Value::TYPE_HASH, 100);
+  tree.Add(NKey("counter"), common::Value::TYPE_STRING, 2);
+
+  const NamespaceNode& root = tree.Root();
+  ASSERT_EQ(root.stats.keys, 4u);
+  ASSERT_EQ(root.children.size(), 1u);
+  ASSERT_EQ(root.DirectKeys().keys, 1u);
+
+  const NamespaceNode& users = *root.children.at("users");
+  ASSERT_EQ(users.name, "users");
+  ASSERT_EQ(users.stats.keys, 3u);
+  ASSERT_EQ(users.stats.total_bytes, 120u);
+  ASSERT_EQ(users.stats.max_bytes, 100u);
+  ASSERT_EQ(users.stats.ttl_histogram[TTL_BUCKET_MINUTE], 1u);
+  ASSERT_EQ(users.stats.types.at(common::Value::TYPE_HASH), 1u);
+
+  const NamespaceNode& user = *users.children.at("1");
+  ASSERT_EQ(user.name, "users:1");
+  ASSERT_EQ(user.stats.keys, 2u);
+  ASSERT_EQ(tree.NodesCount(), 3u);
+}
+
+TEST(NamespaceTree, TopChildrenAndMerge) {
+  NamespaceTreeOptions options;
+  options.max_children = 2;
+  NamespaceTree left(":", options);
+  NamespaceTree right(":", options);
+  for (int i = 0; i < 10; ++i) {
+    left.Add(NKey("big:" + common::ConvertToString(i)), common::Value::TYPE_STRING, 1);
+    right.Add(NKey("big:" + common::ConvertToString(i)), common::Value::TYPE_STRING, 1);
+  }
+  left.Add(NKey("medium:1"), common::Value::TYPE_STRING, 1);
+  left.Add(NKey("medium:2"), common::Value::TYPE_STRING, 1);
+  for (int i = 0; i < 5; ++i) {
+    right.Add(NKey("small" + common::ConvertToString(i) + ":1"), common::Value::TYPE_STRING, 1);
+  }
+
+  left.Merge(right);
+  const NamespaceNode& root = left.Root();
+  ASSERT_EQ(root.stats.keys, 27u);
+  ASSERT_LE(root.children.size(), 4u);
+  ASSERT_EQ(root.children.at("big")->stats.keys, 20u);
+  uint64_t counted = root.other.keys;
+  for (auto it = root.children.begin(); it != root.children.end(); ++it) {
+    counted += it->second->stats.keys;
+  }
+  ASSERT_EQ(counted, 27u);
+}
+
+TEST(NamespaceRange, KeysOfNamespace) {
+  NamespaceRange users("users", ":");
+  ASSERT_EQ(users.start, "users:");
+  ASSERT_EQ(users.limit, "users;");
+  ASSERT_TRUE(users.Contains("users:1"));
+  ASSERT_TRUE(users.Contains("users:1:name"));
+  ASSERT_FALSE(users.Contains("users"));
+  ASSERT_FALSE(users.Contains("users2:1"));
+
+  NamespaceRange all("", ":");
+  ASSERT_TRUE(all.limit.empty());
+  ASSERT_TRUE(all.Contains("users"));
+  ASSERT_TRUE(all.Contains(std::string()));
+}
+
+TEST(NamespaceTree, StatsTargetKeepsTTL) {
+  NamespaceTree tree(":", NamespaceTreeOptions());
+  NamespaceStatsTarget target(&tree);
+  ASSERT_TRUE(target.IsSupportedTTL());
+
+  NDbKValues keys;
+  keys.push_back(NDbKValue(NKey("users:1", 30), NValue(common::Value::CreateStringValue("v"))));
+  keys.push_back(NDbKValue(NKey("users:2"), NValue(common::Value::CreateStringValue("v"))));
+  NDbKValues added_keys;
+  common::Error err = target.SetBatch(keys, &added_keys);
+  ASSERT_FALSE(err && err->IsError());
+  ASSERT_EQ(tree.Root().stats.keys, 2u);
+  ASSERT_EQ(tree.Root().stats.ttl_histogram[TTL_BUCKET_MINUTE], 1u);
+}
@@ -0,0 +1,50 @@
+#include <gtest/gtest.h>
+
+#include "core/internal/range_scan.h"
+
+using namespace fastonosql::core::internal;
+
+TEST(RangeScan, GlobPrefix) {
+  ASSERT_EQ(GlobPrefix("*"), "");
+  ASSERT_EQ(GlobPrefix("user:*"), "user:");
+  ASSERT_EQ(GlobPrefix("user:?0"), "user:");
+  ASSERT_EQ(GlobPrefix("user:[ab]*"), "user:");
+  ASSERT_EQ(GlobPrefix("a\\*b*"), "a*b");
+  ASSERT_EQ(GlobPrefix("key"), "key");
+}
+
+TEST(RangeScan, PrefixEnd) {
+  ASSERT_EQ(PrefixEnd(""), "");
+  ASSERT_EQ(PrefixEnd("user:"), "user;");
+  ASSERT_EQ(PrefixEnd(std::string("a\xff", 2)), "b");
+  ASSERT_EQ(PrefixEnd(std::string("\xff\xff", 2)), "");
+}
+
+TEST(RangeScan, KeyRangePosition) {
+  ASSERT_DOUBLE_EQ(KeyRangePosition("", "", std::string(1, '\x80')), 0.5);
+  ASSERT_DOUBLE_EQ(KeyRangePosition("a", "c", "b"), 0.5);
+  ASSERT_DOUBLE_EQ(KeyRangePosition("user:", "user;", "user:"), 0);
+  ASSERT_GT(KeyRangePosition("user:", "user;", "user:\x80"), 0.4);
+  ASSERT_LT(KeyRangePosition("user:", "user;", "user:\x80"), 0.6);
+  ASSERT_DOUBLE_EQ(KeyRangePosition("a", "c", "d"), 1);
+  ASSERT_DOUBLE_EQ(KeyRangePosition("b", "b", "b"), 1);
+}
+
+TEST(RangeScan, Cursors) {
+  RangeScanCursors cursors;
+  std::string last_key;
+  ASSERT_FALSE(cursors.Take(10, "*", &last_key));
+  cursors.Put(10, "*", "key10");
+  cursors.Put(10, "user:*", "user:10");
+  ASSERT_TRUE(cursors.Take(10, "user:*", &last_key));
+  ASSERT_EQ(last_key, "user:10");
+  ASSERT_FALSE(cursors.Take(10, "user:*", &last_key));
+  ASSERT_TRUE(cursors.Take(10, "*", &last_key));
+  ASSERT_EQ(last_key, "key10");
+
+  for (uint64_t i = 1; i <= RANGE_SCAN_CURSORS_MAX_COUNT + 1; ++i) {
+    cursors.Put(i, "*", "key");
+  }
+  ASSERT_FALSE(cursors.Take(1, "*", &last_key));
+  ASSERT_TRUE(cursors.Take(2, "*", &last_key));
+}
@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <iterator>
+#include <map>
+
+#include <rocksdb/db.h>
+
+#include <common/convert2string.h>
+#include <common/file_system.h>
+
+#include "core/db/rocksdb/sst_loader.h"
+
+using namespace fastonosql::core;
+using fastonosql::core::rocksdb::RunReader;
+using fastonosql::core::rocksdb::SstLoadOptions;
+using fastonosql::core::rocksdb::SstLoader;
+
+namespace {
+
+std::string TempPath(const std::string& name) {
+  return std::string(PROJECT_TEST_TEMP_DIR) + common::file_system::get_separator_string<char>() +
+         name;
+}
+
+void WriteRunString(std::ofstream* out, const std::string& str) {
+  uint32_t size = str.size();
+  out->write(reinterpret_cast<const char*>(&size), sizeof(size));
+  out->write(str.data(), size);
+}
+
+}  // namespace
+
+TEST(SstLoader, DefaultMemoryBudget) {
+  SstLoadOptions options;
+  ASSERT_LE(options.MemoryBudget(), 128u * 1024 * 1024);
+}
+
+TEST(SstLoader, UnsortedAndDuplicatedInput) {
+  const std::string input_path = TempPath("sst_loader_input.txt");
+  const std::string db_path = TempPath("sst_loader_db");
+  std::map<std::string, std::string> expected;
+  {
+    std::ofstream input(input_path, std::ios::out | std::ios::trunc);
+    for (int i = 0; i < 100; ++i) {
+      // every key twice, in shuffled order
+      std::string key = "key" + common::ConvertToString((i * 37) % 50);
+      std::string value = "value" + common::ConvertToString(i);
+      input << "SET " << key << " " << value << "\n";
+      expected[key] = value;
+    }
+  }
+
+  ::rocksdb::Options db_options;
+  db_options.create_if_missing = true;
+  ::rocksdb::DB* db = nullptr;
+  ASSERT_TRUE(::rocksdb::DB::Open(db_options, db_path, &db).ok());
+
+  ImportReader reader(IMPORT_COMMANDS);
+  common::Error err = reader.Open(input_path);
+  ASSERT_FALSE(err && err->IsError());
+
+  // tiny runs and files, so duplicates meet across runs and ssts are cut
+  SstLoadOptions options;
+  options.temp_dir = TempPath("sst_loader_tmp");
+  options.run_size = 512;
+  options.sst_file_size = 512;
+  ImportStats stats;
+  err = SstLoader(db, options)
+            .Run(&reader, SstLoader::interrupt_callback_t(),
+                 SstLoader::progress_callback_t(), &stats);
+  ASSERT_FALSE(err && err->IsError());
+  ASSERT_EQ(stats.sent, 100u);
+  ASSERT_EQ(stats.replies, expected.size());
+  ASSERT_EQ(stats.errors, 0u);
+
+  for (auto it = expected.begin(); it != expected.end(); ++it) {
+    std::string value;
+    ASSERT_TRUE(db->Get(::rocksdb::ReadOptions(), it->first, &value).ok());
+    ASSERT_EQ(value, it->second);
+  }
+
+  reader.Close();
+  delete db;
+  ASSERT_TRUE(::rocksdb::DestroyDB(db_path, ::rocksdb::Options()).ok());
+  err = common::file_system::remove_file(input_path);
+  ASSERT_FALSE(err && err->IsError());
+}
+
+TEST(SstLoader, TruncatedRun) {
+  const std::string path = TempPath("sst_loader_run");
+  std::string whole;
+  {
+    std::ofstream run(path, std::ios::out | std::ios::binary | std::ios::trunc);
+    WriteRunString(&run, "key1");
+    WriteRunString(&run, "value1");
+    WriteRunString(&run, "key2");
+    WriteRunString(&run, "value2");
+  }
+
+  {
+    RunReader reader(path, 0);
+    ASSERT_TRUE(reader.Next());
+    ASSERT_EQ(reader.Current().first, "key1");
+    ASSERT_TRUE(reader.Next());
+    ASSERT_EQ(reader.Current().second, "value2");
+    ASSERT_FALSE(reader.Next());
+    ASSERT_FALSE(reader.IsFailed());
+  }
+
+  // value of the second pair is cut, its end isn't the end of run
+  {
+    std::ifstream in(path, std::ios::in | std::ios::binary);
+    whole.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+  }
+  {
+    std::ofstream run(path, std::ios::out | std::ios::binary | std::ios::trunc);
+    run.write(whole.data(), whole.size() - 3);
+  }
+  {
+    RunReader reader(path, 0);
+    ASSERT_TRUE(reader.Next());
+    ASSERT_FALSE(reader.Next());
+    ASSERT_TRUE(reader.IsFailed());
+  }
+
+  common::Error err = common::file_system::remove_file(path);
+  ASSERT_FALSE(err && err->IsError());
+
+  RunReader missing(path, 0);
+  ASSERT_FALSE(missing.Next());
+  ASSERT_TRUE(missing.IsFailed());
+}